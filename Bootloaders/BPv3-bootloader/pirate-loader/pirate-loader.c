@@ -2,9 +2,13 @@
  
  Pirate-Loader for Bootloader v4
  
- Version  : 1.0.2
+ Version  : 1.2.0
  
  Changelog:
+ +2026-10-17 - Bootloader commands taken from Bootloaders/common/loader.c, shared with the v4 loader and pirate-multiloader
+ 
+ +2026-10-17 - HEX parsing and jump fixing moved to Bootloaders/common/hexfile.c, shared with the v4 loader
+ 
  +2010-06-28 - Made HEX parser case-insensative
  
   + 2010-02-04 - Changed polling interval to 10ms on Windows select wrapper, suggested by Michal (robots)
@@ -23,11 +27,11 @@
  
   UNIX family systems:
 	
-	gcc pirate-loader.c -o pirate-loader
+	gcc pirate-loader.c ../../common/hexfile.c ../../common/loader.c -I../../common -o pirate-loader
  
   WINDOWS:
     
-	cl pirate-loader.c /DWIN32=1
+	cl pirate-loader.c ../../common/hexfile.c ../../common/loader.c /I../../common /DWIN32=1
  
  
  Usage:
@@ -42,7 +46,10 @@
 #include <fcntl.h>
 #include <errno.h>
 
-#define PIRATE_LOADER_VERSION "1.0.2"
+#include "hexfile.h"
+#include "loader.h"
+
+#define PIRATE_LOADER_VERSION "1.2.0"
 
 #define STR_EXPAND(tok) #tok
 #define OS_NAME(tok) STR_EXPAND(tok)
@@ -163,30 +170,6 @@
 #define OS UNKNOWN
 #endif
 
-#define BOOTLOADER_HELLO_STR "\xC1"
-#define BOOTLOADER_OK 0x4B
-#define BOOTLOADER_PLACEMENT 1
-
-#define PIC_FLASHSIZE 0xAC00
-
-#define PIC_NUM_PAGES 512
-#define PIC_NUM_ROWS_IN_PAGE  8
-#define PIC_NUM_WORDS_IN_ROW 64
-
-#define PIC_WORD_SIZE  (3)
-#define PIC_ROW_SIZE  (PIC_NUM_WORDS_IN_ROW * PIC_WORD_SIZE)
-#define PIC_PAGE_SIZE (PIC_NUM_ROWS_IN_PAGE  * PIC_ROW_SIZE)
-
-
-#define PIC_ROW_ADDR(p,r)		(((p) * PIC_PAGE_SIZE) + ((r) * PIC_ROW_SIZE))
-#define PIC_WORD_ADDR(p,r,w)	(PIC_ROW_ADDR(p,r) + ((w) * PIC_WORD_SIZE))
-#define PIC_PAGE_ADDR(p)		(PIC_PAGE_SIZE * (p))
-
-#define PAYLOAD_OFFSET 5
-#define HEADER_LENGTH PAYLOAD_OFFSET
-#define LENGTH_OFFSET 4
-#define COMMAND_OFFSET 3
-
 /* type definitions */
 
 typedef unsigned char  uint8;
@@ -201,6 +184,11 @@ uint8		g_simulate = 0;
 const char* g_device_path  = NULL;
 const char* g_hexfile_path = NULL;
 
+/* upload state */
+
+const loader_target_t*	g_target = NULL;
+loader_window_t			g_pending; //the ds30 bootloader has no pipeline, one command at a time
+
 /* functions */
 
 int readWithTimeout(int fd, uint8* out, int length, int timeout)
@@ -234,34 +222,6 @@ int readWithTimeout(int fd, uint8* out, int length, int timeout)
 	return got;
 }
 
-unsigned char hexdec(const char* pc)
-{	unsigned char temp;
-
-	if(pc[0]>='a'){
-		temp=pc[0]-'a'+10;
-	}else if(pc[0] >= 'A'){
-		temp=pc[0]-'A'+10;		
-	}else{
-		temp=pc[0] - '0';
-	}
-	temp=temp<<4;
-	
-	if(pc[1]>='a'){
-		temp|=pc[1]-'a'+10;
-	}else if(pc[1] >= 'A'){
-		temp|=pc[1]-'A'+10;		
-	}else{
-		temp|=pc[1] - '0';
-	}
-	
-	return(temp & 0x0FF);
-
-	
-	//return (((pc[0] >= 'A') ? ( pc[0] - 'A' + 10 ) : ( pc[0] - '0' ) ) << 4 | 
-	//		((pc[1] >= 'A') ? ( pc[1] - 'A' + 10 ) : ( pc[1] - '0' ) )) & 0x0FF;
-	
-}
-
 void dumpHex(uint8* buf, uint32 len)
 {
 	uint32 i=0;
@@ -272,149 +232,24 @@ void dumpHex(uint8* buf, uint32 len)
 	putchar('\n');
 }
 
-int readHEX(const char* file, uint8* bout, unsigned long max_length, uint8* pages_used)
-{
-	static const uint32 HEX_DATA_OFFSET = 4;
-	uint8  linebin[256] = {0};
-	uint8* data = (linebin + HEX_DATA_OFFSET);
-	uint8  hex_crc, hex_type, hex_len;
-	uint32 hex_addr;
-	uint32 hex_base_addr = 0;
-	uint32 hex_words     = 0;
-	
-	uint32 f_addr = 0;
-	uint32 o_addr = 0;
-	
-	uint32 num_words = 0;
-	
-	char  line[512] = {0};
-	char  *pc;
-	char  *pline = line + 1;
-	int   res = 0;
-	int	  binlen = 0;
-	int   line_no = 0;
-	int   i = 0;
-	
-	FILE* fp = fopen(file, "rb");
-	
-	if( !fp ) {
-		return -1;
-	}
-	
-	while( !feof(fp) && fgets(line, sizeof(line) - 1, fp) )
-	{
-		line_no++;
-		
-		if( line[0] != ':' ) {
-			break;
-		}
-		
-		res = strlen(pline);
-		pc  = pline + res - 1;
-		
-		while( pc > pline && *pc <= ' ' ) {
-			*pc-- = 0;
-			res--;
-		}
-		
-		if( res & 0x01 || res > 512 || res < 10) {
-			fprintf(stderr, "Incorrect number of characters on line %d:%d\n", line_no, res);
-			return -1;
-		}
-		
-		hex_crc = 0;
-		
-		for( pc = pline, i = 0; i<res; i+=2, pc+=2 ) {
-			linebin[i >> 1] = hexdec(pc);
-			hex_crc += linebin[i >> 1];
-		}
-		
-		binlen = res / 2;
-		
-		if( hex_crc != 0 ) {
-			fprintf(stderr, "Checksum does not match, line %d\n", line_no);
-			return -1;
-		}
-		
-		hex_addr = (linebin[1] << 8) | linebin[2];
-		hex_len  = linebin[0];
-		hex_type = linebin[3];
-		
-		if( binlen - (1 + 2 + 1 + hex_len + 1) != 0 ) {
-			fprintf(stderr, "Incorrect number of bytes, line %d\n", line_no);
-			return -1;
-		}
-		
-		if( hex_type == 0x00 )
-		{
-			f_addr  = (hex_base_addr | (hex_addr)) / 2; //PCU
-			
-			if( hex_len % 4 ) {
-				fprintf(stderr, "Misaligned data, line %d\n", line_no);
-				return -1;
-			} else if( f_addr >= PIC_FLASHSIZE ) {
-				fprintf(stderr, "Current record address is higher than maximum allowed, line %d\n", line_no);
-				return -1;
-			}
-			
-			hex_words = hex_len  / 4;
-			o_addr  = (f_addr / 2) * PIC_WORD_SIZE; //BYTES
-			
-			for( i=0; i<hex_words; i++)
-			{
-				bout[o_addr + 0] = data[(i*4) + 2];
-				bout[o_addr + 1] = data[(i*4) + 0];
-				bout[o_addr + 2] = data[(i*4) + 1];
-				
-				pages_used[ (o_addr / PIC_PAGE_SIZE) ] = 1;
-				
-				o_addr    += PIC_WORD_SIZE;
-				num_words ++;
-			}
-
-		} else if ( hex_type == 0x04 && hex_len == 2) {
-			hex_base_addr = (linebin[4] << 24) | (linebin[5] << 16);
-		} else if ( hex_type == 0x01 ) {
-			break; //EOF
-		} else {
-			fprintf(stderr, "Unsupported record type %02x, line %d\n", hex_type, line_no);
-			return -1;
-		}
-		
-	}
-	
-	fclose(fp);
-	return num_words;
-}
-
-uint8 makeCrc(uint8* buf, uint32 len)
-{
-	uint8 crc = 0, i = 0;
-
-	for(i=0; i<len; i++){
-		crc -= *buf++;
-	}
-	
-	return crc;
-}
-
-int sendCommandAndWaitForResponse(int fd, uint8 *command)
+int sendCommandAndWaitForResponse(int fd, uint8 *command, uint32 length)
 {
 	uint8  response[4] = {0};
 	int    res = 0;
 	
-	res = write(fd, command, HEADER_LENGTH + command[LENGTH_OFFSET]);
+	res = write(fd, command, length);
 	
 	if( res <= 0 ) {
 		puts("ERROR");
 		return -1;
 	}
+	loaderWindowSent(&g_pending);
 	
-	res = readWithTimeout(fd, response, 1, 5);
+	res = readWithTimeout(fd, response, loaderWindowReplyLength(&g_pending), 5);
 	if( res != 1 ) {
 		puts("ERROR");
 		return -1;
-	} else if ( response[0] != BOOTLOADER_OK ) {
+	} else if ( loaderWindowReply(&g_pending, response) != LOADER_REPLY_OK ) {
 		printf("ERROR [%02x]\n", response[0]);
 		return -1;
 	} else {
@@ -423,7 +258,7 @@ int sendCommandAndWaitForResponse(int fd, uint8 *command)
 }
 
 
-int sendFirmware(int fd, uint8* data, uint8* pages_used)
+int sendFirmware(int fd, const uint8* data, uint8* pages_used, unsigned long flashsize)
 {
 	uint32 u_addr;
 	
@@ -431,62 +266,50 @@ int sendFirmware(int fd, uint8* data, uint8* pages_used)
 	uint32 page  = 0;
 	uint32 done  = 0;
 	uint32 row   = 0;
-	uint8  command[256] = {0};
+	uint32 length = 0;
+	uint8  command[LOADER_MAX_COMMAND] = {0};
 	
 	
 	for( page=0; page<PIC_NUM_PAGES; page++)
 	{
 		
-		u_addr = page * ( PIC_NUM_WORDS_IN_ROW * 2 * PIC_NUM_ROWS_IN_PAGE );
+		u_addr = loaderPageAddress(page);
 		
 		if( pages_used[page] != 1 ) {
-			if( g_verbose && u_addr < PIC_FLASHSIZE) {
+			if( g_verbose && u_addr < flashsize) {
 				fprintf(stdout, "Skipping page %ld [ %06lx ], not used\n", page, u_addr);
 			}
 			continue;
 		}
 		
-		if( u_addr >= PIC_FLASHSIZE ) {
+		if( u_addr >= flashsize ) {
 			fprintf(stderr, "Address out of flash\n");
 			return -1;
 		}
 		
 		//erase page
-		command[0] = (u_addr & 0x00FF0000) >> 16;
-		command[1] = (u_addr & 0x0000FF00) >>  8;
-		command[2] = (u_addr & 0x000000FF) >>  0;
-		command[COMMAND_OFFSET] = 0x01; //erase command
-		command[LENGTH_OFFSET ] = 0x01; //1 byte, CRC
-		command[PAYLOAD_OFFSET] = makeCrc(command, 5);
+		length = loaderCommandErase(command, page);
 		
 		if( g_verbose ) {
-			dumpHex(command, HEADER_LENGTH + command[LENGTH_OFFSET]);
+			dumpHex(command, length);
 		}
 		
 		printf("Erasing page %ld, %04lx...", page, u_addr);
 		
-		if( g_simulate == 0 && sendCommandAndWaitForResponse(fd, command) < 0 ) {
+		if( g_simulate == 0 && sendCommandAndWaitForResponse(fd, command, length) < 0 ) {
 			return -1;
 		}
 		
 		puts("OK");
 		
 		//write 8 rows
-		for( row = 0; row < PIC_NUM_ROWS_IN_PAGE; row ++, u_addr += (PIC_NUM_WORDS_IN_ROW * 2))
+		for( row = 0; row < PIC_NUM_ROWS_IN_PAGE; row ++, u_addr += PIC_ROW_SPAN)
 		{
-			command[0] = (u_addr & 0x00FF0000) >> 16;
-			command[1] = (u_addr & 0x0000FF00) >>  8;
-			command[2] = (u_addr & 0x000000FF) >>  0;
-			command[COMMAND_OFFSET] = 0x02; //write command
-			command[LENGTH_OFFSET ] = PIC_ROW_SIZE + 0x01; //DATA_LENGTH + CRC
-			
-			memcpy(&command[PAYLOAD_OFFSET], &data[PIC_ROW_ADDR(page, row)], PIC_ROW_SIZE);
-			
-			command[PAYLOAD_OFFSET + PIC_ROW_SIZE] = makeCrc(command, HEADER_LENGTH + PIC_ROW_SIZE);
+			length = loaderCommandWriteRow(command, data, page, row);
 			
 			printf("Writing page %ld row %ld, %04lx...", page, row + page*PIC_NUM_ROWS_IN_PAGE, u_addr);
 			
-			if( g_simulate == 0 && sendCommandAndWaitForResponse(fd, command) < 0 ) {
+			if( g_simulate == 0 && sendCommandAndWaitForResponse(fd, command, length) < 0 ) {
 				return -1;
 			}
 			
@@ -495,7 +318,7 @@ int sendFirmware(int fd, uint8* data, uint8* pages_used)
 			sleep(0);
 			
 			if( g_verbose ) {
-				dumpHex(command, HEADER_LENGTH + command[LENGTH_OFFSET]);
+				dumpHex(command, length);
 			}
 			done += PIC_ROW_SIZE;
 		}
@@ -504,30 +327,6 @@ int sendFirmware(int fd, uint8* data, uint8* pages_used)
 	return done;
 }
 
-void fixJumps(uint8* bin_buff, uint8* pages_used)
-{
-	uint32 iGotoUserAppAdress = 0;
-	uint32 iGotoUserAppAdressB3 = 0, iIter = 0;
-	uint32 iBLAddress = 0;
-	
-	iBLAddress = ( PIC_FLASHSIZE - (BOOTLOADER_PLACEMENT * PIC_NUM_ROWS_IN_PAGE * PIC_NUM_WORDS_IN_ROW * 2)); //PCU
-	iGotoUserAppAdress = iBLAddress  - 4; 
-	iGotoUserAppAdressB3 = (iGotoUserAppAdress / 2) * 3;
-	
-	for ( iIter = 0; iIter < 6; iIter++ ) {
-		bin_buff[ iGotoUserAppAdressB3 + iIter ] = bin_buff[ iIter ];
-	}
-	
-	pages_used[ (iGotoUserAppAdressB3 / PIC_PAGE_SIZE) ] = 1;
-	
-	bin_buff[0] = 0x04;
-	bin_buff[1] = ( (iBLAddress & 0x0000FE) );			
-	bin_buff[2] = ( (iBLAddress & 0x00FF00) >> 8 );			
-	bin_buff[3] = 0x00;	
-	bin_buff[4] = ( (iBLAddress & 0x7F0000) >> 16 );
-	bin_buff[5] = 0x00;
-}
-
 /* non-firmware functions */
 
 int configurePort(int fd, unsigned long baudrate)
@@ -624,8 +423,9 @@ int main (int argc, const char** argv)
 {
 	int		dev_fd = -1, res = -1;
 	uint8	buffer[256] = {0};
+	uint8	command[LOADER_MAX_COMMAND] = {0};
 	uint8	pages_used[PIC_NUM_PAGES] = {0};
-	uint8*	bin_buff = NULL;
+	loader_image_t*	image = NULL;
 	
 	
 	puts("+++++++++++++++++++++++++++++++++++++++++++");
@@ -646,31 +446,29 @@ int main (int argc, const char** argv)
 			return -1;
 		}
 	
-		bin_buff = (uint8*)malloc(256 << 10); //256kB
-		if( !bin_buff ) {
-			fprintf(stderr, "Could not allocate 256kB buffer\n");
+		image = (loader_image_t*)malloc(sizeof(loader_image_t));
+		if( !image ) {
+			fprintf(stderr, "Could not allocate %ldkB image buffer\n", (uint32)(sizeof(loader_image_t) >> 10));
 			goto Error;
 		}
 		
-		//fill the buffer with 0xFF
-		memset(bin_buff, 0xFFFFFFFF, (256 << 10));
-		
 		printf("Parsing HEX file [%s]\n", g_hexfile_path);
 		
-		res = readHEX(g_hexfile_path, bin_buff, (256 << 8), pages_used);
-		if( res <= 0 || res > PIC_FLASHSIZE ) {
-			fprintf(stderr, "Could not load HEX file, result=%d\n", res);
+		//also fixes the bootloader/userprogram jumps
+		if( loaderImageLoad(image, g_hexfile_path, LOADER_FAMILY_BPV3) < 0 ) {
+			fprintf(stderr, "Could not load HEX file\n");
 			goto Error;
 		}
 		
-		printf("Found %d words (%d bytes)\n", res, res * 3);
+		printf("Found %ld words (%ld bytes)\n", image->num_words, image->num_words * 3);
 		
-		printf("Fixing bootloader/userprogram jumps\n");
-		fixJumps(bin_buff, pages_used);
+		memcpy(pages_used, image->pages_used, sizeof(pages_used));
 	}
 	
+	loaderWindowInit(&g_pending, 1);
+	
 	if( g_simulate ) {
-		sendFirmware(dev_fd, bin_buff, pages_used);
+		sendFirmware(dev_fd, image->data, pages_used, image->flashsize);
 		goto Finished;
 	}
 		
@@ -702,11 +500,11 @@ int main (int argc, const char** argv)
 	printf("Sending Hello to the Bootloader...");
 	
 	//send HELLO
-	res = write(dev_fd, BOOTLOADER_HELLO_STR, 1);
+	res = write(dev_fd, command, loaderCommandHello(command));
 	
-	res = readWithTimeout(dev_fd, buffer, 4, 3);
+	res = readWithTimeout(dev_fd, buffer, LOADER_HELLO_REPLY_LENGTH, 3);
 	
-	if( res != 4 || buffer[3] != BOOTLOADER_OK ) {
+	if( res != LOADER_HELLO_REPLY_LENGTH || !loaderHelloValid(buffer) ) {
 		puts("ERROR");
 		fprintf(stderr, "No reply from the bootloader, or invalid reply received: %d\n", res);
 		fprintf(stderr, "Please make sure that PGND and PGC are connected, replug the device and try again\n");
@@ -714,17 +512,19 @@ int main (int argc, const char** argv)
 	}
 	puts("OK\n"); //extra LF for spacing
 	
-	printf("Device ID: %s [%02x]\n", (buffer[0] == 0xD4) ? "PIC24FJ64GA002" : "UNKNOWN", buffer[0]);
+	g_target = loaderFindTarget(LOADER_FAMILY_BPV3, buffer[0]);
+	
+	printf("Device ID: %s [%02x]\n", g_target ? g_target->name : "UNKNOWN", buffer[0]);
 	printf("Bootloader version: %d,%02d\n", buffer[1], buffer[2]);
 	
-	if( buffer[0] != 0xD4 ) {
+	if( !g_target ) {
 		fprintf(stderr, "Unsupported device (%02x:UNKNOWN), only 0xD4 PIC24FJ64GA002 is supported\n", buffer[0]);
 		goto Error;
 	}
 	
 	if( !g_hello_only ) {
 	
-		res = sendFirmware(dev_fd, bin_buff, pages_used);
+		res = sendFirmware(dev_fd, image->data, pages_used, g_target->flashsize);
 		
 		if( res > 0 ) {
 			puts("\nFirmware updated successfully :)!");
@@ -737,15 +537,15 @@ int main (int argc, const char** argv)
 	}
 	
 Finished:
-	if( bin_buff ) { 
-		free( bin_buff );
+	if( image ) { 
+		free( image );
 	}
 	close(dev_fd);
     return 0;
 	
 Error:
-	if( bin_buff ) {
-		free( bin_buff );
+	if( image ) {
+		free( image );
 	}
 	if( dev_fd >= 0 ) {
 		close(dev_fd);
@@ -7,6 +7,8 @@ void usbbufservice(void);
 void bootloader(void);
 void usb_handler(void);
 void WritePage(void);
+void SendPageCrc(void);
+unsigned int Crc16Update(unsigned int crc, BYTE data);
 void __builtin_write_NVM(void);
 void __builtin_tblwtl(unsigned int offset, unsigned int data);
 void __builtin_tblwth(unsigned int offset, unsigned int data);
@@ -22,7 +24,7 @@ BYTE bldone = 0;
 extern BYTE cdc_In_buffer[64];
 extern BYTE cdc_Out_buffer[64];
 #define VER_H 0x04
-#define VER_L 0x0a
+#define VER_L 0x0c
 
 unsigned int userversion  __attribute__((space(prog),address(BLENDADDR-9))) = ((VER_H<<8)|VER_L); 
 
@@ -31,6 +33,8 @@ int foo __attribute__((section("mysection"),address(0x2000)));
 struct _bootstruct {
     BYTE enableerase;
     BYTE blreturn;
+    BYTE pipelined; //reply with a sequence number after the status byte
+    BYTE sequence;
     BYTE addrU;
     BYTE addrH;
     BYTE addrL;
@@ -52,6 +56,7 @@ void bootloader(void) {
 	BYTE crc;
 
     bootstruct.enableerase = 0;
+    bootstruct.pipelined = 0;
 
     do {
         do {
@@ -77,7 +82,13 @@ error:
         	usb_handler();
         	WaitInReady();
             cdc_In_buffer[0] = bootstruct.blreturn; //answer OK
-            putUnsignedCharArrayUsbUsart(cdc_In_buffer, 1);
+            if (bootstruct.pipelined) {
+                //the host keeps several commands in flight, tell it which one this is
+                cdc_In_buffer[1] = bootstruct.sequence++;
+                putUnsignedCharArrayUsbUsart(cdc_In_buffer, 2);
+            } else {
+                putUnsignedCharArrayUsbUsart(cdc_In_buffer, 1);
+            }
 			
 			crc=0;
 
@@ -112,6 +123,7 @@ error:
 				goto error;
 
 			}
+			bootstruct.blreturn = 'K';
 
 			//calculate flash address
         	//fulladdress = ( ((bootstruct.addrU) << 16) + ((bootstruct.addrH) << 8) + bootstruct.addrL);
@@ -128,6 +140,13 @@ error:
 	                break;
 	            case 2: //protect the bootloader and write the row
 	                WritePage();
+	                break;
+	            case 3: //sequence-numbered replies from now on, starting at 0 for this one
+	                bootstruct.pipelined = 1;
+	                bootstruct.sequence = 0;
+	                break;
+	            case 4: //send the CRC of the page, ahead of the usual reply
+	                SendPageCrc();
 	                break;
 				case 0xff:
 					 U1CONbits.USBEN=0; //USB off
@@ -145,6 +164,43 @@ error:
     } while (!bldone);
 }
 
+//CRC-16/CCITT, 0x1021 polynomial
+unsigned int Crc16Update(unsigned int crc, BYTE data) {
+    BYTE i;
+
+    crc ^= ((unsigned int) data) << 8;
+    for (i = 0; i < 8; i++) {
+        if (crc & 0x8000)
+            crc = (crc << 1) ^ 0x1021;
+        else
+            crc <<= 1;
+    }
+    return crc;
+}
+
+void SendPageCrc() {
+    unsigned int i;
+    unsigned int dataword;
+    unsigned int offset;
+    unsigned int crc = 0xFFFF;
+
+    offset = (unsigned int) fulladdress;
+
+	//same byte order the rows are written in: upper, low, high
+    for (i = 0; i < (PAGESIZER * ROWSIZEW); i++) {
+        crc = Crc16Update(crc, (BYTE) __builtin_tblrdh(offset));
+        dataword = __builtin_tblrdl(offset);
+        crc = Crc16Update(crc, (BYTE) dataword);
+        crc = Crc16Update(crc, (BYTE) (dataword >> 8));
+        offset += 2;
+    }
+
+    WaitInReady();
+    cdc_In_buffer[0] = (BYTE) (crc >> 8);
+    cdc_In_buffer[1] = (BYTE) crc;
+    putUnsignedCharArrayUsbUsart(cdc_In_buffer, 2);
+}
+
 void WritePage() {
     BYTE i;
     int dataword;
@@ -2,10 +2,18 @@
 
  Pirate-Loader for Bootloader v4
 
- Version  : 1.0.3
+ Version  : 1.3.0
 
  Changelog:
 
+  + 2026-10-17 - Bootloader protocol taken from Bootloaders/common/loader.c, shared with the v3 loader and pirate-multiloader
+
+  + 2026-10-17 - HEX parsing moved to Bootloaders/common/hexfile.c: memory-mapped, validated, raw images accepted
+
+  + 2026-10-17 - Only rewrite pages whose on-device CRC differs, for bootloader v4.12+ ( --diff )
+
+  + 2026-10-17 - Pipelined row writes with sequence-numbered replies for bootloader v4.11+ ( --window=N )
+
   + 2016-08-22 - Migrated to CMake, minor fixes.
 
   + 2010-06-28 - Made HEX parser case-insensitive
@@ -57,7 +65,10 @@
 #include <fcntl.h>
 #include <errno.h>
 
-#define PIRATE_LOADER_VERSION "1.0.3"
+#include "hexfile.h"
+#include "loader.h"
+
+#define PIRATE_LOADER_VERSION "1.4.0"
 
 #define STR_EXPAND(tok) #tok
 #define OS_NAME(tok) STR_EXPAND(tok)
@@ -196,34 +207,7 @@ typedef unsigned long  uint32;
 #define OS UNKNOWN
 #endif
 
-#define BOOTLOADER_HELLO_STR "\xC1"
-#define BOOTLOADER_OK 0x4B
-#define BOOTLOADER_PROT 'P'
-#define PIC_WORD_SIZE  (3)
-#define PIC_NUM_ROWS_IN_PAGE  8
-#define PIC_NUM_WORDS_IN_ROW 64
-#define PIC_ROW_SIZE  (PIC_NUM_WORDS_IN_ROW * PIC_WORD_SIZE)
-#define PIC_PAGE_SIZE (PIC_NUM_ROWS_IN_PAGE  * PIC_ROW_SIZE)
-#define PIC_ROW_ADDR(p,r)		(((p) * PIC_PAGE_SIZE) + ((r) * PIC_ROW_SIZE))
-#define PIC_WORD_ADDR(p,r,w)	(PIC_ROW_ADDR(p,r) + ((w) * PIC_WORD_SIZE))
-#define PIC_PAGE_ADDR(p)		(PIC_PAGE_SIZE * (p))
-
-#define PAYLOAD_OFFSET 5
-#define HEADER_LENGTH PAYLOAD_OFFSET
-#define LENGTH_OFFSET 4
-#define COMMAND_OFFSET 3
-#define IS_24FJ 1
-#define PIC_NUM_PAGES 512
-
-//#define flashsize 0x2AC00 //was 0xac00
-//#define PIC_NUM_PAGES 512
-
-//unsigned short pic_num_pages;
-unsigned short family = IS_24FJ;
-unsigned long flashsize = 0x2AC00;
-unsigned short eesizeb  = 0;
-unsigned long blstartaddr = 0x400L; // not currently used
-unsigned long blendaddr = 0x23FFL; // not currently used
+#define DEFAULT_WINDOW 8
 
 
 /* global settings, command line arguments */
@@ -231,9 +215,16 @@ unsigned long blendaddr = 0x23FFL; // not currently used
 uint8		g_verbose = 0;
 uint8		g_hello_only = 0;
 uint8		g_simulate = 0;
+uint32		g_window = DEFAULT_WINDOW;
+uint8		g_diff = 0;
 const char* g_device_path  = NULL;
 const char* g_hexfile_path = NULL;
 
+/* upload state */
+
+const loader_target_t*	g_target = NULL;
+loader_window_t			g_pending; //erase and write commands waiting for their reply
+
 /* functions */
 
 int readWithTimeout(int fd, uint8* out, int length, int timeout)
@@ -275,43 +266,41 @@ int readWithTimeout(int fd, uint8* out, int length, int timeout)
     return got;
 }
 
-unsigned char hexdec(const char* pc)
+int writeAll(int fd, const uint8* buf, int length)
 {
-    unsigned char temp;
-
-    if(pc[0]>='a')
-    {
-        temp=pc[0]-'a'+10;
-    }
-    else if(pc[0] >= 'A')
-    {
-        temp=pc[0]-'A'+10;
-    }
-    else
-    {
-        temp=pc[0] - '0';
-    }
-    temp=temp<<4;
+    int res = 0;
+    int sent = 0;
+#ifndef WIN32
+    fd_set fds;
+#endif
 
-    if(pc[1]>='a')
-    {
-        temp|=pc[1]-'a'+10;
-    }
-    else if(pc[1] >= 'A')
-    {
-        temp|=pc[1]-'A'+10;
-    }
-    else
+    while( sent < length )
     {
-        temp|=pc[1] - '0';
-    }
+        res = write(fd, buf + sent, length - sent);
 
-    return(temp & 0x0FF);
+        if( res > 0 )
+        {
+            sent += res;
+            continue;
+        }
 
+#ifndef WIN32
+        //the port is opened non-blocking, wait for room in the output queue
+        if( res < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) )
+        {
+            FD_ZERO(&fds);
+            FD_SET(fd, &fds);
 
-    //return (((pc[0] >= 'A') ? ( pc[0] - 'A' + 10 ) : ( pc[0] - '0' ) ) << 4 |
-    //		((pc[1] >= 'A') ? ( pc[1] - 'A' + 10 ) : ( pc[1] - '0' ) )) & 0x0FF;
+            if( select(fd + 1, NULL, &fds, NULL, NULL) > 0 )
+            {
+                continue;
+            }
+        }
+#endif
+        return -1;
+    }
 
+    return sent;
 }
 
 void dumpHex(uint8* buf, uint32 len)
@@ -325,187 +314,205 @@ void dumpHex(uint8* buf, uint32 len)
     putchar('\n');
 }
 
-int readHEX(const char* file, uint8* bout, unsigned long max_length, uint8* pages_used)
+int waitForResponse(int fd)
 {
-    static const uint32 HEX_DATA_OFFSET = 4;
-    uint8  linebin[256] = {0};
-    uint8* data = (linebin + HEX_DATA_OFFSET);
-    uint8  hex_crc, hex_type, hex_len;
-    uint32 hex_addr;
-    uint32 hex_base_addr = 0;
-    uint32 hex_words     = 0;
-
-    uint32 f_addr = 0;
-    uint32 o_addr = 0;
-
-    uint32 num_words = 0;
-
-    char  line[512] = {0};
-    char  *pc;
-    char  *pline = line + 1;
-    int   res = 0;
-    int	  binlen = 0;
-    int   line_no = 0;
-    int   i = 0;
-
-    FILE* fp = fopen(file, "rb");
-
-    if( !fp )
-    {
-        return -1;
-    }
+    uint8  response[2] = {0};
+    int    length = loaderWindowReplyLength(&g_pending);
 
-    while( !feof(fp) && fgets(line, sizeof(line) - 1, fp) )
+    if( readWithTimeout(fd, response, length, 5) != length )
     {
-        line_no++;
-
-        if( line[0] != ':' )
+        puts("ERROR");
+        if( g_pending.pipelined )
         {
-            break;
+            fprintf(stderr, "No reply from the bootloader for command %d\n", g_pending.next_ack);
         }
+        return -1;
+    }
 
-        res = strlen(pline);
-        pc  = pline + res - 1;
+    switch( loaderWindowReply(&g_pending, response) )
+    {
+    case LOADER_REPLY_OK:
+        return 0;
 
-        while( pc > pline && *pc <= ' ' )
+    case LOADER_REPLY_PROTECTED:
+        if( !g_pending.pipelined )
         {
-            *pc-- = 0;
-            res--;
+            printf("(SKIPPED by bootloader)...");
         }
-
-        if( res & 0x01 || res > 512 || res < 10)
+        else if( g_verbose )
         {
-            fprintf(stderr, "Incorrect number of characters on line %d:%d\n", line_no, res);
-            return -1;
+            printf("Command %d skipped by bootloader\n", response[1]);
         }
+        return 0;
 
-        hex_crc = 0;
+    case LOADER_REPLY_OUT_OF_SEQUENCE:
+        puts("ERROR");
+        fprintf(stderr, "Reply out of sequence, expected %d got %d\n", g_pending.next_ack, response[1]);
+        return -1;
 
-        for( pc = pline, i = 0; i<res; i+=2, pc+=2 )
+    default:
+        if( !g_pending.pipelined )
         {
-            linebin[i >> 1] = hexdec(pc);
-            hex_crc += linebin[i >> 1];
+            printf("ERROR [%02x]\n", response[0]);
         }
-
-        binlen = res / 2;
-
-        if( hex_crc != 0 )
+        else
         {
-            fprintf(stderr, "Checksum does not match, line %d\n", line_no);
-            return -1;
+            puts("ERROR");
+            fprintf(stderr, "Command %d failed [%02x]\n", response[1], response[0]);
         }
+        return -1;
+    }
+}
 
-        hex_addr = (linebin[1] << 8) | linebin[2];
-        hex_len  = linebin[0];
-        hex_type = linebin[3];
-
-        if( binlen - (1 + 2 + 1 + hex_len + 1) != 0 )
+int drainPipeline(int fd)
+{
+    while( g_pending.in_flight > 0 )
+    {
+        if( waitForResponse(fd) < 0 )
         {
-            fprintf(stderr, "Incorrect number of bytes, line %d\n", line_no);
             return -1;
         }
+    }
 
-        if( hex_type == 0x00 )
-        {
-            f_addr  = (hex_base_addr | (hex_addr)) / 2; //PCU
-
-            if( hex_len % 4 )
-            {
-                fprintf(stderr, "Misaligned data, line %d\n", line_no);
-                return -1;
-            }
-            else if( f_addr >= flashsize )
-            {
-                fprintf(stderr, "Current record address is higher than maximum allowed, line %d\n", line_no);
-                return -1;
-            }
-
-            hex_words = hex_len  / 4;
-            o_addr  = (f_addr / 2) * PIC_WORD_SIZE; //BYTES
-
-            for( i=0; i<hex_words; i++)
-            {
-                bout[o_addr + 0] = data[(i*4) + 2];
-                bout[o_addr + 1] = data[(i*4) + 0];
-                bout[o_addr + 2] = data[(i*4) + 1];
-
-                pages_used[ (o_addr / PIC_PAGE_SIZE) ] = 1;
+    return 0;
+}
 
-                o_addr    += PIC_WORD_SIZE;
-                num_words ++;
-            }
+int sendCommand(int fd, uint8 *command, uint32 length)
+{
+    if( g_simulate )
+    {
+        return 0;
+    }
 
-        }
-        else if ( hex_type == 0x04 && hex_len == 2)
-        {
-            hex_base_addr = (linebin[4] << 24) | (linebin[5] << 16);
-        }
-        else if ( hex_type == 0x01 )
-        {
-            break; //EOF
-        }
-        else
+    //keep at most g_window commands waiting for a reply, one until pipelined
+    while( loaderWindowFull(&g_pending) )
+    {
+        if( waitForResponse(fd) < 0 )
         {
-            fprintf(stderr, "Unsupported record type %02x, line %d\n", hex_type, line_no);
             return -1;
         }
+    }
+
+    if( writeAll(fd, command, length) <= 0 )
+    {
+        puts("ERROR");
+        return -1;
+    }
+    loaderWindowSent(&g_pending);
 
+    if( !g_pending.pipelined )
+    {
+        return drainPipeline(fd);
     }
 
-    fclose(fp);
-    return num_words;
+    return 0;
 }
 
-uint8 makeCrc(uint8* buf, uint32 len)
+int enablePipeline(int fd)
 {
-    uint8 crc = 0, i = 0;
+    uint8  command[LOADER_MAX_COMMAND];
+    uint32 length = loaderCommandPipeline(command);
 
-    for(i=0; i<len; i++)
+    loaderWindowPipeline(&g_pending);
+
+    if( sendCommand(fd, command, length) < 0 || drainPipeline(fd) < 0 )
     {
-        crc -= *buf++;
+        loaderWindowInit(&g_pending, g_window);
+        return -1;
     }
 
-    return crc;
+    return 0;
 }
 
-int sendCommandAndWaitForResponse(int fd, uint8 *command)
+int readPageCrc(int fd, uint32 page, uint16* crc)
 {
-    uint8  response[4] = {0};
-    int    res = 0;
-
-    res = write(fd, command, HEADER_LENGTH + command[LENGTH_OFFSET]);
+    uint8  command[LOADER_MAX_COMMAND];
+    uint8  response[LOADER_CRC_REPLY_LENGTH] = {0};
+    uint32 length = loaderCommandPageCrc(command, page);
 
-    if( res <= 0 )
+    if( writeAll(fd, command, length) <= 0 )
     {
-        puts("ERROR");
         return -1;
     }
 
-    res = readWithTimeout(fd, response, 1, 5);
-    if( res != 1 )
+    if( readWithTimeout(fd, response, sizeof(response), 5) != sizeof(response) )
     {
-        puts("ERROR");
         return -1;
     }
-    else if (response[0]== BOOTLOADER_PROT)
-    {
-        printf("(SKIPPED by bootloader)...");
-        return 0;
 
-    }
-    else if ( response[0] != BOOTLOADER_OK )
+    return loaderReplyPageCrc(response, crc);
+}
+
+/* leaves out the pages the bootloader refuses to write, see loaderPageProtected */
+uint32 skipProtectedPages(uint8* pages_used)
+{
+    uint32 page;
+    uint32 skipped = 0;
+
+    for( page = 0; page < PIC_NUM_PAGES; page++ )
     {
-        printf("ERROR [%02x]\n", response[0]);
-        return -1;
+        if( pages_used[page] != 1 || !loaderPageProtected(g_target, page) )
+        {
+            continue;
+        }
+
+        if( g_verbose )
+        {
+            printf("Skipping page %ld [ %06lx ], protected by the bootloader\n", page, (uint32)loaderPageAddress(page));
+        }
+        pages_used[page] = 0;
+        skipped++;
     }
-    else
+
+    return skipped;
+}
+
+int skipUnchangedPages(int fd, const uint8* data, uint8* pages_used)
+{
+    uint32 page;
+    uint32 changed = 0;
+    uint32 unchanged = 0;
+    uint16 crc = 0;
+
+    printf("Comparing page CRCs...");
+
+    for( page = 0; page < PIC_NUM_PAGES; page++ )
     {
-        return 0;
+        if( pages_used[page] != 1 || loaderPageAddress(page) >= g_target->flashsize )
+        {
+            continue;
+        }
+
+        if( readPageCrc(fd, page, &crc) < 0 )
+        {
+            puts("ERROR");
+            fprintf(stderr, "Could not read CRC of page %ld\n", page);
+            return -1;
+        }
+
+        if( crc == loaderPageCrc(data, page, g_target->blstartaddr) )
+        {
+            if( g_verbose )
+            {
+                printf("\nPage %ld [ %06lx ] unchanged", page, (uint32)loaderPageAddress(page));
+            }
+            pages_used[page] = 0;
+            unchanged++;
+        }
+        else
+        {
+            changed++;
+        }
     }
+
+    puts("OK");
+    printf("%ld pages changed, %ld unchanged\n", changed, unchanged);
+
+    return changed;
 }
 
 
-int sendFirmware(int fd, uint8* data, uint8* pages_used)
+int sendFirmware(int fd, const uint8* data, uint8* pages_used, unsigned long flashsize)
 {
     uint32 u_addr;
 
@@ -513,13 +520,14 @@ int sendFirmware(int fd, uint8* data, uint8* pages_used)
     uint32 page  = 0;
     uint32 done  = 0;
     uint32 row   = 0;
-    uint8  command[256] = {0};
+    uint32 length = 0;
+    uint8  command[LOADER_MAX_COMMAND] = {0};
 
 
     for( page=0; page<PIC_NUM_PAGES; page++)
     {
 
-        u_addr = page * ( PIC_NUM_WORDS_IN_ROW * 2 * PIC_NUM_ROWS_IN_PAGE );
+        u_addr = loaderPageAddress(page);
 
         if( pages_used[page] != 1 )
         {
@@ -537,61 +545,74 @@ int sendFirmware(int fd, uint8* data, uint8* pages_used)
         }
 
         //erase page
-        command[0] = (u_addr & 0x00FF0000) >> 16;
-        command[1] = (u_addr & 0x0000FF00) >>  8;
-        command[2] = (u_addr & 0x000000FF) >>  0;
-        command[COMMAND_OFFSET] = 0x01; //erase command
-        command[LENGTH_OFFSET ] = 0x01; //1 byte, CRC
-        command[PAYLOAD_OFFSET] = makeCrc(command, 5);
+        length = loaderCommandErase(command, page);
 
         if( g_verbose )
         {
-            dumpHex(command, HEADER_LENGTH + command[LENGTH_OFFSET]);
+            dumpHex(command, length);
         }
 
-        printf("Erasing page %ld, %04lx...", page, u_addr);
+        if( g_pending.pipelined )
+        {
+            printf("Writing page %ld, %04lx...\r", page, u_addr);
+            fflush(stdout);
+        }
+        else
+        {
+            printf("Erasing page %ld, %04lx...", page, u_addr);
+        }
 
-        if( g_simulate == 0 && sendCommandAndWaitForResponse(fd, command) < 0 )
+        if( sendCommand(fd, command, length) < 0 )
         {
             return -1;
         }
 
-        puts("OK");
+        if( !g_pending.pipelined )
+        {
+            puts("OK");
+        }
 
         //write 8 rows
-        for( row = 0; row < PIC_NUM_ROWS_IN_PAGE; row ++, u_addr += (PIC_NUM_WORDS_IN_ROW * 2))
+        for( row = 0; row < PIC_NUM_ROWS_IN_PAGE; row ++, u_addr += PIC_ROW_SPAN)
         {
-            command[0] = (u_addr & 0x00FF0000) >> 16;
-            command[1] = (u_addr & 0x0000FF00) >>  8;
-            command[2] = (u_addr & 0x000000FF) >>  0;
-            command[COMMAND_OFFSET] = 0x02; //write command
-            command[LENGTH_OFFSET ] = PIC_ROW_SIZE + 0x01; //DATA_LENGTH + CRC
+            length = loaderCommandWriteRow(command, data, page, row);
 
-            memcpy(&command[PAYLOAD_OFFSET], &data[PIC_ROW_ADDR(page, row)], PIC_ROW_SIZE);
-
-            command[PAYLOAD_OFFSET + PIC_ROW_SIZE] = makeCrc(command, HEADER_LENGTH + PIC_ROW_SIZE);
-
-            printf("Writing page %ld row %ld, %04lx...", page, row + page*PIC_NUM_ROWS_IN_PAGE, u_addr);
+            if( !g_pending.pipelined )
+            {
+                printf("Writing page %ld row %ld, %04lx...", page, row + page*PIC_NUM_ROWS_IN_PAGE, u_addr);
+            }
 
             if( g_verbose )
             {
-                dumpHex(command, HEADER_LENGTH + command[LENGTH_OFFSET]);
+                dumpHex(command, length);
             }
 
-            if( g_simulate == 0 && sendCommandAndWaitForResponse(fd, command) < 0 )
+            if( sendCommand(fd, command, length) < 0 )
             {
                 return -1;
             }
 
-            puts("OK");
-
-            sleep(0);
+            if( !g_pending.pipelined )
+            {
+                puts("OK");
 
+                sleep(0);
+            }
 
             done += PIC_ROW_SIZE;
         }
     }
 
+    if( g_pending.pipelined )
+    {
+        if( drainPipeline(fd) < 0 )
+        {
+            return -1;
+        }
+
+        printf("\nWrote %ld bytes\n", done);
+    }
+
     return done;
 }
 
@@ -673,6 +694,20 @@ int parseCommandLine(int argc, const char** argv)
         {
             g_simulate = 1;
         }
+        else if ( !strcmp(argv[i], "--diff") )
+        {
+            g_diff = 1;
+        }
+        else if ( !strncmp(argv[i], "--window=", 9) )
+        {
+            g_window = strtoul(argv[i] + 9, NULL, 10);
+
+            if( g_window < 1 || g_window > LOADER_MAX_WINDOW )
+            {
+                fprintf(stderr, "Window must be between 1 and %d commands\n", LOADER_MAX_WINDOW);
+                return -1;
+            }
+        }
         else if ( !strcmp(argv[i], "--help") )
         {
             argc = 1; //that's not pretty, but it works :)
@@ -690,9 +725,14 @@ int parseCommandLine(int argc, const char** argv)
         //print usage
         puts("pirate-loader usage:\n");
         puts(" ./pirate-loader --dev=/path/to/device --hello");
-        puts(" ./pirate-loader --dev=/path/to/device --hex=/path/to/hexfile.hex [ --verbose ]");
+        puts(" ./pirate-loader --dev=/path/to/device --hex=/path/to/hexfile.hex [ --verbose ] [ --window=N ] [ --diff ]");
         puts(" ./pirate-loader --simulate --hex=/path/to/hexfile.hex [ --verbose ] ");
         puts("");
+        puts(" --window=N keeps up to N commands in flight with bootloader v4.11+,");
+        puts("            use --window=1 to wait for each reply (default 8)");
+        puts(" --diff     only writes the pages whose content differs from the device,");
+        puts("            needs bootloader v4.12+");
+        puts("");
 
         return 0;
     }
@@ -706,8 +746,10 @@ int main (int argc, const char** argv)
 {
     int		dev_fd = -1, res = -1;
     uint8	buffer[256] = {0};
+    uint8	command[LOADER_MAX_COMMAND] = {0};
     uint8	pages_used[PIC_NUM_PAGES] = {0};
-    uint8*	bin_buff = NULL;
+    uint16	version = 0;
+    loader_image_t*	image = NULL;
 
 
     puts("+++++++++++++++++++++++++++++++++++++++++++");
@@ -733,34 +775,31 @@ int main (int argc, const char** argv)
             return -1;
         }
 
-        bin_buff = (uint8*)malloc(0xFFFFFF * sizeof(uint8)); //256kB
-        if( !bin_buff )
+        image = (loader_image_t*)malloc(sizeof(loader_image_t));
+        if( !image )
         {
-            fprintf(stderr, "Could not allocate 256kB buffer\n");
+            fprintf(stderr, "Could not allocate %ldkB image buffer\n", (uint32)(sizeof(loader_image_t) >> 10));
             goto Error;
         }
 
-        //fill the buffer with 0xFF
-        memset(bin_buff, 0xFFFFFFFF, (0xFFFFFF * sizeof(uint8)));
-
         printf("Parsing HEX file [%s]\n", g_hexfile_path);
 
-        res = readHEX(g_hexfile_path, bin_buff, (0xFFFFFF * sizeof(uint8)), pages_used);
-        if( res <= 0 || res > flashsize )
+        if( loaderImageLoad(image, g_hexfile_path, LOADER_FAMILY_BPV4) < 0 )
         {
-            fprintf(stderr, "Could not load HEX file, result=%d\n", res);
+            fprintf(stderr, "Could not load HEX file\n");
             goto Error;
         }
 
-        printf("Found %d words (%d bytes)\n", res, res * 3);
+        printf("Found %ld words (%ld bytes)\n", image->num_words, image->num_words * 3);
 
-        //printf("Fixing bootloader/userprogram jumps\n");
-        //fixJumps(bin_buff, pages_used);
+        memcpy(pages_used, image->pages_used, sizeof(pages_used));
     }
 
+    loaderWindowInit(&g_pending, g_window);
+
     if( g_simulate )
     {
-        sendFirmware(dev_fd, bin_buff, pages_used);
+        sendFirmware(dev_fd, image->data, pages_used, image->flashsize);
         goto Finished;
     }
 
@@ -795,11 +834,11 @@ int main (int argc, const char** argv)
     printf("Sending Hello to the Bootloader...");
 
     //send HELLO
-    res = write(dev_fd, BOOTLOADER_HELLO_STR, 1);
+    res = writeAll(dev_fd, command, loaderCommandHello(command));
 
-    res = readWithTimeout(dev_fd, buffer, 4, 3);
+    res = readWithTimeout(dev_fd, buffer, LOADER_HELLO_REPLY_LENGTH, 3);
 
-    if( res != 4 || buffer[3] != BOOTLOADER_OK )
+    if( res != LOADER_HELLO_REPLY_LENGTH || !loaderHelloValid(buffer) )
     {
         puts("ERROR");
         fprintf(stderr, "No reply from the bootloader, or invalid reply received: %d\n", res);
@@ -809,429 +848,57 @@ int main (int argc, const char** argv)
     }
     puts("OK\n"); //extra LF for spacing
 
+    version = loaderHelloVersion(buffer);
     printf("Bootloader version: %d,%02d\n", buffer[1], buffer[2]);
 
     printf("Device ID [%02x]:",buffer[0]);
-    switch(buffer[0])
-    {
-//    case 0xd4:
-//        printf("PIC24FJ64GA002\n");
-//        break;
-    case  9:
-        printf("PIC24FJ128GB206\n");
-        //    __PIC24FJ128GB206__
-        family = IS_24FJ;
-        flashsize = 0x15800;
-        eesizeb  = 0;
-        blstartaddr = 0x400L;
-        blendaddr = 0x23FFL;
-        break;
-    case 17:
-        printf("PIC24FJ128GB210\n");
-//    __PIC24FJ128GB210__
-        family = IS_24FJ;
-        flashsize = 0x15800;
-        eesizeb  = 0;
-        blstartaddr = 0x400L;
-        blendaddr = 0x23FFL;
-
-        break;
-    case 18:
-        printf("PIC24FJ256GB206\n");
-        //    __PIC24FJ256GB206__
-        family = IS_24FJ;
-        flashsize = 0x2AC00;
-        eesizeb  = 0;
-        blstartaddr = 0x400L;
-        blendaddr = 0x23FFL;
-        break;
-    case 19:
-        printf("PIC24FJ256GB210\n");
-        //    __PIC24FJ256GB210__
-        family = IS_24FJ;
-        flashsize = 0x2AC00;
-        eesizeb  = 0;
-        blstartaddr = 0x400L;
-        blendaddr = 0x23FFL;
-        break;
-    case 191:
-        printf("PIC24FJ256DA206\n");
-        //    __PIC24FJ256DA206__
-        family = IS_24FJ;
-        flashsize = 0x2AC00;
-        eesizeb  = 0;
-        blstartaddr = 0x400L;
-        blendaddr = 0x23FFL;
-        break;
-    case 192:
-        printf("PIC24FJ256DA210\n");
-        //    __PIC24FJ256DA210__
-        family = IS_24FJ;
-        flashsize = 0x2AC00;
-        eesizeb  = 0;
-        blstartaddr = 0x400L;
-        blendaddr = 0x23FFL;
-        break;
-    case 217:
-        printf("PIC24FJ64GB106\n");
-        //    __PIC24FJ64GB106__
-        family = IS_24FJ;
-        flashsize = 0xAC00;
-        eesizeb  = 0;
-        blstartaddr = 0x400L;
-        blendaddr = 0x23FFL;
-        break;
-    case 218:
-        printf("PIC24FJ64GB108\n");
-        //    __PIC24FJ64GB108__
-        family = IS_24FJ;
-        flashsize = 0xAC00;
-        eesizeb  = 0;
-        blstartaddr = 0x400L;
-        blendaddr = 0x23FFL;
-        break;
-    case 219:
-        printf("PIC24FJ64GB110\n");
-        //    __PIC24FJ64GB110__
-        family = IS_24FJ;
-        flashsize = 0xAC00;
-        eesizeb  = 0;
-        blstartaddr = 0x400L;
-        blendaddr = 0x23FFL;
-        break;
-    case 229:
-        printf("PIC24FJ128GB106\n");
-        //    __PIC24FJ128GB106__
-        family = IS_24FJ;
-        flashsize = 0x15800;
-        eesizeb  = 0;
-        blstartaddr = 0x400L;
-        blendaddr = 0x23FFL;
-        break;
-    case 230:
-        printf("PIC24FJ128GB108\n");
-        //    __PIC24FJ128GB108__
-        family = IS_24FJ;
-        flashsize = 0x15800;
-        eesizeb  = 0;
-        blstartaddr = 0x400L;
-        blendaddr = 0x23FFL;
-        break;
-    case 231:
-        printf("PIC24FJ128GB110\n");
-        //    __PIC24FJ128GB110__
-        family = IS_24FJ;
-        flashsize = 0x15800;
-        eesizeb  = 0;
-        blstartaddr = 0x400L;
-        blendaddr = 0x23FFL;
-        break;
-    case 235:
-        printf("PIC24FJ192GB106\n");
-        //    __PIC24FJ192GB106__
-        family = IS_24FJ;
-        flashsize = 0x20C00;
-        eesizeb  = 0;
-        blstartaddr = 0x400L;
-        blendaddr = 0x23FFL;
-        break;
-    case 236:
-        printf("PIC24FJ192GB108\n");
-        //    __PIC24FJ192GB108__
-        family = IS_24FJ;
-        flashsize = 0x20C00;
-        eesizeb  = 0;
-        blstartaddr = 0x400L;
-        blendaddr = 0x23FFL;
-        break;
-    case 237:
-        printf("PIC24FJ192GB110\n");
-        //    __PIC24FJ192GB110__
-        family = IS_24FJ;
-        flashsize = 0x20C00;
-        eesizeb  = 0;
-        blstartaddr = 0x400L;
-        blendaddr = 0x23FFL;
-        break;
-    case 241:
-        printf("PIC24FJ256GB106\n");
-        //    __PIC24FJ256GB106__
-#define IS_24FJ                 1
-        flashsize = 0x2AC00;
-        eesizeb  =         0;
-        blstartaddr = 0x400L;
-        blendaddr = 0x23FFL;
-        break;
-    case 242:
-        printf("PIC24FJ256GB108\n");
-        //    __PIC24FJ256GB108__
-        family = IS_24FJ;
-        flashsize = 0x2AC00;
-        eesizeb  = 0;
-        blstartaddr = 0x400L;
-        blendaddr = 0x23FFL;
-        break;
-    case 243:
-        printf("PIC24FJ256GB110\n");
-        //    __PIC24FJ256GB110__
-        family = IS_24FJ;
-        flashsize = 0x2AC00;
-        eesizeb  = 0;
-        blstartaddr = 0x400L;
-        blendaddr = 0x23FFL;
-        break;
-    case 244:
-        printf("PIC24FJ32GB002\n");
-        //    __PIC24FJ32GB002__
-        family = IS_24FJ;
-        flashsize = 0x5800;
-        eesizeb  = 0;
-        blstartaddr = 0x400L;
-        blendaddr = 0x23FFL;
-        break;
-    case 245:
-        printf("PIC24FJ32GB004\n");
-        //    __PIC24FJ32GB004__
-        family = IS_24FJ;
-        flashsize = 0x5800;
-        eesizeb  = 0;
-        blstartaddr = 0x400L;
-        blendaddr = 0x23FFL;
-        break;
-    case 246:
-        printf("PIC24FJ64GB002\n");
-        //    __PIC24FJ64GB002__
-        family = IS_24FJ;
-        flashsize = 0xAC00;
-        eesizeb  = 0;
-        blstartaddr = 0x400L;
-        blendaddr = 0x23FFL;
-        break;
-    case 247:
-        printf("PIC24FJ64GB004\n");
-        //    __PIC24FJ64GB004__
-        family = IS_24FJ;
-        flashsize = 0xAC00;
-        eesizeb  = 0;
-        blstartaddr = 0x400L;
-        blendaddr = 0x23FFL;
-        break;
-    case 250:
-        printf("PIC24FJ128DA106\n");//    __PIC24FJ128DA106__
-        family = IS_24FJ;
-        flashsize = 0x15800;
-        eesizeb  = 0;
-        blstartaddr = 0x400L;
-        blendaddr = 0x23FFL;
-        break;
-    case 251:
-        printf("PIC24FJ128DA110\n");
-        //    __PIC24FJ128DA110__
-        family = IS_24FJ;
-        flashsize = 0x15800;
-        eesizeb  = 0;
-        blstartaddr = 0x400L;
-        blendaddr = 0x23FFL;
-        break;
-    case 252:
-        printf("PIC24FJ128DA206\n");
-        //    __PIC24FJ128DA206__
-        family = IS_24FJ;
-        flashsize = 0x15800;
-        eesizeb  = 0;
-        blstartaddr = 0x400L;
-        blendaddr = 0x23FFL;
-        break;
-    case 253:
-        printf("PIC24FJ128DA210\n");
-        //    __PIC24FJ128DA210__
-        family = IS_24FJ;
-        flashsize = 0x15800;
-        eesizeb  = 0;
-        blstartaddr = 0x400L;
-        blendaddr = 0x23FFL;
-        break;
-    case 254:
-        printf("PIC24FJ256DA106\n");
-        //    __PIC24FJ256DA106__
-        family = IS_24FJ;
-        flashsize = 0x2AC00;
-        eesizeb  = 0;
-        blstartaddr = 0x400L;
-        blendaddr = 0x23FFL;
-        break;
-    case 255:
-        printf("PIC24FJ256DA110\n");
-        //    __PIC24FJ256DA110__
-        family = IS_24FJ;
-        flashsize = 0x2AC00;
-        eesizeb  = 0;
-        blstartaddr = 0x400L;
-        blendaddr = 0x23FFL;
-        break;
-    case	206:
-        printf("PIC24FJ16GA002\n");
-        flashsize = 	0x2C00;
-
-        break;
-
-    case	207:
-        printf("PIC24FJ16GA004\n");
-        flashsize = 	0x2C00;
-
-        break;
-
-
-    case	208:
-        printf("PIC24FJ32GA002\n");
-        flashsize = 	0x5800;
-
-        break;
-
-    case	209:
-        printf("PIC24FJ32GA004\n");
-        flashsize = 	0x5800;
-
-        break;
-
-    case	210:
-        printf("PIC24FJ48GA002\n");
-        flashsize = 	0x8400;
-
-        break;
-
-    case	211:
-        printf("PIC24FJ48GA004\n");
-        flashsize = 	0x8400;
-
-        break;
-
-
-    case	212:
-        printf("PIC24FJ64GA002\n");
-        flashsize = 	0xAC00;
-
-        break;
-
-    case	213:
-        printf("PIC24FJ64GA004\n");
-        flashsize = 	0xAC00;
-
-        break;
-
-    case	214:
-        printf("PIC24FJ64GA006\n");
-        flashsize = 	0xAC00;
-
-        break;
-
-    case	215:
-        printf("PIC24FJ64GA008\n");
-        flashsize = 	0xAC00;
-        break;
-
-    case	216:
-        printf("PIC24FJ64GA010\n");
-        flashsize = 	0xAC00;
-
-        break;
-
-    case	220:
-        printf("PIC24FJ96GA006\n");
-        flashsize = 	0x10000;
-
-        break;
-
-    case	221:
-        printf("PIC24FJ96GA008\n");
-        flashsize = 	0x10000;
-
-        break;
-
-    case	222:
-        printf("PIC24FJ96GA010\n");
-        flashsize = 	0x10000;
-
-        break;
-
-
-    case	223:
-        printf("PIC24FJ128GA006\n");
-        flashsize = 	0x15800;
-
-        break;
-
-    case	224:
-        printf("PIC24FJ128GA008\n");
-        flashsize = 	0x15800;
-
-        break;
-
-    case	225:
-        printf("PIC24FJ128GA010\n");
-        flashsize = 	0x15800;
-
-        break;
-
-    case	226:
-        printf("PIC24FJ128GA106\n");
-        flashsize = 	0x15800;
-
-        break;
-
-    case	227:
-        printf("PIC24FJ128GA108\n");
-        flashsize = 	0x15800;
-        break;
-
-    case	228:
-        printf("PIC24FJ128GA110\n");
-        flashsize = 	0x15800;
-        break;
 
-    case	232:
-        printf("PIC24FJ192GA106\n");
-        flashsize = 	0x20C00;
-        break;
-
-    case	233:
-        printf("PIC24FJ192GA108\n");
-        flashsize = 	0x20C00;
-        break;
-
-    case	234:
-        printf("PIC24FJ192GA110\n");
-        flashsize = 	0x20C00;
-        break;
-
-    case	238:
-        printf("PIC24FJ256GA106\n");
-        flashsize = 	0x2AC00;
-
-        break;
-
-    case	239:
-        printf("PIC24FJ256GA108\n");
-        flashsize = 	0x2AC00;
-        break;
-
-    case	240:
-        printf("PIC24FJ256GA110\n");
-        flashsize = 	0x2AC00;
-        break;
-
-
-    default:
+    g_target = loaderFindTarget(LOADER_FAMILY_BPV4, buffer[0]);
+    if( !g_target )
+    {
         printf("UNKNOWN");
         fprintf(stderr, "Unsupported device (%02x:UNKNOWN)\n", buffer[0]);
         goto Error;
-        break;
     }
+    printf("%s\n", g_target->name);
 
     if( !g_hello_only )
     {
+        if( (res = skipProtectedPages(pages_used)) > 0 )
+        {
+            printf("Skipping %d pages protected by the bootloader\n", res);
+        }
+
+        if( g_diff )
+        {
+            if( !loaderCanCompare(g_target, version) )
+            {
+                fprintf(stderr, "Bootloader too old to compare pages, writing all of them\n");
+            }
+            else if( (res = skipUnchangedPages(dev_fd, image->data, pages_used)) < 0 )
+            {
+                goto Error;
+            }
+            else if( res == 0 )
+            {
+                puts("\nFirmware already up to date :)!");
+                goto Finished;
+            }
+        }
+
+        if( g_window > 1 && loaderCanPipeline(g_target, version) )
+        {
+            printf("Enabling pipelined writes, %ld commands in flight...", g_window);
+
+            if( enablePipeline(dev_fd) < 0 )
+            {
+                fprintf(stderr, "Could not enable pipelined writes\n");
+                goto Error;
+            }
+            puts("OK");
+        }
 
-        res = sendFirmware(dev_fd, bin_buff, pages_used);
+        res = sendFirmware(dev_fd, image->data, pages_used, g_target->flashsize);
 
         if( res > 0 )
         {
@@ -1247,9 +914,9 @@ int main (int argc, const char** argv)
     }
 
 Finished:
-    if( bin_buff )
+    if( image )
     {
-        free( bin_buff );
+        free( image );
     }
     if( dev_fd >= 0 )
     {
@@ -1258,9 +925,9 @@ Finished:
     return 0;
 
 Error:
-    if( bin_buff )
+    if( image )
     {
-        free( bin_buff );
+        free( image );
     }
     if( dev_fd >= 0 )
     {
@@ -0,0 +1,410 @@
+/*
+ * This file is part of the Bus Pirate project
+ * (http://code.google.com/p/the-bus-pirate/).
+ *
+ * Written and maintained by the Bus Pirate project.
+ *
+ * To the extent possible under law, the project has
+ * waived all copyright and related or neighboring rights to Bus Pirate. This
+ * work is published from United States.
+ *
+ * For details see: http://creativecommons.org/publicdomain/zero/1.0/.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "hexfile.h"
+
+#define HEX_RECORD_DATA 0x00
+#define HEX_RECORD_EOF 0x01
+#define HEX_RECORD_EXTENDED_LINEAR 0x04
+#define HEX_MAX_LINE_CHARS 512
+#define HEX_INVALID_DIGIT 0x10
+
+/* nibble value of every character, HEX_INVALID_DIGIT for anything but 0-9a-fA-F */
+static const uint8_t hex_digits[256] =
+{
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10
+};
+
+/* file mapping */
+
+static int readWholeFile(hexfile_map_t* file, const char* path)
+{
+    FILE* fp = fopen(path, "rb");
+    char* buf = NULL;
+    size_t capacity = 0;
+    size_t got;
+
+    if( !fp )
+    {
+        return -1;
+    }
+
+    //size is not known for pipes and such, grow as we go
+    file->length = 0;
+    do
+    {
+        if( file->length == capacity )
+        {
+            char* grown;
+
+            capacity = capacity ? capacity * 2 : 64 * 1024;
+            grown = (char*)realloc(buf, capacity);
+            if( !grown )
+            {
+                free(buf);
+                fclose(fp);
+                return -1;
+            }
+            buf = grown;
+        }
+
+        got = fread(buf + file->length, 1, capacity - file->length, fp);
+        file->length += got;
+    }
+    while( got > 0 );
+
+    fclose(fp);
+
+    file->data = buf;
+    file->mapped = 0;
+    return 0;
+}
+
+int hexfileMap(hexfile_map_t* file, const char* path)
+{
+#ifdef WIN32
+    HANDLE handle, mapping;
+    DWORD size;
+
+    file->data = NULL;
+    file->length = 0;
+    file->mapped = 0;
+
+    handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if( handle != INVALID_HANDLE_VALUE )
+    {
+        size = GetFileSize(handle, NULL);
+        mapping = (size > 0 && size != INVALID_FILE_SIZE) ? CreateFileMapping(handle, NULL, PAGE_READONLY, 0, 0, NULL) : NULL;
+
+        if( mapping )
+        {
+            //the view keeps the mapping alive once the handles are gone
+            file->data = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+        }
+        CloseHandle(handle);
+
+        if( file->data )
+        {
+            file->length = size;
+            file->mapped = 1;
+            return 0;
+        }
+    }
+#else
+    struct stat st;
+    void* view;
+    int fd;
+
+    file->data = NULL;
+    file->length = 0;
+    file->mapped = 0;
+
+    fd = open(path, O_RDONLY);
+    if( fd >= 0 )
+    {
+        if( fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 )
+        {
+            view = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if( view != MAP_FAILED )
+            {
+                close(fd);
+                file->data = (const char*)view;
+                file->length = st.st_size;
+                file->mapped = 1;
+                return 0;
+            }
+        }
+        close(fd);
+    }
+#endif
+
+    //empty files, pipes and mmap failures
+    return readWholeFile(file, path);
+}
+
+void hexfileUnmap(hexfile_map_t* file)
+{
+    if( !file->data )
+    {
+        return;
+    }
+
+    if( file->mapped )
+    {
+#ifdef WIN32
+        UnmapViewOfFile(file->data);
+#else
+        munmap((void*)file->data, file->length);
+#endif
+    }
+    else
+    {
+        free((void*)file->data);
+    }
+
+    file->data = NULL;
+    file->length = 0;
+}
+
+/* image readers */
+
+static long loadRaw(const hexfile_map_t* file, uint8_t* data, unsigned long size, uint8_t* pages_used, unsigned long flashsize)
+{
+    unsigned long length = file->length;
+    unsigned long page, offset;
+
+    if( length % HEXFILE_WORD_SIZE )
+    {
+        fprintf(stderr, "Raw image is not a whole number of words\n");
+        return -1;
+    }
+
+    if( length > size || (length / HEXFILE_WORD_SIZE) * 2 > flashsize )
+    {
+        fprintf(stderr, "Raw image is larger than the flash\n");
+        return -1;
+    }
+
+    memcpy(data, file->data, length);
+
+    //only pages holding something other than erased flash need writing
+    for( page = 0; page * HEXFILE_PAGE_SIZE < length; page++ )
+    {
+        for( offset = page * HEXFILE_PAGE_SIZE; offset < length && offset < (page + 1) * HEXFILE_PAGE_SIZE; offset++ )
+        {
+            if( data[offset] != 0xFF )
+            {
+                pages_used[page] = 1;
+                break;
+            }
+        }
+    }
+
+    return length / HEXFILE_WORD_SIZE;
+}
+
+static long loadHex(const hexfile_map_t* file, uint8_t* data, unsigned long size, uint8_t* pages_used, unsigned long flashsize)
+{
+    uint8_t        linebin[HEX_MAX_LINE_CHARS / 2];
+    const uint8_t* record = linebin + 4;
+    const uint8_t* line;
+    const uint8_t* end;
+    const uint8_t* eol;
+    uint8_t        hex_crc, hex_type, hex_len, invalid;
+    uint32_t       hex_addr;
+    uint32_t       hex_base_addr = 0;
+    uint32_t       f_addr, o_addr;
+    unsigned long  num_words = 0;
+    unsigned int   hex_words;
+    int            res, line_no = 0, i;
+    uint8_t*       out;
+
+    line = (const uint8_t*)file->data;
+    end  = line + file->length;
+
+    for( ; line < end; line = eol + 1 )
+    {
+        eol = (const uint8_t*)memchr(line, '\n', end - line);
+        if( !eol )
+        {
+            eol = end;
+        }
+
+        line_no++;
+
+        if( line[0] != ':' )
+        {
+            break;
+        }
+
+        //trailing CR and other whitespace
+        res = eol - (line + 1);
+        while( res > 0 && line[res] <= ' ' )
+        {
+            res--;
+        }
+
+        if( res & 0x01 || res > HEX_MAX_LINE_CHARS || res < 10 )
+        {
+            fprintf(stderr, "Incorrect number of characters on line %d:%d\n", line_no, res);
+            return -1;
+        }
+
+        //one table lookup per character, all validated at once
+        hex_crc = 0;
+        invalid = 0;
+        for( i = 0; i < res / 2; i++ )
+        {
+            uint8_t high = hex_digits[line[1 + (i * 2)]];
+            uint8_t low  = hex_digits[line[2 + (i * 2)]];
+
+            invalid |= high | low;
+            linebin[i] = (high << 4) | (low & 0x0F);
+            hex_crc += linebin[i];
+        }
+
+        if( invalid & HEX_INVALID_DIGIT )
+        {
+            fprintf(stderr, "Invalid character, line %d\n", line_no);
+            return -1;
+        }
+
+        if( hex_crc != 0 )
+        {
+            fprintf(stderr, "Checksum does not match, line %d\n", line_no);
+            return -1;
+        }
+
+        hex_addr = (linebin[1] << 8) | linebin[2];
+        hex_len  = linebin[0];
+        hex_type = linebin[3];
+
+        if( (res / 2) - (1 + 2 + 1 + hex_len + 1) != 0 )
+        {
+            fprintf(stderr, "Incorrect number of bytes, line %d\n", line_no);
+            return -1;
+        }
+
+        if( hex_type == HEX_RECORD_DATA )
+        {
+            f_addr = (hex_base_addr | hex_addr) / 2; //PCU
+            hex_words = hex_len / 4;
+            o_addr = (f_addr / 2) * HEXFILE_WORD_SIZE; //BYTES
+
+            if( hex_len % 4 )
+            {
+                fprintf(stderr, "Misaligned data, line %d\n", line_no);
+                return -1;
+            }
+            else if( f_addr + (hex_words * 2) > flashsize || o_addr + (hex_words * HEXFILE_WORD_SIZE) > size )
+            {
+                fprintf(stderr, "Current record address is higher than maximum allowed, line %d\n", line_no);
+                return -1;
+            }
+
+            if( hex_words == 0 )
+            {
+                continue;
+            }
+
+            //XC16 writes low, middle, high, phantom; the image keeps high, low, middle
+            out = data + o_addr;
+            for( i = 0; i < (int)hex_words; i++ )
+            {
+                out[0] = record[(i * 4) + 2];
+                out[1] = record[(i * 4) + 0];
+                out[2] = record[(i * 4) + 1];
+                out += HEXFILE_WORD_SIZE;
+            }
+
+            //a record is far smaller than a page, it spans two at most
+            pages_used[o_addr / HEXFILE_PAGE_SIZE] = 1;
+            pages_used[(o_addr + (hex_words * HEXFILE_WORD_SIZE) - 1) / HEXFILE_PAGE_SIZE] = 1;
+
+            num_words += hex_words;
+        }
+        else if( hex_type == HEX_RECORD_EXTENDED_LINEAR && hex_len == 2 )
+        {
+            hex_base_addr = (linebin[4] << 24) | (linebin[5] << 16);
+        }
+        else if( hex_type == HEX_RECORD_EOF )
+        {
+            break;
+        }
+        else
+        {
+            fprintf(stderr, "Unsupported record type %02x, line %d\n", hex_type, line_no);
+            return -1;
+        }
+    }
+
+    return num_words;
+}
+
+long hexfileLoad(const char* path, uint8_t* data, unsigned long size, uint8_t* pages_used, unsigned long flashsize)
+{
+    hexfile_map_t file;
+    long res;
+
+    if( hexfileMap(&file, path) < 0 )
+    {
+        fprintf(stderr, "Could not open %s\n", path);
+        return -1;
+    }
+
+    if( file.length > 0 && file.data[0] != ':' )
+    {
+        res = loadRaw(&file, data, size, pages_used, flashsize);
+    }
+    else
+    {
+        res = loadHex(&file, data, size, pages_used, flashsize);
+    }
+
+    hexfileUnmap(&file);
+    return res;
+}
+
+void hexfileFixJumps(uint8_t* data, uint8_t* pages_used, unsigned long flashsize, unsigned int placement)
+{
+    uint32_t bl_address = flashsize - (placement * HEXFILE_PAGE_SIZE / HEXFILE_WORD_SIZE * 2); //PCU
+    uint32_t user_jump = ((bl_address - 4) / 2) * HEXFILE_WORD_SIZE;
+    int i;
+
+    for( i = 0; i < 6; i++ )
+    {
+        data[user_jump + i] = data[i];
+    }
+
+    pages_used[user_jump / HEXFILE_PAGE_SIZE] = 1;
+
+    data[0] = 0x04;
+    data[1] = (bl_address & 0x0000FE);
+    data[2] = (bl_address & 0x00FF00) >> 8;
+    data[3] = 0x00;
+    data[4] = (bl_address & 0x7F0000) >> 16;
+    data[5] = 0x00;
+}
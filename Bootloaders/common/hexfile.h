@@ -0,0 +1,71 @@
+/*
+ * This file is part of the Bus Pirate project
+ * (http://code.google.com/p/the-bus-pirate/).
+ *
+ * Written and maintained by the Bus Pirate project.
+ *
+ * To the extent possible under law, the project has
+ * waived all copyright and related or neighboring rights to Bus Pirate. This
+ * work is published from United States.
+ *
+ * For details see: http://creativecommons.org/publicdomain/zero/1.0/.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+/*
+ Firmware image reader shared by the host loaders
+
+ Reads a PIC24 firmware image into the loaders' in-memory layout: three
+ bytes per program word, upper byte first, with one flag per flash page
+ telling whether the image touches it.  Two input formats are accepted:
+
+  - Intel HEX as written by XC16, with 32-bit extended linear addresses,
+  - a raw image in the same three bytes per word layout, such as the flash
+    file saved by bootloader-emulator, recognised by not starting with ':'.
+
+ Input files are memory mapped where the platform allows it and read in
+ whole otherwise.  Every HEX record is validated (characters, length,
+ checksum, alignment and address range) before it touches the image.
+ */
+
+#ifndef PIRATE_HEXFILE_H
+#define PIRATE_HEXFILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* image layout, matches the loaders' PIC_* definitions */
+#define HEXFILE_WORD_SIZE 3
+#define HEXFILE_PAGE_SIZE (8 * 64 * HEXFILE_WORD_SIZE)
+
+/* read-only view of a whole file */
+typedef struct
+{
+    const char* data;
+    size_t      length;
+    int         mapped; //1 when data is a mapping, 0 when it was read into memory
+} hexfile_map_t;
+
+int hexfileMap(hexfile_map_t* file, const char* path);
+void hexfileUnmap(hexfile_map_t* file);
+
+/*
+ Loads the image at path into data, which is size bytes long and should be
+ filled with 0xFF by the caller.  flashsize is the first program address
+ past the end of flash; records beyond it are rejected.  pages_used gets a
+ 1 for every page holding image data.  Returns the number of words read, or
+ -1 after printing what was wrong on stderr.
+ */
+long hexfileLoad(const char* path, uint8_t* data, unsigned long size, uint8_t* pages_used, unsigned long flashsize);
+
+/*
+ The ds30 bootloader of the v3 expects its own jump at address 0, and the
+ application's reset jump right below the bootloader, placement pages from
+ the end of flash.
+ */
+void hexfileFixJumps(uint8_t* data, uint8_t* pages_used, unsigned long flashsize, unsigned int placement);
+
+#endif /* PIRATE_HEXFILE_H */
@@ -0,0 +1,774 @@
+/*
+ * This file is part of the Bus Pirate project
+ * (http://code.google.com/p/the-bus-pirate/).
+ *
+ * Written and maintained by the Bus Pirate project.
+ *
+ * To the extent possible under law, the project has
+ * waived all copyright and related or neighboring rights to Bus Pirate. This
+ * work is published from United States.
+ *
+ * For details see: http://creativecommons.org/publicdomain/zero/1.0/.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#ifndef WIN32
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdarg.h>
+#include <termios.h>
+#include <unistd.h>
+#endif
+
+#include "hexfile.h"
+#include "loader.h"
+
+#define BOOTLOADER_HELLO 0xC1
+#define BOOTLOADER_OK 'K'
+#define BOOTLOADER_PROT 'P'
+#define BOOTLOADER_PIPELINE_VERSION 0x040B
+#define BOOTLOADER_CRC_VERSION 0x040C
+#define BOOTLOADER_CMD_ERASE 0x01
+#define BOOTLOADER_CMD_WRITE 0x02
+#define BOOTLOADER_CMD_PIPELINE 0x03
+#define BOOTLOADER_CMD_PAGE_CRC 0x04
+
+#define PAYLOAD_OFFSET 5
+#define HEADER_LENGTH PAYLOAD_OFFSET
+#define LENGTH_OFFSET 4
+#define COMMAND_OFFSET 3
+
+#define BPV3_DEVICE_ID 0xD4
+#define BPV3_FLASHSIZE 0xAC00
+#define BPV3_BOOTLOADER_PLACEMENT 1
+#define BPV4_MAX_FLASHSIZE 0x2AC00
+#define BPV4_BLSTARTADDR 0x400L
+#define BPV4_BLENDADDR 0x23FFL
+
+#define BPV4_TARGET(id, name, flashsize) { LOADER_FAMILY_BPV4, id, name, flashsize, BPV4_BLSTARTADDR, BPV4_BLENDADDR }
+
+/* devices answering the bootloader hello, see BPv4-bootloader/firmware-v1/bootloader.h */
+static const loader_target_t targets[] =
+{
+    { LOADER_FAMILY_BPV3, BPV3_DEVICE_ID, "PIC24FJ64GA002", BPV3_FLASHSIZE, 0, 0 },
+    BPV4_TARGET(  9, "PIC24FJ128GB206", 0x15800),
+    BPV4_TARGET( 17, "PIC24FJ128GB210", 0x15800),
+    BPV4_TARGET( 18, "PIC24FJ256GB206", 0x2AC00),
+    BPV4_TARGET( 19, "PIC24FJ256GB210", 0x2AC00),
+    BPV4_TARGET(191, "PIC24FJ256DA206", 0x2AC00),
+    BPV4_TARGET(192, "PIC24FJ256DA210", 0x2AC00),
+    BPV4_TARGET(206, "PIC24FJ16GA002",  0x2C00),
+    BPV4_TARGET(207, "PIC24FJ16GA004",  0x2C00),
+    BPV4_TARGET(208, "PIC24FJ32GA002",  0x5800),
+    BPV4_TARGET(209, "PIC24FJ32GA004",  0x5800),
+    BPV4_TARGET(210, "PIC24FJ48GA002",  0x8400),
+    BPV4_TARGET(211, "PIC24FJ48GA004",  0x8400),
+    BPV4_TARGET(212, "PIC24FJ64GA002",  0xAC00),
+    BPV4_TARGET(213, "PIC24FJ64GA004",  0xAC00),
+    BPV4_TARGET(214, "PIC24FJ64GA006",  0xAC00),
+    BPV4_TARGET(215, "PIC24FJ64GA008",  0xAC00),
+    BPV4_TARGET(216, "PIC24FJ64GA010",  0xAC00),
+    BPV4_TARGET(217, "PIC24FJ64GB106",  0xAC00),
+    BPV4_TARGET(218, "PIC24FJ64GB108",  0xAC00),
+    BPV4_TARGET(219, "PIC24FJ64GB110",  0xAC00),
+    BPV4_TARGET(220, "PIC24FJ96GA006",  0x10000),
+    BPV4_TARGET(221, "PIC24FJ96GA008",  0x10000),
+    BPV4_TARGET(222, "PIC24FJ96GA010",  0x10000),
+    BPV4_TARGET(223, "PIC24FJ128GA006", 0x15800),
+    BPV4_TARGET(224, "PIC24FJ128GA008", 0x15800),
+    BPV4_TARGET(225, "PIC24FJ128GA010", 0x15800),
+    BPV4_TARGET(226, "PIC24FJ128GA106", 0x15800),
+    BPV4_TARGET(227, "PIC24FJ128GA108", 0x15800),
+    BPV4_TARGET(228, "PIC24FJ128GA110", 0x15800),
+    BPV4_TARGET(229, "PIC24FJ128GB106", 0x15800),
+    BPV4_TARGET(230, "PIC24FJ128GB108", 0x15800),
+    BPV4_TARGET(231, "PIC24FJ128GB110", 0x15800),
+    BPV4_TARGET(232, "PIC24FJ192GA106", 0x20C00),
+    BPV4_TARGET(233, "PIC24FJ192GA108", 0x20C00),
+    BPV4_TARGET(234, "PIC24FJ192GA110", 0x20C00),
+    BPV4_TARGET(235, "PIC24FJ192GB106", 0x20C00),
+    BPV4_TARGET(236, "PIC24FJ192GB108", 0x20C00),
+    BPV4_TARGET(237, "PIC24FJ192GB110", 0x20C00),
+    BPV4_TARGET(238, "PIC24FJ256GA106", 0x2AC00),
+    BPV4_TARGET(239, "PIC24FJ256GA108", 0x2AC00),
+    BPV4_TARGET(240, "PIC24FJ256GA110", 0x2AC00),
+    { LOADER_FAMILY_BPV4, 241, "PIC24FJ256GB106", 0x2AC00, BPV4_BLSTARTADDR, 0x1FFFL }, //bootloader.h ends it early
+    BPV4_TARGET(242, "PIC24FJ256GB108", 0x2AC00),
+    BPV4_TARGET(243, "PIC24FJ256GB110", 0x2AC00),
+    BPV4_TARGET(244, "PIC24FJ32GB002",  0x5800),
+    BPV4_TARGET(245, "PIC24FJ32GB004",  0x5800),
+    BPV4_TARGET(246, "PIC24FJ64GB002",  0xAC00),
+    BPV4_TARGET(247, "PIC24FJ64GB004",  0xAC00),
+    BPV4_TARGET(250, "PIC24FJ128DA106", 0x15800),
+    BPV4_TARGET(251, "PIC24FJ128DA110", 0x15800),
+    BPV4_TARGET(252, "PIC24FJ128DA206", 0x15800),
+    BPV4_TARGET(253, "PIC24FJ128DA210", 0x15800),
+    BPV4_TARGET(254, "PIC24FJ256DA106", 0x2AC00),
+    BPV4_TARGET(255, "PIC24FJ256DA110", 0x2AC00)
+};
+
+/* image functions */
+
+int loaderImageLoad(loader_image_t* image, const char* path, loader_family_t family)
+{
+    long res;
+
+    memset(image->data, 0xFF, sizeof(image->data));
+    memset(image->pages_used, 0, sizeof(image->pages_used));
+    image->family = family;
+    image->num_words = 0;
+    image->flashsize = (family == LOADER_FAMILY_BPV3) ? BPV3_FLASHSIZE : BPV4_MAX_FLASHSIZE;
+
+    res = hexfileLoad(path, image->data, sizeof(image->data), image->pages_used, image->flashsize);
+    if( res < 0 )
+    {
+        return -1;
+    }
+    image->num_words = res;
+
+    if( image->num_words == 0 )
+    {
+        fprintf(stderr, "No data found in %s\n", path);
+        return -1;
+    }
+
+    if( family == LOADER_FAMILY_BPV3 )
+    {
+        hexfileFixJumps(image->data, image->pages_used, BPV3_FLASHSIZE, BPV3_BOOTLOADER_PLACEMENT);
+    }
+
+    return 0;
+}
+
+static uint16_t crc16Update(uint16_t crc, uint8_t data)
+{
+    int i;
+
+    crc ^= ((uint16_t)data) << 8;
+    for( i = 0; i < 8; i++ )
+    {
+        crc = (crc & 0x8000) ? ((crc << 1) ^ 0x1021) : (crc << 1);
+    }
+
+    return crc;
+}
+
+uint16_t loaderPageCrc(const uint8_t* data, unsigned int page, unsigned long blstartaddr)
+{
+    const uint8_t* pdata = &data[PIC_PAGE_ADDR(page)];
+    uint8_t  jump[6];
+    uint16_t crc = 0xFFFF;
+    unsigned int i;
+
+    //the bootloader puts its own jump in the reset vector, see WritePage
+    jump[0] = 0x04;
+    jump[1] = (uint8_t)(blstartaddr);
+    jump[2] = (uint8_t)(blstartaddr >> 8);
+    jump[3] = 0x00;
+    jump[4] = (uint8_t)((blstartaddr >> 16) && 0xFF);
+    jump[5] = 0x00;
+
+    for( i = 0; i < PIC_PAGE_SIZE; i++ )
+    {
+        crc = crc16Update(crc, (page == 0 && i < sizeof(jump)) ? jump[i] : pdata[i]);
+    }
+
+    return crc;
+}
+
+uint32_t loaderPageAddress(unsigned int page)
+{
+    return page * PIC_PAGE_SPAN;
+}
+
+/* pages WritePage answers with 'P' for: the bootloader itself (PROT_BL) and the config words page (PROT_CONFIG) */
+int loaderPageProtected(const loader_target_t* target, unsigned int page)
+{
+    unsigned long start = loaderPageAddress(page);
+    unsigned long end = start + PIC_PAGE_SPAN - 1;
+
+    if( target->family != LOADER_FAMILY_BPV4 )
+    {
+        return 0;
+    }
+
+    if( start <= target->blendaddr && end >= target->blstartaddr )
+    {
+        return 1;
+    }
+
+    return end >= target->flashsize - PIC_PAGE_SPAN;
+}
+
+/* protocol functions */
+
+const loader_target_t* loaderFindTarget(loader_family_t family, uint8_t id)
+{
+    unsigned int i;
+
+    for( i = 0; i < sizeof(targets) / sizeof(targets[0]); i++ )
+    {
+        if( targets[i].family == family && targets[i].id == id )
+        {
+            return &targets[i];
+        }
+    }
+
+    return NULL;
+}
+
+/* the hello reply is the device id, the bootloader version and 'K' */
+int loaderHelloValid(const uint8_t* reply)
+{
+    return reply[3] == BOOTLOADER_OK;
+}
+
+uint16_t loaderHelloVersion(const uint8_t* reply)
+{
+    return (reply[1] << 8) | reply[2];
+}
+
+int loaderCanCompare(const loader_target_t* target, uint16_t version)
+{
+    return target->family == LOADER_FAMILY_BPV4 && version >= BOOTLOADER_CRC_VERSION;
+}
+
+int loaderCanPipeline(const loader_target_t* target, uint16_t version)
+{
+    return target->family == LOADER_FAMILY_BPV4 && version >= BOOTLOADER_PIPELINE_VERSION;
+}
+
+static unsigned int makeCommand(uint8_t* command, uint32_t u_addr, uint8_t code, const uint8_t* payload, unsigned int length)
+{
+    uint8_t crc = 0;
+    unsigned int i;
+
+    command[0] = (u_addr & 0x00FF0000) >> 16;
+    command[1] = (u_addr & 0x0000FF00) >>  8;
+    command[2] = (u_addr & 0x000000FF) >>  0;
+    command[COMMAND_OFFSET] = code;
+    command[LENGTH_OFFSET ] = length + 1; //DATA_LENGTH + CRC
+
+    if( length > 0 )
+    {
+        memcpy(&command[PAYLOAD_OFFSET], payload, length);
+    }
+
+    for( i = 0; i < HEADER_LENGTH + length; i++ )
+    {
+        crc -= command[i];
+    }
+    command[HEADER_LENGTH + length] = crc;
+
+    return HEADER_LENGTH + length + 1;
+}
+
+unsigned int loaderCommandHello(uint8_t* command)
+{
+    command[0] = BOOTLOADER_HELLO;
+    return 1;
+}
+
+unsigned int loaderCommandPageCrc(uint8_t* command, unsigned int page)
+{
+    return makeCommand(command, loaderPageAddress(page), BOOTLOADER_CMD_PAGE_CRC, NULL, 0);
+}
+
+unsigned int loaderCommandErase(uint8_t* command, unsigned int page)
+{
+    return makeCommand(command, loaderPageAddress(page), BOOTLOADER_CMD_ERASE, NULL, 0);
+}
+
+unsigned int loaderCommandWriteRow(uint8_t* command, const uint8_t* data, unsigned int page, unsigned int row)
+{
+    return makeCommand(command, loaderPageAddress(page) + (row * PIC_ROW_SPAN), BOOTLOADER_CMD_WRITE,
+                       &data[PIC_ROW_ADDR(page, row)], PIC_ROW_SIZE);
+}
+
+/* its reply is the first sequence-numbered one, see loaderWindowPipeline */
+unsigned int loaderCommandPipeline(uint8_t* command)
+{
+    return makeCommand(command, 0, BOOTLOADER_CMD_PIPELINE, NULL, 0);
+}
+
+/* two CRC bytes, then the usual reply */
+int loaderReplyPageCrc(const uint8_t* reply, uint16_t* crc)
+{
+    if( reply[2] != BOOTLOADER_OK )
+    {
+        return -1;
+    }
+
+    *crc = (reply[0] << 8) | reply[1];
+    return 0;
+}
+
+void loaderWindowInit(loader_window_t* window, unsigned int size)
+{
+    window->size = (size < 1 || size > LOADER_MAX_WINDOW) ? 1 : size;
+    window->in_flight = 0;
+    window->next_ack = 0;
+    window->pipelined = 0;
+}
+
+/* call before sending loaderCommandPipeline, undo with loaderWindowInit if its reply is not OK */
+void loaderWindowPipeline(loader_window_t* window)
+{
+    window->in_flight = 0;
+    window->next_ack = 0;
+    window->pipelined = 1;
+}
+
+int loaderWindowFull(const loader_window_t* window)
+{
+    return window->in_flight >= (window->pipelined ? window->size : 1);
+}
+
+void loaderWindowSent(loader_window_t* window)
+{
+    window->in_flight++;
+}
+
+/* a status byte, followed by the sequence number once pipelined */
+unsigned int loaderWindowReplyLength(const loader_window_t* window)
+{
+    return window->pipelined ? 2 : 1;
+}
+
+loader_reply_t loaderWindowReply(loader_window_t* window, const uint8_t* reply)
+{
+    if( window->pipelined )
+    {
+        if( reply[1] != window->next_ack )
+        {
+            return LOADER_REPLY_OUT_OF_SEQUENCE;
+        }
+        window->next_ack++;
+    }
+
+    window->in_flight--;
+
+    switch( reply[0] )
+    {
+    case BOOTLOADER_OK:
+        return LOADER_REPLY_OK;
+    case BOOTLOADER_PROT:
+        return LOADER_REPLY_PROTECTED;
+    default:
+        return LOADER_REPLY_FAILED;
+    }
+}
+
+/* device functions */
+
+#ifndef WIN32
+
+static void fail(loader_device_t* dev, const char* format, ...)
+{
+    va_list args;
+
+    va_start(args, format);
+    vsnprintf(dev->error, sizeof(dev->error), format, args);
+    va_end(args);
+
+    dev->state = LOADER_STATE_FAILED;
+    dev->finished = time(NULL);
+}
+
+static void queued(loader_device_t* dev, unsigned int length)
+{
+    dev->tx_len = length;
+    dev->tx_done = 0;
+    dev->deadline = time(NULL) + dev->options.timeout;
+}
+
+static int findNextPage(loader_device_t* dev, unsigned int from)
+{
+    for( dev->page = from; dev->page < PIC_NUM_PAGES; dev->page++ )
+    {
+        if( dev->pages_used[dev->page] )
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/* queues the next erase or row write, returns 0 when everything was sent */
+static int queueNextWrite(loader_device_t* dev)
+{
+    if( dev->row == PIC_NUM_ROWS_IN_PAGE )
+    {
+        if( !findNextPage(dev, dev->page + 1) )
+        {
+            return 0;
+        }
+        dev->row = -1;
+    }
+
+    if( dev->row < 0 )
+    {
+        queued(dev, loaderCommandErase(dev->tx, dev->page));
+    }
+    else
+    {
+        queued(dev, loaderCommandWriteRow(dev->tx, dev->image->data, dev->page, dev->row));
+    }
+
+    dev->row++;
+    return 1;
+}
+
+static void startWriting(loader_device_t* dev)
+{
+    unsigned int page;
+
+    dev->pages_total = 0;
+    for( page = 0; page < PIC_NUM_PAGES; page++ )
+    {
+        dev->pages_total += dev->pages_used[page];
+    }
+    dev->commands_total = dev->pages_total * (PIC_NUM_ROWS_IN_PAGE + 1);
+    dev->commands_done = 0;
+
+    if( !findNextPage(dev, 0) )
+    {
+        dev->state = LOADER_STATE_DONE;
+        dev->finished = time(NULL);
+        return;
+    }
+    dev->row = -1;
+
+    if( dev->options.window > 1 && loaderCanPipeline(dev->target, dev->version) )
+    {
+        loaderWindowPipeline(&dev->window);
+        queued(dev, loaderCommandPipeline(dev->tx));
+        loaderWindowSent(&dev->window);
+        dev->state = LOADER_STATE_PIPELINE;
+        dev->reply_len = loaderWindowReplyLength(&dev->window);
+        return;
+    }
+
+    dev->state = LOADER_STATE_WRITE;
+    dev->reply_len = loaderWindowReplyLength(&dev->window);
+}
+
+static void handleHello(loader_device_t* dev)
+{
+    unsigned int i;
+
+    if( !loaderHelloValid(dev->rx) )
+    {
+        fail(dev, "invalid hello reply [%02x]", dev->rx[3]);
+        return;
+    }
+
+    dev->version = loaderHelloVersion(dev->rx);
+    dev->target = loaderFindTarget(dev->image->family, dev->rx[0]);
+
+    if( !dev->target )
+    {
+        fail(dev, "unsupported device %02x for a %s image", dev->rx[0],
+             dev->image->family == LOADER_FAMILY_BPV3 ? "v3" : "v4");
+        return;
+    }
+
+    for( i = 0; i < PIC_NUM_PAGES; i++ )
+    {
+        if( dev->pages_used[i] && loaderPageAddress(i) >= dev->target->flashsize )
+        {
+            fail(dev, "image does not fit in %s flash", dev->target->name);
+            return;
+        }
+    }
+
+    //never compare or write what the bootloader will not let us change
+    for( i = 0; i < PIC_NUM_PAGES; i++ )
+    {
+        if( dev->pages_used[i] && loaderPageProtected(dev->target, i) )
+        {
+            dev->pages_used[i] = 0;
+            dev->pages_protected++;
+        }
+    }
+
+    if( dev->options.diff && loaderCanCompare(dev->target, dev->version) && findNextPage(dev, 0) )
+    {
+        dev->state = LOADER_STATE_COMPARE;
+        dev->reply_len = LOADER_CRC_REPLY_LENGTH;
+        queued(dev, loaderCommandPageCrc(dev->tx, dev->page));
+        return;
+    }
+
+    startWriting(dev);
+}
+
+static void handleCompare(loader_device_t* dev)
+{
+    uint16_t crc;
+
+    if( loaderReplyPageCrc(dev->rx, &crc) < 0 )
+    {
+        fail(dev, "page %u CRC failed [%02x]", dev->page, dev->rx[2]);
+        return;
+    }
+
+    if( crc == loaderPageCrc(dev->image->data, dev->page, dev->target->blstartaddr) )
+    {
+        dev->pages_used[dev->page] = 0;
+        dev->pages_skipped++;
+    }
+
+    if( findNextPage(dev, dev->page + 1) )
+    {
+        queued(dev, loaderCommandPageCrc(dev->tx, dev->page));
+        return;
+    }
+
+    startWriting(dev);
+}
+
+static void handlePipeline(loader_device_t* dev)
+{
+    if( loaderWindowReply(&dev->window, dev->rx) != LOADER_REPLY_OK )
+    {
+        fail(dev, "could not enable pipelined writes [%02x %02x]", dev->rx[0], dev->rx[1]);
+        return;
+    }
+
+    dev->state = LOADER_STATE_WRITE;
+}
+
+static void handleWriteReply(loader_device_t* dev)
+{
+    switch( loaderWindowReply(&dev->window, dev->rx) )
+    {
+    case LOADER_REPLY_OK:
+        break;
+    case LOADER_REPLY_OUT_OF_SEQUENCE:
+        fail(dev, "reply out of sequence, expected %d got %d", dev->window.next_ack, dev->rx[1]);
+        return;
+    case LOADER_REPLY_PROTECTED:
+        if( dev->target->family == LOADER_FAMILY_BPV4 )
+        {
+            break;
+        }
+        //fall through
+    default:
+        fail(dev, "command failed [%02x]", dev->rx[0]);
+        return;
+    }
+
+    dev->commands_done++;
+
+    if( dev->commands_done == dev->commands_total )
+    {
+        dev->state = LOADER_STATE_DONE;
+        dev->finished = time(NULL);
+    }
+}
+
+static void handleReply(loader_device_t* dev)
+{
+    dev->deadline = time(NULL) + dev->options.timeout;
+
+    switch( dev->state )
+    {
+    case LOADER_STATE_HELLO:
+        handleHello(dev);
+        break;
+    case LOADER_STATE_COMPARE:
+        handleCompare(dev);
+        break;
+    case LOADER_STATE_PIPELINE:
+        handlePipeline(dev);
+        break;
+    case LOADER_STATE_WRITE:
+        handleWriteReply(dev);
+        break;
+    default:
+        break;
+    }
+}
+
+/* writes as much as the port takes, queueing row writes while the window allows */
+static void pump(loader_device_t* dev)
+{
+    int res;
+
+    while( dev->state < LOADER_STATE_DONE )
+    {
+        if( dev->tx_done == dev->tx_len )
+        {
+            if( dev->state != LOADER_STATE_WRITE )
+            {
+                return;
+            }
+
+            if( loaderWindowFull(&dev->window) || !queueNextWrite(dev) )
+            {
+                return;
+            }
+            loaderWindowSent(&dev->window);
+        }
+
+        res = write(dev->fd, dev->tx + dev->tx_done, dev->tx_len - dev->tx_done);
+
+        if( res > 0 )
+        {
+            dev->tx_done += res;
+        }
+        else if( res < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) )
+        {
+            return;
+        }
+        else
+        {
+            fail(dev, "write error: %s", strerror(errno));
+            return;
+        }
+    }
+}
+
+static void drain(loader_device_t* dev)
+{
+    int res;
+
+    while( dev->state < LOADER_STATE_DONE )
+    {
+        res = read(dev->fd, dev->rx + dev->rx_len, dev->reply_len - dev->rx_len);
+
+        if( res > 0 )
+        {
+            dev->rx_len += res;
+            if( dev->rx_len == dev->reply_len )
+            {
+                dev->rx_len = 0;
+                handleReply(dev);
+            }
+        }
+        else if( res < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) )
+        {
+            return;
+        }
+        else
+        {
+            fail(dev, "read error: %s", res == 0 ? "port closed" : strerror(errno));
+            return;
+        }
+    }
+}
+
+int loaderDeviceOpen(loader_device_t* dev, const char* path, const loader_image_t* image, const loader_options_t* options)
+{
+    struct termios tio;
+
+    memset(dev, 0, sizeof(*dev));
+    dev->fd = -1;
+    dev->path = path;
+    dev->image = image;
+    dev->options = *options;
+    dev->started = time(NULL);
+    memcpy(dev->pages_used, image->pages_used, sizeof(dev->pages_used));
+
+    loaderWindowInit(&dev->window, dev->options.window);
+    dev->options.window = dev->window.size;
+
+    dev->fd = open(path, O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if( dev->fd < 0 )
+    {
+        fail(dev, "could not open: %s", strerror(errno));
+        return -1;
+    }
+
+    memset(&tio, 0, sizeof(tio));
+    cfmakeraw(&tio);
+    tio.c_cflag |= (CS8 | CLOCAL | CREAD);
+    tio.c_cc[VTIME] = 0;
+    tio.c_cc[VMIN] = 1;
+    cfsetispeed(&tio, B115200);
+    cfsetospeed(&tio, B115200);
+    tcflush(dev->fd, TCIOFLUSH);
+
+    if( tcsetattr(dev->fd, TCSANOW, &tio) < 0 )
+    {
+        fail(dev, "could not configure: %s", strerror(errno));
+        return -1;
+    }
+
+    dev->reply_len = LOADER_HELLO_REPLY_LENGTH;
+    dev->state = LOADER_STATE_HELLO;
+    queued(dev, loaderCommandHello(dev->tx));
+
+    pump(dev);
+    return dev->state == LOADER_STATE_FAILED ? -1 : 0;
+}
+
+short loaderDeviceEvents(const loader_device_t* dev)
+{
+    if( dev->state >= LOADER_STATE_DONE )
+    {
+        return 0;
+    }
+
+    return POLLIN | ((dev->tx_done < dev->tx_len) ? POLLOUT : 0);
+}
+
+void loaderDeviceService(loader_device_t* dev, short revents)
+{
+    if( dev->state >= LOADER_STATE_DONE )
+    {
+        return;
+    }
+
+    if( revents & (POLLIN | POLLERR | POLLHUP) )
+    {
+        drain(dev);
+    }
+
+    pump(dev);
+
+    if( dev->state < LOADER_STATE_DONE && time(NULL) > dev->deadline )
+    {
+        fail(dev, "no reply from the bootloader");
+    }
+}
+
+int loaderDeviceDone(const loader_device_t* dev)
+{
+    return dev->state >= LOADER_STATE_DONE;
+}
+
+unsigned int loaderDeviceProgress(const loader_device_t* dev)
+{
+    if( dev->state == LOADER_STATE_DONE )
+    {
+        return 100;
+    }
+
+    if( dev->state != LOADER_STATE_WRITE || dev->commands_total == 0 )
+    {
+        return 0;
+    }
+
+    return (dev->commands_done * 100) / dev->commands_total;
+}
+
+void loaderDeviceClose(loader_device_t* dev)
+{
+    if( dev->fd >= 0 )
+    {
+        close(dev->fd);
+        dev->fd = -1;
+    }
+}
+
+#endif /* WIN32 */
@@ -0,0 +1,216 @@
+/*
+ * This file is part of the Bus Pirate project
+ * (http://code.google.com/p/the-bus-pirate/).
+ *
+ * Written and maintained by the Bus Pirate project.
+ *
+ * To the extent possible under law, the project has
+ * waived all copyright and related or neighboring rights to Bus Pirate. This
+ * work is published from United States.
+ *
+ * For details see: http://creativecommons.org/publicdomain/zero/1.0/.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+/*
+ Pirate-Loader library
+
+ Talks to Bus Pirate v3 (ds30) and v4 bootloaders with no global state, so
+ one process can flash many boards at once.  Shared by all host loaders, it
+ comes in two layers:
+
+  - protocol functions build commands into a caller's buffer and decode
+    replies without doing any I/O: the hello, page CRCs, erase and row
+    writes, the supported devices and the window of commands in flight.
+    The single-port pirate-loaders drive them with their own blocking port
+    code, which also runs on Windows,
+  - device functions run a whole upload as a non-blocking state machine on
+    top of the protocol functions, driven by the caller's event loop:
+
+     - loaderDeviceOpen opens and configures the port and sends the hello,
+     - loaderDeviceEvents tells which poll(2) events the device waits for,
+     - loaderDeviceService is called when those events fire or time runs out,
+     - loaderDeviceDone tells when the device succeeded or failed.
+
+    These are POSIX only, as the event loop is built on non-blocking file
+    descriptors, and are left out of WIN32 builds.
+
+ A firmware image is loaded once and shared by all devices.
+ */
+
+#ifndef PIRATE_LOADER_H
+#define PIRATE_LOADER_H
+
+#include <stdint.h>
+#include <time.h>
+
+#define PIC_WORD_SIZE  (3)
+#define PIC_NUM_PAGES 512
+#define PIC_NUM_ROWS_IN_PAGE  8
+#define PIC_NUM_WORDS_IN_ROW 64
+#define PIC_ROW_SIZE  (PIC_NUM_WORDS_IN_ROW * PIC_WORD_SIZE)
+#define PIC_PAGE_SIZE (PIC_NUM_ROWS_IN_PAGE  * PIC_ROW_SIZE)
+#define PIC_IMAGE_SIZE (PIC_NUM_PAGES * PIC_PAGE_SIZE)
+#define PIC_ROW_ADDR(p,r)		(((p) * PIC_PAGE_SIZE) + ((r) * PIC_ROW_SIZE))
+#define PIC_PAGE_ADDR(p)		(PIC_PAGE_SIZE * (p))
+
+/* program addresses spanned by a row and a page, two per word */
+#define PIC_ROW_SPAN  (PIC_NUM_WORDS_IN_ROW * 2)
+#define PIC_PAGE_SPAN (PIC_NUM_ROWS_IN_PAGE * PIC_ROW_SPAN)
+
+#define LOADER_MAX_WINDOW 64
+#define LOADER_MAX_COMMAND (5 + PIC_ROW_SIZE + 1)
+
+/* reply lengths, writes and erases are answered in loaderWindowReplyLength bytes */
+#define LOADER_HELLO_REPLY_LENGTH 4
+#define LOADER_CRC_REPLY_LENGTH 3
+
+typedef enum
+{
+    LOADER_FAMILY_BPV3 = 0, //ds30 bootloader, PIC24FJ64GA002
+    LOADER_FAMILY_BPV4      //Bootloader v4, PIC24FJ256GB106 and friends
+} loader_family_t;
+
+/* a device a bootloader hello can identify */
+typedef struct
+{
+    loader_family_t family;
+    uint8_t         id;
+    const char*     name;
+    unsigned long   flashsize;
+    unsigned long   blstartaddr; //v4 only, the ds30 bootloader refuses nothing
+    unsigned long   blendaddr;
+} loader_target_t;
+
+typedef enum
+{
+    LOADER_REPLY_OK = 0,
+    LOADER_REPLY_PROTECTED,         //v4 left a bootloader or config page alone
+    LOADER_REPLY_FAILED,
+    LOADER_REPLY_OUT_OF_SEQUENCE
+} loader_reply_t;
+
+/* erase and write commands sent but not answered yet */
+typedef struct
+{
+    unsigned int size;      //commands in flight once pipelined, 1 for lock-step
+    unsigned int in_flight;
+    uint8_t      next_ack;  //sequence number of the next pipelined reply
+    int          pipelined;
+} loader_window_t;
+
+typedef enum
+{
+    LOADER_STATE_HELLO = 0,
+    LOADER_STATE_COMPARE,
+    LOADER_STATE_PIPELINE,
+    LOADER_STATE_WRITE,
+    LOADER_STATE_DONE,
+    LOADER_STATE_FAILED
+} loader_state_t;
+
+/* firmware image shared by all devices, read-only once loaded */
+typedef struct
+{
+    loader_family_t family;
+    unsigned long   flashsize;
+    uint8_t         data[PIC_IMAGE_SIZE];
+    uint8_t         pages_used[PIC_NUM_PAGES];
+    unsigned long   num_words;
+} loader_image_t;
+
+/* per-device settings */
+typedef struct
+{
+    unsigned int window; //commands in flight, 1 for lock-step
+    int          diff;   //only write pages whose CRC differs, v4.12+
+    int          timeout; //seconds to wait for any reply
+} loader_options_t;
+
+typedef struct
+{
+    const char*             path;
+    const loader_image_t*   image;
+    loader_options_t        options;
+
+    int             fd;
+    loader_state_t  state;
+    char            error[128];
+
+    /* what the bootloader told us */
+    const loader_target_t*  target;
+    uint16_t                version;
+
+    /* pages still to write, starts as a copy of the image's */
+    uint8_t         pages_used[PIC_NUM_PAGES];
+    unsigned int    pages_total;
+    unsigned int    pages_skipped;
+    unsigned int    pages_protected; //left out, the bootloader refuses them
+
+    /* command cursor: page, and row within it, -1 for the erase */
+    unsigned int    page;
+    int             row;
+
+    /* outgoing command, possibly partially written */
+    uint8_t         tx[LOADER_MAX_COMMAND];
+    unsigned int    tx_len;
+    unsigned int    tx_done;
+
+    /* incoming reply bytes */
+    uint8_t         rx[8];
+    unsigned int    rx_len;
+    unsigned int    reply_len;
+
+    loader_window_t window;
+
+    unsigned long   commands_total;
+    unsigned long   commands_done;
+    time_t          started;
+    time_t          finished;
+    time_t          deadline;
+} loader_device_t;
+
+/* image functions */
+
+int loaderImageLoad(loader_image_t* image, const char* path, loader_family_t family);
+uint16_t loaderPageCrc(const uint8_t* data, unsigned int page, unsigned long blstartaddr);
+uint32_t loaderPageAddress(unsigned int page);
+int loaderPageProtected(const loader_target_t* target, unsigned int page);
+
+/* protocol functions, the loaderCommand ones return the command length */
+
+const loader_target_t* loaderFindTarget(loader_family_t family, uint8_t id);
+int loaderHelloValid(const uint8_t* reply);
+uint16_t loaderHelloVersion(const uint8_t* reply);
+int loaderCanCompare(const loader_target_t* target, uint16_t version);
+int loaderCanPipeline(const loader_target_t* target, uint16_t version);
+
+unsigned int loaderCommandHello(uint8_t* command);
+unsigned int loaderCommandPageCrc(uint8_t* command, unsigned int page);
+unsigned int loaderCommandErase(uint8_t* command, unsigned int page);
+unsigned int loaderCommandWriteRow(uint8_t* command, const uint8_t* data, unsigned int page, unsigned int row);
+unsigned int loaderCommandPipeline(uint8_t* command);
+int loaderReplyPageCrc(const uint8_t* reply, uint16_t* crc);
+
+void loaderWindowInit(loader_window_t* window, unsigned int size);
+void loaderWindowPipeline(loader_window_t* window);
+int loaderWindowFull(const loader_window_t* window);
+void loaderWindowSent(loader_window_t* window);
+unsigned int loaderWindowReplyLength(const loader_window_t* window);
+loader_reply_t loaderWindowReply(loader_window_t* window, const uint8_t* reply);
+
+/* device functions */
+
+#ifndef WIN32
+int loaderDeviceOpen(loader_device_t* dev, const char* path, const loader_image_t* image, const loader_options_t* options);
+short loaderDeviceEvents(const loader_device_t* dev);
+void loaderDeviceService(loader_device_t* dev, short revents);
+int loaderDeviceDone(const loader_device_t* dev);
+unsigned int loaderDeviceProgress(const loader_device_t* dev);
+void loaderDeviceClose(loader_device_t* dev);
+#endif
+
+#endif /* PIRATE_LOADER_H */
@@ -0,0 +1,697 @@
+/*
+
+ Bootloader emulator for Bus Pirate v3 (ds30) and v4 bootloaders
+
+ Version  : 1.0.0
+
+ Answers the bootloader protocol behind a pseudo terminal, keeping the
+ programmed flash in memory, so loader changes can be regression tested and
+ benchmarked without hardware.  The emulated behaviour follows
+ BPv3-bootloader/firmware-v4.5/ds30loader.s and
+ BPv4-bootloader/firmware-v1/bootloader.c: checksum and verify replies, the
+ reset vector substitution, bootloader and configuration page protection,
+ and, for v4.11+ and v4.12+, sequence-numbered replies and page CRCs.
+
+ Flash erase and write times can be added with the latency switches.  A new
+ hello byte where a command is expected starts a new session, so one
+ emulator serves several loader runs in a row.  A per-session summary is
+ printed on stderr.
+
+ Building:
+
+  Built along with pirate-multiloader, POSIX systems only.
+
+ Usage:
+
+	Run ./bootloader-emulator --help for more information on usage and possible switches
+
+ */
+
+#define _XOPEN_SOURCE 600
+#define _DEFAULT_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "loader.h"
+
+#define EMULATOR_VERSION "1.0.0"
+
+#define BOOTLOADER_HELLO 0xC1
+#define BOOTLOADER_OK 'K'
+#define BOOTLOADER_CHECKSUM 'N'
+#define BOOTLOADER_VERIFY 'V'
+#define BOOTLOADER_PROT 'P'
+#define BOOTLOADER_UNKNOWN 'U'
+#define BOOTLOADER_PIPELINE_VERSION 0x040B
+#define BOOTLOADER_CRC_VERSION 0x040C
+
+#define PAGE_ADDRESS_MASK (~((unsigned long)(PIC_NUM_ROWS_IN_PAGE * PIC_NUM_WORDS_IN_ROW * 2) - 1))
+
+typedef struct
+{
+    loader_family_t family;
+    uint8_t         device_id;
+    uint16_t        version;
+    unsigned long   flashsize;
+    unsigned long   erase_latency;   //microseconds
+    unsigned long   write_latency;   //microseconds
+    unsigned long   command_latency; //microseconds
+    unsigned long   fail_command;    //answer this command with a verify error, 0 for never
+    const char*     link_path;
+    const char*     flash_path;
+} emulator_options_t;
+
+typedef struct
+{
+    emulator_options_t options;
+
+    int             fd;
+    uint8_t         inbuf[4096];
+    unsigned int    inbuf_len;
+    unsigned int    inbuf_pos;
+
+    uint8_t*        flash;
+
+    /* bootloader state */
+    int             enable_erase;
+    int             pipelined;
+    uint8_t         sequence;
+    uint8_t         reply;
+
+    /* session statistics */
+    unsigned long   commands;
+    unsigned long   erases;
+    unsigned long   writes;
+    unsigned long   crcs;
+    unsigned long   errors;
+    struct timespec started;
+    struct timespec last;
+} emulator_t;
+
+static volatile sig_atomic_t g_stop = 0;
+
+/* I/O */
+
+int getByte(emulator_t* emu, uint8_t* byte)
+{
+    int res;
+
+    if( emu->inbuf_pos == emu->inbuf_len )
+    {
+        do
+        {
+            res = read(emu->fd, emu->inbuf, sizeof(emu->inbuf));
+        }
+        while( res < 0 && errno == EINTR && !g_stop );
+
+        if( res <= 0 )
+        {
+            return -1;
+        }
+
+        emu->inbuf_len = res;
+        emu->inbuf_pos = 0;
+    }
+
+    *byte = emu->inbuf[emu->inbuf_pos++];
+    return 0;
+}
+
+void putBytes(emulator_t* emu, const uint8_t* data, int length)
+{
+    int res;
+
+    while( length > 0 )
+    {
+        res = write(emu->fd, data, length);
+        if( res <= 0 )
+        {
+            if( res < 0 && errno == EINTR )
+            {
+                continue;
+            }
+            perror("write");
+            exit(1);
+        }
+        data += res;
+        length -= res;
+    }
+}
+
+void delayMicroseconds(unsigned long us)
+{
+    struct timespec ts;
+
+    if( us == 0 )
+    {
+        return;
+    }
+
+    ts.tv_sec = us / 1000000;
+    ts.tv_nsec = (us % 1000000) * 1000;
+    while( nanosleep(&ts, &ts) < 0 && errno == EINTR );
+}
+
+double secondsBetween(const struct timespec* from, const struct timespec* to)
+{
+    return (to->tv_sec - from->tv_sec) + ((to->tv_nsec - from->tv_nsec) / 1e9);
+}
+
+void stopHandler(int sig)
+{
+    (void)sig;
+    g_stop = 1;
+}
+
+/* flash */
+
+uint8_t* flashAt(emulator_t* emu, unsigned long address)
+{
+    return &emu->flash[(address / 2) * PIC_WORD_SIZE];
+}
+
+void saveFlash(emulator_t* emu)
+{
+    FILE* fp;
+
+    if( !emu->options.flash_path )
+    {
+        return;
+    }
+
+    fp = fopen(emu->options.flash_path, "wb");
+    if( !fp )
+    {
+        perror(emu->options.flash_path);
+        return;
+    }
+
+    fwrite(emu->flash, 1, (emu->options.flashsize / 2) * PIC_WORD_SIZE, fp);
+    fclose(fp);
+}
+
+void loadFlash(emulator_t* emu)
+{
+    FILE* fp;
+
+    memset(emu->flash, 0xFF, (emu->options.flashsize / 2) * PIC_WORD_SIZE);
+
+    if( !emu->options.flash_path || !(fp = fopen(emu->options.flash_path, "rb")) )
+    {
+        return;
+    }
+
+    if( fread(emu->flash, 1, (emu->options.flashsize / 2) * PIC_WORD_SIZE, fp) == 0 )
+    {
+        fprintf(stderr, "Empty flash file %s, starting erased\n", emu->options.flash_path);
+    }
+    fclose(fp);
+}
+
+/* protocol */
+
+void startSession(emulator_t* emu)
+{
+    uint8_t hello[3];
+
+    emu->enable_erase = 0;
+    emu->pipelined = 0;
+    emu->reply = BOOTLOADER_OK;
+    emu->commands = emu->erases = emu->writes = emu->crcs = emu->errors = 0;
+    clock_gettime(CLOCK_MONOTONIC, &emu->started);
+    emu->last = emu->started;
+
+    hello[0] = emu->options.device_id;
+    hello[1] = emu->options.version >> 8;
+    hello[2] = emu->options.version & 0xFF;
+    putBytes(emu, hello, sizeof(hello));
+}
+
+void endSession(emulator_t* emu)
+{
+    if( emu->commands == 0 )
+    {
+        return;
+    }
+
+    fprintf(stderr, "Session: %lu commands, %lu erases, %lu rows, %lu CRCs, %lu errors in %.3fs\n",
+            emu->commands, emu->erases, emu->writes, emu->crcs, emu->errors, secondsBetween(&emu->started, &emu->last));
+    saveFlash(emu);
+}
+
+void sendReply(emulator_t* emu)
+{
+    uint8_t reply[2];
+
+    reply[0] = emu->reply;
+    if( emu->pipelined )
+    {
+        reply[1] = emu->sequence++;
+        putBytes(emu, reply, 2);
+    }
+    else
+    {
+        putBytes(emu, reply, 1);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &emu->last);
+}
+
+int isProtected(emulator_t* emu, unsigned long address)
+{
+    unsigned long bl_start;
+
+    if( emu->options.family == LOADER_FAMILY_BPV3 )
+    {
+        //the bootloader sits in the last page, see BLCHECKST
+        bl_start = emu->options.flashsize - (PIC_NUM_ROWS_IN_PAGE * PIC_NUM_WORDS_IN_ROW * 2);
+        return address > bl_start - PIC_NUM_WORDS_IN_ROW;
+    }
+
+    //PROT_BL and PROT_CONFIG
+    return (address >= 0x400 && address <= 0x1FFF) ||
+           (address >= emu->options.flashsize - (2 * PIC_NUM_ROWS_IN_PAGE * PIC_NUM_WORDS_IN_ROW));
+}
+
+void writeRow(emulator_t* emu, unsigned long address, uint8_t* data, unsigned int length)
+{
+    unsigned long bl_start;
+
+    if( isProtected(emu, address) )
+    {
+        //ds30 drops a pending erase, v4 keeps it for the next write
+        if( emu->options.family == LOADER_FAMILY_BPV3 )
+        {
+            emu->enable_erase = 0;
+        }
+        emu->reply = BOOTLOADER_PROT;
+        return;
+    }
+
+    if( address == 0 )
+    {
+        //protect the jump to the bootloader
+        bl_start = (emu->options.family == LOADER_FAMILY_BPV3) ?
+                   emu->options.flashsize - (PIC_NUM_ROWS_IN_PAGE * PIC_NUM_WORDS_IN_ROW * 2) : 0x400;
+        data[0] = 0x04;
+        data[1] = (uint8_t)bl_start;
+        data[2] = (uint8_t)(bl_start >> 8);
+        data[3] = 0x00;
+        data[4] = (uint8_t)(bl_start >> 16);
+        data[5] = 0x00;
+    }
+
+    if( emu->enable_erase )
+    {
+        memset(flashAt(emu, address & PAGE_ADDRESS_MASK), 0xFF, PIC_PAGE_SIZE);
+        emu->enable_erase = 0;
+        emu->erases++;
+        delayMicroseconds(emu->options.erase_latency);
+    }
+
+    if( address + ((length / PIC_WORD_SIZE) * 2) > emu->options.flashsize )
+    {
+        emu->reply = BOOTLOADER_VERIFY;
+        return;
+    }
+
+    //programming can only clear bits
+    {
+        uint8_t* flash = flashAt(emu, address);
+        unsigned int i;
+
+        for( i = 0; i < length; i++ )
+        {
+            flash[i] &= data[i];
+        }
+    }
+    emu->writes++;
+    delayMicroseconds(emu->options.write_latency);
+
+    emu->reply = memcmp(flashAt(emu, address), data, length) ? BOOTLOADER_VERIFY : BOOTLOADER_OK;
+}
+
+void sendPageCrc(emulator_t* emu, unsigned long address)
+{
+    const uint8_t* flash = flashAt(emu, address);
+    uint16_t crc = 0xFFFF;
+    uint8_t reply[2];
+    unsigned int i, bit;
+
+    for( i = 0; i < PIC_PAGE_SIZE; i++ )
+    {
+        crc ^= ((uint16_t)flash[i]) << 8;
+        for( bit = 0; bit < 8; bit++ )
+        {
+            crc = (crc & 0x8000) ? ((crc << 1) ^ 0x1021) : (crc << 1);
+        }
+    }
+
+    reply[0] = crc >> 8;
+    reply[1] = crc & 0xFF;
+    putBytes(emu, reply, 2);
+    emu->crcs++;
+}
+
+/* returns -1 when the host went away, 1 for a new hello, 0 otherwise */
+int handleCommand(emulator_t* emu)
+{
+    uint8_t header[5];
+    uint8_t data[256];
+    uint8_t checksum;
+    uint8_t crc = 0;
+    unsigned long address;
+    unsigned int i;
+
+    for( i = 0; i < sizeof(header); i++ )
+    {
+        if( getByte(emu, &header[i]) < 0 )
+        {
+            return -1;
+        }
+
+        //no flash goes as high as 0xC1xxxx, so this is a new loader saying hello
+        if( i == 0 && header[0] == BOOTLOADER_HELLO )
+        {
+            return 1;
+        }
+        crc += header[i];
+    }
+
+    for( i = 0; i + 1 < header[4]; i++ )
+    {
+        if( getByte(emu, &data[i]) < 0 )
+        {
+            return -1;
+        }
+        crc += data[i];
+    }
+
+    if( getByte(emu, &checksum) < 0 )
+    {
+        return -1;
+    }
+    crc += checksum;
+
+    emu->commands++;
+    delayMicroseconds(emu->options.command_latency);
+
+    if( crc != 0 )
+    {
+        emu->reply = BOOTLOADER_CHECKSUM;
+        emu->errors++;
+        return 0;
+    }
+
+    //older v4 bootloaders left the previous status in place
+    if( emu->options.family == LOADER_FAMILY_BPV3 || emu->options.version >= BOOTLOADER_PIPELINE_VERSION )
+    {
+        emu->reply = BOOTLOADER_OK;
+    }
+
+    address = (header[0] << 16) | (header[1] << 8) | header[2];
+
+    if( emu->options.fail_command != 0 && emu->commands == emu->options.fail_command )
+    {
+        emu->reply = BOOTLOADER_VERIFY;
+        emu->errors++;
+        return 0;
+    }
+
+    if( emu->options.family == LOADER_FAMILY_BPV3 )
+    {
+        //ds30 only looks at bit 1 of the command
+        if( header[3] & 0x02 )
+        {
+            writeRow(emu, address, data, header[4] - 1);
+        }
+        else
+        {
+            emu->enable_erase = 1;
+        }
+    }
+    else
+    {
+        switch( header[3] )
+        {
+        case 1:
+            emu->enable_erase = 1;
+            break;
+        case 2:
+            writeRow(emu, address, data, header[4] - 1);
+            break;
+        case 3:
+            if( emu->options.version >= BOOTLOADER_PIPELINE_VERSION )
+            {
+                emu->pipelined = 1;
+                emu->sequence = 0;
+                break;
+            }
+            emu->reply = BOOTLOADER_UNKNOWN;
+            break;
+        case 4:
+            if( emu->options.version >= BOOTLOADER_CRC_VERSION )
+            {
+                sendPageCrc(emu, address);
+                break;
+            }
+            emu->reply = BOOTLOADER_UNKNOWN;
+            break;
+        default:
+            emu->reply = BOOTLOADER_UNKNOWN;
+            break;
+        }
+    }
+
+    if( emu->reply != BOOTLOADER_OK && emu->reply != BOOTLOADER_PROT )
+    {
+        emu->errors++;
+    }
+
+    return 0;
+}
+
+void run(emulator_t* emu)
+{
+    uint8_t byte;
+    int res;
+
+    for( ;; )
+    {
+        //wait for hello, anything else is ignored like the real thing
+        do
+        {
+            if( getByte(emu, &byte) < 0 )
+            {
+                return;
+            }
+        }
+        while( byte != BOOTLOADER_HELLO );
+
+        do
+        {
+            startSession(emu);
+
+            do
+            {
+                sendReply(emu);
+                res = handleCommand(emu);
+            }
+            while( res == 0 );
+
+            endSession(emu);
+        }
+        while( res == 1 );
+
+        if( res < 0 )
+        {
+            return;
+        }
+    }
+}
+
+/* setup */
+
+int openPty(emulator_t* emu, int* slave_fd)
+{
+    struct termios tio;
+    const char* slave_path;
+
+    emu->fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if( emu->fd < 0 || grantpt(emu->fd) < 0 || unlockpt(emu->fd) < 0 || !(slave_path = ptsname(emu->fd)) )
+    {
+        perror("Could not create a pseudo terminal");
+        return -1;
+    }
+
+    //keep the slave open, so the master does not see hangups between loader runs
+    *slave_fd = open(slave_path, O_RDWR | O_NOCTTY);
+    if( *slave_fd < 0 )
+    {
+        perror(slave_path);
+        return -1;
+    }
+
+    tcgetattr(*slave_fd, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(*slave_fd, TCSANOW, &tio);
+
+    if( emu->options.link_path )
+    {
+        unlink(emu->options.link_path);
+        if( symlink(slave_path, emu->options.link_path) < 0 )
+        {
+            perror(emu->options.link_path);
+            return -1;
+        }
+    }
+
+    printf("%s\n", slave_path);
+    fflush(stdout);
+
+    return 0;
+}
+
+int parseCommandLine(int argc, const char** argv, emulator_options_t* options)
+{
+    int i = 0;
+    int explicit_flashsize = 0;
+
+    options->family = LOADER_FAMILY_BPV4;
+    options->device_id = 241; //PIC24FJ256GB106
+    options->version = BOOTLOADER_CRC_VERSION;
+    options->flashsize = 0x2AC00;
+
+    for( i = 1; i < argc; i++ )
+    {
+        if( !strcmp(argv[i], "--bpv3") )
+        {
+            options->family = LOADER_FAMILY_BPV3;
+            options->device_id = 0xD4; //PIC24FJ64GA002
+            options->version = 0x0102;
+            if( !explicit_flashsize )
+            {
+                options->flashsize = 0xAC00;
+            }
+        }
+        else if( !strncmp(argv[i], "--device-id=", 12) )
+        {
+            options->device_id = strtoul(argv[i] + 12, NULL, 0);
+        }
+        else if( !strncmp(argv[i], "--version=", 10) )
+        {
+            options->version = strtoul(argv[i] + 10, NULL, 0);
+        }
+        else if( !strncmp(argv[i], "--flashsize=", 12) )
+        {
+            options->flashsize = strtoul(argv[i] + 12, NULL, 0);
+            explicit_flashsize = 1;
+        }
+        else if( !strncmp(argv[i], "--erase-latency=", 16) )
+        {
+            options->erase_latency = strtoul(argv[i] + 16, NULL, 10);
+        }
+        else if( !strncmp(argv[i], "--write-latency=", 16) )
+        {
+            options->write_latency = strtoul(argv[i] + 16, NULL, 10);
+        }
+        else if( !strncmp(argv[i], "--latency=", 10) )
+        {
+            options->command_latency = strtoul(argv[i] + 10, NULL, 10);
+        }
+        else if( !strncmp(argv[i], "--fail-command=", 15) )
+        {
+            options->fail_command = strtoul(argv[i] + 15, NULL, 10);
+        }
+        else if( !strncmp(argv[i], "--link=", 7) )
+        {
+            options->link_path = argv[i] + 7;
+        }
+        else if( !strncmp(argv[i], "--flash=", 8) )
+        {
+            options->flash_path = argv[i] + 8;
+        }
+        else if( !strcmp(argv[i], "--help") )
+        {
+            puts("bootloader-emulator " EMULATOR_VERSION " usage:\n");
+            puts(" ./bootloader-emulator [ --bpv3 ] [ --device-id=N ] [ --version=0xHHLL ] [ --flashsize=N ]");
+            puts("                       [ --latency=US ] [ --erase-latency=US ] [ --write-latency=US ]");
+            puts("                       [ --fail-command=N ] [ --link=/path/to/symlink ] [ --flash=/path/to/image.bin ]");
+            puts("");
+            puts(" Prints the pseudo terminal to connect the loader to, then serves loader");
+            puts(" sessions until the pseudo terminal is closed.");
+            puts("");
+            puts(" --bpv3            emulate the ds30 bootloader of Bus Pirate v3 boards");
+            puts(" --version         bootloader version reported by the hello reply, v4 default 0x040C");
+            puts(" --latency         delay before handling each command, in microseconds");
+            puts(" --erase-latency   extra delay for each page erase, in microseconds");
+            puts(" --write-latency   extra delay for each row write, in microseconds");
+            puts(" --fail-command    answer the Nth command of each session with a verify error");
+            puts(" --flash           load the flash content from, and save it to, this file");
+            puts("");
+            return 0;
+        }
+        else
+        {
+            fprintf(stderr, "Unknown parameter %s, please use bootloader-emulator --help for usage\n", argv[i]);
+            return -1;
+        }
+    }
+
+    if( options->flashsize == 0 || options->flashsize > 0x1000000 )
+    {
+        fprintf(stderr, "Invalid flash size\n");
+        return -1;
+    }
+
+    return 1;
+}
+
+int main(int argc, const char** argv)
+{
+    emulator_t emu;
+    struct sigaction sa;
+    int slave_fd = -1;
+    int res;
+
+    memset(&emu, 0, sizeof(emu));
+
+    if( (res = parseCommandLine(argc, argv, &emu.options)) <= 0 )
+    {
+        return res;
+    }
+
+    emu.flash = (uint8_t*)malloc((emu.options.flashsize / 2) * PIC_WORD_SIZE + PIC_PAGE_SIZE);
+    if( !emu.flash )
+    {
+        fprintf(stderr, "Out of memory\n");
+        return -1;
+    }
+    loadFlash(&emu);
+
+    if( openPty(&emu, &slave_fd) < 0 )
+    {
+        return -1;
+    }
+
+    //stop reading on ^C, so the last session is still reported and saved
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = stopHandler;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    run(&emu);
+
+    close(slave_fd);
+    close(emu.fd);
+    free(emu.flash);
+    return 0;
+}
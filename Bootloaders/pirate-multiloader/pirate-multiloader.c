@@ -0,0 +1,288 @@
+/*
+
+ Pirate-MultiLoader for Bootloader v3 and v4
+
+ Version  : 1.0.0
+
+ Flashes the same firmware on many Bus Pirates at once, one serial port per
+ board, from a single event loop.  Every port runs its own copy of the loader
+ protocol, so a slow or failing board does not hold up the others.
+
+ Building:
+
+  CMake is required for building this program.  POSIX systems only.
+
+  cd pirate-multiloader
+  mkdir build
+  cd build
+  cmake ..
+  make
+
+ Usage:
+
+	Run ./pirate-multiloader --help for more information on usage and possible switches
+
+ */
+
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "loader.h"
+
+#define PIRATE_MULTILOADER_VERSION "1.0.0"
+
+#define DEFAULT_WINDOW 8
+#define DEFAULT_TIMEOUT 5
+#define POLL_INTERVAL_MS 250
+
+/* command line arguments */
+
+typedef struct
+{
+    const char*         hexfile_path;
+    loader_family_t     family;
+    loader_options_t    options;
+    const char**        ports;
+    int                 num_ports;
+} multiloader_args_t;
+
+int parseCommandLine(int argc, const char** argv, multiloader_args_t* args)
+{
+    int i = 0;
+
+    args->hexfile_path = NULL;
+    args->family = LOADER_FAMILY_BPV4;
+    args->options.window = DEFAULT_WINDOW;
+    args->options.diff = 0;
+    args->options.timeout = DEFAULT_TIMEOUT;
+    args->ports = argv + argc;
+    args->num_ports = 0;
+
+    for( i = 1; i < argc; i++ )
+    {
+        if( !strncmp(argv[i], "--hex=", 6) )
+        {
+            args->hexfile_path = argv[i] + 6;
+        }
+        else if( !strcmp(argv[i], "--bpv3") )
+        {
+            args->family = LOADER_FAMILY_BPV3;
+        }
+        else if( !strcmp(argv[i], "--diff") )
+        {
+            args->options.diff = 1;
+        }
+        else if( !strncmp(argv[i], "--window=", 9) )
+        {
+            args->options.window = strtoul(argv[i] + 9, NULL, 10);
+
+            if( args->options.window < 1 || args->options.window > LOADER_MAX_WINDOW )
+            {
+                fprintf(stderr, "Window must be between 1 and %d commands\n", LOADER_MAX_WINDOW);
+                return -1;
+            }
+        }
+        else if( !strncmp(argv[i], "--timeout=", 10) )
+        {
+            args->options.timeout = atoi(argv[i] + 10);
+        }
+        else if( !strcmp(argv[i], "--help") )
+        {
+            argc = 1;
+            break;
+        }
+        else if( !strncmp(argv[i], "--", 2) )
+        {
+            fprintf(stderr, "Unknown parameter %s, please use pirate-multiloader --help for usage\n", argv[i]);
+            return -1;
+        }
+        else
+        {
+            //the ports are the remaining arguments
+            args->ports = argv + i;
+            args->num_ports = argc - i;
+            break;
+        }
+    }
+
+    if( argc == 1 )
+    {
+        puts("pirate-multiloader usage:\n");
+        puts(" ./pirate-multiloader --hex=/path/to/hexfile.hex [ --bpv3 ] [ --diff ] [ --window=N ] [ --timeout=S ] /dev/port1 [ /dev/port2 ... ]");
+        puts("");
+        puts(" --bpv3      boards run the v3 (ds30) bootloader, default is v4");
+        puts(" --diff      only writes the pages whose content differs, v4.12+ bootloaders");
+        puts(" --window=N  keeps up to N commands in flight, v4.11+ bootloaders (default 8)");
+        puts(" --timeout=S fails a board after S seconds without a reply (default 5)");
+        puts("");
+
+        return 0;
+    }
+
+    if( !args->hexfile_path || args->num_ports == 0 )
+    {
+        fprintf(stderr, "Please specify a HEX file and at least one port\n");
+        return -1;
+    }
+
+    return 1;
+}
+
+void printProgress(const loader_device_t* devices, int num_devices, int force)
+{
+    static time_t last = 0;
+    int i;
+
+    //once a second is plenty for a progress line
+    if( !force && time(NULL) == last )
+    {
+        return;
+    }
+    last = time(NULL);
+
+    for( i = 0; i < num_devices; i++ )
+    {
+        if( devices[i].state == LOADER_STATE_FAILED )
+        {
+            printf(" %s: FAIL", devices[i].path);
+        }
+        else
+        {
+            printf(" %s: %3u%%", devices[i].path, loaderDeviceProgress(&devices[i]));
+        }
+    }
+    putchar('\r');
+    fflush(stdout);
+}
+
+int printReport(const loader_device_t* devices, int num_devices)
+{
+    int i;
+    int failed = 0;
+
+    puts("\n\nPort                 Device           Pages  Skipped  Protected  Time  Result");
+
+    for( i = 0; i < num_devices; i++ )
+    {
+        const loader_device_t* dev = &devices[i];
+
+        printf("%-20s %-16s %5u  %7u  %9u  %3lds  %s\n",
+               dev->path,
+               dev->target ? dev->target->name : "-",
+               dev->pages_total,
+               dev->pages_skipped,
+               dev->pages_protected,
+               (long)(dev->finished - dev->started),
+               dev->state == LOADER_STATE_DONE ? "OK" : dev->error);
+
+        if( dev->state != LOADER_STATE_DONE )
+        {
+            failed++;
+        }
+    }
+
+    printf("\n%d of %d boards updated\n", num_devices - failed, num_devices);
+
+    return failed;
+}
+
+/* entry point */
+
+int main(int argc, const char** argv)
+{
+    multiloader_args_t  args;
+    loader_image_t*     image = NULL;
+    loader_device_t*    devices = NULL;
+    struct pollfd*      fds = NULL;
+    int                 res, i, pending;
+
+    puts("+++++++++++++++++++++++++++++++++++++++++++++++");
+    puts("  Pirate-MultiLoader for BP with Bootloader v3/v4");
+    puts("  Loader version: " PIRATE_MULTILOADER_VERSION);
+    puts("+++++++++++++++++++++++++++++++++++++++++++++++\n");
+
+    if( (res = parseCommandLine(argc, argv, &args)) <= 0 )
+    {
+        return res;
+    }
+
+    image = (loader_image_t*)malloc(sizeof(loader_image_t));
+    devices = (loader_device_t*)calloc(args.num_ports, sizeof(loader_device_t));
+    fds = (struct pollfd*)calloc(args.num_ports, sizeof(struct pollfd));
+    if( !image || !devices || !fds )
+    {
+        fprintf(stderr, "Out of memory\n");
+        res = -1;
+        goto Finished;
+    }
+
+    printf("Parsing HEX file [%s]\n", args.hexfile_path);
+
+    if( loaderImageLoad(image, args.hexfile_path, args.family) < 0 )
+    {
+        fprintf(stderr, "Could not load HEX file\n");
+        res = -1;
+        goto Finished;
+    }
+
+    printf("Found %ld words (%ld bytes)\n", image->num_words, image->num_words * 3);
+    printf("Flashing %d boards\n\n", args.num_ports);
+
+    for( i = 0; i < args.num_ports; i++ )
+    {
+        loaderDeviceOpen(&devices[i], args.ports[i], image, &args.options);
+    }
+
+    do
+    {
+        pending = 0;
+
+        for( i = 0; i < args.num_ports; i++ )
+        {
+            fds[i].fd = loaderDeviceDone(&devices[i]) ? -1 : devices[i].fd;
+            fds[i].events = loaderDeviceEvents(&devices[i]);
+            fds[i].revents = 0;
+            pending += !loaderDeviceDone(&devices[i]);
+        }
+
+        if( pending == 0 )
+        {
+            break;
+        }
+
+        //wake up now and then even without events, to notice timeouts
+        if( poll(fds, args.num_ports, POLL_INTERVAL_MS) < 0 )
+        {
+            perror("poll");
+            res = -1;
+            goto Finished;
+        }
+
+        for( i = 0; i < args.num_ports; i++ )
+        {
+            loaderDeviceService(&devices[i], fds[i].revents);
+        }
+
+        printProgress(devices, args.num_ports, 0);
+    }
+    while( 1 );
+
+    printProgress(devices, args.num_ports, 1);
+    res = printReport(devices, args.num_ports) ? -1 : 0;
+
+Finished:
+    if( devices )
+    {
+        for( i = 0; i < args.num_ports; i++ )
+        {
+            loaderDeviceClose(&devices[i]);
+        }
+    }
+    free(fds);
+    free(devices);
+    free(image);
+    return res;
+}
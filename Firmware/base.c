@@ -23,12 +23,18 @@
 
 #include "base.h"
 #include "core.h"
+#include "scheduler.h"
 
 /**
  * @brief Prefix string for hexadecimal values in human-readable form.
  */
 static const uint8_t HEX_PREFIX[] = {'0', 'x'};
 
+/**
+ * @brief Prefix string for binary values in human-readable form.
+ */
+static const uint8_t BIN_PREFIX[] = {'0', 'b'};
+
 /**
  * @brief Look-up table for hexadecimal to ASCII transformations.
  */
@@ -36,6 +42,33 @@ static const unsigned char HEX_ASCII_TABLE[] = {'0', '1', '2', '3', '4', '5',
                                                 '6', '7', '8', '9', 'A', 'B',
                                                 'C', 'D', 'E', 'F'};
 
+/**
+ * @brief How many decimal digits are needed to represent a 32-bits value.
+ */
+#define DECIMAL_DIGITS 10
+
+/**
+ * @brief Index of the first entry in POWERS_OF_TEN whose digits can be
+ * extracted using 16-bits arithmetic only.
+ */
+#define FIRST_16_BITS_DIGIT 6
+
+/**
+ * @brief How often the continuous voltage probe refreshes its measurement, in
+ * microseconds.
+ */
+#define ADC_PROBE_PERIOD_US 250000
+
+/**
+ * @brief Powers of ten used to extract decimal digits by repeated subtraction.
+ *
+ * The PIC24 has no 32-bits hardware divider, so a division-based conversion
+ * ends up calling the compiler's software division routine once per digit.
+ * Subtracting each power of ten at most nine times is considerably cheaper.
+ */
+static const uint32_t POWERS_OF_TEN[DECIMAL_DIGITS] = {
+    1000000000, 100000000, 10000000, 1000000, 100000, 10000, 1000, 100, 10, 1};
+
 #if defined(BUSPIRATEV4)
 extern BYTE cdc_In_len;
 extern BYTE cdc_Out_len;
@@ -43,6 +76,7 @@ extern BYTE cdc_Out_len;
 
 extern bus_pirate_configuration_t bus_pirate_configuration;
 extern mode_configuration_t mode_configuration;
+extern bus_pirate_protocol_t enabled_protocols[ENABLED_PROTOCOLS_COUNT];
 
 #ifdef BUSPIRATEV3
 #pragma config FNOSC = FRCPLL
@@ -115,16 +149,16 @@ static const uint8_t REVERSED_BITS_TABLE[] = {
 static void clear_mode_configuration(void);
 
 /**
- * @brief Prints the given value to the serial port as a decimal number.
+ * @brief Converts the given value into its decimal ASCII representation,
+ * without leading zeroes.
  *
- * @warning the denominator *must* be equal to 10^digits.
+ * @param[in] value the value to convert.
+ * @param[out] buffer the buffer to write digits into, at least DECIMAL_DIGITS
+ * bytes long.
  *
- * @param[in] value the value to print.
- * @param[in] denominator the divisor to use when printing the value.
- * @param[in] digits how many digits to print.
+ * @return how many digits were written into the buffer.
  */
-static void print_decimal(const uint32_t value, const uint32_t denominator,
-                          const uint8_t digits);
+static size_t format_decimal(const uint32_t value, uint8_t *buffer);
 
 #ifdef BP_USE_HARDWARE_DELAY_TIMER
 
@@ -154,14 +188,56 @@ static inline void delay_short(uint16_t microseconds);
 
 #endif /* BP_USE_HARDWARE_DELAY_TIMER */
 
+/**
+ * @brief Takes a voltage probe measurement and prints it over the previous
+ * one.
+ *
+ * @return always true, as the measurement is written to the serial port.
+ */
+static bool adc_probe_task(void);
+
+#ifdef BUSPIRATEV3
+
+/**
+ * @brief Waits until the transmission interrupt has sent out everything that
+ * was appended to the user-facing serial ring buffer, so that direct writes
+ * to the serial port do not get interleaved with it.
+ */
+static inline void wait_for_ringbuffer_drain(void);
+
+/**
+ * @brief Moves characters from the user-facing serial ring buffer into the
+ * UART transmission FIFO until either is exhausted.
+ *
+ * Called from the transmission interrupt handler only.
+ */
+static void drain_ringbuffer(void);
+
+#endif /* BUSPIRATEV3 */
+
 void clear_mode_configuration(void) {
   mode_configuration.high_impedance = OFF;
   mode_configuration.speed = 0;
-  mode_configuration.periodicService = OFF;
+  bp_set_periodic_service_state(OFF);
   mode_configuration.alternate_aux = 0;
   mode_configuration.little_endian = NO;
 }
 
+void bp_set_periodic_service_state(const bool state) {
+  mode_configuration.periodicService = state;
+
+#ifdef BP_ENABLE_SCHEDULER
+  if (state == ON) {
+    bp_scheduler_start_task(
+        BP_SCHEDULER_TASK_PROTOCOL,
+        enabled_protocols[bus_pirate_configuration.bus_mode].periodic_update,
+        0);
+  } else {
+    bp_scheduler_stop_task(BP_SCHEDULER_TASK_PROTOCOL);
+  }
+#endif /* BP_ENABLE_SCHEDULER */
+}
+
 void bp_reset_board_state(void) {
   BP_MOSI_DIR = INPUT;
   BP_CLK_DIR = INPUT;
@@ -259,33 +335,52 @@ void bp_adc_probe(void) {
   bp_disable_adc();
 }
 
-void bp_adc_continuous_probe(void) {
+bool adc_probe_task(void) {
   uint16_t measurement;
 
+  /* Turn the ADC on. */
+  AD1CON1bits.ADON = ON;
+
+  /* Perform the measurement. */
+  measurement = bp_read_adc(BP_ADC_PROBE);
+
+  /* Turn the ADC off. */
+  AD1CON1bits.ADON = OFF;
+
+  /* Erase previous measurement. */
+  bp_write_string("\x08\x08\x08\x08\x08");
+
+  /* Print new measurement. */
+  bp_write_voltage(measurement);
+  MSG_VOLTAGE_UNIT;
+
+  return true;
+}
+
+void bp_adc_continuous_probe(void) {
+
   MSG_ADC_VOLTMETER_MODE;
   MSG_ANY_KEY_TO_EXIT_PROMPT;
   MSG_ADC_VOLTAGE_PROBE_HEADER;
   bp_write_voltage(0);
   MSG_VOLTAGE_UNIT;
 
+#ifdef BP_ENABLE_SCHEDULER
+  /* Refresh the measurement in the background until a key is pressed. */
+  bp_scheduler_start_task(BP_SCHEDULER_TASK_ADC_PROBE, adc_probe_task,
+                          ADC_PROBE_PERIOD_US);
+  while (!user_serial_ready_to_read()) {
+    if (!bp_scheduler_service()) {
+      bp_scheduler_wait();
+    }
+  }
+  bp_scheduler_stop_task(BP_SCHEDULER_TASK_ADC_PROBE);
+#else
   /* Perform ADC probes until a character is sent to the serial port. */
   while (!user_serial_ready_to_read()) {
-    /* Turn the ADC on. */
-    AD1CON1bits.ADON = ON;
-
-    /* Perform the measurement. */
-    measurement = bp_read_adc(BP_ADC_PROBE);
-
-    /* Turn the ADC off. */
-    AD1CON1bits.ADON = OFF;
-
-    /* Erase previous measurement. */
-    bp_write_string("\x08\x08\x08\x08\x08");
-
-    /* Print new measurement. */
-    bp_write_voltage(measurement);
-    MSG_VOLTAGE_UNIT;
+    adc_probe_task();
   }
+#endif /* BP_ENABLE_SCHEDULER */
 
   /* Flush the incoming serial buffer. */
   user_serial_read_byte();
@@ -376,8 +471,26 @@ uint16_t bp_reverse_integer(const uint16_t value, const uint8_t bits) {
 void bp_write_buffer(const uint8_t *buffer, const size_t length) {
   size_t offset;
 
+  /* Do not transmit if the board should be quiet. */
+  if (bus_pirate_configuration.quiet) {
+    return;
+  }
+
   for (offset = 0; offset < length; offset++) {
-    user_serial_transmit_character(buffer[offset]);
+#ifdef BUSPIRATEV4
+    putc_cdc(buffer[offset]);
+#else
+    /* Let pending ring buffer data out first. */
+    if (offset == 0) {
+      wait_for_ringbuffer_drain();
+    }
+
+    /* Wait until transmission can take place. */
+    while (U1STAbits.UTXBF == ON) {
+    }
+
+    U1TXREG = buffer[offset];
+#endif /* BUSPIRATEV4 */
   }
 }
 
@@ -396,108 +509,109 @@ void bp_write_line(const char *string) {
 }
 
 void bp_write_bin_byte(const uint8_t value) {
+  uint8_t buffer[sizeof(BIN_PREFIX) + 8];
   uint8_t mask = 0x80;
   size_t index;
 
-  MSG_BINARY_NUMBER_PREFIX;
-
-  for (index = 0; index < 8; index++) {
-    user_serial_transmit_character((value & mask) ? '1' : '0');
+  buffer[0] = BIN_PREFIX[0];
+  buffer[1] = BIN_PREFIX[1];
+  for (index = sizeof(BIN_PREFIX); index < sizeof(buffer); index++) {
+    buffer[index] = (value & mask) ? '1' : '0';
     mask >>= 1;
   }
+
+  bp_write_buffer(buffer, sizeof(buffer));
 }
 
 void bp_write_dec_dword_friendly(const uint32_t value) {
-  unsigned long int temp;
-  int mld, mil;
-  uint32_t number;
+  uint8_t digits[DECIMAL_DIGITS];
+  uint8_t buffer[DECIMAL_DIGITS + ((DECIMAL_DIGITS - 1) / 3)];
+  size_t length;
+  size_t group;
+  size_t offset;
+  size_t index;
 
-  number = value;
-  mld = 0;
-  mil = 0;
-  temp = 0;
-
-  if (number >= 1000000) {
-    temp = number / 1000000;
-    bp_write_dec_word(temp);
-    user_serial_transmit_character(',');
-    number %= 1000000;
-    if (number < 1000)
-      bp_write_string("000,");
-    mld = 1;
-    mil = 1;
-  }
-  if (number >= 1000) {
-    temp = number / 1000;
-    if (temp >= 100) {
-      bp_write_dec_word(temp);
-    } else if (mld) {
-      if (temp >= 10) {
-        user_serial_transmit_character('0'); // 1 leading zero
-      } else {
-        bp_write_string("00");
-      }
-      bp_write_dec_word(temp);
-    } else
-      bp_write_dec_word(temp);
-    user_serial_transmit_character(',');
-    number %= 1000;
-    mil = 1;
-  }
-  if (number >= 100) {
-    bp_write_dec_word(number);
-  } else if (mil) {
-    if (number >= 10) {
-      user_serial_transmit_character('0'); // 1 leading zero
-    } else {
-      bp_write_string("00");
+  length = format_decimal(value, digits);
+
+  /* The leftmost group can be shorter than three digits. */
+  group = length % 3;
+  if (group == 0) {
+    group = 3;
+  }
+
+  offset = 0;
+  for (index = 0; index < length; index++) {
+    if (group == 0) {
+      buffer[offset++] = ',';
+      group = 3;
     }
-    bp_write_dec_word(number);
-  } else
-    bp_write_dec_word(number);
+    buffer[offset++] = digits[index];
+    group--;
+  }
+
+  bp_write_buffer(buffer, offset);
 }
 
-void print_decimal(const uint32_t value, const uint32_t denominator,
-                   const uint8_t digits) {
+size_t format_decimal(const uint32_t value, uint8_t *buffer) {
   uint32_t number;
-  uint32_t divisor;
-  uint32_t current;
+  uint16_t short_number;
+  uint16_t power;
+  size_t length;
+  size_t index;
   uint8_t digit;
-  bool first;
 
-  first = false;
   number = value;
-  divisor = denominator;
+  length = 0;
 
-  if (!value) {
-    user_serial_transmit_character('0');
-    return;
+  /* Skip leading zeroes, but always emit at least one digit. */
+  index = 0;
+  while ((index < (DECIMAL_DIGITS - 1)) && (number < POWERS_OF_TEN[index])) {
+    index++;
   }
 
-  for (digit = 0; digit < digits; digit++) {
-    current = number / divisor;
-    if (first || (current > 0)) {
-      user_serial_transmit_character(current + '0');
-      number -= (current * divisor);
-      first = true;
+  /* The topmost digits need 32-bits arithmetic. */
+  for (; index < FIRST_16_BITS_DIGIT; index++) {
+    digit = '0';
+    while (number >= POWERS_OF_TEN[index]) {
+      number -= POWERS_OF_TEN[index];
+      digit++;
     }
+    buffer[length++] = digit;
+  }
 
-    divisor /= 10;
+  /* Whatever is left is less than 10000 and fits in 16 bits. */
+  short_number = (uint16_t)number;
+  for (; index < DECIMAL_DIGITS; index++) {
+    power = (uint16_t)POWERS_OF_TEN[index];
+    digit = '0';
+    while (short_number >= power) {
+      short_number -= power;
+      digit++;
+    }
+    buffer[length++] = digit;
   }
+
+  return length;
 }
 
 void bp_write_dec_dword(const uint32_t value) {
-  print_decimal(value, 10000000, 8);
+  uint8_t buffer[DECIMAL_DIGITS];
+
+  bp_write_buffer(buffer, format_decimal(value, buffer));
 }
 
-void bp_write_dec_word(const uint16_t value) { print_decimal(value, 10000, 5); }
+void bp_write_dec_word(const uint16_t value) { bp_write_dec_dword(value); }
 
-void bp_write_dec_byte(const uint8_t value) { print_decimal(value, 100, 3); }
+void bp_write_dec_byte(const uint8_t value) { bp_write_dec_dword(value); }
 
 void bp_write_hex_byte(const uint8_t value) {
-  MSG_HEXADECIMAL_NUMBER_PREFIX;
-  user_serial_transmit_character(HEX_ASCII_TABLE[(value >> 4) & 0x0F]);
-  user_serial_transmit_character(HEX_ASCII_TABLE[value & 0x0F]);
+  uint8_t buffer[sizeof(HEX_PREFIX) + 2];
+
+  buffer[0] = HEX_PREFIX[0];
+  buffer[1] = HEX_PREFIX[1];
+  buffer[2] = HEX_ASCII_TABLE[(value >> 4) & 0x0F];
+  buffer[3] = HEX_ASCII_TABLE[value & 0x0F];
+  bp_write_buffer(buffer, sizeof(buffer));
 }
 
 void bp_write_hex_byte_to_ringbuffer(const uint8_t value) {
@@ -508,11 +622,15 @@ void bp_write_hex_byte_to_ringbuffer(const uint8_t value) {
 }
 
 void bp_write_hex_word(const uint16_t value) {
-  MSG_HEXADECIMAL_NUMBER_PREFIX;
-  user_serial_transmit_character(HEX_ASCII_TABLE[(value >> 12) & 0x0F]);
-  user_serial_transmit_character(HEX_ASCII_TABLE[(value >> 8) & 0x0F]);
-  user_serial_transmit_character(HEX_ASCII_TABLE[(value >> 4) & 0x0F]);
-  user_serial_transmit_character(HEX_ASCII_TABLE[value & 0x0F]);
+  uint8_t buffer[sizeof(HEX_PREFIX) + 4];
+
+  buffer[0] = HEX_PREFIX[0];
+  buffer[1] = HEX_PREFIX[1];
+  buffer[2] = HEX_ASCII_TABLE[(value >> 12) & 0x0F];
+  buffer[3] = HEX_ASCII_TABLE[(value >> 8) & 0x0F];
+  buffer[4] = HEX_ASCII_TABLE[(value >> 4) & 0x0F];
+  buffer[5] = HEX_ASCII_TABLE[value & 0x0F];
+  bp_write_buffer(buffer, sizeof(buffer));
 }
 
 void bp_write_voltage(const uint16_t adc) {
@@ -529,15 +647,27 @@ void bp_write_voltage(const uint16_t adc) {
    */
   const uint16_t centivolts = (adc * 29) / 45;
 
-  uint8_t value;
+  uint8_t digits[DECIMAL_DIGITS];
+  uint8_t buffer[DECIMAL_DIGITS + 1];
+  size_t length;
+  size_t padding;
+  size_t offset;
+  size_t index;
+
+  length = format_decimal(centivolts, digits);
+
+  /* Pad with zeroes to always have one integer digit and two decimals. */
+  padding = (length < 3) ? (3 - length) : 0;
 
-  bp_write_dec_byte(centivolts / 100);
-  user_serial_transmit_character('.');
-  value = centivolts % 100;
-  if (value < 10) {
-    user_serial_transmit_character('0');
+  offset = 0;
+  for (index = 0; index < (padding + length); index++) {
+    if (index == (padding + length - 2)) {
+      buffer[offset++] = '.';
+    }
+    buffer[offset++] = (index < padding) ? '0' : digits[index - padding];
   }
-  bp_write_dec_byte(value);
+
+  bp_write_buffer(buffer, offset);
 }
 
 uint16_t bp_read_from_flash(const uint16_t page, const uint16_t address) {
@@ -637,12 +767,19 @@ void bp_delay_us(uint16_t microseconds) {
 /**
  * @brief User-facing serial ring buffer write pointer.
  */
-static uint16_t user_serial_ringbuffer_write;
+static volatile uint16_t user_serial_ringbuffer_write;
 
 /**
- * @brief User-facing serial ring buffer read pointer.
+ * @brief User-facing serial ring buffer read pointer, updated by the
+ * transmission interrupt handler.
  */
-static uint16_t user_serial_ringbuffer_read;
+static volatile uint16_t user_serial_ringbuffer_read;
+
+/**
+ * @brief Flag indicating whether the transmission interrupt is busy sending
+ * out the ring buffer content.
+ */
+static volatile bool user_serial_ringbuffer_draining = NO;
 
 #ifndef BP_ENABLE_UART_SUPPORT
 
@@ -715,40 +852,54 @@ bool user_serial_transmit_done(void) { return U1STAbits.TRMT; }
 bool user_serial_ready_to_read(void) { return U1STAbits.URXDA; }
 
 void user_serial_ringbuffer_setup(void) {
+  wait_for_ringbuffer_drain();
   user_serial_ringbuffer_read = 0;
   user_serial_ringbuffer_write = 1;
   bus_pirate_configuration.overflow = NO;
 }
 
 void user_serial_ringbuffer_process(void) {
+  /* Transmission is handled by the UART transmission interrupt. */
+}
+
+void user_serial_ringbuffer_flush(void) { wait_for_ringbuffer_drain(); }
+
+void user_serial_ringbuffer_append(const char character) {
   uint16_t index;
 
-  /* No free slots? */
-  if (U1STAbits.UTXBF == YES) {
+  if (user_serial_ringbuffer_write == user_serial_ringbuffer_read) {
+    BP_LEDMODE = LOW;
+    bus_pirate_configuration.overflow = YES;
     return;
   }
-  index = user_serial_ringbuffer_read + 1;
 
-  /* Wrap around if needed. */
+  bus_pirate_configuration.terminal_input[user_serial_ringbuffer_write] =
+      character;
+
+  /* Publish the new write position in a single store. */
+  index = user_serial_ringbuffer_write + 1;
   if (index == BP_TERMINAL_BUFFER_SIZE) {
     index = 0;
   }
+  user_serial_ringbuffer_write = index;
 
-  /* Nothing to do. */
-  if (index == user_serial_ringbuffer_write) {
-    return;
+  /* Trigger the transmission interrupt if it is not already running. */
+  if (!user_serial_ringbuffer_draining) {
+    user_serial_ringbuffer_draining = YES;
+    IFS0bits.U1TXIF = ON;
+    IEC0bits.U1TXIE = ON;
   }
+}
 
-  /* Send character to port. */
-  user_serial_ringbuffer_read = index;
-  U1TXREG =
-      bus_pirate_configuration.terminal_input[user_serial_ringbuffer_read];
+void wait_for_ringbuffer_drain(void) {
+  while (user_serial_ringbuffer_draining) {
+  }
 }
 
-void user_serial_ringbuffer_flush(void) {
+void drain_ringbuffer(void) {
   uint16_t index;
 
-  for (;;) {
+  while (U1STAbits.UTXBF == NO) {
     index = user_serial_ringbuffer_read + 1;
 
     /* Wrap around if needed. */
@@ -756,32 +907,15 @@ void user_serial_ringbuffer_flush(void) {
       index = 0;
     }
 
-    /* Nothing to do. */
+    /* Stop once everything has been sent. */
     if (index == user_serial_ringbuffer_write) {
+      IEC0bits.U1TXIE = OFF;
+      user_serial_ringbuffer_draining = NO;
       return;
     }
 
-    /* Send character. */
-    if (U1STAbits.UTXBF == NO) {
-      user_serial_ringbuffer_read = index;
-      U1TXREG =
-          bus_pirate_configuration.terminal_input[user_serial_ringbuffer_read];
-    }
-  }
-}
-
-void user_serial_ringbuffer_append(const char character) {
-  if (user_serial_ringbuffer_write == user_serial_ringbuffer_read) {
-    BP_LEDMODE = LOW;
-    bus_pirate_configuration.overflow = YES;
-    return;
-  }
-
-  bus_pirate_configuration.terminal_input[user_serial_ringbuffer_write] =
-      character;
-  user_serial_ringbuffer_write++;
-  if (user_serial_ringbuffer_write == BP_TERMINAL_BUFFER_SIZE) {
-    user_serial_ringbuffer_write = 0;
+    user_serial_ringbuffer_read = index;
+    U1TXREG = bus_pirate_configuration.terminal_input[index];
   }
 }
 
@@ -798,6 +932,9 @@ void user_serial_transmit_character(const char character) {
     return;
   }
 
+  /* Let pending ring buffer data out first. */
+  wait_for_ringbuffer_drain();
+
   /* Wait until transmission can take place. */
   while (U1STAbits.UTXBF == ON) {
   }
@@ -856,6 +993,12 @@ void __attribute__((interrupt, no_auto_psv)) _U1RXInterrupt(void) {
 }
 
 void __attribute__((interrupt, no_auto_psv)) _U1TXInterrupt(void) {
+  if (user_serial_ringbuffer_draining) {
+    IFS0bits.U1TXIF = OFF;
+    drain_ringbuffer();
+    return;
+  }
+
   UART1TXSent++;
   if (UART1TXSent == UART1TXAvailable) {
     IEC0bits.U1TXIE = NO;
@@ -132,6 +132,14 @@ uint16_t bp_reverse_word(const uint16_t value);
  */
 void bp_reset_board_state(void);
 
+/**
+ * @brief Turns the current protocol's periodic update calls on or off.
+ *
+ * @param[in] state ON to call the protocol's periodic update callback while
+ * idle, OFF to stop calling it.
+ */
+void bp_set_periodic_service_state(const bool state);
+
 /**
  * @brief Reads a value from the ADC on the given channel.
  *
@@ -437,20 +445,28 @@ void user_serial_transmit_character(const char character);
 void user_serial_ringbuffer_setup(void);
 
 /**
- * @brief Flushes the user-facing serial port ringbuffer.
+ * @brief Flushes the user-facing serial port ringbuffer, waiting until all of
+ * its content has been sent out.
  */
 void user_serial_ringbuffer_flush(void);
 
 /**
- * @brief Appends the given character to the user-facing serial port ringbuffer,
- * blocking until there is enough space.
+ * @brief Appends the given character to the user-facing serial port ringbuffer.
+ *
+ * If the ringbuffer is full the character is dropped and the overflow flag in
+ * the board configuration is set.
  *
  * @param[in] character the character to append.
  */
 void user_serial_ringbuffer_append(const char character);
 
 /**
- * @brief Transmits the first available character from the ringbuffer.
+ * @brief Transmits pending characters from the ringbuffer.
+ *
+ * On Bus Pirate v3 the ringbuffer is sent out by the UART transmission
+ * interrupt as soon as characters are appended, and on Bus Pirate v4 by the
+ * USB stack, so this does nothing.  It is kept so sniffers can still call it
+ * in their main loop.
  */
 void user_serial_ringbuffer_process(void);
 
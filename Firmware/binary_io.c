@@ -143,6 +143,7 @@ typedef enum {
   BITBANG_COMMAND_ADC_ONE_SHOT,
   BITBANG_COMMAND_ADC_CONTINUOUS,
   BITBANG_COMMAND_FREQUENCY_COUNT,
+  BITBANG_COMMAND_SET_SERIAL_SPEED,
   BITBANG_COMMAND_JTAG_XSVF = 0x18
 } bitbang_command;
 
@@ -276,6 +277,45 @@ static inline void handle_clear_pwm(void);
 static inline void handle_read_adc_one_shot(void);
 static inline void handle_read_adc_continuously(void);
 static inline void handle_frequency_measurement(void);
+
+#ifdef BP_ENABLE_BINARY_IO_SERIAL_SPEED
+
+/**
+ * @brief How long to wait for the host to confirm a new serial speed, in
+ * milliseconds.
+ */
+#define SERIAL_SPEED_HANDSHAKE_TIMEOUT_MS 100
+
+/**
+ * @brief How many bytes to look at for the start of the serial speed
+ * handshake sequence before giving up.
+ */
+#define SERIAL_SPEED_HANDSHAKE_ATTEMPTS 8
+
+/**
+ * @brief Waits for a byte from the user-facing serial port, up to the serial
+ * speed handshake timeout.
+ *
+ * @param[out] value the byte read, if any.
+ *
+ * @return true if a byte was read, false if the timeout expired.
+ */
+static bool read_handshake_byte(uint8_t *value);
+
+/**
+ * @brief Switches the user-facing serial port to a host-provided baud rate
+ * generator value.
+ *
+ * The command is followed by the two bytes of the new baud rate generator
+ * value, high byte first.  The Bus Pirate acknowledges the request at the old
+ * speed, switches over, and then waits for the host to send 0xAA 0x55 at the
+ * new speed.  If the sequence arrives in time the Bus Pirate answers 0x01 at
+ * the new speed, otherwise it silently goes back to the old speed.
+ */
+static inline void handle_set_serial_speed(void);
+
+#endif /* BP_ENABLE_BINARY_IO_SERIAL_SPEED */
+
 static inline void handle_bitbang_command(const bitbang_command command);
 
 static void read_and_transmit_adc_measurement(void);
@@ -347,6 +387,7 @@ Commands:
 00010010 // setup PWM
 00010011 // clear PWM
 00010100 // ADC measurement
+00010111 // Set serial port speed (v3 only)
 
 // Added JM  Only with BP4
 00010101 // ADC ....
@@ -482,6 +523,14 @@ void handle_bitbang_command(const bitbang_command command) {
     handle_frequency_measurement();
     break;
 
+  case BITBANG_COMMAND_SET_SERIAL_SPEED:
+#ifdef BP_ENABLE_BINARY_IO_SERIAL_SPEED
+    handle_set_serial_speed();
+#else
+    REPORT_IO_FAILURE();
+#endif /* BP_ENABLE_BINARY_IO_SERIAL_SPEED */
+    break;
+
   case BITBANG_COMMAND_JTAG_XSVF:
 #ifdef BUSPIRATEV4
     bp_enable_voltage_regulator();
@@ -502,6 +551,59 @@ void handle_bitbang_command(const bitbang_command command) {
   }
 }
 
+#ifdef BP_ENABLE_BINARY_IO_SERIAL_SPEED
+
+bool read_handshake_byte(uint8_t *value) {
+  uint16_t ticks;
+
+  for (ticks = 0; ticks < (SERIAL_SPEED_HANDSHAKE_TIMEOUT_MS * 10); ticks++) {
+    if (user_serial_ready_to_read()) {
+      *value = user_serial_read_byte();
+      return true;
+    }
+    bp_delay_us(100);
+  }
+
+  return false;
+}
+
+void handle_set_serial_speed(void) {
+  const uint16_t previous_rate = U1BRG;
+  uint16_t rate;
+  uint8_t value;
+  uint8_t attempts;
+
+  rate = user_serial_read_byte() << 8;
+  rate |= user_serial_read_byte();
+
+  /* A zero divisor would run the link faster than the FTDI chip can go. */
+  if (rate == 0) {
+    REPORT_IO_FAILURE();
+    return;
+  }
+
+  /* Acknowledge at the old speed, and let it out before switching over. */
+  REPORT_IO_SUCCESS();
+  user_serial_wait_transmission_done();
+  user_serial_set_baud_rate(rate);
+
+  /* Framing errors while the host catches up may show up as junk bytes. */
+  user_serial_clear_overflow();
+  for (attempts = 0; (attempts < SERIAL_SPEED_HANDSHAKE_ATTEMPTS) &&
+                     read_handshake_byte(&value);
+       attempts++) {
+    if ((value == 0xAA) && read_handshake_byte(&value) && (value == 0x55)) {
+      REPORT_IO_SUCCESS();
+      return;
+    }
+  }
+
+  user_serial_set_baud_rate(previous_rate);
+  user_serial_clear_overflow();
+}
+
+#endif /* BP_ENABLE_BINARY_IO_SERIAL_SPEED */
+
 void reset_state(void) {
   bp_disable_3v3_pullup();
   bitbang_pin_direction_set(0xFF);
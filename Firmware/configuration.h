@@ -544,6 +544,41 @@
 
 #endif /* BP_ENABLE_COMMAND_HISTORY */
 
+/**
+ * Enable the '+' command to repeat the last bus command line.
+ */
+#define BP_ENABLE_COMMAND_REPEAT
+
+#ifdef BP_ENABLE_COMMAND_REPEAT
+
+/**
+ * How many bus operations a compiled command line can hold.
+ */
+#ifdef BUSPIRATEV3
+#define BP_COMMAND_REPEAT_MAX_OPERATIONS 16
+#else
+#define BP_COMMAND_REPEAT_MAX_OPERATIONS 32
+#endif /* BUSPIRATEV3 */
+
+#endif /* BP_ENABLE_COMMAND_REPEAT */
+
+/**
+ * Store user-defined macros in program flash as precompiled bus operations,
+ * rather than as text in RAM.  Macros then survive resets, but can only hold
+ * bus operations.  Each macro takes a whole flash erase page (512 program
+ * words), and needs BP_ENABLE_COMMAND_REPEAT.
+ *
+ * Only enabled by default on v4, the v3 part has no spare flash pages for it
+ * and keeps the free-form text macros.
+ */
+#ifdef BUSPIRATEV4
+#define BP_ENABLE_FLASH_MACROS
+#endif /* BUSPIRATEV4 */
+
+#if defined(BP_ENABLE_FLASH_MACROS) && !defined(BP_ENABLE_COMMAND_REPEAT)
+#error "Flash macros need BP_ENABLE_COMMAND_REPEAT to be defined"
+#endif /* BP_ENABLE_FLASH_MACROS && !BP_ENABLE_COMMAND_REPEAT */
+
 /**
  * How many user-defined macros can be set.
  */
@@ -554,7 +589,7 @@
 #endif /* BUSPIRATEV3 */
 
 /**
- * Maximum length, in bytes of a user-defined macro.
+ * Maximum length, in bytes of a user-defined macro stored in RAM.
  */
 #ifdef BUSPIRATEV3
 #define BP_USER_MACRO_MAX_LENGTH 24
@@ -585,4 +620,28 @@
  */
 #define BP_USE_HARDWARE_DELAY_TIMER
 
+/**
+ * Run background tasks, such as the protocol periodic updates and the
+ * continuous voltage probe, from a cooperative scheduler timed by the delay
+ * timer rather than from busy loops.
+ */
+#define BP_ENABLE_SCHEDULER
+
+#if defined(BP_ENABLE_SCHEDULER) && !defined(BP_USE_HARDWARE_DELAY_TIMER)
+#error "The scheduler needs BP_USE_HARDWARE_DELAY_TIMER to be defined"
+#endif /* BP_ENABLE_SCHEDULER && !BP_USE_HARDWARE_DELAY_TIMER */
+
+#ifdef BUSPIRATEV3
+
+/**
+ * Let binary mode hosts raise the serial port speed from the BBIO root, with
+ * a handshake at the new speed and fallback to the old one.
+ *
+ * Bus Pirate v4 talks over USB CDC, where the serial port speed is
+ * meaningless.
+ */
+#define BP_ENABLE_BINARY_IO_SERIAL_SPEED
+
+#endif /* BUSPIRATEV3 */
+
 #endif /* !BP_CONFIGURATION_H */
@@ -256,6 +256,7 @@ typedef struct {
   bus_pirate_available_protocols_t bus_mode;
   uint8_t quiet : 1;
   uint8_t overflow : 1;
+  uint8_t batch_mode : 1;
 #ifdef BP_ENABLE_BASIC_SUPPORT
   uint8_t basic : 1;
 #endif /* BP_ENABLE_BASIC_SUPPORT */
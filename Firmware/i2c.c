@@ -473,6 +473,11 @@ void i2c_macro(unsigned int c) {
     break;
 
   case 2:
+    if (bus_pirate_configuration.batch_mode) {
+      /* The sniffer ring buffer would overwrite the batch script. */
+      mode_configuration.command_error = YES;
+      break;
+    }
     i2c_cleanup();
 
     MSG_SNIFFER_MESSAGE;
@@ -21,6 +21,7 @@
 #include "basic.h"
 #include "core.h"
 #include "proc_menu.h"
+#include "scheduler.h"
 #include "selftest.h"
 
 #ifdef BUSPIRATEV4
@@ -163,6 +164,11 @@ void initialize_board(void) {
   /* Set up delay timer. */
   bp_initialise_delay_timer();
 
+#ifdef BP_ENABLE_SCHEDULER
+  /* Set up background tasks scheduler. */
+  bp_scheduler_initialise();
+#endif /* BP_ENABLE_SCHEDULER */
+
   /* Set up the UART port pins. */
 
 #ifdef BUSPIRATEV3
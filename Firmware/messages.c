@@ -19,35 +19,109 @@
 
 #include "base.h"
 
+/**
+ * @brief How many decoded characters are collected before being sent out to
+ * the serial port.
+ */
+#define MESSAGE_BLOCK_SIZE 32
+
+/**
+ * @brief Reads a byte from a packed byte array stored in program memory.
+ *
+ * @param[in] address the program memory address the array starts at.
+ * @param[in] offset the index of the byte to read.
+ *
+ * @return the byte at the given position.
+ */
+static uint8_t read_packed_byte(const unsigned long address,
+                                const uint16_t offset);
+
+/**
+ * @brief Unpacks the three bytes held by the given program memory word.
+ *
+ * @param[in] address the program memory address of the word to read.
+ * @param[out] bytes the buffer to unpack the word into, three bytes long.
+ */
+static void read_packed_word(const unsigned long address, uint8_t *bytes);
+
+uint8_t read_packed_byte(const unsigned long address, const uint16_t offset) {
+  unsigned long word_address = address + ((offset / 3) << 1);
+
+  TBLPAG = (word_address >> 16) & 0xFF;
+  switch (offset % 3) {
+  case 0:
+    return LO8(__builtin_tblrdl(word_address));
+
+  case 1:
+    return HI8(__builtin_tblrdl(word_address));
+
+  default:
+    return LO8(__builtin_tblrdh(word_address));
+  }
+}
+
+void read_packed_word(const unsigned long address, uint8_t *bytes) {
+  uint16_t word;
+
+  TBLPAG = (address >> 16) & 0xFF;
+  word = __builtin_tblrdl(address);
+  bytes[0] = LO8(word);
+  bytes[1] = HI8(word);
+  bytes[2] = LO8(__builtin_tblrdh(address));
+}
+
 void bp_message_write_buffer(unsigned long strptr) {
   uint8_t tblpag_prev = TBLPAG;
-  uint8_t index = 0;
-  char ch = '\0';
-
-  do {
-    TBLPAG = (strptr >> 16) & 0xFF;
-    switch (index) {
-    case 0:
-      ch = LO8(__builtin_tblrdl(strptr));
-      index++;
-      break;
-
-    case 1:
-      ch = HI8(__builtin_tblrdl(strptr));
-      index++;
-      break;
+  uint8_t block[MESSAGE_BLOCK_SIZE];
+  uint8_t pending[BP_MESSAGE_TOKEN_DEPTH + 1];
+  uint8_t word[3];
+  uint8_t index = sizeof(word);
+  size_t length = 0;
+  uint16_t entry;
+  uint8_t depth;
+  uint8_t symbol;
 
-    case 2:
-      ch = LO8(__builtin_tblrdh(strptr));
+  for (;;) {
+    /* Fetch three bytes at once with a single table read pair. */
+    if (index == sizeof(word)) {
+      read_packed_word(strptr, word);
       strptr += 2;
       index = 0;
+    }
+
+    symbol = word[index++];
+    if (symbol == '\0') {
       break;
     }
 
-    if (ch != '\0') {
-      user_serial_transmit_character(ch);
+    /*
+     * Dictionary tokens expand into a pair of symbols, each one being either a
+     * plain character or another token.  Pending symbols are kept in a small
+     * stack whose size is bound by the maximum token nesting level.
+     */
+
+    pending[0] = symbol;
+    depth = 1;
+    while (depth > 0) {
+      symbol = pending[--depth];
+      if (symbol < BP_MESSAGE_FIRST_TOKEN) {
+        block[length++] = symbol;
+        if (length == sizeof(block)) {
+          bp_write_buffer(block, length);
+          length = 0;
+        }
+        continue;
+      }
+
+      entry = (symbol - BP_MESSAGE_FIRST_TOKEN) << 1;
+      pending[depth++] = read_packed_byte(BP_MESSAGE_DICTIONARY, entry + 1);
+      pending[depth++] = read_packed_byte(BP_MESSAGE_DICTIONARY, entry);
     }
-  } while (ch != '\0');
+  }
+
+  if (length > 0) {
+    bp_write_buffer(block, length);
+  }
 
   TBLPAG = tblpag_prev;
 }
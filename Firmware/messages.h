@@ -40,6 +40,9 @@ void print_help(void);
  * Prints a given byte array range from the packed string buffer to the serial
  * port.
  *
+ * Strings are stored in compressed form, with dictionary tokens being expanded
+ * on the fly using the shared dictionary generated by `packstrings.py`.
+ *
  * @param[in] strptr pointer to the string.
  */
 void bp_message_write_buffer(unsigned long strptr);
@@ -1,6 +1,11 @@
 #ifndef BP_MESSAGES_V3_H
 #define BP_MESSAGES_V3_H
 
+#define BP_MESSAGE_FIRST_TOKEN 0x80
+#define BP_MESSAGE_TOKEN_DEPTH 5
+void bp_message_dictionary(void);
+#define BP_MESSAGE_DICTIONARY __builtin_tbladdress(bp_message_dictionary)
+
 void BPMSG1022_str(void);
 #define BPMSG1022 bp_message_write_buffer(__builtin_tbladdress(BPMSG1022_str))
 void BPMSG1023_str(void);
@@ -323,6 +328,12 @@ void MSG_ANY_KEY_TO_EXIT_PROMPT_str(void);
 #define MSG_ANY_KEY_TO_EXIT_PROMPT bp_message_write_line(__builtin_tbladdress(MSG_ANY_KEY_TO_EXIT_PROMPT_str))
 void MSG_BASE_CONVERTER_EQUAL_SIGN_str(void);
 #define MSG_BASE_CONVERTER_EQUAL_SIGN bp_message_write_buffer(__builtin_tbladdress(MSG_BASE_CONVERTER_EQUAL_SIGN_str))
+void MSG_BATCH_MODE_DONE_str(void);
+#define MSG_BATCH_MODE_DONE bp_message_write_line(__builtin_tbladdress(MSG_BATCH_MODE_DONE_str))
+void MSG_BATCH_MODE_READY_str(void);
+#define MSG_BATCH_MODE_READY bp_message_write_line(__builtin_tbladdress(MSG_BATCH_MODE_READY_str))
+void MSG_BATCH_MODE_SCRIPT_TOO_LONG_str(void);
+#define MSG_BATCH_MODE_SCRIPT_TOO_LONG bp_message_write_line(__builtin_tbladdress(MSG_BATCH_MODE_SCRIPT_TOO_LONG_str))
 void MSG_BBIO_MODE_IDENTIFIER_str(void);
 #define MSG_BBIO_MODE_IDENTIFIER bp_message_write_buffer(__builtin_tbladdress(MSG_BBIO_MODE_IDENTIFIER_str))
 void MSG_BINARY_NUMBER_PREFIX_str(void);
@@ -483,6 +494,8 @@ void MSG_RAW_MODE_IDENTIFIER_str(void);
 #define MSG_RAW_MODE_IDENTIFIER bp_message_write_buffer(__builtin_tbladdress(MSG_RAW_MODE_IDENTIFIER_str))
 void MSG_READ_HEADER_str(void);
 #define MSG_READ_HEADER bp_message_write_buffer(__builtin_tbladdress(MSG_READ_HEADER_str))
+void MSG_REPEAT_NO_COMMAND_LINE_str(void);
+#define MSG_REPEAT_NO_COMMAND_LINE bp_message_write_line(__builtin_tbladdress(MSG_REPEAT_NO_COMMAND_LINE_str))
 void MSG_SNIFFER_MESSAGE_str(void);
 #define MSG_SNIFFER_MESSAGE bp_message_write_line(__builtin_tbladdress(MSG_SNIFFER_MESSAGE_str))
 void MSG_SOFTWARE_MODE_SPEED_PROMPT_str(void);
@@ -563,6 +576,8 @@ void MSG_UART_WAITING_ACTIVITY_str(void);
 #define MSG_UART_WAITING_ACTIVITY bp_message_write_line(__builtin_tbladdress(MSG_UART_WAITING_ACTIVITY_str))
 void MSG_UNKNOWN_MACRO_ERROR_str(void);
 #define MSG_UNKNOWN_MACRO_ERROR bp_message_write_line(__builtin_tbladdress(MSG_UNKNOWN_MACRO_ERROR_str))
+void MSG_USER_MACRO_STORAGE_FULL_str(void);
+#define MSG_USER_MACRO_STORAGE_FULL bp_message_write_line(__builtin_tbladdress(MSG_USER_MACRO_STORAGE_FULL_str))
 void MSG_VOLTAGE_UNIT_str(void);
 #define MSG_VOLTAGE_UNIT bp_message_write_buffer(__builtin_tbladdress(MSG_VOLTAGE_UNIT_str))
 void MSG_VREG_TOO_LOW_str(void);
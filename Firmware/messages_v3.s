@@ -1,170 +1,304 @@
+	; Message dictionary
+	; <128> "\r\n"
+	; <129> "--"
+	; <130> "\r\n "
+	; <131> "e "
+	; <132> ". "
+	; <133> "t "
+	; <134> "o "
+	; <135> "----"
+	; <136> "er"
+	; <137> " ("
+	; <138> "in"
+	; <139> "s "
+	; <140> "en"
+	; <141> "it"
+	; <142> "\t\t"
+	; <143> "on"
+	; <144> "or"
+	; <145> ", "
+	; <146> "re"
+	; <147> ": "
+	; <148> "ac"
+	; <149> "d "
+	; <150> "Hz"
+	; <151> "\r\n 2"
+	; <152> "ar"
+	; <153> "an"
+	; <154> "de"
+	; <155> "00"
+	; <156> "RE"
+	; <157> "\r\n 1"
+	; <158> "AR"
+	; <159> "lo"
+	; <160> "le "
+	; <161> "st"
+	; <162> "--------"
+	; <163> "ul"
+	; <164> "y "
+	; <165> "RO"
+	; <166> "ed"
+	; <167> "hi"
+	; <168> "sp"
+	; <169> "\r\n 2. "
+	; <170> "\r\n 1. "
+	; <171> ") "
+	; <172> "AT"
+	; <173> "Se"
+	; <174> "ad"
+	; <175> "al"
+	; <176> "to "
+	; <177> " s"
+	; <178> ":\r\n 1. "
+	; <179> "AD"
+	; <180> "ti"
+	; <181> "acr"
+	; <182> ")\t"
+	; <183> "0x"
+	; <184> "KHz"
+	; <185> "es"
+	; <186> "at"
+	; <187> "ol"
+	; <188> "p "
+	; <189> "ut"
+	; <190> "acro "
+	; <191> " *"
+	; <192> "CL"
+	; <193> "CS"
+	; <194> "SE"
+	; <195> "ex"
+	; <196> "g "
+	; <197> "mo"
+	; <198> "\r\n1"
+	; <199> "Set "
+	; <200> ".("
+	; <201> "AU"
+	; <202> "Macro "
+	; <203> "dle "
+	; <204> "ff"
+	; <205> "ic"
+	; <206> "it "
+	; <207> " (0x"
+	; <208> "\t\t\t"
+	; <209> "AUX"
+	; <210> "\tS"
+	; <211> "  "
+	; <212> "16"
+	; <213> "3."
+	; <214> "CH"
+	; <215> "IS"
+	; <216> "MHz"
+	; <217> "ON"
+	; <218> "PU"
+	; <219> "as"
+	; <220> "ch"
+	; <221> "men"
+	; <222> "no"
+	; <223> "to"
+	; <224> "low"
+	; <225> "ROM"
+	; <226> " 0"
+	; <227> " L"
+	; <228> " p"
+	; <229> " ROM"
+	; <230> "2C"
+	; <231> "CK"
+	; <232> "DE"
+	; <233> "DAT"
+	; <234> "Hi"
+	; <235> "IN"
+	; <236> "I2C"
+	; <237> "MO"
+	; <238> "ND"
+	; <239> "et"
+	; <240> "le"
+	; <241> "mm"
+	; <242> "ro"
+	; <243> "tr"
+	; <244> "us"
+	; <245> "acti"
+	; <246> "----------------"
+	; <247> "\t-"
+	; <248> " B"
+	; <249> " S"
+	; <250> " c"
+	; <251> "ER"
+	; <252> "OW"
+	; <253> "PI"
+	; <254> "Re"
+	; <255> "aul"
+	.section .text.bp_message_dictionary, code
+	.global _bp_message_dictionary
+_bp_message_dictionary:
+	.pbyte 0x0D, 0x0A, 0x2D, 0x2D, 0x80, 0x20, 0x65, 0x20, 0x2E, 0x20, 0x74, 0x20, 0x6F, 0x20, 0x81, 0x81, 0x65, 0x72, 0x20, 0x28, 0x69, 0x6E, 0x73, 0x20, 0x65, 0x6E, 0x69, 0x74, 0x09, 0x09, 0x6F, 0x6E, 0x6F, 0x72, 0x2C, 0x20, 0x72, 0x65, 0x3A, 0x20, 0x61, 0x63, 0x64, 0x20, 0x48, 0x7A, 0x82, 0x32, 0x61, 0x72, 0x61, 0x6E, 0x64, 0x65, 0x30, 0x30, 0x52, 0x45, 0x82, 0x31, 0x41, 0x52, 0x6C, 0x6F, 0x6C, 0x83, 0x73, 0x74, 0x87, 0x87, 0x75, 0x6C, 0x79, 0x20, 0x52, 0x4F, 0x65, 0x64, 0x68, 0x69, 0x73, 0x70, 0x97, 0x84, 0x9D, 0x84, 0x29, 0x20, 0x41, 0x54, 0x53, 0x65, 0x61, 0x64, 0x61, 0x6C, 0x74, 0x86, 0x20, 0x73, 0x3A, 0xAA, 0x41, 0x44, 0x74, 0x69, 0x94, 0x72, 0x29, 0x09, 0x30, 0x78, 0x4B, 0x96, 0x65, 0x73, 0x61, 0x74, 0x6F, 0x6C, 0x70, 0x20, 0x75, 0x74, 0xB5, 0x86, 0x20, 0x2A, 0x43, 0x4C, 0x43, 0x53, 0x53, 0x45, 0x65, 0x78, 0x67, 0x20, 0x6D, 0x6F, 0x80, 0x31, 0xAD, 0x85, 0x2E, 0x28, 0x41, 0x55, 0x4D, 0xBE, 0x64, 0xA0, 0x66, 0x66, 0x69, 0x63, 0x69, 0x85, 0x89, 0xB7, 0x8E, 0x09, 0xC9, 0x58, 0x09, 0x53, 0x20, 0x20, 0x31, 0x36, 0x33, 0x2E, 0x43, 0x48, 0x49, 0x53, 0x4D, 0x96, 0x4F, 0x4E, 0x50, 0x55, 0x61, 0x73, 0x63, 0x68, 0x6D, 0x8C, 0x6E, 0x6F, 0x74, 0x6F, 0x9F, 0x77, 0xA5, 0x4D, 0x20, 0x30, 0x20, 0x4C, 0x20, 0x70, 0x20, 0xE1, 0x32, 0x43, 0x43, 0x4B, 0x44, 0x45, 0x44, 0xAC, 0x48, 0x69, 0x49, 0x4E, 0x49, 0xE6, 0x4D, 0x4F, 0x4E, 0x44, 0x65, 0x74, 0x6C, 0x65, 0x6D, 0x6D, 0x72, 0x6F, 0x74, 0x72, 0x75, 0x73, 0x94, 0xB4, 0xA2, 0xA2, 0x09, 0x2D, 0x20, 0x42, 0x20, 0x53, 0x20, 0x63, 0x45, 0x52, 0x4F, 0x57, 0x50, 0x49, 0x52, 0x65, 0x61, 0xA3
+
 	; BPMSG1022
 	.section .text.BPMSG1022, code
 	.global _BPMSG1022_str
 _BPMSG1022_str:
-	.pasciz "DS18S20 High Prec Dig Therm"
+	.pasciz "DS18S20 ", <234>, "gh P", <146>, "c Di", <196>, "Th", <136>, "m"
 
 	; BPMSG1023
 	.section .text.BPMSG1023, code
 	.global _BPMSG1023_str
 _BPMSG1023_str:
-	.pasciz "DS18B20 Prog Res Dig Therm"
+	.pasciz "DS18B20 P", <242>, <196>, <254>, <139>, "Di", <196>, "Th", <136>, "m"
 
 	; BPMSG1024
 	.section .text.BPMSG1024, code
 	.global _BPMSG1024_str
 _BPMSG1024_str:
-	.pasciz "DS1822 Econo Dig Therm"
+	.pasciz "DS1822 Ec", <143>, <134>, "Di", <196>, "Th", <136>, "m"
 
 	; BPMSG1025
 	.section .text.BPMSG1025, code
 	.global _BPMSG1025_str
 _BPMSG1025_str:
-	.pasciz "DS2404 EconoRAM time Chip"
+	.pasciz "DS2404 Ec", <143>, "oRAM ", <180>, "m", <131>, "C", <167>, "p"
 
 	; BPMSG1026
 	.section .text.BPMSG1026, code
 	.global _BPMSG1026_str
 _BPMSG1026_str:
-	.pasciz "DS2431 1K EEPROM"
+	.pasciz "DS2431 1K EEP", <225>
 
 	; BPMSG1027
 	.section .text.BPMSG1027, code
 	.global _BPMSG1027_str
 _BPMSG1027_str:
-	.pasciz "Unknown device"
+	.pasciz "Unk", <222>, "wn ", <154>, "v", <205>, "e"
 
 	; BPMSG1028
 	.section .text.BPMSG1028, code
 	.global _BPMSG1028_str
 _BPMSG1028_str:
-	.pasciz "PWM disabled"
+	.pasciz "PWM disabl", <166>
 
 	; BPMSG1029
 	.section .text.BPMSG1029, code
 	.global _BPMSG1029_str
 _BPMSG1029_str:
-	.pasciz "1KHz-4,000KHz PWM"
+	.pasciz "1", <184>, "-4,", <155>, "0", <184>, " PWM"
 
 	; BPMSG1030
 	.section .text.BPMSG1030, code
 	.global _BPMSG1030_str
 _BPMSG1030_str:
-	.pasciz "Frequency in KHz "
+	.pasciz "F", <146>, "qu", <140>, "c", <164>, <138>, " ", <184>, " "
 
 	; BPMSG1033
 	.section .text.BPMSG1033, code
 	.global _BPMSG1033_str
 _BPMSG1033_str:
-	.pasciz "Duty cycle in % "
+	.pasciz "D", <189>, <164>, "cyc", <160>, <138>, " % "
 
 	; BPMSG1034
 	.section .text.BPMSG1034, code
 	.global _BPMSG1034_str
 _BPMSG1034_str:
-	.pasciz "PWM active"
+	.pasciz "PWM ", <245>, "ve"
 
 	; BPMSG1037
 	.section .text.BPMSG1037, code
 	.global _BPMSG1037_str
 _BPMSG1037_str:
-	.pasciz "ERROR: PWM active, g to disable"
+	.pasciz <251>, <165>, "R", <147>, "PWM ", <245>, "ve", <145>, <196>, <176>, "disab", <240>
 
 	; BPMSG1038
 	.section .text.BPMSG1038, code
 	.global _BPMSG1038_str
 _BPMSG1038_str:
-	.pasciz "AUX Frequency: "
+	.pasciz <209>, " F", <146>, "qu", <140>, "cy", <147>
 
 	; BPMSG1039
 	.section .text.BPMSG1039, code
 	.global _BPMSG1039_str
 _BPMSG1039_str:
-	.pasciz "AUX INPUT/HI-Z"
+	.pasciz <209>, " ", <235>, <218>, "T/HI-Z"
 
 	; BPMSG1040
 	.section .text.BPMSG1040, code
 	.global _BPMSG1040_str
 _BPMSG1040_str:
-	.pasciz "AUX HIGH"
+	.pasciz <209>, " HIGH"
 
 	; BPMSG1041
 	.section .text.BPMSG1041, code
 	.global _BPMSG1041_str
 _BPMSG1041_str:
-	.pasciz "AUX LOW"
+	.pasciz <209>, <227>, <252>
 
 	; BPMSG1047
 	.section .text.BPMSG1047, code
 	.global _BPMSG1047_str
 _BPMSG1047_str:
-	.pasciz "Error("
+	.pasciz "Err", <144>, "("
 
 	; BPMSG1048
 	.section .text.BPMSG1048, code
 	.global _BPMSG1048_str
 _BPMSG1048_str:
-	.pasciz ") @line:"
+	.pasciz <171>, "@l", <138>, "e:"
 
 	; BPMSG1049
 	.section .text.BPMSG1049, code
 	.global _BPMSG1049_str
 _BPMSG1049_str:
-	.pasciz " @pgmspace:"
+	.pasciz " @pgm", <168>, <148>, "e:"
 
 	; BPMSG1050
 	.section .text.BPMSG1050, code
 	.global _BPMSG1050_str
 _BPMSG1050_str:
-	.pasciz " bytes."
+	.pasciz " byt", <185>, "."
 
 	; BPMSG1051
 	.section .text.BPMSG1051, code
 	.global _BPMSG1051_str
 _BPMSG1051_str:
-	.pasciz "Too long!"
+	.pasciz "To", <134>, "l", <143>, "g!"
 
 	; BPMSG1052
 	.section .text.BPMSG1052, code
 	.global _BPMSG1052_str
 _BPMSG1052_str:
-	.pasciz "Syntax error"
+	.pasciz "Syntax ", <136>, "r", <144>
 
 	; BPMSG1064
 	.section .text.BPMSG1064, code
 	.global _BPMSG1064_str
 _BPMSG1064_str:
-	.pasciz "I2C mode:\r\n 1. Software\r\n 2. Hardware"
+	.pasciz <236>, " ", <197>, <154>, <178>, "Softwa", <146>, <169>, "H", <152>, "dwa", <146>
 
 	; BPMSG1066
 	.section .text.BPMSG1066, code
 	.global _BPMSG1066_str
 _BPMSG1066_str:
-	.pasciz "WARNING: HARDWARE I2C is broken on this PIC! (REV A3)"
+	.pasciz "W", <158>, "N", <235>, "G", <147>, "H", <158>, "DWA", <156>, " ", <236>, " i", <139>, "b", <242>, "k", <140>, " ", <143>, " t", <167>, <139>, <253>, "C!", <137>, <156>, "V A3)"
 
 	; BPMSG1067
 	.section .text.BPMSG1067, code
 	.global _BPMSG1067_str
 _BPMSG1067_str:
-	.pasciz "Set speed:\r\n 1. 100KHz\r\n 2. 400KHz\r\n 3. 1MHz"
+	.pasciz <199>, <168>, "e", <166>, <178>, "1", <155>, <184>, <169>, "4", <155>, <184>, <130>, "3", <132>, "1", <216>
 
 	; BPMSG1068
 	.section .text.BPMSG1068, code
 	.global _BPMSG1068_str
 _BPMSG1068_str:
-	.pasciz "I2C (mod spd)=( "
+	.pasciz <236>, <137>, <197>, <149>, <168>, "d)=( "
 
 	; BPMSG1069
 	.section .text.BPMSG1069, code
 	.global _BPMSG1069_str
 _BPMSG1069_str:
-	.pasciz " 0.Macro menu\r\n 1.7bit address search\r\n 2.I2C sniffer"
+	.pasciz <226>, ".", <202>, <221>, "u", <157>, ".7b", <206>, <174>, "d", <146>, "s", <139>, "se", <152>, <220>, <151>, ".", <236>, <177>, "ni", <204>, <136>
 
 	; BPMSG1070
 	.section .text.BPMSG1070, code
 	.global _BPMSG1070_str
 _BPMSG1070_str:
-	.pasciz "Searching I2C address space. Found devices at:"
+	.pasciz <173>, <152>, <220>, <138>, <196>, <236>, " ", <174>, "d", <146>, "s", <139>, <168>, <148>, "e", <132>, "Foun", <149>, <154>, "v", <205>, "e", <139>, <186>, ":"
 
 	; BPMSG1084
 	.section .text.BPMSG1084, code
@@ -176,229 +310,229 @@ _BPMSG1084_str:
 	.section .text.BPMSG1085, code
 	.global _BPMSG1085_str
 _BPMSG1085_str:
-	.pasciz "Ready"
+	.pasciz <254>, <174>, "y"
 
 	; BPMSG1086
 	.section .text.BPMSG1086, code
 	.global _BPMSG1086_str
 _BPMSG1086_str:
-	.pasciz "a/A/@ controls AUX pin"
+	.pasciz "a/A/@", <250>, <143>, <243>, <187>, <139>, <209>, <228>, <138>
 
 	; BPMSG1087
 	.section .text.BPMSG1087, code
 	.global _BPMSG1087_str
 _BPMSG1087_str:
-	.pasciz "a/A/@ controls CS pin"
+	.pasciz "a/A/@", <250>, <143>, <243>, <187>, <139>, <193>, <228>, <138>
 
 	; BPMSG1088
 	.section .text.BPMSG1088, code
 	.global _BPMSG1088_str
 _BPMSG1088_str:
-	.pasciz "Command not used in this mode"
+	.pasciz "Co", <241>, <153>, <149>, <222>, <133>, <244>, "e", <149>, <138>, " t", <167>, <139>, <197>, <154>
 
 	; BPMSG1089
 	.section .text.BPMSG1089, code
 	.global _BPMSG1089_str
 _BPMSG1089_str:
-	.pasciz "Pull-up resistors OFF"
+	.pasciz "P", <163>, "l-u", <188>, <146>, "si", <161>, <144>, <139>, "OFF"
 
 	; BPMSG1091
 	.section .text.BPMSG1091, code
 	.global _BPMSG1091_str
 _BPMSG1091_str:
-	.pasciz "Pull-up resistors ON"
+	.pasciz "P", <163>, "l-u", <188>, <146>, "si", <161>, <144>, <139>, <217>
 
 	; BPMSG1092
 	.section .text.BPMSG1092, code
 	.global _BPMSG1092_str
 _BPMSG1092_str:
-	.pasciz "Self-test in HiZ mode only"
+	.pasciz <173>, "lf-t", <185>, <133>, <138>, " ", <234>, "Z ", <197>, "d", <131>, <143>, "ly"
 
 	; BPMSG1093
 	.section .text.BPMSG1093, code
 	.global _BPMSG1093_str
 _BPMSG1093_str:
-	.pasciz "RESET"
+	.pasciz <156>, <194>, "T"
 
 	; BPMSG1094
 	.section .text.BPMSG1094, code
 	.global _BPMSG1094_str
 _BPMSG1094_str:
-	.pasciz "BOOTLOADER"
+	.pasciz "BOOTLO", <179>, <251>
 
 	; BPMSG1095
 	.section .text.BPMSG1095, code
 	.global _BPMSG1095_str
 _BPMSG1095_str:
-	.pasciz "AUX INPUT/HI-Z, READ: "
+	.pasciz <209>, " ", <235>, <218>, "T/HI-Z", <145>, <156>, <179>, <147>
 
 	; BPMSG1098
 	.section .text.BPMSG1098, code
 	.global _BPMSG1098_str
 _BPMSG1098_str:
-	.pasciz "DATA STATE: "
+	.pasciz <233>, "A", <249>, "T", <172>, "E", <147>
 
 	; BPMSG1099
 	.section .text.BPMSG1099, code
 	.global _BPMSG1099_str
 _BPMSG1099_str:
-	.pasciz "DELAY "
+	.pasciz <232>, "LAY "
 
 	; BPMSG1100
 	.section .text.BPMSG1100, code
 	.global _BPMSG1100_str
 _BPMSG1100_str:
-	.pasciz "us"
+	.pasciz <244>
 
 	; BPMSG1101
 	.section .text.BPMSG1101, code
 	.global _BPMSG1101_str
 _BPMSG1101_str:
-	.pasciz "WRITE: "
+	.pasciz "WRITE", <147>
 
 	; BPMSG1103
 	.section .text.BPMSG1103, code
 	.global _BPMSG1103_str
 _BPMSG1103_str:
-	.pasciz "CLOCK, 1"
+	.pasciz <192>, "O", <231>, <145>, "1"
 
 	; BPMSG1104
 	.section .text.BPMSG1104, code
 	.global _BPMSG1104_str
 _BPMSG1104_str:
-	.pasciz "CLOCK, 0"
+	.pasciz <192>, "O", <231>, <145>, "0"
 
 	; BPMSG1105
 	.section .text.BPMSG1105, code
 	.global _BPMSG1105_str
 _BPMSG1105_str:
-	.pasciz "DATA OUTPUT, 1"
+	.pasciz <233>, "A OUT", <218>, "T", <145>, "1"
 
 	; BPMSG1106
 	.section .text.BPMSG1106, code
 	.global _BPMSG1106_str
 _BPMSG1106_str:
-	.pasciz "DATA OUTPUT, 0"
+	.pasciz <233>, "A OUT", <218>, "T", <145>, "0"
 
 	; BPMSG1107
 	.section .text.BPMSG1107, code
 	.global _BPMSG1107_str
 _BPMSG1107_str:
-	.pasciz " *pin is now HiZ"
+	.pasciz <191>, "p", <138>, " i", <139>, <222>, "w ", <234>, "Z"
 
 	; BPMSG1108
 	.section .text.BPMSG1108, code
 	.global _BPMSG1108_str
 _BPMSG1108_str:
-	.pasciz "CLOCK TICKS: "
+	.pasciz <192>, "O", <231>, " TI", <231>, "S", <147>
 
 	; BPMSG1109
 	.section .text.BPMSG1109, code
 	.global _BPMSG1109_str
 _BPMSG1109_str:
-	.pasciz "READ BIT: "
+	.pasciz <156>, <179>, <248>, "IT", <147>
 
 	; BPMSG1110
 	.section .text.BPMSG1110, code
 	.global _BPMSG1110_str
 _BPMSG1110_str:
-	.pasciz "Syntax error at char "
+	.pasciz "Syntax ", <136>, "r", <144>, " a", <133>, <220>, <152>, " "
 
 	; BPMSG1111
 	.section .text.BPMSG1111, code
 	.global _BPMSG1111_str
 _BPMSG1111_str:
-	.pasciz "x. exit(without change)"
+	.pasciz "x", <132>, <195>, <141>, "(w", <141>, "hou", <133>, <220>, <153>, "ge)"
 
 	; BPMSG1112
 	.section .text.BPMSG1112, code
 	.global _BPMSG1112_str
 _BPMSG1112_str:
-	.pasciz "no mode change"
+	.pasciz "n", <134>, <197>, "d", <131>, <220>, <153>, "ge"
 
 	; BPMSG1114
 	.section .text.BPMSG1114, code
 	.global _BPMSG1114_str
 _BPMSG1114_str:
-	.pasciz "Nonexistent protocol!"
+	.pasciz "N", <143>, <195>, "i", <161>, <140>, <133>, "p", <242>, <223>, "c", <187>, "!"
 
 	; BPMSG1115
 	.section .text.BPMSG1115, code
 	.global _BPMSG1115_str
 _BPMSG1115_str:
-	.pasciz "x. exit"
+	.pasciz "x", <132>, <195>, <141>
 
 	; BPMSG1117
 	.section .text.BPMSG1117, code
 	.global _BPMSG1117_str
 _BPMSG1117_str:
-	.pasciz "DEVID:"
+	.pasciz <232>, "VID:"
 
 	; BPMSG1118
 	.section .text.BPMSG1118, code
 	.global _BPMSG1118_str
 _BPMSG1118_str:
-	.pasciz "http://dangerousprototypes.com"
+	.pasciz "http://d", <153>, "g", <136>, "ou", <168>, <242>, <223>, "typ", <185>, ".com"
 
 	; BPMSG1119
 	.section .text.BPMSG1119, code
 	.global _BPMSG1119_str
 _BPMSG1119_str:
-	.pasciz "*----------*"
+	.pasciz "*", <162>, <129>, "*"
 
 	; BPMSG1120
 	.section .text.BPMSG1120, code
 	.global _BPMSG1120_str
 _BPMSG1120_str:
-	.pasciz "Open drain outputs (H=Hi-Z, L=GND)"
+	.pasciz "Op", <140>, " dra", <138>, " o", <189>, "p", <189>, "s", <137>, "H=", <234>, "-Z", <145>, "L=G", <238>, ")"
 
 	; BPMSG1121
 	.section .text.BPMSG1121, code
 	.global _BPMSG1121_str
 _BPMSG1121_str:
-	.pasciz "Normal outputs (H=3.3v, L=GND)"
+	.pasciz "N", <144>, "m", <175>, " o", <189>, "p", <189>, "s", <137>, "H=", <213>, "3v", <145>, "L=G", <238>, ")"
 
 	; BPMSG1123
 	.section .text.BPMSG1123, code
 	.global _BPMSG1123_str
 _BPMSG1123_str:
-	.pasciz "MSB set: MOST sig bit first"
+	.pasciz "MSB", <177>, <239>, <147>, <237>, "ST", <177>, "i", <196>, "b", <206>, "fir", <161>
 
 	; BPMSG1124
 	.section .text.BPMSG1124, code
 	.global _BPMSG1124_str
 _BPMSG1124_str:
-	.pasciz "LSB set: LEAST sig bit first"
+	.pasciz "LSB", <177>, <239>, <147>, "LEAST", <177>, "i", <196>, "b", <206>, "fir", <161>
 
 	; BPMSG1126
 	.section .text.BPMSG1126, code
 	.global _BPMSG1126_str
 _BPMSG1126_str:
-	.pasciz " Bootloader v"
+	.pasciz <248>, "oot", <159>, <174>, <136>, " v"
 
 	; BPMSG1127
 	.section .text.BPMSG1127, code
 	.global _BPMSG1127_str
 _BPMSG1127_str:
-	.pasciz " 1. HEX\r\n 2. DEC\r\n 3. BIN\r\n 4. RAW"
+	.pasciz " 1", <132>, "HEX", <169>, <232>, "C", <130>, "3", <132>, "B", <235>, <130>, "4", <132>, "RAW"
 
 	; BPMSG1128
 	.section .text.BPMSG1128, code
 	.global _BPMSG1128_str
 _BPMSG1128_str:
-	.pasciz "Display format set"
+	.pasciz "Di", <168>, "la", <164>, "f", <144>, "ma", <133>, "s", <239>
 
 	; BPMSG1134
 	.section .text.BPMSG1134, code
 	.global _BPMSG1134_str
 _BPMSG1134_str:
-	.pasciz "Adjust your terminal"
+	.pasciz "Adj", <244>, <133>, "your t", <136>, "m", <138>, <175>
 
 	; BPMSG1135
 	.section .text.BPMSG1135, code
 	.global _BPMSG1135_str
 _BPMSG1135_str:
-	.pasciz "Are you sure? "
+	.pasciz "Ar", <131>, "you", <177>, "u", <146>, "? "
 
 	; BPMSG1136
 	.section .text.BPMSG1136, code
@@ -416,49 +550,49 @@ _BPMSG1137_str:
 	.section .text.BPMSG1163, code
 	.global _BPMSG1163_str
 _BPMSG1163_str:
-	.pasciz "Disconnect any devices\r\nConnect (Vpu to +5V) and (ADC to +3.3V)"
+	.pasciz "Disc", <143>, "nec", <133>, <153>, <164>, <154>, "v", <205>, <185>, <128>, "C", <143>, "nec", <133>, "(Vpu ", <176>, "+5V", <171>, <153>, "d", <137>, <179>, "C ", <176>, "+", <213>, "3V)"
 
 	; BPMSG1164
 	.section .text.BPMSG1164, code
 	.global _BPMSG1164_str
 _BPMSG1164_str:
-	.pasciz "Ctrl"
+	.pasciz "C", <243>, "l"
 
 	; BPMSG1165
 	.section .text.BPMSG1165, code
 	.global _BPMSG1165_str
 _BPMSG1165_str:
-	.pasciz "AUX"
+	.pasciz <209>
 
 	; BPMSG1166
 	.section .text.BPMSG1166, code
 	.global _BPMSG1166_str
 _BPMSG1166_str:
-	.pasciz "MODE LED"
+	.pasciz <237>, <232>, <227>, "ED"
 
 	; BPMSG1167
 	.section .text.BPMSG1167, code
 	.global _BPMSG1167_str
 _BPMSG1167_str:
-	.pasciz "PULLUP H"
+	.pasciz <218>, "LLUP H"
 
 	; BPMSG1168
 	.section .text.BPMSG1168, code
 	.global _BPMSG1168_str
 _BPMSG1168_str:
-	.pasciz "PULLUP L"
+	.pasciz <218>, "LLUP", <227>
 
 	; BPMSG1169
 	.section .text.BPMSG1169, code
 	.global _BPMSG1169_str
 _BPMSG1169_str:
-	.pasciz "VREG"
+	.pasciz "V", <156>, "G"
 
 	; BPMSG1170
 	.section .text.BPMSG1170, code
 	.global _BPMSG1170_str
 _BPMSG1170_str:
-	.pasciz "ADC and supply"
+	.pasciz <179>, "C ", <153>, <149>, "supply"
 
 	; BPMSG1171
 	.section .text.BPMSG1171, code
@@ -470,79 +604,79 @@ _BPMSG1171_str:
 	.section .text.BPMSG1172, code
 	.global _BPMSG1172_str
 _BPMSG1172_str:
-	.pasciz "VPU"
+	.pasciz "V", <218>
 
 	; BPMSG1173
 	.section .text.BPMSG1173, code
 	.global _BPMSG1173_str
 _BPMSG1173_str:
-	.pasciz "3.3V"
+	.pasciz <213>, "3V"
 
 	; BPMSG1174
 	.section .text.BPMSG1174, code
 	.global _BPMSG1174_str
 _BPMSG1174_str:
-	.pasciz "ADC"
+	.pasciz <179>, "C"
 
 	; BPMSG1175
 	.section .text.BPMSG1175, code
 	.global _BPMSG1175_str
 _BPMSG1175_str:
-	.pasciz "Bus high"
+	.pasciz "Bu", <139>, <167>, "gh"
 
 	; BPMSG1176
 	.section .text.BPMSG1176, code
 	.global _BPMSG1176_str
 _BPMSG1176_str:
-	.pasciz "Bus Hi-Z 0"
+	.pasciz "Bu", <139>, <234>, "-Z", <226>
 
 	; BPMSG1177
 	.section .text.BPMSG1177, code
 	.global _BPMSG1177_str
 _BPMSG1177_str:
-	.pasciz "Bus Hi-Z 1"
+	.pasciz "Bu", <139>, <234>, "-Z 1"
 
 	; BPMSG1178
 	.section .text.BPMSG1178, code
 	.global _BPMSG1178_str
 _BPMSG1178_str:
-	.pasciz "MODE and VREG LEDs should be on!"
+	.pasciz <237>, <232>, " ", <153>, <149>, "V", <156>, "G", <227>, "ED", <139>, "sho", <163>, <149>, "b", <131>, <143>, "!"
 
 	; BPMSG1179
 	.section .text.BPMSG1179, code
 	.global _BPMSG1179_str
 _BPMSG1179_str:
-	.pasciz "Found "
+	.pasciz "Foun", <149>
 
 	; BPMSG1180
 	.section .text.BPMSG1180, code
 	.global _BPMSG1180_str
 _BPMSG1180_str:
-	.pasciz " errors."
+	.pasciz " ", <136>, "r", <144>, "s."
 
 	; BPMSG1181
 	.section .text.BPMSG1181, code
 	.global _BPMSG1181_str
 _BPMSG1181_str:
-	.pasciz "MOSI"
+	.pasciz <237>, "SI"
 
 	; BPMSG1182
 	.section .text.BPMSG1182, code
 	.global _BPMSG1182_str
 _BPMSG1182_str:
-	.pasciz "CLK"
+	.pasciz <192>, "K"
 
 	; BPMSG1183
 	.section .text.BPMSG1183, code
 	.global _BPMSG1183_str
 _BPMSG1183_str:
-	.pasciz "MISO"
+	.pasciz "M", <215>, "O"
 
 	; BPMSG1184
 	.section .text.BPMSG1184, code
 	.global _BPMSG1184_str
 _BPMSG1184_str:
-	.pasciz "CS"
+	.pasciz <193>
 
 	; BPMSG1185
 	.section .text.BPMSG1185, code
@@ -560,19 +694,19 @@ _BPMSG1186_str:
 	.section .text.BPMSG1209, code
 	.global _BPMSG1209_str
 _BPMSG1209_str:
-	.pasciz "WARNING: pins not open drain (HiZ)"
+	.pasciz "W", <158>, "N", <235>, "G", <147>, "p", <138>, <139>, <222>, <133>, "op", <140>, " dra", <138>, <137>, <234>, "Z)"
 
 	; BPMSG1210
 	.section .text.BPMSG1210, code
 	.global _BPMSG1210_str
 _BPMSG1210_str:
-	.pasciz " REVID:"
+	.pasciz " ", <156>, "VID:"
 
 	; BPMSG1211
 	.section .text.BPMSG1211, code
 	.global _BPMSG1211_str
 _BPMSG1211_str:
-	.pasciz "\r\nInvalid choice, try again"
+	.pasciz <128>, "Inv", <175>, "i", <149>, <220>, "o", <205>, "e", <145>, <243>, <164>, "aga", <138>
 
 	; BPMSG1212
 	.section .text.BPMSG1212, code
@@ -584,61 +718,61 @@ _BPMSG1212_str:
 	.section .text.BPMSG1213, code
 	.global _BPMSG1213_str
 _BPMSG1213_str:
-	.pasciz "RS LOW, COMMAND MODE"
+	.pasciz "RS", <227>, <252>, <145>, "COMMA", <238>, " ", <237>, <232>
 
 	; BPMSG1214
 	.section .text.BPMSG1214, code
 	.global _BPMSG1214_str
 _BPMSG1214_str:
-	.pasciz "RS HIGH, DATA MODE"
+	.pasciz "RS HIGH", <145>, <233>, "A ", <237>, <232>
 
 	; BPMSG1216
 	.section .text.BPMSG1216, code
 	.global _BPMSG1216_str
 _BPMSG1216_str:
-	.pasciz "This mode requires an adapter"
+	.pasciz "T", <167>, <139>, <197>, "d", <131>, <146>, "qui", <146>, <139>, <153>, " ", <174>, "apt", <136>
 
 	; BPMSG1219
 	.section .text.BPMSG1219, code
 	.global _BPMSG1219_str
 _BPMSG1219_str:
-	.pasciz " 0.Macro menu\r\n 1.LCD Reset\r\n 2.Init LCD\r\n 3.Clear LCD\r\n 4.Cursor position ex:(4) 0\r\n 6.Write test numbers ex:(6) 80\r\n 7.Write test characters ex:(7) 80"
+	.pasciz <226>, ".", <202>, <221>, "u", <157>, ".LCD R", <185>, <239>, <151>, ".In", <206>, "LCD", <130>, <213>, "C", <240>, <152>, <227>, "CD", <130>, "4.Curs", <144>, <228>, "os", <141>, "i", <143>, " ", <195>, ":(4", <171>, "0", <130>, "6.Wr", <141>, <131>, "t", <185>, <133>, "numb", <136>, <139>, <195>, ":(6", <171>, "80", <130>, "7.Wr", <141>, <131>, "t", <185>, <133>, <220>, <152>, <148>, "t", <136>, <139>, <195>, ":(7", <171>, "80"
 
 	; BPMSG1220
 	.section .text.BPMSG1220, code
 	.global _BPMSG1220_str
 _BPMSG1220_str:
-	.pasciz "Display lines:\r\n 1. 1 \r\n 2. Multiple"
+	.pasciz "Di", <168>, "la", <164>, "l", <138>, <185>, <178>, "1 ", <169>, "M", <163>, <180>, "p", <240>
 
 	; BPMSG1221
 	.section .text.BPMSG1221, code
 	.global _BPMSG1221_str
 _BPMSG1221_str:
-	.pasciz "INIT"
+	.pasciz <235>, "IT"
 
 	; BPMSG1222
 	.section .text.BPMSG1222, code
 	.global _BPMSG1222_str
 _BPMSG1222_str:
-	.pasciz "CLEAR"
+	.pasciz <192>, "E", <158>
 
 	; BPMSG1223
 	.section .text.BPMSG1223, code
 	.global _BPMSG1223_str
 _BPMSG1223_str:
-	.pasciz "CURSOR SET"
+	.pasciz "CURSOR ", <194>, "T"
 
 	; BPMSG1226
 	.section .text.BPMSG1226, code
 	.global _BPMSG1226_str
 _BPMSG1226_str:
-	.pasciz "Pinstates:"
+	.pasciz "P", <138>, <161>, <186>, <185>, ":"
 
 	; BPMSG1227
 	.section .text.BPMSG1227, code
 	.global _BPMSG1227_str
 _BPMSG1227_str:
-	.pasciz "GND\t3.3V\t5.0V\tADC\tVPU\tAUX\t"
+	.pasciz "G", <238>, "\t", <213>, "3V\t5.0V\t", <179>, "C\tV", <218>, "\t", <209>, "\t"
 
 	; BPMSG1228
 	.section .text.BPMSG1228, code
@@ -650,235 +784,235 @@ _BPMSG1228_str:
 	.section .text.BPMSG1233, code
 	.global _BPMSG1233_str
 _BPMSG1233_str:
-	.pasciz "1.(BR)\t2.(RD)\t3.(OR)\t4.(YW)\t5.(GN)\t6.(BL)\t7.(PU)\t8.(GR)\t9.(WT)\t0.(Blk)"
+	.pasciz "1", <200>, "BR", <182>, "2", <200>, "RD", <182>, "3", <200>, "OR", <182>, "4", <200>, "YW", <182>, "5", <200>, "GN", <182>, "6", <200>, "BL", <182>, "7", <200>, <218>, <182>, "8", <200>, "GR", <182>, "9", <200>, "WT", <182>, "0", <200>, "Blk)"
 
 	; BPMSG1234
 	.section .text.BPMSG1234, code
 	.global _BPMSG1234_str
 _BPMSG1234_str:
-	.pasciz "GND\t"
+	.pasciz "G", <238>, "\t"
 
 	; BPMSG1245
 	.section .text.BPMSG1245, code
 	.global _BPMSG1245_str
 _BPMSG1245_str:
-	.pasciz " autorange "
+	.pasciz " a", <189>, <144>, <153>, "g", <131>
 
 	; BPMSG1251
 	.section .text.BPMSG1251, code
 	.global _BPMSG1251_str
 _BPMSG1251_str:
-	.pasciz "Space to continue"
+	.pasciz "Sp", <148>, <131>, <176>, "c", <143>, "t", <138>, "ue"
 
 	; BPMSG1252
 	.section .text.BPMSG1252, code
 	.global _BPMSG1252_str
 _BPMSG1252_str:
-	.pasciz "Number of bits read/write: "
+	.pasciz "Numb", <136>, " of b", <141>, <139>, <146>, <174>, "/wr", <141>, "e", <147>
 
 	; BPMSG1254
 	.section .text.BPMSG1254, code
 	.global _BPMSG1254_str
 _BPMSG1254_str:
-	.pasciz "Position in degrees"
+	.pasciz "Pos", <141>, "i", <143>, " ", <138>, " ", <154>, "g", <146>, <185>
 
 	; BPMSG1255
 	.section .text.BPMSG1255, code
 	.global _BPMSG1255_str
 _BPMSG1255_str:
-	.pasciz "Servo active"
+	.pasciz "S", <136>, "v", <134>, <245>, "ve"
 
 	; HLP1000
 	.section .text.HLP1000, code
 	.global _HLP1000_str
 _HLP1000_str:
-	.pasciz " General\t\t\t\t\tProtocol interaction"
+	.pasciz " G", <140>, <136>, <175>, <142>, <208>, "P", <242>, <223>, "c", <187>, " ", <138>, "t", <136>, <245>, <143>
 
 	; HLP1001
 	.section .text.HLP1001, code
 	.global _HLP1001_str
 _HLP1001_str:
-	.pasciz " ---------------------------------------------------------------------------"
+	.pasciz " ", <246>, <246>, <246>, <246>, <162>, <129>, "-"
 
 	; HLP1002
 	.section .text.HLP1002, code
 	.global _HLP1002_str
 _HLP1002_str:
-	.pasciz " ?\tThis help\t\t\t(0)\tList current macros"
+	.pasciz " ?\tT", <167>, <139>, "help", <208>, "(0", <182>, "Lis", <133>, "curr", <140>, <133>, "m", <181>, "os"
 
 	; HLP1003
 	.section .text.HLP1003, code
 	.global _HLP1003_str
 _HLP1003_str:
-	.pasciz " =X/|X\tConverts X/reverse X\t\t(x)\tMacro x"
+	.pasciz " =X/|X\tC", <143>, "v", <136>, "t", <139>, "X/", <146>, "v", <136>, "s", <131>, "X", <142>, "(x", <182>, <202>, "x"
 
 	; HLP1004
 	.section .text.HLP1004, code
 	.global _HLP1004_str
 _HLP1004_str:
-	.pasciz " ~\tSelftest\t\t\t[\tStart"
+	.pasciz " ~\t", <173>, "lfte", <161>, <208>, "[", <210>, "t", <152>, "t"
 
 	; HLP1005
 	.section .text.HLP1005, code
 	.global _HLP1005_str
 _HLP1005_str:
-	.pasciz " #\tReset the BP   \t\t\t]\tStop"
+	.pasciz " #\tR", <185>, "e", <133>, "th", <131>, "BP", <211>, " ", <208>, "]", <210>, <223>, "p"
 
 	; HLP1006
 	.section .text.HLP1006, code
 	.global _HLP1006_str
 _HLP1006_str:
-	.pasciz " $\tJump to bootloader\t\t{\tStart with read"
+	.pasciz " $\tJum", <188>, <176>, "boot", <159>, <174>, <136>, <142>, "{", <210>, "t", <152>, <133>, "w", <141>, "h ", <146>, <174>
 
 	; HLP1007
 	.section .text.HLP1007, code
 	.global _HLP1007_str
 _HLP1007_str:
-	.pasciz " &/%\tDelay 1 us/ms\t\t\t}\tStop"
+	.pasciz " &/%\tDela", <164>, "1 ", <244>, "/ms", <208>, "}", <210>, <223>, "p"
 
 	; HLP1008
 	.section .text.HLP1008, code
 	.global _HLP1008_str
 _HLP1008_str:
-	.pasciz " a/A/@\tAUXPIN (low/HI/READ)\t\t\"abc\"\tSend string"
+	.pasciz " a/A/@\t", <209>, "P", <235>, <137>, <224>, "/HI/", <156>, <179>, ")", <142>, "\"abc\"", <210>, <140>, <149>, <161>, "r", <138>, "g"
 
 	; HLP1009
 	.section .text.HLP1009, code
 	.global _HLP1009_str
 _HLP1009_str:
-	.pasciz " b\tSet baudrate\t\t\t123"
+	.pasciz " b\t", <199>, "baudr", <186>, "e", <208>, "123"
 
 	; HLP1010
 	.section .text.HLP1010, code
 	.global _HLP1010_str
 _HLP1010_str:
-	.pasciz " c/C\tAUX assignment (aux/CS)\t\t0x123"
+	.pasciz <250>, "/C\t", <209>, " ", <219>, "sign", <221>, <133>, "(aux/", <193>, ")", <142>, <183>, "123"
 
 	; HLP1011
 	.section .text.HLP1011, code
 	.global _HLP1011_str
 _HLP1011_str:
-	.pasciz " d/D\tMeasure ADC (once/CONT.)\t0b110\tSend value"
+	.pasciz " d/D\tMe", <219>, "ur", <131>, <179>, "C", <137>, <143>, "ce/C", <217>, "T.", <182>, "0b110", <210>, <140>, <149>, "v", <175>, "ue"
 
 	; HLP1012
 	.section .text.HLP1012, code
 	.global _HLP1012_str
 _HLP1012_str:
-	.pasciz " f\tMeasure frequency\t\tr\tRead"
+	.pasciz " f\tMe", <219>, "ur", <131>, "f", <146>, "qu", <140>, "cy", <142>, "r\t", <254>, <174>
 
 	; HLP1013
 	.section .text.HLP1013, code
 	.global _HLP1013_str
 _HLP1013_str:
-	.pasciz " g/S\tGenerate PWM/Servo\t\t/\tCLK hi"
+	.pasciz " g/S\tG", <140>, <136>, <186>, <131>, "PWM/S", <136>, "vo", <142>, "/\t", <192>, "K ", <167>
 
 	; HLP1014
 	.section .text.HLP1014, code
 	.global _HLP1014_str
 _HLP1014_str:
-	.pasciz " h\tCommandhistory\t\t\t\\\tCLK lo"
+	.pasciz " h\tCo", <241>, <153>, "d", <167>, <161>, <144>, "y", <208>, "\\\t", <192>, "K ", <159>
 
 	; HLP1015
 	.section .text.HLP1015, code
 	.global _HLP1015_str
 _HLP1015_str:
-	.pasciz " i\tVersioninfo/statusinfo\t\t^\tCLK tick"
+	.pasciz " i\tV", <136>, "si", <143>, <138>, "fo/", <161>, <186>, <244>, <138>, "fo", <142>, "^\t", <192>, "K ", <180>, "ck"
 
 	; HLP1016
 	.section .text.HLP1016, code
 	.global _HLP1016_str
 _HLP1016_str:
-	.pasciz " l/L\tBitorder (msb/LSB)\t\t-\tDAT hi"
+	.pasciz " l/L\tB", <141>, <144>, "d", <136>, <137>, "msb/LSB)", <142>, "-\t", <233>, " ", <167>
 
 	; HLP1017
 	.section .text.HLP1017, code
 	.global _HLP1017_str
 _HLP1017_str:
-	.pasciz " m\tChange mode\t\t\t_\tDAT lo"
+	.pasciz " m\tCh", <153>, "g", <131>, <197>, <154>, <208>, "_\t", <233>, " ", <159>
 
 	; HLP1018
 	.section .text.HLP1018, code
 	.global _HLP1018_str
 _HLP1018_str:
-	.pasciz " o\tSet output type\t\t\t.\tDAT read"
+	.pasciz " o\t", <199>, "o", <189>, "pu", <133>, "type", <208>, ".\t", <233>, " ", <146>, <174>
 
 	; HLP1019
 	.section .text.HLP1019, code
 	.global _HLP1019_str
 _HLP1019_str:
-	.pasciz " p/P\tPullup resistors (off/ON)\t!\tBit read"
+	.pasciz <228>, "/P\tP", <163>, "lu", <188>, <146>, "si", <161>, <144>, "s", <137>, "o", <204>, "/", <217>, <182>, "!\tB", <206>, <146>, <174>
 
 	; HLP1020
 	.section .text.HLP1020, code
 	.global _HLP1020_str
 _HLP1020_str:
-	.pasciz " s\tScript engine\t\t\t:\tRepeat e.g. r:10"
+	.pasciz <177>, <210>, "crip", <133>, <140>, "g", <138>, "e", <208>, ":\t", <254>, "pea", <133>, "e.g", <132>, "r:10"
 
 	; HLP1021
 	.section .text.HLP1021, code
 	.global _HLP1021_str
 _HLP1021_str:
-	.pasciz " v\tShow volts/states\t\t.\tBits to read/write e.g. 0x55.2"
+	.pasciz " v", <210>, "how v", <187>, "ts/", <161>, <186>, <185>, <142>, ".\tB", <141>, <139>, <176>, <146>, <174>, "/wr", <141>, <131>, "e.g", <132>, <183>, "55.2"
 
 	; HLP1022
 	.section .text.HLP1022, code
 	.global _HLP1022_str
 _HLP1022_str:
-	.pasciz " w/W\tPSU (off/ON)\t\t<x>/<x= >/<0>\tUsermacro x/assign x/list all"
+	.pasciz " w/W\tPSU", <137>, "o", <204>, "/", <217>, ")", <142>, "<x>/<x= >/<0>\tUs", <136>, "m", <190>, "x/", <219>, "sign x/lis", <133>, <175>, "l"
 
 	; MSG_1WIRE_ADDRESS_MACRO_HEADER
 	.section .text.MSG_1WIRE_ADDRESS_MACRO_HEADER, code
 	.global _MSG_1WIRE_ADDRESS_MACRO_HEADER_str
 _MSG_1WIRE_ADDRESS_MACRO_HEADER_str:
-	.pasciz "ADDRESS MACRO "
+	.pasciz <179>, "D", <156>, "SS MAC", <165>, " "
 
 	; MSG_1WIRE_ALARM_MACRO_NAME
 	.section .text.MSG_1WIRE_ALARM_MACRO_NAME, code
 	.global _MSG_1WIRE_ALARM_MACRO_NAME_str
 _MSG_1WIRE_ALARM_MACRO_NAME_str:
-	.pasciz "ALARM SEARCH (0xEC)"
+	.pasciz "AL", <158>, "M ", <194>, <158>, <214>, <207>, "EC)"
 
 	; MSG_1WIRE_BUS_RESET
 	.section .text.MSG_1WIRE_BUS_RESET, code
 	.global _MSG_1WIRE_BUS_RESET_str
 _MSG_1WIRE_BUS_RESET_str:
-	.pasciz "BUS RESET "
+	.pasciz "BUS ", <156>, <194>, "T "
 
 	; MSG_1WIRE_LOOKUP_ID_HEADER
 	.section .text.MSG_1WIRE_LOOKUP_ID_HEADER, code
 	.global _MSG_1WIRE_LOOKUP_ID_HEADER_str
 _MSG_1WIRE_LOOKUP_ID_HEADER_str:
-	.pasciz "\r\n   *"
+	.pasciz <130>, " ", <191>
 
 	; MSG_1WIRE_MACRO_LIST
 	.section .text.MSG_1WIRE_MACRO_LIST, code
 	.global _MSG_1WIRE_MACRO_LIST_str
 _MSG_1WIRE_MACRO_LIST_str:
-	.pasciz "1WIRE ROM COMMAND MACROs:\r\n 51.READ ROM (0x33) *for single device bus\r\n 85.MATCH ROM (0x55) *followed by 64bit address\r\n 204.SKIP ROM (0xCC) *followed by command\r\n 236.ALARM SEARCH (0xEC)\r\n 240.SEARCH ROM (0xF0)"
+	.pasciz "1WI", <156>, <229>, " COMMA", <238>, " MAC", <165>, "s:", <130>, "51.", <156>, <179>, <229>, <207>, "33", <171>, "*f", <144>, <177>, <138>, "g", <160>, <154>, "v", <205>, <131>, "b", <244>, <130>, "85.M", <172>, <214>, <229>, <207>, "55", <171>, "*f", <187>, <224>, "e", <149>, "b", <164>, "64b", <206>, <174>, "d", <146>, "ss", <151>, "04.SKIP", <229>, <207>, "CC", <171>, "*f", <187>, <224>, "e", <149>, "b", <164>, "co", <241>, <153>, "d", <151>, "36.AL", <158>, "M ", <194>, <158>, <214>, <207>, "EC)", <151>, "40.", <194>, <158>, <214>, <229>, <207>, "F0)"
 
 	; MSG_1WIRE_MACRO_MENU_HEADER
 	.section .text.MSG_1WIRE_MACRO_MENU_HEADER, code
 	.global _MSG_1WIRE_MACRO_MENU_HEADER_str
 _MSG_1WIRE_MACRO_MENU_HEADER_str:
-	.pasciz " 0.Macro menu"
+	.pasciz <226>, ".", <202>, <221>, "u"
 
 	; MSG_1WIRE_MACRO_TABLE_HEADER
 	.section .text.MSG_1WIRE_MACRO_TABLE_HEADER, code
 	.global _MSG_1WIRE_MACRO_TABLE_HEADER_str
 _MSG_1WIRE_MACRO_TABLE_HEADER_str:
-	.pasciz "Macro     1WIRE address"
+	.pasciz <202>, <211>, <211>, "1WI", <156>, " ", <174>, "d", <146>, "ss"
 
 	; MSG_1WIRE_MACRO_TABLE_TRAILER
 	.section .text.MSG_1WIRE_MACRO_TABLE_TRAILER, code
 	.global _MSG_1WIRE_MACRO_TABLE_TRAILER_str
 _MSG_1WIRE_MACRO_TABLE_TRAILER_str:
-	.pasciz "Device IDs are available by MACRO, see (0)."
+	.pasciz "Dev", <205>, <131>, "ID", <139>, <152>, <131>, "availab", <160>, "b", <164>, "MAC", <165>, <145>, "se", <131>, "(0)."
 
 	; MSG_1WIRE_MATCH_ROM_MACRO_NAME
 	.section .text.MSG_1WIRE_MATCH_ROM_MACRO_NAME, code
 	.global _MSG_1WIRE_MATCH_ROM_MACRO_NAME_str
 _MSG_1WIRE_MATCH_ROM_MACRO_NAME_str:
-	.pasciz "MATCH ROM (0x55)"
+	.pasciz "M", <172>, <214>, <229>, <207>, "55)"
 
 	; MSG_1WIRE_MODE_IDENTIFIER
 	.section .text.MSG_1WIRE_MODE_IDENTIFIER, code
@@ -890,73 +1024,73 @@ _MSG_1WIRE_MODE_IDENTIFIER_str:
 	.section .text.MSG_1WIRE_NEXT_CLOCK_ALERT, code
 	.global _MSG_1WIRE_NEXT_CLOCK_ALERT_str
 _MSG_1WIRE_NEXT_CLOCK_ALERT_str:
-	.pasciz " *next clock (^) will use this value"
+	.pasciz <191>, "n", <195>, <133>, "c", <159>, "ck", <137>, "^", <171>, "will ", <244>, <131>, "t", <167>, <139>, "v", <175>, "ue"
 
 	; MSG_1WIRE_NO_DEVICE
 	.section .text.MSG_1WIRE_NO_DEVICE, code
 	.global _MSG_1WIRE_NO_DEVICE_str
 _MSG_1WIRE_NO_DEVICE_str:
-	.pasciz "No device, try (ALARM) SEARCH macro first"
+	.pasciz "N", <134>, <154>, "v", <205>, "e", <145>, <243>, "y", <137>, "AL", <158>, "M", <171>, <194>, <158>, <214>, " m", <190>, "fir", <161>
 
 	; MSG_1WIRE_NO_DEVICE_DETECTED
 	.section .text.MSG_1WIRE_NO_DEVICE_DETECTED, code
 	.global _MSG_1WIRE_NO_DEVICE_DETECTED_str
 _MSG_1WIRE_NO_DEVICE_DETECTED_str:
-	.pasciz "*No device detected "
+	.pasciz "*N", <134>, <154>, "v", <205>, <131>, <154>, "tecte", <149>
 
 	; MSG_1WIRE_PINS_STATE
 	.section .text.MSG_1WIRE_PINS_STATE, code
 	.global _MSG_1WIRE_PINS_STATE_str
 _MSG_1WIRE_PINS_STATE_str:
-	.pasciz "-\tOWD\t-\t-"
+	.pasciz "-\t", <252>, "D", <247>, <247>
 
 	; MSG_1WIRE_READ_ROM_MACRO_NAME
 	.section .text.MSG_1WIRE_READ_ROM_MACRO_NAME, code
 	.global _MSG_1WIRE_READ_ROM_MACRO_NAME_str
 _MSG_1WIRE_READ_ROM_MACRO_NAME_str:
-	.pasciz "READ ROM (0x33): "
+	.pasciz <156>, <179>, <229>, <207>, "33)", <147>
 
 	; MSG_1WIRE_SEARCH_MACRO_NAME
 	.section .text.MSG_1WIRE_SEARCH_MACRO_NAME, code
 	.global _MSG_1WIRE_SEARCH_MACRO_NAME_str
 _MSG_1WIRE_SEARCH_MACRO_NAME_str:
-	.pasciz "SEARCH (0xF0)"
+	.pasciz <194>, <158>, <214>, <207>, "F0)"
 
 	; MSG_1WIRE_SKIP_ROM_MACRO_NAME
 	.section .text.MSG_1WIRE_SKIP_ROM_MACRO_NAME, code
 	.global _MSG_1WIRE_SKIP_ROM_MACRO_NAME_str
 _MSG_1WIRE_SKIP_ROM_MACRO_NAME_str:
-	.pasciz "SKIP ROM (0xCC)"
+	.pasciz "SKIP", <229>, <207>, "CC)"
 
 	; MSG_1WIRE_SPEED_PROMPT
 	.section .text.MSG_1WIRE_SPEED_PROMPT, code
 	.global _MSG_1WIRE_SPEED_PROMPT_str
 _MSG_1WIRE_SPEED_PROMPT_str:
-	.pasciz "Set speed:\r\n 1. Standard (~16.3kbps) \r\n 2. Overdrive (~160kps)"
+	.pasciz <199>, <168>, "e", <166>, <178>, "St", <153>, "d", <152>, "d", <137>, "~", <212>, ".3kbps", <171>, <169>, "Ov", <136>, "driv", <131>, "(~", <212>, "0kps)"
 
 	; MSG_ACK
 	.section .text.MSG_ACK, code
 	.global _MSG_ACK_str
 _MSG_ACK_str:
-	.pasciz "ACK"
+	.pasciz "A", <231>
 
 	; MSG_ADC_VOLTAGE_PROBE_HEADER
 	.section .text.MSG_ADC_VOLTAGE_PROBE_HEADER, code
 	.global _MSG_ADC_VOLTAGE_PROBE_HEADER_str
 _MSG_ADC_VOLTAGE_PROBE_HEADER_str:
-	.pasciz "VOLTAGE PROBE: "
+	.pasciz "VOLTAGE P", <165>, "BE", <147>
 
 	; MSG_ADC_VOLTMETER_MODE
 	.section .text.MSG_ADC_VOLTMETER_MODE, code
 	.global _MSG_ADC_VOLTMETER_MODE_str
 _MSG_ADC_VOLTMETER_MODE_str:
-	.pasciz "VOLTMETER MODE"
+	.pasciz "VOLTMET", <251>, " ", <237>, <232>
 
 	; MSG_ANY_KEY_TO_EXIT_PROMPT
 	.section .text.MSG_ANY_KEY_TO_EXIT_PROMPT, code
 	.global _MSG_ANY_KEY_TO_EXIT_PROMPT_str
 _MSG_ANY_KEY_TO_EXIT_PROMPT_str:
-	.pasciz "Any key to exit"
+	.pasciz "An", <164>, "ke", <164>, <176>, <195>, <141>
 
 	; MSG_BASE_CONVERTER_EQUAL_SIGN
 	.section .text.MSG_BASE_CONVERTER_EQUAL_SIGN, code
@@ -964,6 +1098,24 @@ _MSG_ANY_KEY_TO_EXIT_PROMPT_str:
 _MSG_BASE_CONVERTER_EQUAL_SIGN_str:
 	.pasciz " = "
 
+	; MSG_BATCH_MODE_DONE
+	.section .text.MSG_BATCH_MODE_DONE, code
+	.global _MSG_BATCH_MODE_DONE_str
+_MSG_BATCH_MODE_DONE_str:
+	.pasciz "B", <172>, <214>, " D", <217>, "E"
+
+	; MSG_BATCH_MODE_READY
+	.section .text.MSG_BATCH_MODE_READY, code
+	.global _MSG_BATCH_MODE_READY_str
+_MSG_BATCH_MODE_READY_str:
+	.pasciz "B", <172>, <214>, " ", <156>, <179>, "Y", <145>, <140>, <149>, "scrip", <133>, "w", <141>, "h ^D"
+
+	; MSG_BATCH_MODE_SCRIPT_TOO_LONG
+	.section .text.MSG_BATCH_MODE_SCRIPT_TOO_LONG, code
+	.global _MSG_BATCH_MODE_SCRIPT_TOO_LONG_str
+_MSG_BATCH_MODE_SCRIPT_TOO_LONG_str:
+	.pasciz "Scrip", <133>, <223>, <134>, "l", <143>, "g"
+
 	; MSG_BBIO_MODE_IDENTIFIER
 	.section .text.MSG_BBIO_MODE_IDENTIFIER, code
 	.global _MSG_BBIO_MODE_IDENTIFIER_str
@@ -980,7 +1132,7 @@ _MSG_BINARY_NUMBER_PREFIX_str:
 	.section .text.MSG_CHIP_IDENTIFIER_CLONE, code
 	.global _MSG_CHIP_IDENTIFIER_CLONE_str
 _MSG_CHIP_IDENTIFIER_CLONE_str:
-	.pasciz " clone w/different PIC"
+	.pasciz <250>, "l", <143>, <131>, "w/di", <204>, <136>, <140>, <133>, <253>, "C"
 
 	; MSG_CHIP_REVISION_A3
 	.section .text.MSG_CHIP_REVISION_A3, code
@@ -1010,7 +1162,7 @@ _MSG_CHIP_REVISION_B8_str:
 	.section .text.MSG_CHIP_REVISION_ID_BEGIN, code
 	.global _MSG_CHIP_REVISION_ID_BEGIN_str
 _MSG_CHIP_REVISION_ID_BEGIN_str:
-	.pasciz " (24FJ64GA00 "
+	.pasciz <137>, "24FJ64GA", <155>, " "
 
 	; MSG_CHIP_REVISION_ID_END_2
 	.section .text.MSG_CHIP_REVISION_ID_END_2, code
@@ -1040,19 +1192,19 @@ _MSG_CLEAR_LINE_WITH_CR_str:
 	.section .text.MSG_CLUTCH_DISENGAGED, code
 	.global _MSG_CLUTCH_DISENGAGED_str
 _MSG_CLUTCH_DISENGAGED_str:
-	.pasciz "Clutch disengaged!!!"
+	.pasciz "Cl", <189>, <220>, " dis", <140>, "gag", <166>, "!!!"
 
 	; MSG_CLUTCH_ENGAGED
 	.section .text.MSG_CLUTCH_ENGAGED, code
 	.global _MSG_CLUTCH_ENGAGED_str
 _MSG_CLUTCH_ENGAGED_str:
-	.pasciz "Clutch engaged!!!"
+	.pasciz "Cl", <189>, <220>, " ", <140>, "gag", <166>, "!!!"
 
 	; MSG_COMMAND_HAS_NO_EFFECT
 	.section .text.MSG_COMMAND_HAS_NO_EFFECT, code
 	.global _MSG_COMMAND_HAS_NO_EFFECT_str
 _MSG_COMMAND_HAS_NO_EFFECT_str:
-	.pasciz "ERROR: command has no effect here"
+	.pasciz <251>, <165>, "R", <147>, "co", <241>, <153>, <149>, "ha", <139>, "n", <134>, "e", <204>, "ec", <133>, "h", <136>, "e"
 
 	; MSG_CURSOR_LEFT
 	.section .text.MSG_CURSOR_LEFT, code
@@ -1082,73 +1234,73 @@ _MSG_DESTRUCTIVE_BACKSPACE_str:
 	.section .text.MSG_FINISH_SETUP_PROMPT, code
 	.global _MSG_FINISH_SETUP_PROMPT_str
 _MSG_FINISH_SETUP_PROMPT_str:
-	.pasciz "To finish setup, start up the power supplies with command 'W'"
+	.pasciz "T", <134>, "f", <138>, "ish", <177>, <239>, "up", <145>, <161>, <152>, <133>, "u", <188>, "th", <131>, "pow", <136>, <177>, "upplie", <139>, "w", <141>, "h", <250>, "o", <241>, <153>, <149>, "'W'"
 
 	; MSG_HEXADECIMAL_NUMBER_PREFIX
 	.section .text.MSG_HEXADECIMAL_NUMBER_PREFIX, code
 	.global _MSG_HEXADECIMAL_NUMBER_PREFIX_str
 _MSG_HEXADECIMAL_NUMBER_PREFIX_str:
-	.pasciz "0x"
+	.pasciz <183>
 
 	; MSG_I2C_MODE_IDENTIFIER
 	.section .text.MSG_I2C_MODE_IDENTIFIER, code
 	.global _MSG_I2C_MODE_IDENTIFIER_str
 _MSG_I2C_MODE_IDENTIFIER_str:
-	.pasciz "I2C1"
+	.pasciz <236>, "1"
 
 	; MSG_I2C_PINS_STATE
 	.section .text.MSG_I2C_PINS_STATE, code
 	.global _MSG_I2C_PINS_STATE_str
 _MSG_I2C_PINS_STATE_str:
-	.pasciz "SCL\tSDA\t-\t-"
+	.pasciz "S", <192>, <210>, "DA", <247>, <247>
 
 	; MSG_I2C_READ_ADDRESS_END
 	.section .text.MSG_I2C_READ_ADDRESS_END, code
 	.global _MSG_I2C_READ_ADDRESS_END_str
 _MSG_I2C_READ_ADDRESS_END_str:
-	.pasciz " R) "
+	.pasciz " R", <171>
 
 	; MSG_I2C_START_BIT
 	.section .text.MSG_I2C_START_BIT, code
 	.global _MSG_I2C_START_BIT_str
 _MSG_I2C_START_BIT_str:
-	.pasciz "I2C START BIT"
+	.pasciz <236>, <249>, "T", <158>, "T", <248>, "IT"
 
 	; MSG_I2C_STOP_BIT
 	.section .text.MSG_I2C_STOP_BIT, code
 	.global _MSG_I2C_STOP_BIT_str
 _MSG_I2C_STOP_BIT_str:
-	.pasciz "I2C STOP BIT"
+	.pasciz <236>, <249>, "TOP", <248>, "IT"
 
 	; MSG_I2C_WRITE_ADDRESS_END
 	.section .text.MSG_I2C_WRITE_ADDRESS_END, code
 	.global _MSG_I2C_WRITE_ADDRESS_END_str
 _MSG_I2C_WRITE_ADDRESS_END_str:
-	.pasciz " W) "
+	.pasciz " W", <171>
 
 	; MSG_KEYBOARD_ERROR_NODATA
 	.section .text.MSG_KEYBOARD_ERROR_NODATA, code
 	.global _MSG_KEYBOARD_ERROR_NODATA_str
 _MSG_KEYBOARD_ERROR_NODATA_str:
-	.pasciz " NONE"
+	.pasciz " N", <217>, "E"
 
 	; MSG_KEYBOARD_ERROR_PARITY
 	.section .text.MSG_KEYBOARD_ERROR_PARITY, code
 	.global _MSG_KEYBOARD_ERROR_PARITY_str
 _MSG_KEYBOARD_ERROR_PARITY_str:
-	.pasciz " *parity error"
+	.pasciz <191>, "p", <152>, <141>, <164>, <136>, "r", <144>
 
 	; MSG_KEYBOARD_ERROR_STARTBIT
 	.section .text.MSG_KEYBOARD_ERROR_STARTBIT, code
 	.global _MSG_KEYBOARD_ERROR_STARTBIT_str
 _MSG_KEYBOARD_ERROR_STARTBIT_str:
-	.pasciz " *startbit error"
+	.pasciz <191>, <161>, <152>, "tb", <206>, <136>, "r", <144>
 
 	; MSG_KEYBOARD_ERROR_STOPBIT
 	.section .text.MSG_KEYBOARD_ERROR_STOPBIT, code
 	.global _MSG_KEYBOARD_ERROR_STOPBIT_str
 _MSG_KEYBOARD_ERROR_STOPBIT_str:
-	.pasciz " *stopbit error"
+	.pasciz <191>, <161>, "opb", <206>, <136>, "r", <144>
 
 	; MSG_KEYBOARD_ERROR_TIMEOUT
 	.section .text.MSG_KEYBOARD_ERROR_TIMEOUT, code
@@ -1160,19 +1312,19 @@ _MSG_KEYBOARD_ERROR_TIMEOUT_str:
 	.section .text.MSG_KEYBOARD_ERROR_UNKNOWN, code
 	.global _MSG_KEYBOARD_ERROR_UNKNOWN_str
 _MSG_KEYBOARD_ERROR_UNKNOWN_str:
-	.pasciz " UNKNOWN ERROR"
+	.pasciz " UNKN", <252>, "N ", <251>, <165>, "R"
 
 	; MSG_KEYBOARD_LIVE_INPUT_START
 	.section .text.MSG_KEYBOARD_LIVE_INPUT_START, code
 	.global _MSG_KEYBOARD_LIVE_INPUT_START_str
 _MSG_KEYBOARD_LIVE_INPUT_START_str:
-	.pasciz "Input monitor, any key exits"
+	.pasciz "Inpu", <133>, "m", <143>, <141>, <144>, <145>, <153>, <164>, "ke", <164>, <195>, <141>, "s"
 
 	; MSG_KEYBOARD_MACRO_MENU
 	.section .text.MSG_KEYBOARD_MACRO_MENU, code
 	.global _MSG_KEYBOARD_MACRO_MENU_str
 _MSG_KEYBOARD_MACRO_MENU_str:
-	.pasciz " 0. Macro menu\r\n 1. Live input monitor"
+	.pasciz <226>, <132>, <202>, <221>, "u", <170>, "Liv", <131>, <138>, "pu", <133>, "m", <143>, <141>, <144>
 
 	; MSG_MODE_HEADER_END
 	.section .text.MSG_MODE_HEADER_END, code
@@ -1184,13 +1336,13 @@ _MSG_MODE_HEADER_END_str:
 	.section .text.MSG_NACK, code
 	.global _MSG_NACK_str
 _MSG_NACK_str:
-	.pasciz "NACK"
+	.pasciz "NA", <231>
 
 	; MSG_NO_VOLTAGE_ON_PULLUP_PIN
 	.section .text.MSG_NO_VOLTAGE_ON_PULLUP_PIN, code
 	.global _MSG_NO_VOLTAGE_ON_PULLUP_PIN_str
 _MSG_NO_VOLTAGE_ON_PULLUP_PIN_str:
-	.pasciz "Warning: no voltage on Vpullup pin"
+	.pasciz "W", <152>, "n", <138>, "g", <147>, "n", <134>, "v", <187>, "tag", <131>, <143>, " Vp", <163>, "lu", <188>, "p", <138>
 
 	; MSG_OPENOCD_MODE_IDENTIFIER
 	.section .text.MSG_OPENOCD_MODE_IDENTIFIER, code
@@ -1214,19 +1366,19 @@ _MSG_PIC_DEVICE_ID_str:
 	.section .text.MSG_PIC_EXIT_MODE, code
 	.global _MSG_PIC_EXIT_MODE_str
 _MSG_PIC_EXIT_MODE_str:
-	.pasciz "Please exit PIC programming mode"
+	.pasciz "P", <240>, <219>, <131>, <195>, <206>, <253>, "C", <228>, <242>, "gra", <241>, <138>, <196>, <197>, <154>
 
 	; MSG_PIC_MACRO_MENU
 	.section .text.MSG_PIC_MACRO_MENU, code
 	.global _MSG_PIC_MACRO_MENU_str
 _MSG_PIC_MACRO_MENU_str:
-	.pasciz "(1) get devID"
+	.pasciz "(1", <171>, "ge", <133>, <154>, "vID"
 
 	; MSG_PIC_MACRO_NOT_IMPLEMENTED
 	.section .text.MSG_PIC_MACRO_NOT_IMPLEMENTED, code
 	.global _MSG_PIC_MACRO_NOT_IMPLEMENTED_str
 _MSG_PIC_MACRO_NOT_IMPLEMENTED_str:
-	.pasciz "Not implemented (yet)"
+	.pasciz "No", <133>, "imp", <240>, <221>, "t", <166>, <137>, "y", <239>, ")"
 
 	; MSG_PIC_MODE_COMMAND
 	.section .text.MSG_PIC_MODE_COMMAND, code
@@ -1244,145 +1396,145 @@ _MSG_PIC_MODE_DATA_str:
 	.section .text.MSG_PIC_MODE_HEADER, code
 	.global _MSG_PIC_MODE_HEADER_str
 _MSG_PIC_MODE_HEADER_str:
-	.pasciz "PIC(mod dly)=("
+	.pasciz <253>, "C(", <197>, <149>, "dly)=("
 
 	; MSG_PIC_MODE_IDENTIFIER
 	.section .text.MSG_PIC_MODE_IDENTIFIER, code
 	.global _MSG_PIC_MODE_IDENTIFIER_str
 _MSG_PIC_MODE_IDENTIFIER_str:
-	.pasciz "PIC1"
+	.pasciz <253>, "C1"
 
 	; MSG_PIC_MODE_PROMPT
 	.section .text.MSG_PIC_MODE_PROMPT, code
 	.global _MSG_PIC_MODE_PROMPT_str
 _MSG_PIC_MODE_PROMPT_str:
-	.pasciz "Commandmode?\r\n1. 6b/14b\r\n2. 4b/16b"
+	.pasciz "Co", <241>, <153>, "d", <197>, <154>, "?", <198>, <132>, "6b/14b", <128>, "2", <132>, "4b/", <212>, "b"
 
 	; MSG_PIC_NO_READ
 	.section .text.MSG_PIC_NO_READ, code
 	.global _MSG_PIC_NO_READ_str
 _MSG_PIC_NO_READ_str:
-	.pasciz "no read"
+	.pasciz "n", <134>, <146>, <174>
 
 	; MSG_PIC_PINS_STATE
 	.section .text.MSG_PIC_PINS_STATE, code
 	.global _MSG_PIC_PINS_STATE_str
 _MSG_PIC_PINS_STATE_str:
-	.pasciz "PGC\tPGD\t-\t-"
+	.pasciz "PGC\tPGD", <247>, <247>
 
 	; MSG_PIC_REVISION_ID
 	.section .text.MSG_PIC_REVISION_ID, code
 	.global _MSG_PIC_REVISION_ID_str
 _MSG_PIC_REVISION_ID_str:
-	.pasciz " Rev = "
+	.pasciz " ", <254>, "v = "
 
 	; MSG_PIC_UNKNOWN_MODE
 	.section .text.MSG_PIC_UNKNOWN_MODE, code
 	.global _MSG_PIC_UNKNOWN_MODE_str
 _MSG_PIC_UNKNOWN_MODE_str:
-	.pasciz "unknown mode"
+	.pasciz "unk", <222>, "wn ", <197>, <154>
 
 	; MSG_PIN_OUTPUT_TYPE_PROMPT
 	.section .text.MSG_PIN_OUTPUT_TYPE_PROMPT, code
 	.global _MSG_PIN_OUTPUT_TYPE_PROMPT_str
 _MSG_PIN_OUTPUT_TYPE_PROMPT_str:
-	.pasciz "Select output type:\r\n 1. Open drain (H=Hi-Z, L=GND)\r\n 2. Normal (H=3.3V, L=GND)"
+	.pasciz <173>, <240>, "c", <133>, "o", <189>, "pu", <133>, "type", <178>, "Op", <140>, " dra", <138>, <137>, "H=", <234>, "-Z", <145>, "L=G", <238>, ")", <169>, "N", <144>, "m", <175>, <137>, "H=", <213>, "3V", <145>, "L=G", <238>, ")"
 
 	; MSG_POWER_SUPPLIES_OFF
 	.section .text.MSG_POWER_SUPPLIES_OFF, code
 	.global _MSG_POWER_SUPPLIES_OFF_str
 _MSG_POWER_SUPPLIES_OFF_str:
-	.pasciz "POWER SUPPLIES OFF"
+	.pasciz "P", <252>, <251>, <249>, "UPPLIES OFF"
 
 	; MSG_POWER_SUPPLIES_ON
 	.section .text.MSG_POWER_SUPPLIES_ON, code
 	.global _MSG_POWER_SUPPLIES_ON_str
 _MSG_POWER_SUPPLIES_ON_str:
-	.pasciz "POWER SUPPLIES ON"
+	.pasciz "P", <252>, <251>, <249>, "UPPLIES ", <217>
 
 	; MSG_PWM_FREQUENCY_TOO_LOW
 	.section .text.MSG_PWM_FREQUENCY_TOO_LOW, code
 	.global _MSG_PWM_FREQUENCY_TOO_LOW_str
 _MSG_PWM_FREQUENCY_TOO_LOW_str:
-	.pasciz "Frequencies < 1Hz are not supported."
+	.pasciz "F", <146>, "qu", <140>, "cie", <139>, "< 1", <150>, " ", <152>, <131>, <222>, <133>, "supp", <144>, "t", <166>, "."
 
 	; MSG_PWM_HZ_MARKER
 	.section .text.MSG_PWM_HZ_MARKER, code
 	.global _MSG_PWM_HZ_MARKER_str
 _MSG_PWM_HZ_MARKER_str:
-	.pasciz " Hz"
+	.pasciz " ", <150>
 
 	; MSG_RAW2WIRE_ATR_DATA_UNITS_HEADER
 	.section .text.MSG_RAW2WIRE_ATR_DATA_UNITS_HEADER, code
 	.global _MSG_RAW2WIRE_ATR_DATA_UNITS_HEADER_str
 _MSG_RAW2WIRE_ATR_DATA_UNITS_HEADER_str:
-	.pasciz "Data units: "
+	.pasciz "D", <186>, "a un", <141>, "s", <147>
 
 	; MSG_RAW2WIRE_ATR_DATA_UNITS_NO_INDICATION
 	.section .text.MSG_RAW2WIRE_ATR_DATA_UNITS_NO_INDICATION, code
 	.global _MSG_RAW2WIRE_ATR_DATA_UNITS_NO_INDICATION_str
 _MSG_RAW2WIRE_ATR_DATA_UNITS_NO_INDICATION_str:
-	.pasciz "no indication"
+	.pasciz "n", <134>, <138>, "d", <205>, "a", <180>, <143>
 
 	; MSG_RAW2WIRE_ATR_DATA_UNIT_LENGTH
 	.section .text.MSG_RAW2WIRE_ATR_DATA_UNIT_LENGTH, code
 	.global _MSG_RAW2WIRE_ATR_DATA_UNIT_LENGTH_str
 _MSG_RAW2WIRE_ATR_DATA_UNIT_LENGTH_str:
-	.pasciz "Data unit length (bits): "
+	.pasciz "D", <186>, "a un", <206>, "l", <140>, "gth", <137>, "b", <141>, "s)", <147>
 
 	; MSG_RAW2WIRE_ATR_PROTOCOL_2WIRE
 	.section .text.MSG_RAW2WIRE_ATR_PROTOCOL_2WIRE, code
 	.global _MSG_RAW2WIRE_ATR_PROTOCOL_2WIRE_str
 _MSG_RAW2WIRE_ATR_PROTOCOL_2WIRE_str:
-	.pasciz "2 wire"
+	.pasciz "2 wi", <146>
 
 	; MSG_RAW2WIRE_ATR_PROTOCOL_3WIRE
 	.section .text.MSG_RAW2WIRE_ATR_PROTOCOL_3WIRE, code
 	.global _MSG_RAW2WIRE_ATR_PROTOCOL_3WIRE_str
 _MSG_RAW2WIRE_ATR_PROTOCOL_3WIRE_str:
-	.pasciz "3 wire"
+	.pasciz "3 wi", <146>
 
 	; MSG_RAW2WIRE_ATR_PROTOCOL_HEADER
 	.section .text.MSG_RAW2WIRE_ATR_PROTOCOL_HEADER, code
 	.global _MSG_RAW2WIRE_ATR_PROTOCOL_HEADER_str
 _MSG_RAW2WIRE_ATR_PROTOCOL_HEADER_str:
-	.pasciz "Protocol: "
+	.pasciz "P", <242>, <223>, "c", <187>, <147>
 
 	; MSG_RAW2WIRE_ATR_PROTOCOL_SERIAL
 	.section .text.MSG_RAW2WIRE_ATR_PROTOCOL_SERIAL, code
 	.global _MSG_RAW2WIRE_ATR_PROTOCOL_SERIAL_str
 _MSG_RAW2WIRE_ATR_PROTOCOL_SERIAL_str:
-	.pasciz "serial"
+	.pasciz "s", <136>, "i", <175>
 
 	; MSG_RAW2WIRE_ATR_PROTOCOL_UNKNOWN
 	.section .text.MSG_RAW2WIRE_ATR_PROTOCOL_UNKNOWN, code
 	.global _MSG_RAW2WIRE_ATR_PROTOCOL_UNKNOWN_str
 _MSG_RAW2WIRE_ATR_PROTOCOL_UNKNOWN_str:
-	.pasciz "unknown"
+	.pasciz "unk", <222>, "wn"
 
 	; MSG_RAW2WIRE_ATR_READ_TYPE_HEADER
 	.section .text.MSG_RAW2WIRE_ATR_READ_TYPE_HEADER, code
 	.global _MSG_RAW2WIRE_ATR_READ_TYPE_HEADER_str
 _MSG_RAW2WIRE_ATR_READ_TYPE_HEADER_str:
-	.pasciz "Read type: "
+	.pasciz <254>, "a", <149>, "type", <147>
 
 	; MSG_RAW2WIRE_ATR_READ_TYPE_TO_END
 	.section .text.MSG_RAW2WIRE_ATR_READ_TYPE_TO_END, code
 	.global _MSG_RAW2WIRE_ATR_READ_TYPE_TO_END_str
 _MSG_RAW2WIRE_ATR_READ_TYPE_TO_END_str:
-	.pasciz "to end"
+	.pasciz <176>, <140>, "d"
 
 	; MSG_RAW2WIRE_ATR_READ_TYPE_VARIABLE_LENGTH
 	.section .text.MSG_RAW2WIRE_ATR_READ_TYPE_VARIABLE_LENGTH, code
 	.global _MSG_RAW2WIRE_ATR_READ_TYPE_VARIABLE_LENGTH_str
 _MSG_RAW2WIRE_ATR_READ_TYPE_VARIABLE_LENGTH_str:
-	.pasciz "variable length"
+	.pasciz "v", <152>, "iab", <160>, "l", <140>, "gth"
 
 	; MSG_RAW2WIRE_ATR_REPLY_HEADER
 	.section .text.MSG_RAW2WIRE_ATR_REPLY_HEADER, code
 	.global _MSG_RAW2WIRE_ATR_REPLY_HEADER_str
 _MSG_RAW2WIRE_ATR_REPLY_HEADER_str:
-	.pasciz "ISO 7816-3 reply (uses current LSB setting): "
+	.pasciz <215>, "O 78", <212>, "-3 ", <146>, "ply", <137>, <244>, "e", <139>, "curr", <140>, <133>, "LSB", <177>, <239>, "t", <138>, "g)", <147>
 
 	; MSG_RAW2WIRE_ATR_RFU
 	.section .text.MSG_RAW2WIRE_ATR_RFU, code
@@ -1394,7 +1546,7 @@ _MSG_RAW2WIRE_ATR_RFU_str:
 	.section .text.MSG_RAW2WIRE_ATR_TRIGGER_INFO, code
 	.global _MSG_RAW2WIRE_ATR_TRIGGER_INFO_str
 _MSG_RAW2WIRE_ATR_TRIGGER_INFO_str:
-	.pasciz "ISO 7816-3 ATR (RESET on CS)\r\nRESET HIGH, CLOCK TICK, RESET LOW"
+	.pasciz <215>, "O 78", <212>, "-3 ", <172>, "R", <137>, <156>, <194>, "T ", <143>, " ", <193>, ")", <128>, <156>, <194>, "T HIGH", <145>, <192>, "O", <231>, " TI", <231>, <145>, <156>, <194>, "T", <227>, <252>
 
 	; MSG_RAW2WIRE_I2C_START
 	.section .text.MSG_RAW2WIRE_I2C_START, code
@@ -1412,25 +1564,25 @@ _MSG_RAW2WIRE_I2C_STOP_str:
 	.section .text.MSG_RAW2WIRE_MACRO_MENU, code
 	.global _MSG_RAW2WIRE_MACRO_MENU_str
 _MSG_RAW2WIRE_MACRO_MENU_str:
-	.pasciz " 0.Macro menu\r\n 1.ISO7816-3 ATR\r\n 2.ISO7816-3 parse only"
+	.pasciz <226>, ".", <202>, <221>, "u", <157>, ".", <215>, "O78", <212>, "-3 ", <172>, "R", <151>, ".", <215>, "O78", <212>, "-3", <228>, <152>, "s", <131>, <143>, "ly"
 
 	; MSG_RAW2WIRE_MODE_HEADER
 	.section .text.MSG_RAW2WIRE_MODE_HEADER, code
 	.global _MSG_RAW2WIRE_MODE_HEADER_str
 _MSG_RAW2WIRE_MODE_HEADER_str:
-	.pasciz "R2W (spd hiz)=( "
+	.pasciz "R2W", <137>, <168>, <149>, <167>, "z)=( "
 
 	; MSG_RAW3WIRE_MODE_HEADER
 	.section .text.MSG_RAW3WIRE_MODE_HEADER, code
 	.global _MSG_RAW3WIRE_MODE_HEADER_str
 _MSG_RAW3WIRE_MODE_HEADER_str:
-	.pasciz "R3W (spd csl hiz)=( "
+	.pasciz "R3W", <137>, <168>, <149>, "csl ", <167>, "z)=( "
 
 	; MSG_RAW_BRG_VALUE_INPUT
 	.section .text.MSG_RAW_BRG_VALUE_INPUT, code
 	.global _MSG_RAW_BRG_VALUE_INPUT_str
 _MSG_RAW_BRG_VALUE_INPUT_str:
-	.pasciz "Enter raw value for BRG"
+	.pasciz "Ent", <136>, " raw v", <175>, "u", <131>, "f", <144>, <248>, "RG"
 
 	; MSG_RAW_MODE_IDENTIFIER
 	.section .text.MSG_RAW_MODE_IDENTIFIER, code
@@ -1442,121 +1594,127 @@ _MSG_RAW_MODE_IDENTIFIER_str:
 	.section .text.MSG_READ_HEADER, code
 	.global _MSG_READ_HEADER_str
 _MSG_READ_HEADER_str:
-	.pasciz "READ: "
+	.pasciz <156>, <179>, <147>
+
+	; MSG_REPEAT_NO_COMMAND_LINE
+	.section .text.MSG_REPEAT_NO_COMMAND_LINE, code
+	.global _MSG_REPEAT_NO_COMMAND_LINE_str
+_MSG_REPEAT_NO_COMMAND_LINE_str:
+	.pasciz "N", <134>, "bu", <139>, "co", <241>, <153>, <149>, "l", <138>, <131>, <176>, <146>, "pe", <186>
 
 	; MSG_SNIFFER_MESSAGE
 	.section .text.MSG_SNIFFER_MESSAGE, code
 	.global _MSG_SNIFFER_MESSAGE_str
 _MSG_SNIFFER_MESSAGE_str:
-	.pasciz "Sniffer"
+	.pasciz "Sni", <204>, <136>
 
 	; MSG_SOFTWARE_MODE_SPEED_PROMPT
 	.section .text.MSG_SOFTWARE_MODE_SPEED_PROMPT, code
 	.global _MSG_SOFTWARE_MODE_SPEED_PROMPT_str
 _MSG_SOFTWARE_MODE_SPEED_PROMPT_str:
-	.pasciz "Set speed:\r\n 1. ~5KHz\r\n 2. ~50KHz\r\n 3. ~100KHz\r\n 4. ~400KHz"
+	.pasciz <199>, <168>, "e", <166>, <178>, "~5", <184>, <169>, "~50", <184>, <130>, "3", <132>, "~1", <155>, <184>, <130>, "4", <132>, "~4", <155>, <184>
 
 	; MSG_SPI_COULD_NOT_KEEP_UP
 	.section .text.MSG_SPI_COULD_NOT_KEEP_UP, code
 	.global _MSG_SPI_COULD_NOT_KEEP_UP_str
 _MSG_SPI_COULD_NOT_KEEP_UP_str:
-	.pasciz "Couldn't keep up"
+	.pasciz "Co", <163>, "dn'", <133>, "kee", <188>, "up"
 
 	; MSG_SPI_CS_DISABLED
 	.section .text.MSG_SPI_CS_DISABLED, code
 	.global _MSG_SPI_CS_DISABLED_str
 _MSG_SPI_CS_DISABLED_str:
-	.pasciz "CS DISABLED"
+	.pasciz <193>, " D", <215>, "ABLED"
 
 	; MSG_SPI_CS_ENABLED
 	.section .text.MSG_SPI_CS_ENABLED, code
 	.global _MSG_SPI_CS_ENABLED_str
 _MSG_SPI_CS_ENABLED_str:
-	.pasciz "CS ENABLED"
+	.pasciz <193>, " ENABLED"
 
 	; MSG_SPI_CS_MODE_PROMPT
 	.section .text.MSG_SPI_CS_MODE_PROMPT, code
 	.global _MSG_SPI_CS_MODE_PROMPT_str
 _MSG_SPI_CS_MODE_PROMPT_str:
-	.pasciz "CS:\r\n 1. CS\r\n 2. /CS *default"
+	.pasciz <193>, <178>, <193>, <169>, "/", <193>, <191>, <154>, "f", <255>, "t"
 
 	; MSG_SPI_EDGE_PROMPT
 	.section .text.MSG_SPI_EDGE_PROMPT, code
 	.global _MSG_SPI_EDGE_PROMPT_str
 _MSG_SPI_EDGE_PROMPT_str:
-	.pasciz "Output clock edge:\r\n 1. Idle to active\r\n 2. Active to idle *default"
+	.pasciz "O", <189>, "pu", <133>, "c", <159>, "ck ", <166>, "ge", <178>, "I", <203>, <176>, <245>, "ve", <169>, "Ac", <180>, "v", <131>, <176>, "i", <203>, "*", <154>, "f", <255>, "t"
 
 	; MSG_SPI_MACRO_MENU
 	.section .text.MSG_SPI_MACRO_MENU, code
 	.global _MSG_SPI_MACRO_MENU_str
 _MSG_SPI_MACRO_MENU_str:
-	.pasciz " 0.Macro menu\r\n 1.Sniff CS low\r\n 2.Sniff all traffic\r\n10.Set clock idle low\r\n11.Set clock idle high\r\n12.Set edge idle to active\r\n13.Set edge active to idle\r\n14.Sample phase on middle\r\n15.Sample phase on end"
+	.pasciz <226>, ".", <202>, <221>, "u", <157>, ".Sni", <204>, " ", <193>, " ", <224>, <151>, ".Sni", <204>, " ", <175>, "l ", <243>, "a", <204>, <205>, <198>, "0.", <199>, "c", <159>, "ck i", <203>, <224>, <198>, "1.", <199>, "c", <159>, "ck i", <203>, <167>, "gh", <198>, "2.", <199>, <166>, "g", <131>, "i", <203>, <176>, <245>, "ve", <198>, <213>, <199>, <166>, "g", <131>, <245>, "v", <131>, <176>, "id", <240>, <198>, "4.Samp", <160>, "ph", <219>, <131>, <143>, " midd", <240>, <198>, "5.Samp", <160>, "ph", <219>, <131>, <143>, " ", <140>, "d"
 
 	; MSG_SPI_MODE_HEADER_START
 	.section .text.MSG_SPI_MODE_HEADER_START, code
 	.global _MSG_SPI_MODE_HEADER_START_str
 _MSG_SPI_MODE_HEADER_START_str:
-	.pasciz "SPI (spd ckp ske smp csl hiz)=( "
+	.pasciz "S", <253>, <137>, <168>, <149>, "ckp", <177>, "k", <131>, "sm", <188>, "csl ", <167>, "z)=( "
 
 	; MSG_SPI_MODE_IDENTIFIER
 	.section .text.MSG_SPI_MODE_IDENTIFIER, code
 	.global _MSG_SPI_MODE_IDENTIFIER_str
 _MSG_SPI_MODE_IDENTIFIER_str:
-	.pasciz "SPI1"
+	.pasciz "S", <253>, "1"
 
 	; MSG_SPI_PINS_STATE
 	.section .text.MSG_SPI_PINS_STATE, code
 	.global _MSG_SPI_PINS_STATE_str
 _MSG_SPI_PINS_STATE_str:
-	.pasciz "CLK\tMOSI\tCS\tMISO"
+	.pasciz <192>, "K\t", <237>, "SI\t", <193>, "\tM", <215>, "O"
 
 	; MSG_SPI_POLARITY_PROMPT
 	.section .text.MSG_SPI_POLARITY_PROMPT, code
 	.global _MSG_SPI_POLARITY_PROMPT_str
 _MSG_SPI_POLARITY_PROMPT_str:
-	.pasciz "Clock polarity:\r\n 1. Idle low *default\r\n 2. Idle high"
+	.pasciz "C", <159>, "ck", <228>, <187>, <152>, <141>, "y", <178>, "I", <203>, <224>, <191>, <154>, "f", <255>, "t", <169>, "I", <203>, <167>, "gh"
 
 	; MSG_SPI_SAMPLE_PROMPT
 	.section .text.MSG_SPI_SAMPLE_PROMPT, code
 	.global _MSG_SPI_SAMPLE_PROMPT_str
 _MSG_SPI_SAMPLE_PROMPT_str:
-	.pasciz "Input sample phase:\r\n 1. Middle *default\r\n 2. End"
+	.pasciz "Inpu", <133>, "samp", <160>, "ph", <219>, "e", <178>, "Mid", <203>, "*", <154>, "f", <255>, "t", <169>, "End"
 
 	; MSG_SPI_SPEED_PROMPT
 	.section .text.MSG_SPI_SPEED_PROMPT, code
 	.global _MSG_SPI_SPEED_PROMPT_str
 _MSG_SPI_SPEED_PROMPT_str:
-	.pasciz "Set speed:\r\n 1.  30KHz\r\n 2. 125KHz\r\n 3. 250KHz\r\n 4.   1MHz\r\n 5.  50KHz\r\n 6. 1.3MHz\r\n 7.   2MHz\r\n 8. 2.6MHz\r\n 9. 3.2MHz\r\n10.   4MHz\r\n11. 5.3MHz\r\n12.   8MHz"
+	.pasciz <199>, <168>, "e", <166>, <178>, " 30", <184>, <169>, "125", <184>, <130>, "3", <132>, "250", <184>, <130>, "4", <132>, <211>, "1", <216>, <130>, "5", <132>, " 50", <184>, <130>, "6", <132>, "1.3", <216>, <130>, "7", <132>, <211>, "2", <216>, <130>, "8", <132>, "2.6", <216>, <130>, "9", <132>, <213>, "2", <216>, <198>, "0", <132>, <211>, "4", <216>, <198>, "1", <132>, "5.3", <216>, <198>, "2", <132>, <211>, "8", <216>
 
 	; MSG_UART_BAUD_CALCULATED
 	.section .text.MSG_UART_BAUD_CALCULATED, code
 	.global _MSG_UART_BAUD_CALCULATED_str
 _MSG_UART_BAUD_CALCULATED_str:
-	.pasciz "\n\rCalculated: \t"
+	.pasciz "\n\rC", <175>, "c", <163>, <186>, <166>, <147>, "\t"
 
 	; MSG_UART_BAUD_ESTIMATED
 	.section .text.MSG_UART_BAUD_ESTIMATED, code
 	.global _MSG_UART_BAUD_ESTIMATED_str
 _MSG_UART_BAUD_ESTIMATED_str:
-	.pasciz "\n\rEstimated:  \t"
+	.pasciz "\n\rE", <161>, "im", <186>, <166>, <147>, " \t"
 
 	; MSG_UART_BAUD_OVERFLOW
 	.section .text.MSG_UART_BAUD_OVERFLOW, code
 	.global _MSG_UART_BAUD_OVERFLOW_str
 _MSG_UART_BAUD_OVERFLOW_str:
-	.pasciz "** Baud>16m: The BP cannot measure above 16000000, Done."
+	.pasciz "**", <248>, "aud>", <212>, "m", <147>, "Th", <131>, "BP", <250>, <153>, <222>, <133>, "me", <219>, "ur", <131>, "abov", <131>, <212>, <155>, <155>, <155>, <145>, "D", <143>, "e."
 
 	; MSG_UART_BITS_PARITY_PROMPT
 	.section .text.MSG_UART_BITS_PARITY_PROMPT, code
 	.global _MSG_UART_BITS_PARITY_PROMPT_str
 _MSG_UART_BITS_PARITY_PROMPT_str:
-	.pasciz "Data bits and parity:\r\n 1. 8, NONE *default \r\n 2. 8, EVEN \r\n 3. 8, ODD \r\n 4. 9, NONE"
+	.pasciz "D", <186>, "a b", <141>, <139>, <153>, <149>, "p", <152>, <141>, "y", <178>, "8", <145>, "N", <217>, "E", <191>, <154>, "f", <255>, <133>, <169>, "8", <145>, "EVEN ", <130>, "3", <132>, "8", <145>, "ODD ", <130>, "4", <132>, "9", <145>, "N", <217>, "E"
 
 	; MSG_UART_BITS_STOP_PROMPT
 	.section .text.MSG_UART_BITS_STOP_PROMPT, code
 	.global _MSG_UART_BITS_STOP_PROMPT_str
 _MSG_UART_BITS_STOP_PROMPT_str:
-	.pasciz "Stop bits:\r\n 1. 1 *default\r\n 2. 2"
+	.pasciz "S", <223>, <188>, "b", <141>, "s", <178>, "1", <191>, <154>, "f", <255>, "t", <169>, "2"
 
 	; MSG_UART_BPS_MARKER
 	.section .text.MSG_UART_BPS_MARKER, code
@@ -1568,25 +1726,25 @@ _MSG_UART_BPS_MARKER_str:
 	.section .text.MSG_UART_BRIDGE, code
 	.global _MSG_UART_BRIDGE_str
 _MSG_UART_BRIDGE_str:
-	.pasciz "UART bridge"
+	.pasciz "U", <158>, "T bridge"
 
 	; MSG_UART_BRIDGE_EXIT
 	.section .text.MSG_UART_BRIDGE_EXIT, code
 	.global _MSG_UART_BRIDGE_EXIT_str
 _MSG_UART_BRIDGE_EXIT_str:
-	.pasciz "Reset to exit"
+	.pasciz "R", <185>, "e", <133>, <176>, <195>, <141>
 
 	; MSG_UART_EARLY_EXIT
 	.section .text.MSG_UART_EARLY_EXIT, code
 	.global _MSG_UART_EARLY_EXIT_str
 _MSG_UART_EARLY_EXIT_str:
-	.pasciz "** Early Exit!"
+	.pasciz "** E", <152>, "l", <164>, "Ex", <141>, "!"
 
 	; MSG_UART_FAILED_NO_DATA
 	.section .text.MSG_UART_FAILED_NO_DATA, code
 	.global _MSG_UART_FAILED_NO_DATA_str
 _MSG_UART_FAILED_NO_DATA_str:
-	.pasciz "FAILED, NO DATA"
+	.pasciz "FAILED", <145>, "NO ", <233>, "A"
 
 	; MSG_UART_FRAMING_ERROR
 	.section .text.MSG_UART_FRAMING_ERROR, code
@@ -1598,91 +1756,97 @@ _MSG_UART_FRAMING_ERROR_str:
 	.section .text.MSG_UART_LIVE_DISPLAY_START, code
 	.global _MSG_UART_LIVE_DISPLAY_START_str
 _MSG_UART_LIVE_DISPLAY_START_str:
-	.pasciz "UART LIVE DISPLAY, } TO STOP"
+	.pasciz "U", <158>, "T", <227>, "IVE D", <215>, "PLAY", <145>, "} TO", <249>, "TOP"
 
 	; MSG_UART_LIVE_DISPLAY_STOP
 	.section .text.MSG_UART_LIVE_DISPLAY_STOP, code
 	.global _MSG_UART_LIVE_DISPLAY_STOP_str
 _MSG_UART_LIVE_DISPLAY_STOP_str:
-	.pasciz "LIVE DISPLAY STOPPED"
+	.pasciz "LIVE D", <215>, "PLAY", <249>, "TOPPED"
 
 	; MSG_UART_MACRO_MENU
 	.section .text.MSG_UART_MACRO_MENU, code
 	.global _MSG_UART_MACRO_MENU_str
 _MSG_UART_MACRO_MENU_str:
-	.pasciz " 0.Macro menu\r\n 1.Transparent bridge\r\n 2.Live monitor\r\n 3.Bridge with flow control\n\r 4.Auto Baud Detection"
+	.pasciz <226>, ".", <202>, <221>, "u", <157>, ".Tr", <153>, <168>, <152>, <140>, <133>, "bridge", <151>, ".Liv", <131>, "m", <143>, <141>, <144>, <130>, <213>, "Bridg", <131>, "w", <141>, "h f", <224>, <250>, <143>, <243>, <187>, "\n\r 4.Au", <176>, "Bau", <149>, "D", <239>, "ec", <180>, <143>
 
 	; MSG_UART_MODE_HEADER
 	.section .text.MSG_UART_MODE_HEADER, code
 	.global _MSG_UART_MODE_HEADER_str
 _MSG_UART_MODE_HEADER_str:
-	.pasciz "UART (spd brg dbp sb rxp hiz)=( "
+	.pasciz "U", <158>, "T", <137>, <168>, <149>, "br", <196>, "dbp", <177>, "b rx", <188>, <167>, "z)=( "
 
 	; MSG_UART_MODE_IDENTIFIER
 	.section .text.MSG_UART_MODE_IDENTIFIER, code
 	.global _MSG_UART_MODE_IDENTIFIER_str
 _MSG_UART_MODE_IDENTIFIER_str:
-	.pasciz "ART1"
+	.pasciz <158>, "T1"
 
 	; MSG_UART_OVERRUN_ERROR
 	.section .text.MSG_UART_OVERRUN_ERROR, code
 	.global _MSG_UART_OVERRUN_ERROR_str
 _MSG_UART_OVERRUN_ERROR_str:
-	.pasciz "*Bytes dropped*"
+	.pasciz "*Byte", <139>, "d", <242>, "pp", <166>, "*"
 
 	; MSG_UART_PARITY_ERROR
 	.section .text.MSG_UART_PARITY_ERROR, code
 	.global _MSG_UART_PARITY_ERROR_str
 _MSG_UART_PARITY_ERROR_str:
-	.pasciz "-p "
+	.pasciz "-", <188>
 
 	; MSG_UART_PINS_STATE
 	.section .text.MSG_UART_PINS_STATE, code
 	.global _MSG_UART_PINS_STATE_str
 _MSG_UART_PINS_STATE_str:
-	.pasciz "-\tTxD\t-\tRxD"
+	.pasciz "-\tTxD", <247>, "\tRxD"
 
 	; MSG_UART_POLARITY_PROMPT
 	.section .text.MSG_UART_POLARITY_PROMPT, code
 	.global _MSG_UART_POLARITY_PROMPT_str
 _MSG_UART_POLARITY_PROMPT_str:
-	.pasciz "Receive polarity:\r\n 1. Idle 1 *default\r\n 2. Idle 0"
+	.pasciz <254>, "ceiv", <131>, "p", <187>, <152>, <141>, "y", <178>, "I", <203>, "1", <191>, <154>, "f", <255>, "t", <169>, "I", <203>, "0"
 
 	; MSG_UART_POSSIBLE_OVERFLOW
 	.section .text.MSG_UART_POSSIBLE_OVERFLOW, code
 	.global _MSG_UART_POSSIBLE_OVERFLOW_str
 _MSG_UART_POSSIBLE_OVERFLOW_str:
-	.pasciz "WARNING: Possible buffer overflow"
+	.pasciz "W", <158>, "N", <235>, "G", <147>, "Possib", <160>, "bu", <204>, <136>, " ov", <136>, "f", <224>
 
 	; MSG_UART_RAW_BRG_PROMPT
 	.section .text.MSG_UART_RAW_BRG_PROMPT, code
 	.global _MSG_UART_RAW_BRG_PROMPT_str
 _MSG_UART_RAW_BRG_PROMPT_str:
-	.pasciz "Raw value for BRG (MIDI=127)"
+	.pasciz "Raw v", <175>, "u", <131>, "f", <144>, <248>, "RG", <137>, "MIDI=127)"
 
 	; MSG_UART_RAW_UART_INPUT
 	.section .text.MSG_UART_RAW_UART_INPUT, code
 	.global _MSG_UART_RAW_UART_INPUT_str
 _MSG_UART_RAW_UART_INPUT_str:
-	.pasciz "Raw UART input"
+	.pasciz "Raw U", <158>, "T ", <138>, "p", <189>
 
 	; MSG_UART_SET_PORT_SPEED
 	.section .text.MSG_UART_SET_PORT_SPEED, code
 	.global _MSG_UART_SET_PORT_SPEED_str
 _MSG_UART_SET_PORT_SPEED_str:
-	.pasciz "Set serial port speed: (bps)\r\n 1. 300\r\n 2. 1200\r\n 3. 2400\r\n 4. 4800\r\n 5. 9600\r\n 6. 19200\r\n 7. 38400\r\n 8. 57600\r\n 9. 115200\r\n10. BRG raw value"
+	.pasciz <199>, "s", <136>, "i", <175>, <228>, <144>, <133>, <168>, "e", <166>, ":", <137>, "bps)", <170>, "3", <155>, <169>, "12", <155>, <130>, "3", <132>, "24", <155>, <130>, "4", <132>, "48", <155>, <130>, "5", <132>, "96", <155>, <130>, "6", <132>, "192", <155>, <130>, "7", <132>, "384", <155>, <130>, "8", <132>, "576", <155>, <130>, "9", <132>, "1152", <155>, <198>, "0", <132>, "BRG raw v", <175>, "ue"
 
 	; MSG_UART_WAITING_ACTIVITY
 	.section .text.MSG_UART_WAITING_ACTIVITY, code
 	.global _MSG_UART_WAITING_ACTIVITY_str
 _MSG_UART_WAITING_ACTIVITY_str:
-	.pasciz "Waiting activity..."
+	.pasciz "Wa", <141>, <138>, <196>, <245>, "v", <141>, "y..."
 
 	; MSG_UNKNOWN_MACRO_ERROR
 	.section .text.MSG_UNKNOWN_MACRO_ERROR, code
 	.global _MSG_UNKNOWN_MACRO_ERROR_str
 _MSG_UNKNOWN_MACRO_ERROR_str:
-	.pasciz "Unknown macro, try ? or (0) for help"
+	.pasciz "Unk", <222>, "wn m", <181>, "o", <145>, <243>, <164>, "? ", <144>, <137>, "0", <171>, "f", <144>, " help"
+
+	; MSG_USER_MACRO_STORAGE_FULL
+	.section .text.MSG_USER_MACRO_STORAGE_FULL, code
+	.global _MSG_USER_MACRO_STORAGE_FULL_str
+_MSG_USER_MACRO_STORAGE_FULL_str:
+	.pasciz <202>, <161>, <144>, "ag", <131>, "f", <163>, "l"
 
 	; MSG_VOLTAGE_UNIT
 	.section .text.MSG_VOLTAGE_UNIT, code
@@ -1694,17 +1858,17 @@ _MSG_VOLTAGE_UNIT_str:
 	.section .text.MSG_VREG_TOO_LOW, code
 	.global _MSG_VREG_TOO_LOW_str
 _MSG_VREG_TOO_LOW_str:
-	.pasciz "VREG too low, is there a short?"
+	.pasciz "V", <156>, "G ", <223>, <134>, <224>, <145>, "i", <139>, "th", <136>, <131>, "a", <177>, "h", <144>, "t?"
 
 	; MSG_WARNING_HEADER
 	.section .text.MSG_WARNING_HEADER, code
 	.global _MSG_WARNING_HEADER_str
 _MSG_WARNING_HEADER_str:
-	.pasciz "Warning: "
+	.pasciz "W", <152>, "n", <138>, "g", <147>
 
 	; MSG_WARNING_SHORT_OR_NO_PULLUP
 	.section .text.MSG_WARNING_SHORT_OR_NO_PULLUP, code
 	.global _MSG_WARNING_SHORT_OR_NO_PULLUP_str
 _MSG_WARNING_SHORT_OR_NO_PULLUP_str:
-	.pasciz "*Short or no pull-up "
+	.pasciz "*Sh", <144>, <133>, <144>, " n", <134>, "p", <163>, "l-u", <188>
 
@@ -1,200 +1,334 @@
+	; Message dictionary
+	; <128> "\r\n"
+	; <129> "--"
+	; <130> "\r\n "
+	; <131> "t "
+	; <132> "e "
+	; <133> ". "
+	; <134> "in"
+	; <135> "o "
+	; <136> "on"
+	; <137> "d "
+	; <138> "----"
+	; <139> "er"
+	; <140> "s "
+	; <141> "it"
+	; <142> "  "
+	; <143> "en"
+	; <144> " ("
+	; <145> "ar"
+	; <146> ", "
+	; <147> "or"
+	; <148> "\t\t"
+	; <149> "re"
+	; <150> "ac"
+	; <151> ": "
+	; <152> "\r\n 2"
+	; <153> "Hz"
+	; <154> "de"
+	; <155> "RO"
+	; <156> "te"
+	; <157> "\r\n 1"
+	; <158> "RE"
+	; <159> "an"
+	; <160> "ul"
+	; <161> "y "
+	; <162> "00"
+	; <163> "st"
+	; <164> "al"
+	; <165> "lo"
+	; <166> ") "
+	; <167> "le "
+	; <168> "ti"
+	; <169> "--------"
+	; <170> "Se"
+	; <171> "p "
+	; <172> "AR"
+	; <173> "AU"
+	; <174> "ad"
+	; <175> "ol"
+	; <176> "sp"
+	; <177> "to "
+	; <178> "\r\n 2. "
+	; <179> "\r\n 1. "
+	; <180> "AD"
+	; <181> "AT"
+	; <182> "ed"
+	; <183> "g "
+	; <184> "hi"
+	; <185> "ROM"
+	; <186> ":\r\n 1. "
+	; <187> "pu"
+	; <188> "acr"
+	; <189> "AUX"
+	; <190> " s"
+	; <191> "0x"
+	; <192> "KHz"
+	; <193> "\tS"
+	; <194> "CL"
+	; <195> "SE"
+	; <196> "ex"
+	; <197> "\r\n1"
+	; <198> "Set "
+	; <199> "acro "
+	; <200> "\t#"
+	; <201> "3."
+	; <202> "CS"
+	; <203> "mo"
+	; <204> "om"
+	; <205> "ou"
+	; <206> " *"
+	; <207> "Macro "
+	; <208> "ab"
+	; <209> "as"
+	; <210> "dle "
+	; <211> "ic"
+	; <212> "it "
+	; <213> "le"
+	; <214> "to"
+	; <215> "tr"
+	; <216> "us"
+	; <217> " (0x"
+	; <218> "ull"
+	; <219> "tiv"
+	; <220> " p"
+	; <221> "-\t"
+	; <222> "16"
+	; <223> "CH"
+	; <224> "IS"
+	; <225> "MHz"
+	; <226> "ON"
+	; <227> "Re"
+	; <228> "ch"
+	; <229> "con"
+	; <230> "ge "
+	; <231> "is"
+	; <232> "men"
+	; <233> "no"
+	; <234> "up "
+	; <235> "   "
+	; <236> "\t\t\t"
+	; <237> "\t#0"
+	; <238> " 0"
+	; <239> " L"
+	; <240> " ROM"
+	; <241> "2C"
+	; <242> "CK"
+	; <243> "DE"
+	; <244> "DAT"
+	; <245> "Hi"
+	; <246> "I2C"
+	; <247> "MO"
+	; <248> "ND"
+	; <249> "PU"
+	; <250> "bo"
+	; <251> "et"
+	; <252> "ff"
+	; <253> "ro"
+	; <254> "ta"
+	; <255> "ard "
+	.section .text.bp_message_dictionary, code
+	.global _bp_message_dictionary
+_bp_message_dictionary:
+	.pbyte 0x0D, 0x0A, 0x2D, 0x2D, 0x80, 0x20, 0x74, 0x20, 0x65, 0x20, 0x2E, 0x20, 0x69, 0x6E, 0x6F, 0x20, 0x6F, 0x6E, 0x64, 0x20, 0x81, 0x81, 0x65, 0x72, 0x73, 0x20, 0x69, 0x74, 0x20, 0x20, 0x65, 0x6E, 0x20, 0x28, 0x61, 0x72, 0x2C, 0x20, 0x6F, 0x72, 0x09, 0x09, 0x72, 0x65, 0x61, 0x63, 0x3A, 0x20, 0x82, 0x32, 0x48, 0x7A, 0x64, 0x65, 0x52, 0x4F, 0x74, 0x65, 0x82, 0x31, 0x52, 0x45, 0x61, 0x6E, 0x75, 0x6C, 0x79, 0x20, 0x30, 0x30, 0x73, 0x74, 0x61, 0x6C, 0x6C, 0x6F, 0x29, 0x20, 0x6C, 0x84, 0x74, 0x69, 0x8A, 0x8A, 0x53, 0x65, 0x70, 0x20, 0x41, 0x52, 0x41, 0x55, 0x61, 0x64, 0x6F, 0x6C, 0x73, 0x70, 0x74, 0x87, 0x98, 0x85, 0x9D, 0x85, 0x41, 0x44, 0x41, 0x54, 0x65, 0x64, 0x67, 0x20, 0x68, 0x69, 0x9B, 0x4D, 0x3A, 0xB3, 0x70, 0x75, 0x96, 0x72, 0xAD, 0x58, 0x20, 0x73, 0x30, 0x78, 0x4B, 0x99, 0x09, 0x53, 0x43, 0x4C, 0x53, 0x45, 0x65, 0x78, 0x80, 0x31, 0xAA, 0x83, 0xBC, 0x87, 0x09, 0x23, 0x33, 0x2E, 0x43, 0x53, 0x6D, 0x6F, 0x6F, 0x6D, 0x6F, 0x75, 0x20, 0x2A, 0x4D, 0xC7, 0x61, 0x62, 0x61, 0x73, 0x64, 0xA7, 0x69, 0x63, 0x69, 0x83, 0x6C, 0x65, 0x74, 0x6F, 0x74, 0x72, 0x75, 0x73, 0x90, 0xBF, 0xA0, 0x6C, 0xA8, 0x76, 0x20, 0x70, 0x2D, 0x09, 0x31, 0x36, 0x43, 0x48, 0x49, 0x53, 0x4D, 0x99, 0x4F, 0x4E, 0x52, 0x65, 0x63, 0x68, 0x63, 0x88, 0x67, 0x84, 0x69, 0x73, 0x6D, 0x8F, 0x6E, 0x6F, 0x75, 0xAB, 0x8E, 0x20, 0x94, 0x09, 0xC8, 0x30, 0x20, 0x30, 0x20, 0x4C, 0x20, 0xB9, 0x32, 0x43, 0x43, 0x4B, 0x44, 0x45, 0x44, 0xB5, 0x48, 0x69, 0x49, 0xF1, 0x4D, 0x4F, 0x4E, 0x44, 0x50, 0x55, 0x62, 0x6F, 0x65, 0x74, 0x66, 0x66, 0x72, 0x6F, 0x74, 0x61, 0x91, 0x89
+
 	; BPMSG1022
 	.section .text.BPMSG1022, code
 	.global _BPMSG1022_str
 _BPMSG1022_str:
-	.pasciz "DS18S20 High Prec Dig Therm"
+	.pasciz "DS18S20 ", <245>, "gh P", <149>, "c Di", <183>, "Th", <139>, "m"
 
 	; BPMSG1023
 	.section .text.BPMSG1023, code
 	.global _BPMSG1023_str
 _BPMSG1023_str:
-	.pasciz "DS18B20 Prog Res Dig Therm"
+	.pasciz "DS18B20 P", <253>, <183>, <227>, <140>, "Di", <183>, "Th", <139>, "m"
 
 	; BPMSG1024
 	.section .text.BPMSG1024, code
 	.global _BPMSG1024_str
 _BPMSG1024_str:
-	.pasciz "DS1822 Econo Dig Therm"
+	.pasciz "DS1822 E", <229>, <135>, "Di", <183>, "Th", <139>, "m"
 
 	; BPMSG1025
 	.section .text.BPMSG1025, code
 	.global _BPMSG1025_str
 _BPMSG1025_str:
-	.pasciz "DS2404 EconoRAM time Chip"
+	.pasciz "DS2404 E", <229>, "oRAM ", <168>, "m", <132>, "C", <184>, "p"
 
 	; BPMSG1026
 	.section .text.BPMSG1026, code
 	.global _BPMSG1026_str
 _BPMSG1026_str:
-	.pasciz "DS2431 1K EEPROM"
+	.pasciz "DS2431 1K EEP", <185>
 
 	; BPMSG1027
 	.section .text.BPMSG1027, code
 	.global _BPMSG1027_str
 _BPMSG1027_str:
-	.pasciz "Unknown device"
+	.pasciz "Unk", <233>, "wn ", <154>, "v", <211>, "e"
 
 	; BPMSG1028
 	.section .text.BPMSG1028, code
 	.global _BPMSG1028_str
 _BPMSG1028_str:
-	.pasciz "PWM disabled"
+	.pasciz "PWM d", <231>, <208>, "l", <182>
 
 	; BPMSG1029
 	.section .text.BPMSG1029, code
 	.global _BPMSG1029_str
 _BPMSG1029_str:
-	.pasciz "1KHz-4,000KHz PWM"
+	.pasciz "1", <192>, "-4,", <162>, "0", <192>, " PWM"
 
 	; BPMSG1030
 	.section .text.BPMSG1030, code
 	.global _BPMSG1030_str
 _BPMSG1030_str:
-	.pasciz "Frequency in KHz "
+	.pasciz "F", <149>, "qu", <143>, "c", <161>, <134>, " ", <192>, " "
 
 	; BPMSG1033
 	.section .text.BPMSG1033, code
 	.global _BPMSG1033_str
 _BPMSG1033_str:
-	.pasciz "Duty cycle in % "
+	.pasciz "Dut", <161>, "cyc", <167>, <134>, " % "
 
 	; BPMSG1034
 	.section .text.BPMSG1034, code
 	.global _BPMSG1034_str
 _BPMSG1034_str:
-	.pasciz "PWM active"
+	.pasciz "PWM ", <150>, <219>, "e"
 
 	; BPMSG1037
 	.section .text.BPMSG1037, code
 	.global _BPMSG1037_str
 _BPMSG1037_str:
-	.pasciz "ERROR: PWM active, g to disable"
+	.pasciz "ER", <155>, "R", <151>, "PWM ", <150>, <219>, "e", <146>, <183>, <177>, "d", <231>, <208>, <213>
 
 	; BPMSG1038
 	.section .text.BPMSG1038, code
 	.global _BPMSG1038_str
 _BPMSG1038_str:
-	.pasciz "AUX Frequency: "
+	.pasciz <189>, " F", <149>, "qu", <143>, "cy", <151>
 
 	; BPMSG1039
 	.section .text.BPMSG1039, code
 	.global _BPMSG1039_str
 _BPMSG1039_str:
-	.pasciz "AUX INPUT/HI-Z"
+	.pasciz <189>, " IN", <249>, "T/HI-Z"
 
 	; BPMSG1040
 	.section .text.BPMSG1040, code
 	.global _BPMSG1040_str
 _BPMSG1040_str:
-	.pasciz "AUX HIGH"
+	.pasciz <189>, " HIGH"
 
 	; BPMSG1041
 	.section .text.BPMSG1041, code
 	.global _BPMSG1041_str
 _BPMSG1041_str:
-	.pasciz "AUX LOW"
+	.pasciz <189>, <239>, "OW"
 
 	; BPMSG1047
 	.section .text.BPMSG1047, code
 	.global _BPMSG1047_str
 _BPMSG1047_str:
-	.pasciz "Error("
+	.pasciz "Err", <147>, "("
 
 	; BPMSG1048
 	.section .text.BPMSG1048, code
 	.global _BPMSG1048_str
 _BPMSG1048_str:
-	.pasciz ") @line:"
+	.pasciz <166>, "@l", <134>, "e:"
 
 	; BPMSG1049
 	.section .text.BPMSG1049, code
 	.global _BPMSG1049_str
 _BPMSG1049_str:
-	.pasciz " @pgmspace:"
+	.pasciz " @pgm", <176>, <150>, "e:"
 
 	; BPMSG1050
 	.section .text.BPMSG1050, code
 	.global _BPMSG1050_str
 _BPMSG1050_str:
-	.pasciz " bytes."
+	.pasciz " by", <156>, "s."
 
 	; BPMSG1051
 	.section .text.BPMSG1051, code
 	.global _BPMSG1051_str
 _BPMSG1051_str:
-	.pasciz "Too long!"
+	.pasciz "To", <135>, "l", <136>, "g!"
 
 	; BPMSG1052
 	.section .text.BPMSG1052, code
 	.global _BPMSG1052_str
 _BPMSG1052_str:
-	.pasciz "Syntax error"
+	.pasciz "Syn", <254>, "x ", <139>, "r", <147>
 
 	; BPMSG1053
 	.section .text.BPMSG1053, code
 	.global _BPMSG1053_str
 _BPMSG1053_str:
-	.pasciz "No EEPROM"
+	.pasciz "N", <135>, "EEP", <185>
 
 	; BPMSG1054
 	.section .text.BPMSG1054, code
 	.global _BPMSG1054_str
 _BPMSG1054_str:
-	.pasciz "Erasing"
+	.pasciz "Er", <209>, <134>, "g"
 
 	; BPMSG1055
 	.section .text.BPMSG1055, code
 	.global _BPMSG1055_str
 _BPMSG1055_str:
-	.pasciz "done"
+	.pasciz "d", <136>, "e"
 
 	; BPMSG1056
 	.section .text.BPMSG1056, code
 	.global _BPMSG1056_str
 _BPMSG1056_str:
-	.pasciz "Saving to slot "
+	.pasciz "Sav", <134>, <183>, <177>, "s", <165>, <131>
 
 	; BPMSG1057
 	.section .text.BPMSG1057, code
 	.global _BPMSG1057_str
 _BPMSG1057_str:
-	.pasciz "Invalid slot"
+	.pasciz "Inv", <164>, "i", <137>, "s", <165>, "t"
 
 	; BPMSG1058
 	.section .text.BPMSG1058, code
 	.global _BPMSG1058_str
 _BPMSG1058_str:
-	.pasciz "Loading from slot "
+	.pasciz "Lo", <174>, <134>, <183>, "fr", <204>, <190>, <165>, <131>
 
 	; BPMSG1064
 	.section .text.BPMSG1064, code
 	.global _BPMSG1064_str
 _BPMSG1064_str:
-	.pasciz "I2C mode:\r\n 1. Software\r\n 2. Hardware"
+	.pasciz <246>, " ", <203>, <154>, <186>, "Softw", <145>, "e", <178>, "H", <145>, "dw", <145>, "e"
 
 	; BPMSG1067
 	.section .text.BPMSG1067, code
 	.global _BPMSG1067_str
 _BPMSG1067_str:
-	.pasciz "Set speed:\r\n 1. 100KHz\r\n 2. 400KHz\r\n 3. 1MHz"
+	.pasciz <198>, <176>, "e", <182>, <186>, "1", <162>, <192>, <178>, "4", <162>, <192>, <130>, "3", <133>, "1", <225>
 
 	; BPMSG1068
 	.section .text.BPMSG1068, code
 	.global _BPMSG1068_str
 _BPMSG1068_str:
-	.pasciz "I2C (mod spd)=( "
+	.pasciz <246>, <144>, <203>, <137>, <176>, "d)=( "
 
 	; BPMSG1069
 	.section .text.BPMSG1069, code
 	.global _BPMSG1069_str
 _BPMSG1069_str:
-	.pasciz " 0.Macro menu\r\n 1.7bit address search\r\n 2.I2C sniffer\r\n 3.Connect to on-board EEPROM\r\n 4.Enable Writing the on-board EEPROM"
+	.pasciz <238>, ".", <207>, <232>, "u", <157>, ".7b", <212>, <174>, "d", <149>, "s", <140>, "se", <145>, <228>, <152>, ".", <246>, <190>, "ni", <252>, <139>, <130>, <201>, "C", <136>, "nec", <131>, <177>, <136>, "-", <250>, <255>, "EEP", <185>, <130>, "4.En", <208>, <167>, "Wr", <141>, <134>, <183>, "th", <132>, <136>, "-", <250>, <255>, "EEP", <185>
 
 	; BPMSG1070
 	.section .text.BPMSG1070, code
 	.global _BPMSG1070_str
 _BPMSG1070_str:
-	.pasciz "Searching I2C address space. Found devices at:"
+	.pasciz <170>, <145>, <228>, <134>, <183>, <246>, " ", <174>, "d", <149>, "s", <140>, <176>, <150>, "e", <133>, "F", <205>, "n", <137>, <154>, "v", <211>, "e", <140>, "at:"
 
 	; BPMSG1084
 	.section .text.BPMSG1084, code
@@ -206,223 +340,223 @@ _BPMSG1084_str:
 	.section .text.BPMSG1085, code
 	.global _BPMSG1085_str
 _BPMSG1085_str:
-	.pasciz "Ready"
+	.pasciz <227>, <174>, "y"
 
 	; BPMSG1086
 	.section .text.BPMSG1086, code
 	.global _BPMSG1086_str
 _BPMSG1086_str:
-	.pasciz "a/A/@ controls AUX pin"
+	.pasciz "a/A/@ ", <229>, <215>, <175>, <140>, <189>, <220>, <134>
 
 	; BPMSG1087
 	.section .text.BPMSG1087, code
 	.global _BPMSG1087_str
 _BPMSG1087_str:
-	.pasciz "a/A/@ controls CS pin"
+	.pasciz "a/A/@ ", <229>, <215>, <175>, <140>, <202>, <220>, <134>
 
 	; BPMSG1088
 	.section .text.BPMSG1088, code
 	.global _BPMSG1088_str
 _BPMSG1088_str:
-	.pasciz "Command not used in this mode"
+	.pasciz "C", <204>, "m", <159>, <137>, <233>, <131>, <216>, "e", <137>, <134>, " t", <184>, <140>, <203>, <154>
 
 	; BPMSG1089
 	.section .text.BPMSG1089, code
 	.global _BPMSG1089_str
 _BPMSG1089_str:
-	.pasciz "Pull-up resistors OFF"
+	.pasciz "P", <218>, "-", <234>, <149>, "si", <163>, <147>, <140>, "OFF"
 
 	; BPMSG1091
 	.section .text.BPMSG1091, code
 	.global _BPMSG1091_str
 _BPMSG1091_str:
-	.pasciz "Pull-up resistors ON"
+	.pasciz "P", <218>, "-", <234>, <149>, "si", <163>, <147>, <140>, <226>
 
 	; BPMSG1092
 	.section .text.BPMSG1092, code
 	.global _BPMSG1092_str
 _BPMSG1092_str:
-	.pasciz "Self-test in HiZ mode only"
+	.pasciz <170>, "lf-", <156>, "s", <131>, <134>, " ", <245>, "Z ", <203>, "d", <132>, <136>, "ly"
 
 	; BPMSG1093
 	.section .text.BPMSG1093, code
 	.global _BPMSG1093_str
 _BPMSG1093_str:
-	.pasciz "RESET"
+	.pasciz <158>, <195>, "T"
 
 	; BPMSG1094
 	.section .text.BPMSG1094, code
 	.global _BPMSG1094_str
 _BPMSG1094_str:
-	.pasciz "BOOTLOADER"
+	.pasciz "BOOTLO", <180>, "ER"
 
 	; BPMSG1095
 	.section .text.BPMSG1095, code
 	.global _BPMSG1095_str
 _BPMSG1095_str:
-	.pasciz "AUX INPUT/HI-Z, READ: "
+	.pasciz <189>, " IN", <249>, "T/HI-Z", <146>, <158>, <180>, <151>
 
 	; BPMSG1098
 	.section .text.BPMSG1098, code
 	.global _BPMSG1098_str
 _BPMSG1098_str:
-	.pasciz "DATA STATE: "
+	.pasciz <244>, "A ST", <181>, "E", <151>
 
 	; BPMSG1099
 	.section .text.BPMSG1099, code
 	.global _BPMSG1099_str
 _BPMSG1099_str:
-	.pasciz "DELAY "
+	.pasciz <243>, "LAY "
 
 	; BPMSG1100
 	.section .text.BPMSG1100, code
 	.global _BPMSG1100_str
 _BPMSG1100_str:
-	.pasciz "us"
+	.pasciz <216>
 
 	; BPMSG1101
 	.section .text.BPMSG1101, code
 	.global _BPMSG1101_str
 _BPMSG1101_str:
-	.pasciz "WRITE: "
+	.pasciz "WRITE", <151>
 
 	; BPMSG1103
 	.section .text.BPMSG1103, code
 	.global _BPMSG1103_str
 _BPMSG1103_str:
-	.pasciz "CLOCK, 1"
+	.pasciz <194>, "O", <242>, <146>, "1"
 
 	; BPMSG1104
 	.section .text.BPMSG1104, code
 	.global _BPMSG1104_str
 _BPMSG1104_str:
-	.pasciz "CLOCK, 0"
+	.pasciz <194>, "O", <242>, <146>, "0"
 
 	; BPMSG1105
 	.section .text.BPMSG1105, code
 	.global _BPMSG1105_str
 _BPMSG1105_str:
-	.pasciz "DATA OUTPUT, 1"
+	.pasciz <244>, "A OUT", <249>, "T", <146>, "1"
 
 	; BPMSG1106
 	.section .text.BPMSG1106, code
 	.global _BPMSG1106_str
 _BPMSG1106_str:
-	.pasciz "DATA OUTPUT, 0"
+	.pasciz <244>, "A OUT", <249>, "T", <146>, "0"
 
 	; BPMSG1107
 	.section .text.BPMSG1107, code
 	.global _BPMSG1107_str
 _BPMSG1107_str:
-	.pasciz " *pin is now HiZ"
+	.pasciz <206>, "p", <134>, " i", <140>, <233>, "w ", <245>, "Z"
 
 	; BPMSG1108
 	.section .text.BPMSG1108, code
 	.global _BPMSG1108_str
 _BPMSG1108_str:
-	.pasciz "CLOCK TICKS: "
+	.pasciz <194>, "O", <242>, " TI", <242>, "S", <151>
 
 	; BPMSG1109
 	.section .text.BPMSG1109, code
 	.global _BPMSG1109_str
 _BPMSG1109_str:
-	.pasciz "READ BIT: "
+	.pasciz <158>, <180>, " BIT", <151>
 
 	; BPMSG1110
 	.section .text.BPMSG1110, code
 	.global _BPMSG1110_str
 _BPMSG1110_str:
-	.pasciz "Syntax error at char "
+	.pasciz "Syn", <254>, "x ", <139>, "r", <147>, " a", <131>, <228>, <145>, " "
 
 	; BPMSG1111
 	.section .text.BPMSG1111, code
 	.global _BPMSG1111_str
 _BPMSG1111_str:
-	.pasciz "x. exit(without change)"
+	.pasciz "x", <133>, <196>, <141>, "(w", <141>, "h", <205>, <131>, <228>, <159>, "ge)"
 
 	; BPMSG1112
 	.section .text.BPMSG1112, code
 	.global _BPMSG1112_str
 _BPMSG1112_str:
-	.pasciz "no mode change"
+	.pasciz "n", <135>, <203>, "d", <132>, <228>, <159>, "ge"
 
 	; BPMSG1114
 	.section .text.BPMSG1114, code
 	.global _BPMSG1114_str
 _BPMSG1114_str:
-	.pasciz "Nonexistent protocol!"
+	.pasciz "N", <136>, <196>, "i", <163>, <143>, <131>, "p", <253>, <214>, "c", <175>, "!"
 
 	; BPMSG1115
 	.section .text.BPMSG1115, code
 	.global _BPMSG1115_str
 _BPMSG1115_str:
-	.pasciz "x. exit"
+	.pasciz "x", <133>, <196>, <141>
 
 	; BPMSG1117
 	.section .text.BPMSG1117, code
 	.global _BPMSG1117_str
 _BPMSG1117_str:
-	.pasciz "DEVID:"
+	.pasciz <243>, "VID:"
 
 	; BPMSG1118
 	.section .text.BPMSG1118, code
 	.global _BPMSG1118_str
 _BPMSG1118_str:
-	.pasciz "http://dangerousprototypes.com"
+	.pasciz "http://d", <159>, "g", <139>, <205>, <176>, <253>, <214>, "types.c", <204>
 
 	; BPMSG1119
 	.section .text.BPMSG1119, code
 	.global _BPMSG1119_str
 _BPMSG1119_str:
-	.pasciz "*----------*"
+	.pasciz "*", <169>, <129>, "*"
 
 	; BPMSG1120
 	.section .text.BPMSG1120, code
 	.global _BPMSG1120_str
 _BPMSG1120_str:
-	.pasciz "Open drain outputs (H=Hi-Z, L=GND)"
+	.pasciz "Op", <143>, " dra", <134>, " ", <205>, "t", <187>, "t", <140>, "(H=", <245>, "-Z", <146>, "L=G", <248>, ")"
 
 	; BPMSG1121
 	.section .text.BPMSG1121, code
 	.global _BPMSG1121_str
 _BPMSG1121_str:
-	.pasciz "Normal outputs (H=3.3v, L=GND)"
+	.pasciz "N", <147>, "m", <164>, " ", <205>, "t", <187>, "t", <140>, "(H=", <201>, "3v", <146>, "L=G", <248>, ")"
 
 	; BPMSG1123
 	.section .text.BPMSG1123, code
 	.global _BPMSG1123_str
 _BPMSG1123_str:
-	.pasciz "MSB set: MOST sig bit first"
+	.pasciz "MSB", <190>, <251>, <151>, <247>, "ST", <190>, "i", <183>, "b", <212>, "fir", <163>
 
 	; BPMSG1124
 	.section .text.BPMSG1124, code
 	.global _BPMSG1124_str
 _BPMSG1124_str:
-	.pasciz "LSB set: LEAST sig bit first"
+	.pasciz "LSB", <190>, <251>, <151>, "LEAST", <190>, "i", <183>, "b", <212>, "fir", <163>
 
 	; BPMSG1127
 	.section .text.BPMSG1127, code
 	.global _BPMSG1127_str
 _BPMSG1127_str:
-	.pasciz " 1. HEX\r\n 2. DEC\r\n 3. BIN\r\n 4. RAW"
+	.pasciz " 1", <133>, "HEX", <178>, <243>, "C", <130>, "3", <133>, "BIN", <130>, "4", <133>, "RAW"
 
 	; BPMSG1128
 	.section .text.BPMSG1128, code
 	.global _BPMSG1128_str
 _BPMSG1128_str:
-	.pasciz "Display format set"
+	.pasciz "Di", <176>, "la", <161>, "f", <147>, "ma", <131>, "s", <251>
 
 	; BPMSG1134
 	.section .text.BPMSG1134, code
 	.global _BPMSG1134_str
 _BPMSG1134_str:
-	.pasciz "Adjust your terminal"
+	.pasciz "Adj", <216>, <131>, "y", <205>, "r t", <139>, "m", <134>, <164>
 
 	; BPMSG1135
 	.section .text.BPMSG1135, code
 	.global _BPMSG1135_str
 _BPMSG1135_str:
-	.pasciz "Are you sure? "
+	.pasciz "Ar", <132>, "y", <205>, <190>, "u", <149>, "? "
 
 	; BPMSG1136
 	.section .text.BPMSG1136, code
@@ -440,49 +574,49 @@ _BPMSG1137_str:
 	.section .text.BPMSG1163, code
 	.global _BPMSG1163_str
 _BPMSG1163_str:
-	.pasciz "Disconnect any devices\r\nConnect (ADC to +3.3V)"
+	.pasciz "D", <231>, <229>, "nec", <131>, <159>, <161>, <154>, "v", <211>, "es", <128>, "C", <136>, "nec", <131>, "(", <180>, "C ", <177>, "+", <201>, "3V)"
 
 	; BPMSG1164
 	.section .text.BPMSG1164, code
 	.global _BPMSG1164_str
 _BPMSG1164_str:
-	.pasciz "Ctrl"
+	.pasciz "C", <215>, "l"
 
 	; BPMSG1165
 	.section .text.BPMSG1165, code
 	.global _BPMSG1165_str
 _BPMSG1165_str:
-	.pasciz "AUX"
+	.pasciz <189>
 
 	; BPMSG1166
 	.section .text.BPMSG1166, code
 	.global _BPMSG1166_str
 _BPMSG1166_str:
-	.pasciz "MODE LED"
+	.pasciz <247>, <243>, <239>, "ED"
 
 	; BPMSG1167
 	.section .text.BPMSG1167, code
 	.global _BPMSG1167_str
 _BPMSG1167_str:
-	.pasciz "PULLUP H"
+	.pasciz <249>, "LLUP H"
 
 	; BPMSG1168
 	.section .text.BPMSG1168, code
 	.global _BPMSG1168_str
 _BPMSG1168_str:
-	.pasciz "PULLUP L"
+	.pasciz <249>, "LLUP", <239>
 
 	; BPMSG1169
 	.section .text.BPMSG1169, code
 	.global _BPMSG1169_str
 _BPMSG1169_str:
-	.pasciz "VREG"
+	.pasciz "V", <158>, "G"
 
 	; BPMSG1170
 	.section .text.BPMSG1170, code
 	.global _BPMSG1170_str
 _BPMSG1170_str:
-	.pasciz "ADC and supply"
+	.pasciz <180>, "C ", <159>, <137>, "supply"
 
 	; BPMSG1171
 	.section .text.BPMSG1171, code
@@ -494,79 +628,79 @@ _BPMSG1171_str:
 	.section .text.BPMSG1172, code
 	.global _BPMSG1172_str
 _BPMSG1172_str:
-	.pasciz "VPU"
+	.pasciz "V", <249>
 
 	; BPMSG1173
 	.section .text.BPMSG1173, code
 	.global _BPMSG1173_str
 _BPMSG1173_str:
-	.pasciz "3.3V"
+	.pasciz <201>, "3V"
 
 	; BPMSG1174
 	.section .text.BPMSG1174, code
 	.global _BPMSG1174_str
 _BPMSG1174_str:
-	.pasciz "ADC"
+	.pasciz <180>, "C"
 
 	; BPMSG1175
 	.section .text.BPMSG1175, code
 	.global _BPMSG1175_str
 _BPMSG1175_str:
-	.pasciz "Bus high"
+	.pasciz "Bu", <140>, <184>, "gh"
 
 	; BPMSG1176
 	.section .text.BPMSG1176, code
 	.global _BPMSG1176_str
 _BPMSG1176_str:
-	.pasciz "Bus Hi-Z 0"
+	.pasciz "Bu", <140>, <245>, "-Z", <238>
 
 	; BPMSG1177
 	.section .text.BPMSG1177, code
 	.global _BPMSG1177_str
 _BPMSG1177_str:
-	.pasciz "Bus Hi-Z 1"
+	.pasciz "Bu", <140>, <245>, "-Z 1"
 
 	; BPMSG1178
 	.section .text.BPMSG1178, code
 	.global _BPMSG1178_str
 _BPMSG1178_str:
-	.pasciz "MODE, VREG, and USB LEDs should be on!"
+	.pasciz <247>, <243>, <146>, "V", <158>, "G", <146>, <159>, <137>, "USB", <239>, "ED", <140>, "sho", <160>, <137>, "b", <132>, <136>, "!"
 
 	; BPMSG1179
 	.section .text.BPMSG1179, code
 	.global _BPMSG1179_str
 _BPMSG1179_str:
-	.pasciz "Found "
+	.pasciz "F", <205>, "n", <137>
 
 	; BPMSG1180
 	.section .text.BPMSG1180, code
 	.global _BPMSG1180_str
 _BPMSG1180_str:
-	.pasciz " errors."
+	.pasciz " ", <139>, "r", <147>, "s."
 
 	; BPMSG1181
 	.section .text.BPMSG1181, code
 	.global _BPMSG1181_str
 _BPMSG1181_str:
-	.pasciz "MOSI"
+	.pasciz <247>, "SI"
 
 	; BPMSG1182
 	.section .text.BPMSG1182, code
 	.global _BPMSG1182_str
 _BPMSG1182_str:
-	.pasciz "CLK"
+	.pasciz <194>, "K"
 
 	; BPMSG1183
 	.section .text.BPMSG1183, code
 	.global _BPMSG1183_str
 _BPMSG1183_str:
-	.pasciz "MISO"
+	.pasciz "M", <224>, "O"
 
 	; BPMSG1184
 	.section .text.BPMSG1184, code
 	.global _BPMSG1184_str
 _BPMSG1184_str:
-	.pasciz "CS"
+	.pasciz <202>
 
 	; BPMSG1185
 	.section .text.BPMSG1185, code
@@ -584,19 +718,19 @@ _BPMSG1186_str:
 	.section .text.BPMSG1209, code
 	.global _BPMSG1209_str
 _BPMSG1209_str:
-	.pasciz "WARNING: pins not open drain (HiZ)"
+	.pasciz "W", <172>, "NING", <151>, "p", <134>, <140>, <233>, <131>, "op", <143>, " dra", <134>, <144>, <245>, "Z)"
 
 	; BPMSG1210
 	.section .text.BPMSG1210, code
 	.global _BPMSG1210_str
 _BPMSG1210_str:
-	.pasciz " REVID:"
+	.pasciz " ", <158>, "VID:"
 
 	; BPMSG1211
 	.section .text.BPMSG1211, code
 	.global _BPMSG1211_str
 _BPMSG1211_str:
-	.pasciz "\r\nInvalid choice, try again"
+	.pasciz <128>, "Inv", <164>, "i", <137>, <228>, "o", <211>, "e", <146>, <215>, <161>, "aga", <134>
 
 	; BPMSG1212
 	.section .text.BPMSG1212, code
@@ -608,31 +742,31 @@ _BPMSG1212_str:
 	.section .text.BPMSG1213, code
 	.global _BPMSG1213_str
 _BPMSG1213_str:
-	.pasciz "RS LOW, COMMAND MODE"
+	.pasciz "RS", <239>, "OW", <146>, "COMMA", <248>, " ", <247>, <243>
 
 	; BPMSG1214
 	.section .text.BPMSG1214, code
 	.global _BPMSG1214_str
 _BPMSG1214_str:
-	.pasciz "RS HIGH, DATA MODE"
+	.pasciz "RS HIGH", <146>, <244>, "A ", <247>, <243>
 
 	; BPMSG1216
 	.section .text.BPMSG1216, code
 	.global _BPMSG1216_str
 _BPMSG1216_str:
-	.pasciz "This mode requires an adapter"
+	.pasciz "T", <184>, <140>, <203>, "d", <132>, <149>, "qui", <149>, <140>, <159>, " ", <174>, "apt", <139>
 
 	; BPMSG1219
 	.section .text.BPMSG1219, code
 	.global _BPMSG1219_str
 _BPMSG1219_str:
-	.pasciz " 0.Macro menu\r\n 1.LCD Reset\r\n 2.Init LCD\r\n 3.Clear LCD\r\n 4.Cursor position ex:(4) 0\r\n 6.Write test numbers ex:(6) 80\r\n 7.Write test characters ex:(7) 80"
+	.pasciz <238>, ".", <207>, <232>, "u", <157>, ".LCD ", <227>, "s", <251>, <152>, ".In", <212>, "LCD", <130>, <201>, "C", <213>, <145>, <239>, "CD", <130>, "4.Curs", <147>, <220>, "os", <141>, "i", <136>, " ", <196>, ":(4", <166>, "0", <130>, "6.Wr", <141>, <132>, <156>, "s", <131>, "numb", <139>, <140>, <196>, ":(6", <166>, "80", <130>, "7.Wr", <141>, <132>, <156>, "s", <131>, <228>, <145>, <150>, "t", <139>, <140>, <196>, ":(7", <166>, "80"
 
 	; BPMSG1220
 	.section .text.BPMSG1220, code
 	.global _BPMSG1220_str
 _BPMSG1220_str:
-	.pasciz "Display lines:\r\n 1. 1 \r\n 2. Multiple"
+	.pasciz "Di", <176>, "la", <161>, "l", <134>, "es", <186>, "1 ", <178>, "M", <160>, <168>, "p", <213>
 
 	; BPMSG1221
 	.section .text.BPMSG1221, code
@@ -644,19 +778,19 @@ _BPMSG1221_str:
 	.section .text.BPMSG1222, code
 	.global _BPMSG1222_str
 _BPMSG1222_str:
-	.pasciz "CLEAR"
+	.pasciz <194>, "E", <172>
 
 	; BPMSG1223
 	.section .text.BPMSG1223, code
 	.global _BPMSG1223_str
 _BPMSG1223_str:
-	.pasciz "CURSOR SET"
+	.pasciz "CURSOR ", <195>, "T"
 
 	; BPMSG1226
 	.section .text.BPMSG1226, code
 	.global _BPMSG1226_str
 _BPMSG1226_str:
-	.pasciz "Pinstates:"
+	.pasciz "P", <134>, <163>, "a", <156>, "s:"
 
 	; BPMSG1228
 	.section .text.BPMSG1228, code
@@ -668,73 +802,73 @@ _BPMSG1228_str:
 	.section .text.BPMSG1234, code
 	.global _BPMSG1234_str
 _BPMSG1234_str:
-	.pasciz "GND\t"
+	.pasciz "G", <248>, "\t"
 
 	; BPMSG1245
 	.section .text.BPMSG1245, code
 	.global _BPMSG1245_str
 _BPMSG1245_str:
-	.pasciz " autorange "
+	.pasciz " aut", <147>, <159>, <230>
 
 	; BPMSG1251
 	.section .text.BPMSG1251, code
 	.global _BPMSG1251_str
 _BPMSG1251_str:
-	.pasciz "Space to continue"
+	.pasciz "Sp", <150>, <132>, <177>, <229>, "t", <134>, "ue"
 
 	; BPMSG1252
 	.section .text.BPMSG1252, code
 	.global _BPMSG1252_str
 _BPMSG1252_str:
-	.pasciz "Number of bits read/write: "
+	.pasciz "Numb", <139>, " of b", <141>, <140>, <149>, <174>, "/wr", <141>, "e", <151>
 
 	; BPMSG1254
 	.section .text.BPMSG1254, code
 	.global _BPMSG1254_str
 _BPMSG1254_str:
-	.pasciz "Position in degrees"
+	.pasciz "Pos", <141>, "i", <136>, " ", <134>, " ", <154>, "g", <149>, "es"
 
 	; BPMSG1255
 	.section .text.BPMSG1255, code
 	.global _BPMSG1255_str
 _BPMSG1255_str:
-	.pasciz "Servo active"
+	.pasciz "S", <139>, "v", <135>, <150>, <219>, "e"
 
 	; BPMSG1256
 	.section .text.BPMSG1256, code
 	.global _BPMSG1256_str
 _BPMSG1256_str:
-	.pasciz "#12    \t#11    \t#10    \t#09   \t#08   \t#07   \t#06   \t#05   \t#04   \t#03   \t#02   \t#01   "
+	.pasciz "#12", <142>, <142>, <200>, "11", <142>, <142>, <200>, "10", <142>, <142>, <237>, "9", <235>, <237>, "8", <235>, <237>, "7", <235>, <237>, "6", <235>, <237>, "5", <235>, <237>, "4", <235>, <237>, "3", <235>, <237>, "2", <235>, <237>, "1", <235>
 
 	; BPMSG1257
 	.section .text.BPMSG1257, code
 	.global _BPMSG1257_str
 _BPMSG1257_str:
-	.pasciz "GND\t5.0V\t3.3V\tVPU\tADC\tAUX2\tAUX1\tAUX\t"
+	.pasciz "G", <248>, "\t5.0V\t", <201>, "3V\tV", <249>, "\t", <180>, "C\t", <189>, "2\t", <189>, "1\t", <189>, "\t"
 
 	; BPMSG1263
 	.section .text.BPMSG1263, code
 	.global _BPMSG1263_str
 _BPMSG1263_str:
-	.pasciz "a/A/@ controls AUX1 pin"
+	.pasciz "a/A/@ ", <229>, <215>, <175>, <140>, <189>, "1", <220>, <134>
 
 	; BPMSG1264
 	.section .text.BPMSG1264, code
 	.global _BPMSG1264_str
 _BPMSG1264_str:
-	.pasciz "a/A/@ controls AUX2 pin"
+	.pasciz "a/A/@ ", <229>, <215>, <175>, <140>, <189>, "2", <220>, <134>
 
 	; BPMSG1265
 	.section .text.BPMSG1265, code
 	.global _BPMSG1265_str
 _BPMSG1265_str:
-	.pasciz "EEPROM"
+	.pasciz "EEP", <185>
 
 	; BPMSG1266
 	.section .text.BPMSG1266, code
 	.global _BPMSG1266_str
 _BPMSG1266_str:
-	.pasciz "SCL"
+	.pasciz "S", <194>
 
 	; BPMSG1267
 	.section .text.BPMSG1267, code
@@ -752,229 +886,229 @@ _BPMSG1268_str:
 	.section .text.BPMSG1269, code
 	.global _BPMSG1269_str
 _BPMSG1269_str:
-	.pasciz "READ&WRITE"
+	.pasciz <158>, <180>, "&WRITE"
 
 	; BPMSG1270
 	.section .text.BPMSG1270, code
 	.global _BPMSG1270_str
 _BPMSG1270_str:
-	.pasciz "Vusb"
+	.pasciz "V", <216>, "b"
 
 	; BPMSG1271
 	.section .text.BPMSG1271, code
 	.global _BPMSG1271_str
 _BPMSG1271_str:
-	.pasciz "Select Vpu (Pullup) Source:\r\n 1) External (or None)\r\n 2) Onboard 3.3v\r\n 3) Onboard 5.0v"
+	.pasciz <170>, <213>, "c", <131>, "V", <187>, <144>, "P", <218>, "up", <166>, "S", <205>, "rce:", <157>, <166>, "Ext", <139>, "n", <164>, <144>, <147>, " N", <136>, "e)", <152>, <166>, "On", <250>, <255>, <201>, "3v", <130>, "3", <166>, "On", <250>, <255>, "5.0v"
 
 	; BPMSG1272
 	.section .text.BPMSG1272, code
 	.global _BPMSG1272_str
 _BPMSG1272_str:
-	.pasciz " on-board pullup voltage "
+	.pasciz " ", <136>, "-", <250>, <255>, "p", <218>, <234>, "v", <175>, <254>, <230>
 
 	; BPMSG1273
 	.section .text.BPMSG1273, code
 	.global _BPMSG1273_str
 _BPMSG1273_str:
-	.pasciz "enabled"
+	.pasciz <143>, <208>, "l", <182>
 
 	; BPMSG1274
 	.section .text.BPMSG1274, code
 	.global _BPMSG1274_str
 _BPMSG1274_str:
-	.pasciz "disabled"
+	.pasciz "d", <231>, <208>, "l", <182>
 
 	; HLP1000
 	.section .text.HLP1000, code
 	.global _HLP1000_str
 _HLP1000_str:
-	.pasciz "General\t\t\t\t\tProtocol interaction"
+	.pasciz "G", <143>, <139>, <164>, <148>, <236>, "P", <253>, <214>, "c", <175>, " ", <134>, "t", <139>, <150>, <168>, <136>
 
 	; HLP1001
 	.section .text.HLP1001, code
 	.global _HLP1001_str
 _HLP1001_str:
-	.pasciz "---------------------------------------------------------------------------"
+	.pasciz <169>, <169>, <169>, <169>, <169>, <169>, <169>, <169>, <169>, <129>, "-"
 
 	; HLP1002
 	.section .text.HLP1002, code
 	.global _HLP1002_str
 _HLP1002_str:
-	.pasciz "?\tThis help\t\t\t(0)\tList current macros"
+	.pasciz "?\tT", <184>, <140>, "help", <236>, "(0)\tL", <231>, <131>, "curr", <143>, <131>, "m", <188>, "os"
 
 	; HLP1003
 	.section .text.HLP1003, code
 	.global _HLP1003_str
 _HLP1003_str:
-	.pasciz "=X/|X\tConverts X/reverse X\t\t(x)\tMacro x"
+	.pasciz "=X/|X\tC", <136>, "v", <139>, "t", <140>, "X/", <149>, "v", <139>, "s", <132>, "X", <148>, "(x)\t", <207>, "x"
 
 	; HLP1004
 	.section .text.HLP1004, code
 	.global _HLP1004_str
 _HLP1004_str:
-	.pasciz "~\tSelftest\t\t\t[\tStart"
+	.pasciz "~\t", <170>, "lf", <156>, <163>, <236>, "[", <193>, "t", <145>, "t"
 
 	; HLP1005
 	.section .text.HLP1005, code
 	.global _HLP1005_str
 _HLP1005_str:
-	.pasciz "o\tSet output type\t\t\t]\tStop"
+	.pasciz "o\t", <198>, <205>, "t", <187>, <131>, "type", <236>, "]", <193>, <214>, "p"
 
 	; HLP1006
 	.section .text.HLP1006, code
 	.global _HLP1006_str
 _HLP1006_str:
-	.pasciz "$\tJump to bootloader\t\t{\tStart with read"
+	.pasciz "$\tJum", <171>, <177>, <250>, "ot", <165>, <174>, <139>, <148>, "{", <193>, "t", <145>, <131>, "w", <141>, "h ", <149>, <174>
 
 	; HLP1007
 	.section .text.HLP1007, code
 	.global _HLP1007_str
 _HLP1007_str:
-	.pasciz "&/%\tDelay 1 us/ms\t\t\t}\tStop"
+	.pasciz "&/%\tDela", <161>, "1 ", <216>, "/ms", <236>, "}", <193>, <214>, "p"
 
 	; HLP1008
 	.section .text.HLP1008, code
 	.global _HLP1008_str
 _HLP1008_str:
-	.pasciz "a/A/@\tAUXPIN (low/HI/READ)\t\t\"abc\"\tSend string"
+	.pasciz "a/A/@\t", <189>, "PIN", <144>, <165>, "w/HI/", <158>, <180>, ")", <148>, "\"", <208>, "c\"", <193>, <143>, <137>, <163>, "r", <134>, "g"
 
 	; HLP1009
 	.section .text.HLP1009, code
 	.global _HLP1009_str
 _HLP1009_str:
-	.pasciz "b\tSet baudrate\t\t\t123\tSend integer value"
+	.pasciz "b\t", <198>, "baudra", <156>, <236>, "123", <193>, <143>, <137>, <134>, <156>, "g", <139>, " v", <164>, "ue"
 
 	; HLP1010
 	.section .text.HLP1010, code
 	.global _HLP1010_str
 _HLP1010_str:
-	.pasciz "c/C/k/K\tAUX assignment (A0/CS/A1/A2)\t0x123\tSend hex value"
+	.pasciz "c/C/k/K\t", <189>, " ", <209>, "sign", <232>, <131>, "(A0/", <202>, "/A1/A2)\t", <191>, "123", <193>, <143>, <137>, "h", <196>, " v", <164>, "ue"
 
 	; HLP1011
 	.section .text.HLP1011, code
 	.global _HLP1011_str
 _HLP1011_str:
-	.pasciz "d/D\tMeasure ADC (once/CONT.)\t0b110\tSend binary value"
+	.pasciz "d/D\tMe", <209>, "ur", <132>, <180>, "C", <144>, <136>, "ce/C", <226>, "T.)\t0b110", <193>, <143>, <137>, "b", <134>, <145>, <161>, "v", <164>, "ue"
 
 	; HLP1012
 	.section .text.HLP1012, code
 	.global _HLP1012_str
 _HLP1012_str:
-	.pasciz "f\tMeasure frequency\t\tr\tRead"
+	.pasciz "f\tMe", <209>, "ur", <132>, "f", <149>, "qu", <143>, "cy", <148>, "r\t", <227>, <174>
 
 	; HLP1013
 	.section .text.HLP1013, code
 	.global _HLP1013_str
 _HLP1013_str:
-	.pasciz "g/S\tGenerate PWM/Servo\t\t/\tCLK hi"
+	.pasciz "g/S\tG", <143>, <139>, "at", <132>, "PWM/S", <139>, "vo", <148>, "/\t", <194>, "K ", <184>
 
 	; HLP1014
 	.section .text.HLP1014, code
 	.global _HLP1014_str
 _HLP1014_str:
-	.pasciz "h\tCommandhistory\t\t\t\\\tCLK lo"
+	.pasciz "h\tC", <204>, "m", <159>, "d", <184>, <163>, <147>, "y", <236>, "\\\t", <194>, "K ", <165>
 
 	; HLP1015
 	.section .text.HLP1015, code
 	.global _HLP1015_str
 _HLP1015_str:
-	.pasciz "i\tVersioninfo/statusinfo\t\t^\tCLK tick"
+	.pasciz "i\tV", <139>, "si", <136>, <134>, "fo/", <163>, "at", <216>, <134>, "fo", <148>, "^\t", <194>, "K ", <168>, "ck"
 
 	; HLP1016
 	.section .text.HLP1016, code
 	.global _HLP1016_str
 _HLP1016_str:
-	.pasciz "l/L\tBitorder (msb/LSB)\t\t-\tDAT hi"
+	.pasciz "l/L\tB", <141>, <147>, "d", <139>, <144>, "msb/LSB)", <148>, <221>, <244>, " ", <184>
 
 	; HLP1017
 	.section .text.HLP1017, code
 	.global _HLP1017_str
 _HLP1017_str:
-	.pasciz "m\tChange mode\t\t\t_\tDAT lo"
+	.pasciz "m\tCh", <159>, <230>, <203>, <154>, <236>, "_\t", <244>, " ", <165>
 
 	; HLP1018
 	.section .text.HLP1018, code
 	.global _HLP1018_str
 _HLP1018_str:
-	.pasciz "e\tSet Pullup Method\t\t.\tDAT read"
+	.pasciz "e\t", <198>, "P", <218>, <234>, "M", <251>, "hod", <148>, ".\t", <244>, " ", <149>, <174>
 
 	; HLP1019
 	.section .text.HLP1019, code
 	.global _HLP1019_str
 _HLP1019_str:
-	.pasciz "p/P\tPullup resistors (off/ON)\t!\tBit read"
+	.pasciz "p/P\tP", <218>, <234>, <149>, "si", <163>, <147>, <140>, "(o", <252>, "/", <226>, ")\t!\tB", <212>, <149>, <174>
 
 	; HLP1020
 	.section .text.HLP1020, code
 	.global _HLP1020_str
 _HLP1020_str:
-	.pasciz "s\tScript engine\t\t\t:\tRepeat e.g. r:10"
+	.pasciz "s", <193>, "crip", <131>, <143>, "g", <134>, "e", <236>, ":\t", <227>, "pea", <131>, "e.g", <133>, "r:10"
 
 	; HLP1021
 	.section .text.HLP1021, code
 	.global _HLP1021_str
 _HLP1021_str:
-	.pasciz "v\tShow volts/states\t\t;\tBits to read/write e.g. 0x55;2"
+	.pasciz "v", <193>, "how v", <175>, "ts/", <163>, "a", <156>, "s", <148>, ";\tB", <141>, <140>, <177>, <149>, <174>, "/wr", <141>, <132>, "e.g", <133>, <191>, "55;2"
 
 	; HLP1022
 	.section .text.HLP1022, code
 	.global _HLP1022_str
 _HLP1022_str:
-	.pasciz "w/W\tPSU (off/ON)\t\t<x>/<x= >/<0>\tUsermacro x/assign x/list all"
+	.pasciz "w/W\tPSU", <144>, "o", <252>, "/", <226>, ")", <148>, "<x>/<x= >/<0>\tUs", <139>, "m", <199>, "x/", <209>, "sign x/l", <231>, <131>, <164>, "l"
 
 	; MSG_1WIRE_ADDRESS_MACRO_HEADER
 	.section .text.MSG_1WIRE_ADDRESS_MACRO_HEADER, code
 	.global _MSG_1WIRE_ADDRESS_MACRO_HEADER_str
 _MSG_1WIRE_ADDRESS_MACRO_HEADER_str:
-	.pasciz "ADDRESS MACRO "
+	.pasciz <180>, "D", <158>, "SS MAC", <155>, " "
 
 	; MSG_1WIRE_ALARM_MACRO_NAME
 	.section .text.MSG_1WIRE_ALARM_MACRO_NAME, code
 	.global _MSG_1WIRE_ALARM_MACRO_NAME_str
 _MSG_1WIRE_ALARM_MACRO_NAME_str:
-	.pasciz "ALARM SEARCH (0xEC)"
+	.pasciz "AL", <172>, "M ", <195>, <172>, <223>, <217>, "EC)"
 
 	; MSG_1WIRE_BUS_RESET
 	.section .text.MSG_1WIRE_BUS_RESET, code
 	.global _MSG_1WIRE_BUS_RESET_str
 _MSG_1WIRE_BUS_RESET_str:
-	.pasciz "BUS RESET "
+	.pasciz "BUS ", <158>, <195>, "T "
 
 	; MSG_1WIRE_LOOKUP_ID_HEADER
 	.section .text.MSG_1WIRE_LOOKUP_ID_HEADER, code
 	.global _MSG_1WIRE_LOOKUP_ID_HEADER_str
 _MSG_1WIRE_LOOKUP_ID_HEADER_str:
-	.pasciz "\r\n   *"
+	.pasciz <130>, <142>, "*"
 
 	; MSG_1WIRE_MACRO_LIST
 	.section .text.MSG_1WIRE_MACRO_LIST, code
 	.global _MSG_1WIRE_MACRO_LIST_str
 _MSG_1WIRE_MACRO_LIST_str:
-	.pasciz "1WIRE ROM COMMAND MACROs:\r\n 51.READ ROM (0x33) *for single device bus\r\n 85.MATCH ROM (0x55) *followed by 64bit address\r\n 204.SKIP ROM (0xCC) *followed by command\r\n 236.ALARM SEARCH (0xEC)\r\n 240.SEARCH ROM (0xF0)"
+	.pasciz "1WI", <158>, <240>, " COMMA", <248>, " MAC", <155>, "s:", <130>, "51.", <158>, <180>, <240>, <217>, "33", <166>, "*f", <147>, <190>, <134>, "g", <167>, <154>, "v", <211>, <132>, "b", <216>, <130>, "85.M", <181>, <223>, <240>, <217>, "55", <166>, "*f", <175>, <165>, "we", <137>, "b", <161>, "64b", <212>, <174>, "d", <149>, "ss", <152>, "04.SKIP", <240>, <217>, "CC", <166>, "*f", <175>, <165>, "we", <137>, "b", <161>, "c", <204>, "m", <159>, "d", <152>, "36.AL", <172>, "M ", <195>, <172>, <223>, <217>, "EC)", <152>, "40.", <195>, <172>, <223>, <240>, <217>, "F0)"
 
 	; MSG_1WIRE_MACRO_MENU_HEADER
 	.section .text.MSG_1WIRE_MACRO_MENU_HEADER, code
 	.global _MSG_1WIRE_MACRO_MENU_HEADER_str
 _MSG_1WIRE_MACRO_MENU_HEADER_str:
-	.pasciz " 0.Macro menu"
+	.pasciz <238>, ".", <207>, <232>, "u"
 
 	; MSG_1WIRE_MACRO_TABLE_HEADER
 	.section .text.MSG_1WIRE_MACRO_TABLE_HEADER, code
 	.global _MSG_1WIRE_MACRO_TABLE_HEADER_str
 _MSG_1WIRE_MACRO_TABLE_HEADER_str:
-	.pasciz "Macro     1WIRE address"
+	.pasciz <207>, <142>, <142>, "1WI", <158>, " ", <174>, "d", <149>, "ss"
 
 	; MSG_1WIRE_MACRO_TABLE_TRAILER
 	.section .text.MSG_1WIRE_MACRO_TABLE_TRAILER, code
 	.global _MSG_1WIRE_MACRO_TABLE_TRAILER_str
 _MSG_1WIRE_MACRO_TABLE_TRAILER_str:
-	.pasciz "Device IDs are available by MACRO, see (0)."
+	.pasciz "Dev", <211>, <132>, "ID", <140>, <145>, <132>, "avail", <208>, <167>, "b", <161>, "MAC", <155>, <146>, "se", <132>, "(0)."
 
 	; MSG_1WIRE_MATCH_ROM_MACRO_NAME
 	.section .text.MSG_1WIRE_MATCH_ROM_MACRO_NAME, code
 	.global _MSG_1WIRE_MATCH_ROM_MACRO_NAME_str
 _MSG_1WIRE_MATCH_ROM_MACRO_NAME_str:
-	.pasciz "MATCH ROM (0x55)"
+	.pasciz "M", <181>, <223>, <240>, <217>, "55)"
 
 	; MSG_1WIRE_MODE_IDENTIFIER
 	.section .text.MSG_1WIRE_MODE_IDENTIFIER, code
@@ -986,73 +1120,73 @@ _MSG_1WIRE_MODE_IDENTIFIER_str:
 	.section .text.MSG_1WIRE_NEXT_CLOCK_ALERT, code
 	.global _MSG_1WIRE_NEXT_CLOCK_ALERT_str
 _MSG_1WIRE_NEXT_CLOCK_ALERT_str:
-	.pasciz " *next clock (^) will use this value"
+	.pasciz <206>, "n", <196>, <131>, "c", <165>, "ck", <144>, "^", <166>, "will ", <216>, <132>, "t", <184>, <140>, "v", <164>, "ue"
 
 	; MSG_1WIRE_NO_DEVICE
 	.section .text.MSG_1WIRE_NO_DEVICE, code
 	.global _MSG_1WIRE_NO_DEVICE_str
 _MSG_1WIRE_NO_DEVICE_str:
-	.pasciz "No device, try (ALARM) SEARCH macro first"
+	.pasciz "N", <135>, <154>, "v", <211>, "e", <146>, <215>, "y", <144>, "AL", <172>, "M", <166>, <195>, <172>, <223>, " m", <199>, "fir", <163>
 
 	; MSG_1WIRE_NO_DEVICE_DETECTED
 	.section .text.MSG_1WIRE_NO_DEVICE_DETECTED, code
 	.global _MSG_1WIRE_NO_DEVICE_DETECTED_str
 _MSG_1WIRE_NO_DEVICE_DETECTED_str:
-	.pasciz "*No device detected "
+	.pasciz "*N", <135>, <154>, "v", <211>, <132>, <154>, <156>, "c", <156>, <137>
 
 	; MSG_1WIRE_PINS_STATE
 	.section .text.MSG_1WIRE_PINS_STATE, code
 	.global _MSG_1WIRE_PINS_STATE_str
 _MSG_1WIRE_PINS_STATE_str:
-	.pasciz "-\t-\t-\tOWD"
+	.pasciz <221>, <221>, <221>, "OWD"
 
 	; MSG_1WIRE_READ_ROM_MACRO_NAME
 	.section .text.MSG_1WIRE_READ_ROM_MACRO_NAME, code
 	.global _MSG_1WIRE_READ_ROM_MACRO_NAME_str
 _MSG_1WIRE_READ_ROM_MACRO_NAME_str:
-	.pasciz "READ ROM (0x33): "
+	.pasciz <158>, <180>, <240>, <217>, "33)", <151>
 
 	; MSG_1WIRE_SEARCH_MACRO_NAME
 	.section .text.MSG_1WIRE_SEARCH_MACRO_NAME, code
 	.global _MSG_1WIRE_SEARCH_MACRO_NAME_str
 _MSG_1WIRE_SEARCH_MACRO_NAME_str:
-	.pasciz "SEARCH (0xF0)"
+	.pasciz <195>, <172>, <223>, <217>, "F0)"
 
 	; MSG_1WIRE_SKIP_ROM_MACRO_NAME
 	.section .text.MSG_1WIRE_SKIP_ROM_MACRO_NAME, code
 	.global _MSG_1WIRE_SKIP_ROM_MACRO_NAME_str
 _MSG_1WIRE_SKIP_ROM_MACRO_NAME_str:
-	.pasciz "SKIP ROM (0xCC)"
+	.pasciz "SKIP", <240>, <217>, "CC)"
 
 	; MSG_1WIRE_SPEED_PROMPT
 	.section .text.MSG_1WIRE_SPEED_PROMPT, code
 	.global _MSG_1WIRE_SPEED_PROMPT_str
 _MSG_1WIRE_SPEED_PROMPT_str:
-	.pasciz "Set speed:\r\n 1. Standard (~16.3kbps) \r\n 2. Overdrive (~160kps)"
+	.pasciz <198>, <176>, "e", <182>, <186>, "St", <159>, "d", <255>, "(~", <222>, ".3kbps", <166>, <178>, "Ov", <139>, "driv", <132>, "(~", <222>, "0kps)"
 
 	; MSG_ACK
 	.section .text.MSG_ACK, code
 	.global _MSG_ACK_str
 _MSG_ACK_str:
-	.pasciz "ACK"
+	.pasciz "A", <242>
 
 	; MSG_ADC_VOLTAGE_PROBE_HEADER
 	.section .text.MSG_ADC_VOLTAGE_PROBE_HEADER, code
 	.global _MSG_ADC_VOLTAGE_PROBE_HEADER_str
 _MSG_ADC_VOLTAGE_PROBE_HEADER_str:
-	.pasciz "VOLTAGE PROBE: "
+	.pasciz "VOLTAGE P", <155>, "BE", <151>
 
 	; MSG_ADC_VOLTMETER_MODE
 	.section .text.MSG_ADC_VOLTMETER_MODE, code
 	.global _MSG_ADC_VOLTMETER_MODE_str
 _MSG_ADC_VOLTMETER_MODE_str:
-	.pasciz "VOLTMETER MODE"
+	.pasciz "VOLTMETER ", <247>, <243>
 
 	; MSG_ANY_KEY_TO_EXIT_PROMPT
 	.section .text.MSG_ANY_KEY_TO_EXIT_PROMPT, code
 	.global _MSG_ANY_KEY_TO_EXIT_PROMPT_str
 _MSG_ANY_KEY_TO_EXIT_PROMPT_str:
-	.pasciz "Any key to exit"
+	.pasciz "An", <161>, "ke", <161>, <177>, <196>, <141>
 
 	; MSG_BASE_CONVERTER_EQUAL_SIGN
 	.section .text.MSG_BASE_CONVERTER_EQUAL_SIGN, code
@@ -1060,11 +1194,29 @@ _MSG_ANY_KEY_TO_EXIT_PROMPT_str:
 _MSG_BASE_CONVERTER_EQUAL_SIGN_str:
 	.pasciz " = "
 
+	; MSG_BATCH_MODE_DONE
+	.section .text.MSG_BATCH_MODE_DONE, code
+	.global _MSG_BATCH_MODE_DONE_str
+_MSG_BATCH_MODE_DONE_str:
+	.pasciz "B", <181>, <223>, " D", <226>, "E"
+
+	; MSG_BATCH_MODE_READY
+	.section .text.MSG_BATCH_MODE_READY, code
+	.global _MSG_BATCH_MODE_READY_str
+_MSG_BATCH_MODE_READY_str:
+	.pasciz "B", <181>, <223>, " ", <158>, <180>, "Y", <146>, <143>, <137>, "scrip", <131>, "w", <141>, "h ^D"
+
+	; MSG_BATCH_MODE_SCRIPT_TOO_LONG
+	.section .text.MSG_BATCH_MODE_SCRIPT_TOO_LONG, code
+	.global _MSG_BATCH_MODE_SCRIPT_TOO_LONG_str
+_MSG_BATCH_MODE_SCRIPT_TOO_LONG_str:
+	.pasciz "Scrip", <131>, <214>, <135>, "l", <136>, "g"
+
 	; MSG_BAUD_DETECTION_SELECTED
 	.section .text.MSG_BAUD_DETECTION_SELECTED, code
 	.global _MSG_BAUD_DETECTION_SELECTED_str
 _MSG_BAUD_DETECTION_SELECTED_str:
-	.pasciz "Baud detection selected.."
+	.pasciz "Bau", <137>, <154>, <156>, "c", <168>, <136>, <190>, "e", <213>, "c", <156>, "d.."
 
 	; MSG_BBIO_MODE_IDENTIFIER
 	.section .text.MSG_BBIO_MODE_IDENTIFIER, code
@@ -1082,7 +1234,7 @@ _MSG_BINARY_NUMBER_PREFIX_str:
 	.section .text.MSG_CFG0_FIELD, code
 	.global _MSG_CFG0_FIELD_str
 _MSG_CFG0_FIELD_str:
-	.pasciz "CFG0: "
+	.pasciz "CFG0", <151>
 
 	; MSG_CHIP_REVISION_A3
 	.section .text.MSG_CHIP_REVISION_A3, code
@@ -1100,7 +1252,7 @@ _MSG_CHIP_REVISION_A5_str:
 	.section .text.MSG_CHIP_REVISION_ID_BEGIN, code
 	.global _MSG_CHIP_REVISION_ID_BEGIN_str
 _MSG_CHIP_REVISION_ID_BEGIN_str:
-	.pasciz " (24FJ256GB106 "
+	.pasciz <144>, "24FJ256GB106 "
 
 	; MSG_CHIP_REVISION_UNKNOWN
 	.section .text.MSG_CHIP_REVISION_UNKNOWN, code
@@ -1118,19 +1270,19 @@ _MSG_CLEAR_LINE_WITH_CR_str:
 	.section .text.MSG_CLUTCH_DISENGAGED, code
 	.global _MSG_CLUTCH_DISENGAGED_str
 _MSG_CLUTCH_DISENGAGED_str:
-	.pasciz "Clutch disengaged!!!"
+	.pasciz "Clut", <228>, " d", <231>, <143>, "gag", <182>, "!!!"
 
 	; MSG_CLUTCH_ENGAGED
 	.section .text.MSG_CLUTCH_ENGAGED, code
 	.global _MSG_CLUTCH_ENGAGED_str
 _MSG_CLUTCH_ENGAGED_str:
-	.pasciz "Clutch engaged!!!"
+	.pasciz "Clut", <228>, " ", <143>, "gag", <182>, "!!!"
 
 	; MSG_COMMAND_HAS_NO_EFFECT
 	.section .text.MSG_COMMAND_HAS_NO_EFFECT, code
 	.global _MSG_COMMAND_HAS_NO_EFFECT_str
 _MSG_COMMAND_HAS_NO_EFFECT_str:
-	.pasciz "ERROR: command has no effect here"
+	.pasciz "ER", <155>, "R", <151>, "c", <204>, "m", <159>, <137>, "ha", <140>, "n", <135>, "e", <252>, "ec", <131>, "h", <139>, "e"
 
 	; MSG_CURSOR_LEFT
 	.section .text.MSG_CURSOR_LEFT, code
@@ -1160,73 +1312,73 @@ _MSG_DESTRUCTIVE_BACKSPACE_str:
 	.section .text.MSG_FINISH_SETUP_PROMPT, code
 	.global _MSG_FINISH_SETUP_PROMPT_str
 _MSG_FINISH_SETUP_PROMPT_str:
-	.pasciz "To finish setup, start up the power supplies with command 'W'"
+	.pasciz "T", <135>, "f", <134>, <231>, "h", <190>, <251>, "up", <146>, <163>, <145>, <131>, <234>, "th", <132>, "pow", <139>, <190>, "upplie", <140>, "w", <141>, "h c", <204>, "m", <159>, <137>, "'W'"
 
 	; MSG_HEXADECIMAL_NUMBER_PREFIX
 	.section .text.MSG_HEXADECIMAL_NUMBER_PREFIX, code
 	.global _MSG_HEXADECIMAL_NUMBER_PREFIX_str
 _MSG_HEXADECIMAL_NUMBER_PREFIX_str:
-	.pasciz "0x"
+	.pasciz <191>
 
 	; MSG_I2C_MODE_IDENTIFIER
 	.section .text.MSG_I2C_MODE_IDENTIFIER, code
 	.global _MSG_I2C_MODE_IDENTIFIER_str
 _MSG_I2C_MODE_IDENTIFIER_str:
-	.pasciz "I2C1"
+	.pasciz <246>, "1"
 
 	; MSG_I2C_PINS_STATE
 	.section .text.MSG_I2C_PINS_STATE, code
 	.global _MSG_I2C_PINS_STATE_str
 _MSG_I2C_PINS_STATE_str:
-	.pasciz "-\t-\tSCL\tSDA"
+	.pasciz <221>, "-", <193>, <194>, <193>, "DA"
 
 	; MSG_I2C_READ_ADDRESS_END
 	.section .text.MSG_I2C_READ_ADDRESS_END, code
 	.global _MSG_I2C_READ_ADDRESS_END_str
 _MSG_I2C_READ_ADDRESS_END_str:
-	.pasciz " R) "
+	.pasciz " R", <166>
 
 	; MSG_I2C_START_BIT
 	.section .text.MSG_I2C_START_BIT, code
 	.global _MSG_I2C_START_BIT_str
 _MSG_I2C_START_BIT_str:
-	.pasciz "I2C START BIT"
+	.pasciz <246>, " ST", <172>, "T BIT"
 
 	; MSG_I2C_STOP_BIT
 	.section .text.MSG_I2C_STOP_BIT, code
 	.global _MSG_I2C_STOP_BIT_str
 _MSG_I2C_STOP_BIT_str:
-	.pasciz "I2C STOP BIT"
+	.pasciz <246>, " STOP BIT"
 
 	; MSG_I2C_WRITE_ADDRESS_END
 	.section .text.MSG_I2C_WRITE_ADDRESS_END, code
 	.global _MSG_I2C_WRITE_ADDRESS_END_str
 _MSG_I2C_WRITE_ADDRESS_END_str:
-	.pasciz " W) "
+	.pasciz " W", <166>
 
 	; MSG_KEYBOARD_ERROR_NODATA
 	.section .text.MSG_KEYBOARD_ERROR_NODATA, code
 	.global _MSG_KEYBOARD_ERROR_NODATA_str
 _MSG_KEYBOARD_ERROR_NODATA_str:
-	.pasciz " NONE"
+	.pasciz " N", <226>, "E"
 
 	; MSG_KEYBOARD_ERROR_PARITY
 	.section .text.MSG_KEYBOARD_ERROR_PARITY, code
 	.global _MSG_KEYBOARD_ERROR_PARITY_str
 _MSG_KEYBOARD_ERROR_PARITY_str:
-	.pasciz " *parity error"
+	.pasciz <206>, "p", <145>, <141>, <161>, <139>, "r", <147>
 
 	; MSG_KEYBOARD_ERROR_STARTBIT
 	.section .text.MSG_KEYBOARD_ERROR_STARTBIT, code
 	.global _MSG_KEYBOARD_ERROR_STARTBIT_str
 _MSG_KEYBOARD_ERROR_STARTBIT_str:
-	.pasciz " *startbit error"
+	.pasciz <206>, <163>, <145>, "tb", <212>, <139>, "r", <147>
 
 	; MSG_KEYBOARD_ERROR_STOPBIT
 	.section .text.MSG_KEYBOARD_ERROR_STOPBIT, code
 	.global _MSG_KEYBOARD_ERROR_STOPBIT_str
 _MSG_KEYBOARD_ERROR_STOPBIT_str:
-	.pasciz " *stopbit error"
+	.pasciz <206>, <163>, "opb", <212>, <139>, "r", <147>
 
 	; MSG_KEYBOARD_ERROR_TIMEOUT
 	.section .text.MSG_KEYBOARD_ERROR_TIMEOUT, code
@@ -1238,19 +1390,19 @@ _MSG_KEYBOARD_ERROR_TIMEOUT_str:
 	.section .text.MSG_KEYBOARD_ERROR_UNKNOWN, code
 	.global _MSG_KEYBOARD_ERROR_UNKNOWN_str
 _MSG_KEYBOARD_ERROR_UNKNOWN_str:
-	.pasciz " UNKNOWN ERROR"
+	.pasciz " UNKNOWN ER", <155>, "R"
 
 	; MSG_KEYBOARD_LIVE_INPUT_START
 	.section .text.MSG_KEYBOARD_LIVE_INPUT_START, code
 	.global _MSG_KEYBOARD_LIVE_INPUT_START_str
 _MSG_KEYBOARD_LIVE_INPUT_START_str:
-	.pasciz "Input monitor, any key exits"
+	.pasciz "In", <187>, <131>, "m", <136>, <141>, <147>, <146>, <159>, <161>, "ke", <161>, <196>, <141>, "s"
 
 	; MSG_KEYBOARD_MACRO_MENU
 	.section .text.MSG_KEYBOARD_MACRO_MENU, code
 	.global _MSG_KEYBOARD_MACRO_MENU_str
 _MSG_KEYBOARD_MACRO_MENU_str:
-	.pasciz " 0. Macro menu\r\n 1. Live input monitor"
+	.pasciz <238>, <133>, <207>, <232>, "u", <179>, "Liv", <132>, <134>, <187>, <131>, "m", <136>, <141>, <147>
 
 	; MSG_MODE_HEADER_END
 	.section .text.MSG_MODE_HEADER_END, code
@@ -1262,19 +1414,19 @@ _MSG_MODE_HEADER_END_str:
 	.section .text.MSG_NACK, code
 	.global _MSG_NACK_str
 _MSG_NACK_str:
-	.pasciz "NACK"
+	.pasciz "NA", <242>
 
 	; MSG_NO_VOLTAGE_ON_PULLUP_PIN
 	.section .text.MSG_NO_VOLTAGE_ON_PULLUP_PIN, code
 	.global _MSG_NO_VOLTAGE_ON_PULLUP_PIN_str
 _MSG_NO_VOLTAGE_ON_PULLUP_PIN_str:
-	.pasciz "Warning: no voltage on Vpullup pin"
+	.pasciz "W", <145>, "n", <134>, "g", <151>, "n", <135>, "v", <175>, <254>, <230>, <136>, " Vp", <218>, <234>, "p", <134>
 
 	; MSG_ONBOARD_I2C_EEPROM_WRITE_PROTECT_DISABLED
 	.section .text.MSG_ONBOARD_I2C_EEPROM_WRITE_PROTECT_DISABLED, code
 	.global _MSG_ONBOARD_I2C_EEPROM_WRITE_PROTECT_DISABLED_str
 _MSG_ONBOARD_I2C_EEPROM_WRITE_PROTECT_DISABLED_str:
-	.pasciz "On-board EEPROM write protect disabled"
+	.pasciz "On-", <250>, <255>, "EEP", <185>, " wr", <141>, <132>, "p", <253>, <156>, "c", <131>, "d", <231>, <208>, "l", <182>
 
 	; MSG_OPENOCD_MODE_IDENTIFIER
 	.section .text.MSG_OPENOCD_MODE_IDENTIFIER, code
@@ -1298,19 +1450,19 @@ _MSG_PIC_DEVICE_ID_str:
 	.section .text.MSG_PIC_EXIT_MODE, code
 	.global _MSG_PIC_EXIT_MODE_str
 _MSG_PIC_EXIT_MODE_str:
-	.pasciz "Please exit PIC programming mode"
+	.pasciz "P", <213>, <209>, <132>, <196>, <212>, "PIC", <220>, <253>, "gramm", <134>, <183>, <203>, <154>
 
 	; MSG_PIC_MACRO_MENU
 	.section .text.MSG_PIC_MACRO_MENU, code
 	.global _MSG_PIC_MACRO_MENU_str
 _MSG_PIC_MACRO_MENU_str:
-	.pasciz "(1) get devID"
+	.pasciz "(1", <166>, "ge", <131>, <154>, "vID"
 
 	; MSG_PIC_MACRO_NOT_IMPLEMENTED
 	.section .text.MSG_PIC_MACRO_NOT_IMPLEMENTED, code
 	.global _MSG_PIC_MACRO_NOT_IMPLEMENTED_str
 _MSG_PIC_MACRO_NOT_IMPLEMENTED_str:
-	.pasciz "Not implemented (yet)"
+	.pasciz "No", <131>, "imp", <213>, <232>, <156>, <137>, "(y", <251>, ")"
 
 	; MSG_PIC_MODE_COMMAND
 	.section .text.MSG_PIC_MODE_COMMAND, code
@@ -1328,7 +1480,7 @@ _MSG_PIC_MODE_DATA_str:
 	.section .text.MSG_PIC_MODE_HEADER, code
 	.global _MSG_PIC_MODE_HEADER_str
 _MSG_PIC_MODE_HEADER_str:
-	.pasciz "PIC(mod dly)=("
+	.pasciz "PIC(", <203>, <137>, "dly)=("
 
 	; MSG_PIC_MODE_IDENTIFIER
 	.section .text.MSG_PIC_MODE_IDENTIFIER, code
@@ -1340,37 +1492,37 @@ _MSG_PIC_MODE_IDENTIFIER_str:
 	.section .text.MSG_PIC_MODE_PROMPT, code
 	.global _MSG_PIC_MODE_PROMPT_str
 _MSG_PIC_MODE_PROMPT_str:
-	.pasciz "Commandmode?\r\n1. 6b/14b\r\n2. 4b/16b"
+	.pasciz "C", <204>, "m", <159>, "d", <203>, <154>, "?", <197>, <133>, "6b/14b", <128>, "2", <133>, "4b/", <222>, "b"
 
 	; MSG_PIC_NO_READ
 	.section .text.MSG_PIC_NO_READ, code
 	.global _MSG_PIC_NO_READ_str
 _MSG_PIC_NO_READ_str:
-	.pasciz "no read"
+	.pasciz "n", <135>, <149>, <174>
 
 	; MSG_PIC_PINS_STATE
 	.section .text.MSG_PIC_PINS_STATE, code
 	.global _MSG_PIC_PINS_STATE_str
 _MSG_PIC_PINS_STATE_str:
-	.pasciz "-\t-\tPGC\tPGD"
+	.pasciz <221>, <221>, "PGC\tPGD"
 
 	; MSG_PIC_REVISION_ID
 	.section .text.MSG_PIC_REVISION_ID, code
 	.global _MSG_PIC_REVISION_ID_str
 _MSG_PIC_REVISION_ID_str:
-	.pasciz " Rev = "
+	.pasciz " ", <227>, "v = "
 
 	; MSG_PIC_UNKNOWN_MODE
 	.section .text.MSG_PIC_UNKNOWN_MODE, code
 	.global _MSG_PIC_UNKNOWN_MODE_str
 _MSG_PIC_UNKNOWN_MODE_str:
-	.pasciz "unknown mode"
+	.pasciz "unk", <233>, "wn ", <203>, <154>
 
 	; MSG_PIN_OUTPUT_TYPE_PROMPT
 	.section .text.MSG_PIN_OUTPUT_TYPE_PROMPT, code
 	.global _MSG_PIN_OUTPUT_TYPE_PROMPT_str
 _MSG_PIN_OUTPUT_TYPE_PROMPT_str:
-	.pasciz "Select output type:\r\n 1. Open drain (H=Hi-Z, L=GND)\r\n 2. Normal (H=3.3V, L=GND)"
+	.pasciz <170>, <213>, "c", <131>, <205>, "t", <187>, <131>, "type", <186>, "Op", <143>, " dra", <134>, <144>, "H=", <245>, "-Z", <146>, "L=G", <248>, ")", <178>, "N", <147>, "m", <164>, <144>, "H=", <201>, "3V", <146>, "L=G", <248>, ")"
 
 	; MSG_POWER_SUPPLIES_OFF
 	.section .text.MSG_POWER_SUPPLIES_OFF, code
@@ -1382,91 +1534,91 @@ _MSG_POWER_SUPPLIES_OFF_str:
 	.section .text.MSG_POWER_SUPPLIES_ON, code
 	.global _MSG_POWER_SUPPLIES_ON_str
 _MSG_POWER_SUPPLIES_ON_str:
-	.pasciz "POWER SUPPLIES ON"
+	.pasciz "POWER SUPPLIES ", <226>
 
 	; MSG_PWM_FREQUENCY_TOO_LOW
 	.section .text.MSG_PWM_FREQUENCY_TOO_LOW, code
 	.global _MSG_PWM_FREQUENCY_TOO_LOW_str
 _MSG_PWM_FREQUENCY_TOO_LOW_str:
-	.pasciz "Frequencies < 1Hz are not supported."
+	.pasciz "F", <149>, "qu", <143>, "cie", <140>, "< 1", <153>, " ", <145>, <132>, <233>, <131>, "supp", <147>, <156>, "d."
 
 	; MSG_PWM_HZ_MARKER
 	.section .text.MSG_PWM_HZ_MARKER, code
 	.global _MSG_PWM_HZ_MARKER_str
 _MSG_PWM_HZ_MARKER_str:
-	.pasciz " Hz"
+	.pasciz " ", <153>
 
 	; MSG_RAW2WIRE_ATR_DATA_UNITS_HEADER
 	.section .text.MSG_RAW2WIRE_ATR_DATA_UNITS_HEADER, code
 	.global _MSG_RAW2WIRE_ATR_DATA_UNITS_HEADER_str
 _MSG_RAW2WIRE_ATR_DATA_UNITS_HEADER_str:
-	.pasciz "Data units: "
+	.pasciz "Da", <254>, " un", <141>, "s", <151>
 
 	; MSG_RAW2WIRE_ATR_DATA_UNITS_NO_INDICATION
 	.section .text.MSG_RAW2WIRE_ATR_DATA_UNITS_NO_INDICATION, code
 	.global _MSG_RAW2WIRE_ATR_DATA_UNITS_NO_INDICATION_str
 _MSG_RAW2WIRE_ATR_DATA_UNITS_NO_INDICATION_str:
-	.pasciz "no indication"
+	.pasciz "n", <135>, <134>, "d", <211>, "a", <168>, <136>
 
 	; MSG_RAW2WIRE_ATR_DATA_UNIT_LENGTH
 	.section .text.MSG_RAW2WIRE_ATR_DATA_UNIT_LENGTH, code
 	.global _MSG_RAW2WIRE_ATR_DATA_UNIT_LENGTH_str
 _MSG_RAW2WIRE_ATR_DATA_UNIT_LENGTH_str:
-	.pasciz "Data unit length (bits): "
+	.pasciz "Da", <254>, " un", <212>, "l", <143>, "gth", <144>, "b", <141>, "s)", <151>
 
 	; MSG_RAW2WIRE_ATR_PROTOCOL_2WIRE
 	.section .text.MSG_RAW2WIRE_ATR_PROTOCOL_2WIRE, code
 	.global _MSG_RAW2WIRE_ATR_PROTOCOL_2WIRE_str
 _MSG_RAW2WIRE_ATR_PROTOCOL_2WIRE_str:
-	.pasciz "2 wire"
+	.pasciz "2 wi", <149>
 
 	; MSG_RAW2WIRE_ATR_PROTOCOL_3WIRE
 	.section .text.MSG_RAW2WIRE_ATR_PROTOCOL_3WIRE, code
 	.global _MSG_RAW2WIRE_ATR_PROTOCOL_3WIRE_str
 _MSG_RAW2WIRE_ATR_PROTOCOL_3WIRE_str:
-	.pasciz "3 wire"
+	.pasciz "3 wi", <149>
 
 	; MSG_RAW2WIRE_ATR_PROTOCOL_HEADER
 	.section .text.MSG_RAW2WIRE_ATR_PROTOCOL_HEADER, code
 	.global _MSG_RAW2WIRE_ATR_PROTOCOL_HEADER_str
 _MSG_RAW2WIRE_ATR_PROTOCOL_HEADER_str:
-	.pasciz "Protocol: "
+	.pasciz "P", <253>, <214>, "c", <175>, <151>
 
 	; MSG_RAW2WIRE_ATR_PROTOCOL_SERIAL
 	.section .text.MSG_RAW2WIRE_ATR_PROTOCOL_SERIAL, code
 	.global _MSG_RAW2WIRE_ATR_PROTOCOL_SERIAL_str
 _MSG_RAW2WIRE_ATR_PROTOCOL_SERIAL_str:
-	.pasciz "serial"
+	.pasciz "s", <139>, "i", <164>
 
 	; MSG_RAW2WIRE_ATR_PROTOCOL_UNKNOWN
 	.section .text.MSG_RAW2WIRE_ATR_PROTOCOL_UNKNOWN, code
 	.global _MSG_RAW2WIRE_ATR_PROTOCOL_UNKNOWN_str
 _MSG_RAW2WIRE_ATR_PROTOCOL_UNKNOWN_str:
-	.pasciz "unknown"
+	.pasciz "unk", <233>, "wn"
 
 	; MSG_RAW2WIRE_ATR_READ_TYPE_HEADER
 	.section .text.MSG_RAW2WIRE_ATR_READ_TYPE_HEADER, code
 	.global _MSG_RAW2WIRE_ATR_READ_TYPE_HEADER_str
 _MSG_RAW2WIRE_ATR_READ_TYPE_HEADER_str:
-	.pasciz "Read type: "
+	.pasciz <227>, "a", <137>, "type", <151>
 
 	; MSG_RAW2WIRE_ATR_READ_TYPE_TO_END
 	.section .text.MSG_RAW2WIRE_ATR_READ_TYPE_TO_END, code
 	.global _MSG_RAW2WIRE_ATR_READ_TYPE_TO_END_str
 _MSG_RAW2WIRE_ATR_READ_TYPE_TO_END_str:
-	.pasciz "to end"
+	.pasciz <177>, <143>, "d"
 
 	; MSG_RAW2WIRE_ATR_READ_TYPE_VARIABLE_LENGTH
 	.section .text.MSG_RAW2WIRE_ATR_READ_TYPE_VARIABLE_LENGTH, code
 	.global _MSG_RAW2WIRE_ATR_READ_TYPE_VARIABLE_LENGTH_str
 _MSG_RAW2WIRE_ATR_READ_TYPE_VARIABLE_LENGTH_str:
-	.pasciz "variable length"
+	.pasciz "v", <145>, "i", <208>, <167>, "l", <143>, "gth"
 
 	; MSG_RAW2WIRE_ATR_REPLY_HEADER
 	.section .text.MSG_RAW2WIRE_ATR_REPLY_HEADER, code
 	.global _MSG_RAW2WIRE_ATR_REPLY_HEADER_str
 _MSG_RAW2WIRE_ATR_REPLY_HEADER_str:
-	.pasciz "ISO 7816-3 reply (uses current LSB setting): "
+	.pasciz <224>, "O 78", <222>, "-3 ", <149>, "ply", <144>, <216>, "e", <140>, "curr", <143>, <131>, "LSB", <190>, <251>, "t", <134>, "g)", <151>
 
 	; MSG_RAW2WIRE_ATR_RFU
 	.section .text.MSG_RAW2WIRE_ATR_RFU, code
@@ -1478,7 +1630,7 @@ _MSG_RAW2WIRE_ATR_RFU_str:
 	.section .text.MSG_RAW2WIRE_ATR_TRIGGER_INFO, code
 	.global _MSG_RAW2WIRE_ATR_TRIGGER_INFO_str
 _MSG_RAW2WIRE_ATR_TRIGGER_INFO_str:
-	.pasciz "ISO 7816-3 ATR (RESET on CS)\r\nRESET HIGH, CLOCK TICK, RESET LOW"
+	.pasciz <224>, "O 78", <222>, "-3 ", <181>, "R", <144>, <158>, <195>, "T ", <136>, " ", <202>, ")", <128>, <158>, <195>, "T HIGH", <146>, <194>, "O", <242>, " TI", <242>, <146>, <158>, <195>, "T", <239>, "OW"
 
 	; MSG_RAW2WIRE_I2C_START
 	.section .text.MSG_RAW2WIRE_I2C_START, code
@@ -1496,25 +1648,25 @@ _MSG_RAW2WIRE_I2C_STOP_str:
 	.section .text.MSG_RAW2WIRE_MACRO_MENU, code
 	.global _MSG_RAW2WIRE_MACRO_MENU_str
 _MSG_RAW2WIRE_MACRO_MENU_str:
-	.pasciz " 0.Macro menu\r\n 1.ISO7816-3 ATR\r\n 2.ISO7816-3 parse only"
+	.pasciz <238>, ".", <207>, <232>, "u", <157>, ".", <224>, "O78", <222>, "-3 ", <181>, "R", <152>, ".", <224>, "O78", <222>, "-3", <220>, <145>, "s", <132>, <136>, "ly"
 
 	; MSG_RAW2WIRE_MODE_HEADER
 	.section .text.MSG_RAW2WIRE_MODE_HEADER, code
 	.global _MSG_RAW2WIRE_MODE_HEADER_str
 _MSG_RAW2WIRE_MODE_HEADER_str:
-	.pasciz "R2W (spd hiz)=( "
+	.pasciz "R2W", <144>, <176>, <137>, <184>, "z)=( "
 
 	; MSG_RAW3WIRE_MODE_HEADER
 	.section .text.MSG_RAW3WIRE_MODE_HEADER, code
 	.global _MSG_RAW3WIRE_MODE_HEADER_str
 _MSG_RAW3WIRE_MODE_HEADER_str:
-	.pasciz "R3W (spd csl hiz)=( "
+	.pasciz "R3W", <144>, <176>, <137>, "csl ", <184>, "z)=( "
 
 	; MSG_RAW_BRG_VALUE_INPUT
 	.section .text.MSG_RAW_BRG_VALUE_INPUT, code
 	.global _MSG_RAW_BRG_VALUE_INPUT_str
 _MSG_RAW_BRG_VALUE_INPUT_str:
-	.pasciz "Enter raw value for BRG"
+	.pasciz "Ent", <139>, " raw v", <164>, "u", <132>, "f", <147>, " BRG"
 
 	; MSG_RAW_MODE_IDENTIFIER
 	.section .text.MSG_RAW_MODE_IDENTIFIER, code
@@ -1526,67 +1678,73 @@ _MSG_RAW_MODE_IDENTIFIER_str:
 	.section .text.MSG_READ_HEADER, code
 	.global _MSG_READ_HEADER_str
 _MSG_READ_HEADER_str:
-	.pasciz "READ: "
+	.pasciz <158>, <180>, <151>
+
+	; MSG_REPEAT_NO_COMMAND_LINE
+	.section .text.MSG_REPEAT_NO_COMMAND_LINE, code
+	.global _MSG_REPEAT_NO_COMMAND_LINE_str
+_MSG_REPEAT_NO_COMMAND_LINE_str:
+	.pasciz "N", <135>, "bu", <140>, "c", <204>, "m", <159>, <137>, "l", <134>, <132>, <177>, <149>, "peat"
 
 	; MSG_RESET_MESSAGE
 	.section .text.MSG_RESET_MESSAGE, code
 	.global _MSG_RESET_MESSAGE_str
 _MSG_RESET_MESSAGE_str:
-	.pasciz "RESET"
+	.pasciz <158>, <195>, "T"
 
 	; MSG_SNIFFER_MESSAGE
 	.section .text.MSG_SNIFFER_MESSAGE, code
 	.global _MSG_SNIFFER_MESSAGE_str
 _MSG_SNIFFER_MESSAGE_str:
-	.pasciz "Sniffer"
+	.pasciz "Sni", <252>, <139>
 
 	; MSG_SOFTWARE_MODE_SPEED_PROMPT
 	.section .text.MSG_SOFTWARE_MODE_SPEED_PROMPT, code
 	.global _MSG_SOFTWARE_MODE_SPEED_PROMPT_str
 _MSG_SOFTWARE_MODE_SPEED_PROMPT_str:
-	.pasciz "Set speed:\r\n 1. ~5KHz\r\n 2. ~50KHz\r\n 3. ~100KHz\r\n 4. ~400KHz"
+	.pasciz <198>, <176>, "e", <182>, <186>, "~5", <192>, <178>, "~50", <192>, <130>, "3", <133>, "~1", <162>, <192>, <130>, "4", <133>, "~4", <162>, <192>
 
 	; MSG_SPI_COULD_NOT_KEEP_UP
 	.section .text.MSG_SPI_COULD_NOT_KEEP_UP, code
 	.global _MSG_SPI_COULD_NOT_KEEP_UP_str
 _MSG_SPI_COULD_NOT_KEEP_UP_str:
-	.pasciz "Couldn't keep up"
+	.pasciz "Co", <160>, "dn'", <131>, "kee", <171>, "up"
 
 	; MSG_SPI_CS_DISABLED
 	.section .text.MSG_SPI_CS_DISABLED, code
 	.global _MSG_SPI_CS_DISABLED_str
 _MSG_SPI_CS_DISABLED_str:
-	.pasciz "CS DISABLED"
+	.pasciz <202>, " D", <224>, "ABLED"
 
 	; MSG_SPI_CS_ENABLED
 	.section .text.MSG_SPI_CS_ENABLED, code
 	.global _MSG_SPI_CS_ENABLED_str
 _MSG_SPI_CS_ENABLED_str:
-	.pasciz "CS ENABLED"
+	.pasciz <202>, " ENABLED"
 
 	; MSG_SPI_CS_MODE_PROMPT
 	.section .text.MSG_SPI_CS_MODE_PROMPT, code
 	.global _MSG_SPI_CS_MODE_PROMPT_str
 _MSG_SPI_CS_MODE_PROMPT_str:
-	.pasciz "CS:\r\n 1. CS\r\n 2. /CS *default"
+	.pasciz <202>, <186>, <202>, <178>, "/", <202>, <206>, <154>, "fa", <160>, "t"
 
 	; MSG_SPI_EDGE_PROMPT
 	.section .text.MSG_SPI_EDGE_PROMPT, code
 	.global _MSG_SPI_EDGE_PROMPT_str
 _MSG_SPI_EDGE_PROMPT_str:
-	.pasciz "Output clock edge:\r\n 1. Idle to active\r\n 2. Active to idle *default"
+	.pasciz "Out", <187>, <131>, "c", <165>, "ck ", <182>, "ge", <186>, "I", <210>, <177>, <150>, <219>, "e", <178>, "Ac", <219>, <132>, <177>, "i", <210>, "*", <154>, "fa", <160>, "t"
 
 	; MSG_SPI_MACRO_MENU
 	.section .text.MSG_SPI_MACRO_MENU, code
 	.global _MSG_SPI_MACRO_MENU_str
 _MSG_SPI_MACRO_MENU_str:
-	.pasciz " 0.Macro menu\r\n 1.Sniff CS low\r\n 2.Sniff all traffic\r\n10.Set clock idle low\r\n11.Set clock idle high\r\n12.Set edge idle to active\r\n13.Set edge active to idle\r\n14.Sample phase on middle\r\n15.Sample phase on end"
+	.pasciz <238>, ".", <207>, <232>, "u", <157>, ".Sni", <252>, " ", <202>, " ", <165>, "w", <152>, ".Sni", <252>, " ", <164>, "l ", <215>, "a", <252>, <211>, <197>, "0.", <198>, "c", <165>, "ck i", <210>, <165>, "w", <197>, "1.", <198>, "c", <165>, "ck i", <210>, <184>, "gh", <197>, "2.", <198>, <182>, <230>, "i", <210>, <177>, <150>, <219>, "e", <197>, <201>, <198>, <182>, <230>, <150>, <219>, <132>, <177>, "id", <213>, <197>, "4.Samp", <167>, "ph", <209>, <132>, <136>, " midd", <213>, <197>, "5.Samp", <167>, "ph", <209>, <132>, <136>, " ", <143>, "d"
 
 	; MSG_SPI_MODE_HEADER_START
 	.section .text.MSG_SPI_MODE_HEADER_START, code
 	.global _MSG_SPI_MODE_HEADER_START_str
 _MSG_SPI_MODE_HEADER_START_str:
-	.pasciz "SPI (spd ckp ske smp csl hiz)=( "
+	.pasciz "SPI", <144>, <176>, <137>, "ck", <171>, "sk", <132>, "sm", <171>, "csl ", <184>, "z)=( "
 
 	; MSG_SPI_MODE_IDENTIFIER
 	.section .text.MSG_SPI_MODE_IDENTIFIER, code
@@ -1598,55 +1756,55 @@ _MSG_SPI_MODE_IDENTIFIER_str:
 	.section .text.MSG_SPI_PINS_STATE, code
 	.global _MSG_SPI_PINS_STATE_str
 _MSG_SPI_PINS_STATE_str:
-	.pasciz "CS\tMISO\tCLK\tMOSI"
+	.pasciz <202>, "\tM", <224>, "O\t", <194>, "K\t", <247>, "SI"
 
 	; MSG_SPI_POLARITY_PROMPT
 	.section .text.MSG_SPI_POLARITY_PROMPT, code
 	.global _MSG_SPI_POLARITY_PROMPT_str
 _MSG_SPI_POLARITY_PROMPT_str:
-	.pasciz "Clock polarity:\r\n 1. Idle low *default\r\n 2. Idle high"
+	.pasciz "C", <165>, "ck", <220>, <175>, <145>, <141>, "y", <186>, "I", <210>, <165>, "w", <206>, <154>, "fa", <160>, "t", <178>, "I", <210>, <184>, "gh"
 
 	; MSG_SPI_SAMPLE_PROMPT
 	.section .text.MSG_SPI_SAMPLE_PROMPT, code
 	.global _MSG_SPI_SAMPLE_PROMPT_str
 _MSG_SPI_SAMPLE_PROMPT_str:
-	.pasciz "Input sample phase:\r\n 1. Middle *default\r\n 2. End"
+	.pasciz "In", <187>, <131>, "samp", <167>, "ph", <209>, "e", <186>, "Mid", <210>, "*", <154>, "fa", <160>, "t", <178>, "End"
 
 	; MSG_SPI_SPEED_PROMPT
 	.section .text.MSG_SPI_SPEED_PROMPT, code
 	.global _MSG_SPI_SPEED_PROMPT_str
 _MSG_SPI_SPEED_PROMPT_str:
-	.pasciz "Set speed:\r\n 1.  30KHz\r\n 2. 125KHz\r\n 3. 250KHz\r\n 4.   1MHz\r\n 5.  50KHz\r\n 6. 1.3MHz\r\n 7.   2MHz\r\n 8. 2.6MHz\r\n 9. 3.2MHz\r\n10.   4MHz\r\n11. 5.3MHz\r\n12.   8MHz"
+	.pasciz <198>, <176>, "e", <182>, <186>, " 30", <192>, <178>, "125", <192>, <130>, "3", <133>, "250", <192>, <130>, "4", <133>, <142>, "1", <225>, <130>, "5", <133>, " 50", <192>, <130>, "6", <133>, "1.3", <225>, <130>, "7", <133>, <142>, "2", <225>, <130>, "8", <133>, "2.6", <225>, <130>, "9", <133>, <201>, "2", <225>, <197>, "0", <133>, <142>, "4", <225>, <197>, "1", <133>, "5.3", <225>, <197>, "2", <133>, <142>, "8", <225>
 
 	; MSG_UART_BAUD_CALCULATED
 	.section .text.MSG_UART_BAUD_CALCULATED, code
 	.global _MSG_UART_BAUD_CALCULATED_str
 _MSG_UART_BAUD_CALCULATED_str:
-	.pasciz "\n\rCalculated: \t"
+	.pasciz "\n\rC", <164>, "c", <160>, "a", <156>, "d", <151>, "\t"
 
 	; MSG_UART_BAUD_ESTIMATED
 	.section .text.MSG_UART_BAUD_ESTIMATED, code
 	.global _MSG_UART_BAUD_ESTIMATED_str
 _MSG_UART_BAUD_ESTIMATED_str:
-	.pasciz "\n\rEstimated:  \t"
+	.pasciz "\n\rE", <163>, "ima", <156>, "d:", <142>, "\t"
 
 	; MSG_UART_BAUD_OVERFLOW
 	.section .text.MSG_UART_BAUD_OVERFLOW, code
 	.global _MSG_UART_BAUD_OVERFLOW_str
 _MSG_UART_BAUD_OVERFLOW_str:
-	.pasciz "** Baud>16m: The BP cannot measure above 16000000, Done."
+	.pasciz "** Baud>", <222>, "m", <151>, "Th", <132>, "BP c", <159>, <233>, <131>, "me", <209>, "ur", <132>, <208>, "ov", <132>, <222>, <162>, <162>, <162>, <146>, "D", <136>, "e."
 
 	; MSG_UART_BITS_PARITY_PROMPT
 	.section .text.MSG_UART_BITS_PARITY_PROMPT, code
 	.global _MSG_UART_BITS_PARITY_PROMPT_str
 _MSG_UART_BITS_PARITY_PROMPT_str:
-	.pasciz "Data bits and parity:\r\n 1. 8, NONE *default \r\n 2. 8, EVEN \r\n 3. 8, ODD \r\n 4. 9, NONE"
+	.pasciz "Da", <254>, " b", <141>, <140>, <159>, <137>, "p", <145>, <141>, "y", <186>, "8", <146>, "N", <226>, "E", <206>, <154>, "fa", <160>, <131>, <178>, "8", <146>, "EVEN ", <130>, "3", <133>, "8", <146>, "ODD ", <130>, "4", <133>, "9", <146>, "N", <226>, "E"
 
 	; MSG_UART_BITS_STOP_PROMPT
 	.section .text.MSG_UART_BITS_STOP_PROMPT, code
 	.global _MSG_UART_BITS_STOP_PROMPT_str
 _MSG_UART_BITS_STOP_PROMPT_str:
-	.pasciz "Stop bits:\r\n 1. 1 *default\r\n 2. 2"
+	.pasciz "S", <214>, <171>, "b", <141>, "s", <186>, "1", <206>, <154>, "fa", <160>, "t", <178>, "2"
 
 	; MSG_UART_BPS_MARKER
 	.section .text.MSG_UART_BPS_MARKER, code
@@ -1658,31 +1816,31 @@ _MSG_UART_BPS_MARKER_str:
 	.section .text.MSG_UART_BRIDGE, code
 	.global _MSG_UART_BRIDGE_str
 _MSG_UART_BRIDGE_str:
-	.pasciz "UART bridge"
+	.pasciz "U", <172>, "T bridge"
 
 	; MSG_UART_BRIDGE_EXIT
 	.section .text.MSG_UART_BRIDGE_EXIT, code
 	.global _MSG_UART_BRIDGE_EXIT_str
 _MSG_UART_BRIDGE_EXIT_str:
-	.pasciz "Normal to exit"
+	.pasciz "N", <147>, "m", <164>, " ", <177>, <196>, <141>
 
 	; MSG_UART_CUSTOM_BAUD_RATE_PROMPT
 	.section .text.MSG_UART_CUSTOM_BAUD_RATE_PROMPT, code
 	.global _MSG_UART_CUSTOM_BAUD_RATE_PROMPT_str
 _MSG_UART_CUSTOM_BAUD_RATE_PROMPT_str:
-	.pasciz "Input a custom BAUD rate:"
+	.pasciz "In", <187>, <131>, "a cu", <163>, <204>, " B", <173>, "D ra", <156>, ":"
 
 	; MSG_UART_EARLY_EXIT
 	.section .text.MSG_UART_EARLY_EXIT, code
 	.global _MSG_UART_EARLY_EXIT_str
 _MSG_UART_EARLY_EXIT_str:
-	.pasciz "** Early Exit!"
+	.pasciz "** E", <145>, "l", <161>, "Ex", <141>, "!"
 
 	; MSG_UART_FAILED_NO_DATA
 	.section .text.MSG_UART_FAILED_NO_DATA, code
 	.global _MSG_UART_FAILED_NO_DATA_str
 _MSG_UART_FAILED_NO_DATA_str:
-	.pasciz "FAILED, NO DATA"
+	.pasciz "FAILED", <146>, "NO ", <244>, "A"
 
 	; MSG_UART_FRAMING_ERROR
 	.section .text.MSG_UART_FRAMING_ERROR, code
@@ -1694,85 +1852,91 @@ _MSG_UART_FRAMING_ERROR_str:
 	.section .text.MSG_UART_LIVE_DISPLAY_START, code
 	.global _MSG_UART_LIVE_DISPLAY_START_str
 _MSG_UART_LIVE_DISPLAY_START_str:
-	.pasciz "UART LIVE DISPLAY, } TO STOP"
+	.pasciz "U", <172>, "T", <239>, "IVE D", <224>, "PLAY", <146>, "} TO STOP"
 
 	; MSG_UART_LIVE_DISPLAY_STOP
 	.section .text.MSG_UART_LIVE_DISPLAY_STOP, code
 	.global _MSG_UART_LIVE_DISPLAY_STOP_str
 _MSG_UART_LIVE_DISPLAY_STOP_str:
-	.pasciz "LIVE DISPLAY STOPPED"
+	.pasciz "LIVE D", <224>, "PLAY STOPPED"
 
 	; MSG_UART_MACRO_MENU
 	.section .text.MSG_UART_MACRO_MENU, code
 	.global _MSG_UART_MACRO_MENU_str
 _MSG_UART_MACRO_MENU_str:
-	.pasciz " 0.Macro menu\r\n 1.Transparent bridge\r\n 2.Live monitor\r\n 3.Bridge with flow control\n\r 4.Auto Baud Detection (Activity Needed)"
+	.pasciz <238>, ".", <207>, <232>, "u", <157>, ".Tr", <159>, <176>, <145>, <143>, <131>, "bridge", <152>, ".Liv", <132>, "m", <136>, <141>, <147>, <130>, <201>, "Brid", <230>, "w", <141>, "h f", <165>, "w ", <229>, <215>, <175>, "\n\r 4.Au", <177>, "Bau", <137>, "De", <156>, "c", <168>, <136>, <144>, "Ac", <219>, <141>, <161>, "Nee", <154>, "d)"
 
 	; MSG_UART_MODE_HEADER
 	.section .text.MSG_UART_MODE_HEADER, code
 	.global _MSG_UART_MODE_HEADER_str
 _MSG_UART_MODE_HEADER_str:
-	.pasciz "UART (spd brg dbp sb rxp hiz)=( "
+	.pasciz "U", <172>, "T", <144>, <176>, <137>, "br", <183>, "db", <171>, "sb rx", <171>, <184>, "z)=( "
 
 	; MSG_UART_MODE_IDENTIFIER
 	.section .text.MSG_UART_MODE_IDENTIFIER, code
 	.global _MSG_UART_MODE_IDENTIFIER_str
 _MSG_UART_MODE_IDENTIFIER_str:
-	.pasciz "ART1"
+	.pasciz <172>, "T1"
 
 	; MSG_UART_OVERRUN_ERROR
 	.section .text.MSG_UART_OVERRUN_ERROR, code
 	.global _MSG_UART_OVERRUN_ERROR_str
 _MSG_UART_OVERRUN_ERROR_str:
-	.pasciz "*Bytes dropped*"
+	.pasciz "*By", <156>, <140>, "d", <253>, "pp", <182>, "*"
 
 	; MSG_UART_PARITY_ERROR
 	.section .text.MSG_UART_PARITY_ERROR, code
 	.global _MSG_UART_PARITY_ERROR_str
 _MSG_UART_PARITY_ERROR_str:
-	.pasciz "-p "
+	.pasciz "-", <171>
 
 	; MSG_UART_PINS_STATE
 	.section .text.MSG_UART_PINS_STATE, code
 	.global _MSG_UART_PINS_STATE_str
 _MSG_UART_PINS_STATE_str:
-	.pasciz "-\tRxD\t-\tTxD"
+	.pasciz <221>, "RxD\t", <221>, "TxD"
 
 	; MSG_UART_POLARITY_PROMPT
 	.section .text.MSG_UART_POLARITY_PROMPT, code
 	.global _MSG_UART_POLARITY_PROMPT_str
 _MSG_UART_POLARITY_PROMPT_str:
-	.pasciz "Receive polarity:\r\n 1. Idle 1 *default\r\n 2. Idle 0"
+	.pasciz <227>, "ceiv", <132>, "p", <175>, <145>, <141>, "y", <186>, "I", <210>, "1", <206>, <154>, "fa", <160>, "t", <178>, "I", <210>, "0"
 
 	; MSG_UART_RAW_UART_INPUT
 	.section .text.MSG_UART_RAW_UART_INPUT, code
 	.global _MSG_UART_RAW_UART_INPUT_str
 _MSG_UART_RAW_UART_INPUT_str:
-	.pasciz "Raw UART input"
+	.pasciz "Raw U", <172>, "T ", <134>, <187>, "t"
 
 	; MSG_UART_SET_PORT_SPEED
 	.section .text.MSG_UART_SET_PORT_SPEED, code
 	.global _MSG_UART_SET_PORT_SPEED_str
 _MSG_UART_SET_PORT_SPEED_str:
-	.pasciz "Set serial port speed: (bps)\r\n 1. 300\r\n 2. 1200\r\n 3. 2400\r\n 4. 4800\r\n 5. 9600\r\n 6. 19200\r\n 7. 38400\r\n 8. 57600\r\n 9. 115200\r\n10. Input Custom BAUD\r\n11. Auto-Baud Detection (Activity Required)"
+	.pasciz <198>, "s", <139>, "i", <164>, <220>, <147>, <131>, <176>, "e", <182>, ":", <144>, "bps)", <179>, "3", <162>, <178>, "12", <162>, <130>, "3", <133>, "24", <162>, <130>, "4", <133>, "48", <162>, <130>, "5", <133>, "96", <162>, <130>, "6", <133>, "192", <162>, <130>, "7", <133>, "384", <162>, <130>, "8", <133>, "576", <162>, <130>, "9", <133>, "1152", <162>, <197>, "0", <133>, "In", <187>, <131>, "Cu", <163>, <204>, " B", <173>, "D", <197>, "1", <133>, "Au", <214>, "-Bau", <137>, "De", <156>, "c", <168>, <136>, <144>, "Ac", <219>, <141>, <161>, <227>, "qui", <149>, "d)"
 
 	; MSG_UART_WAITING_ACTIVITY
 	.section .text.MSG_UART_WAITING_ACTIVITY, code
 	.global _MSG_UART_WAITING_ACTIVITY_str
 _MSG_UART_WAITING_ACTIVITY_str:
-	.pasciz "Waiting activity..."
+	.pasciz "Wa", <141>, <134>, <183>, <150>, <219>, <141>, "y..."
 
 	; MSG_UNKNOWN_MACRO_ERROR
 	.section .text.MSG_UNKNOWN_MACRO_ERROR, code
 	.global _MSG_UNKNOWN_MACRO_ERROR_str
 _MSG_UNKNOWN_MACRO_ERROR_str:
-	.pasciz "Unknown macro, try ? or (0) for help"
+	.pasciz "Unk", <233>, "wn m", <188>, "o", <146>, <215>, <161>, "? ", <147>, <144>, "0", <166>, "f", <147>, " help"
+
+	; MSG_USER_MACRO_STORAGE_FULL
+	.section .text.MSG_USER_MACRO_STORAGE_FULL, code
+	.global _MSG_USER_MACRO_STORAGE_FULL_str
+_MSG_USER_MACRO_STORAGE_FULL_str:
+	.pasciz <207>, <163>, <147>, "a", <230>, "f", <218>
 
 	; MSG_USING_ONBOARD_I2C_EEPROM
 	.section .text.MSG_USING_ONBOARD_I2C_EEPROM, code
 	.global _MSG_USING_ONBOARD_I2C_EEPROM_str
 _MSG_USING_ONBOARD_I2C_EEPROM_str:
-	.pasciz "Now using on-board EEPROM I2C interface"
+	.pasciz "Now ", <216>, <134>, <183>, <136>, "-", <250>, <255>, "EEP", <185>, " ", <246>, " ", <134>, "t", <139>, "f", <150>, "e"
 
 	; MSG_VOLTAGE_UNIT
 	.section .text.MSG_VOLTAGE_UNIT, code
@@ -1784,37 +1948,37 @@ _MSG_VOLTAGE_UNIT_str:
 	.section .text.MSG_VOLTAGE_VPULLUP_ALREADY_PRESENT, code
 	.global _MSG_VOLTAGE_VPULLUP_ALREADY_PRESENT_str
 _MSG_VOLTAGE_VPULLUP_ALREADY_PRESENT_str:
-	.pasciz "Warning: already a voltage on Vpullup pin"
+	.pasciz "W", <145>, "n", <134>, "g", <151>, <164>, <149>, <174>, <161>, "a v", <175>, <254>, <230>, <136>, " Vp", <218>, <234>, "p", <134>
 
 	; MSG_VPU_3V3_MARKER
 	.section .text.MSG_VPU_3V3_MARKER, code
 	.global _MSG_VPU_3V3_MARKER_str
 _MSG_VPU_3V3_MARKER_str:
-	.pasciz "Vpu=3V3, "
+	.pasciz "V", <187>, "=3V3", <146>
 
 	; MSG_VPU_5V_MARKER
 	.section .text.MSG_VPU_5V_MARKER, code
 	.global _MSG_VPU_5V_MARKER_str
 _MSG_VPU_5V_MARKER_str:
-	.pasciz "Vpu=5V, "
+	.pasciz "V", <187>, "=5V", <146>
 
 	; MSG_VREG_TOO_LOW
 	.section .text.MSG_VREG_TOO_LOW, code
 	.global _MSG_VREG_TOO_LOW_str
 _MSG_VREG_TOO_LOW_str:
-	.pasciz "VREG too low, is there a short?"
+	.pasciz "V", <158>, "G ", <214>, <135>, <165>, "w", <146>, "i", <140>, "th", <139>, <132>, "a", <190>, "h", <147>, "t?"
 
 	; MSG_WARNING_HEADER
 	.section .text.MSG_WARNING_HEADER, code
 	.global _MSG_WARNING_HEADER_str
 _MSG_WARNING_HEADER_str:
-	.pasciz "Warning: "
+	.pasciz "W", <145>, "n", <134>, "g", <151>
 
 	; MSG_WARNING_SHORT_OR_NO_PULLUP
 	.section .text.MSG_WARNING_SHORT_OR_NO_PULLUP, code
 	.global _MSG_WARNING_SHORT_OR_NO_PULLUP_str
 _MSG_WARNING_SHORT_OR_NO_PULLUP_str:
-	.pasciz "*Short or no pull-up "
+	.pasciz "*Sh", <147>, <131>, <147>, " n", <135>, "p", <218>, "-", <234>
 
 	; MSG_XSV1_MODE_IDENTIFIER
 	.section .text.MSG_XSV1_MODE_IDENTIFIER, code
@@ -26,8 +26,11 @@
 #include "binary_io.h"
 #include "core.h"
 #include "proc_menu.h" //need our public versionInfo() function
+#include "scheduler.h"
 #include "selftest.h"
 #include "sump.h"
+#include "terminal_ops.h"
+#include "user_macros.h"
 
 /**
  * ASCII scancode for the NUL character.
@@ -238,6 +241,33 @@ static void switch_psu_on(void);
  */
 static void switch_psu_off(void);
 
+/**
+ * Receives a script into the terminal buffer and switches the user menu into
+ * batch mode.
+ *
+ * The script is made of regular command lines separated by CR and/or LF
+ * characters, and is terminated by an EOT (^D) character.
+ */
+static void receive_batch_script(void);
+
+/**
+ * Copies the next non-empty line of the batch script into the command line
+ * buffer, without echoing it back.
+ *
+ * @return true if a line was copied, false if the script is over.
+ */
+static bool load_batch_script_line(void);
+
+/**
+ * Writes a value read from the bus to the serial port, even if output is
+ * suppressed because a batch script is being run.
+ *
+ * @param[in] value the value to write.
+ * @param[in] single_bit true if the value is a single bit state, false if it
+ * should be formatted according to the current display mode.
+ */
+static void write_batch_result(const uint16_t value, const bool single_bit);
+
 #ifdef BUSPIRATEV4
 void set_pullup_voltage(void);
 #endif /* BUSPIRATEV4 */
@@ -246,8 +276,10 @@ char cmdbuf[BP_COMMAND_BUFFER_SIZE] = {0};
 unsigned int cmdend;
 unsigned int cmdstart;
 
+#ifndef BP_ENABLE_FLASH_MACROS
 static char user_macros[BP_USER_MACROS_COUNT][BP_USER_MACRO_MAX_LENGTH];
 static int user_macro;
+#endif /* !BP_ENABLE_FLASH_MACROS */
 
 /**
  * The user menu global state container structure.
@@ -264,6 +296,12 @@ typedef struct {
 
   /** Flag indicating if a potentially valid command has been entered. */
   bool command_present;
+
+  /** Offset of the next batch script character in the terminal buffer. */
+  uint16_t batch_offset;
+
+  /** Length of the batch script stored in the terminal buffer. */
+  uint16_t batch_length;
 } menu_state_t;
 
 /**
@@ -296,19 +334,41 @@ void serviceuser(void) {
                 // display read is performed
   newDmode = 0;
 
+#ifdef BP_ENABLE_FLASH_MACROS
+  user_macros_init();
+#else
   memset(user_macros, 0, sizeof(user_macros));
   user_macro = 0;
+#endif /* BP_ENABLE_FLASH_MACROS */
 
   for (;;) {
-    bp_write_string(enabled_protocols[bus_pirate_configuration.bus_mode].name);
+    if (!bus_pirate_configuration.batch_mode) {
+      bp_write_string(
+          enabled_protocols[bus_pirate_configuration.bus_mode].name);
 #ifdef BP_ENABLE_BASIC_SUPPORT
-    if (bus_pirate_configuration.basic) {
-      // bpWstring("(BASIC)");
-      BPMSG1084;
-    }
+      if (bus_pirate_configuration.basic) {
+        // bpWstring("(BASIC)");
+        BPMSG1084;
+      }
 #endif /* BP_ENABLE_BASIC_SUPPORT */
-    bp_write_string(">");
+      bp_write_string(">");
+    }
     while (!menu_state.command_present) {
+      if (bus_pirate_configuration.batch_mode) {
+        if (!load_batch_script_line()) {
+          bus_pirate_configuration.batch_mode = NO;
+          MSG_BATCH_MODE_DONE;
+        }
+
+        /* Submit the line as if the enter key was pressed. */
+        menu_state.command_present = YES;
+        cmdbuf[cmdend] = 0x00;
+        cmdend = (cmdend + 1) & CMDLENMSK;
+        menu_state.cursor_position = cmdend;
+        continue;
+      }
+
+#ifndef BP_ENABLE_FLASH_MACROS
       if (user_macro) {
         user_macro--;
         temp = 0;
@@ -321,22 +381,35 @@ void serviceuser(void) {
         }
         user_macro = 0;
       }
+#endif /* !BP_ENABLE_FLASH_MACROS */
 
       /* Handle periodic service callbacks if needed. */
 
       while (!user_serial_ready_to_read()) {
+        bool serviced = NO;
+
+#ifdef BP_ENABLE_SCHEDULER
+        serviced = bp_scheduler_service();
+        if (!serviced) {
+          bp_scheduler_wait();
+        }
+#else
         if (mode_configuration.periodicService == ON) {
-          /* Print periodic service output if any has been generated. */
-          if (enabled_protocols[bus_pirate_configuration.bus_mode]
-                  .periodic_update()) {
-            bp_write_string(
-                enabled_protocols[bus_pirate_configuration.bus_mode].name);
-            bp_write_string(">");
-            if (cmdstart != cmdend) {
-              for (size_t offset = cmdstart; offset != cmdend; offset++) {
-                user_serial_transmit_character(cmdbuf[offset]);
-                offset &= CMDLENMSK;
-              }
+          serviced =
+              enabled_protocols[bus_pirate_configuration.bus_mode]
+                  .periodic_update();
+        }
+#endif /* BP_ENABLE_SCHEDULER */
+
+        /* Print the prompt again if any periodic output has been generated. */
+        if (serviced) {
+          bp_write_string(
+              enabled_protocols[bus_pirate_configuration.bus_mode].name);
+          bp_write_string(">");
+          if (cmdstart != cmdend) {
+            for (size_t offset = cmdstart; offset != cmdend; offset++) {
+              user_serial_transmit_character(cmdbuf[offset]);
+              offset &= CMDLENMSK;
             }
           }
         }
@@ -424,12 +497,18 @@ void serviceuser(void) {
     mode_configuration.command_error = NO;
 
     bool stop = NO;
+#ifdef BP_ENABLE_COMMAND_REPEAT
+    bool repeatable = YES;
+#endif /* BP_ENABLE_COMMAND_REPEAT */
 
 #ifdef BP_ENABLE_BASIC_SUPPORT
     if (bus_pirate_configuration.basic) {
       bp_basic_enter_interactive_interpreter();
       BPMSG1085;
       stop = YES;
+#ifdef BP_ENABLE_COMMAND_REPEAT
+      repeatable = NO;
+#endif /* BP_ENABLE_COMMAND_REPEAT */
     }
 #endif /* BP_ENABLE_BASIC_SUPPORT */
 
@@ -437,6 +516,11 @@ void serviceuser(void) {
                   // different display read is performed
     newDmode = 0;
 
+    /* Only bus read results are reported back when running a script. */
+    if (bus_pirate_configuration.batch_mode) {
+      bus_pirate_configuration.quiet = YES;
+    }
+
     while (!stop) {
       uint8_t c = cmdbuf[cmdstart];
 
@@ -454,6 +538,28 @@ void serviceuser(void) {
         print_help();
         break;
 
+      case '*':
+        if (bus_pirate_configuration.batch_mode) {
+          mode_configuration.command_error = YES;
+        } else {
+          receive_batch_script();
+        }
+        break;
+
+#ifdef BP_ENABLE_COMMAND_REPEAT
+      case '+':
+        temp = NO;
+        if (cmdbuf[(cmdstart + 1) & CMDLENMSK] == 'q') {
+          cmdstart = (cmdstart + 1) & CMDLENMSK;
+          temp = YES;
+        }
+        repeat = getrepeat();
+        if (!terminal_ops_run(repeat, temp)) {
+          MSG_REPEAT_NO_COMMAND_LINE;
+        }
+        break;
+#endif /* BP_ENABLE_COMMAND_REPEAT */
+
       case 'i':
         print_version_info();
         if (bus_pirate_configuration.bus_mode != BP_HIZ) {
@@ -669,6 +775,9 @@ void serviceuser(void) {
         break;
 
       case '<':
+#ifdef BP_ENABLE_FLASH_MACROS
+        user_macros_handle_command();
+#else
         mode_configuration.command_error = YES;
         temp = 1;
 
@@ -717,6 +826,7 @@ void serviceuser(void) {
             }
           }
         }
+#endif /* BP_ENABLE_FLASH_MACROS */
         break;
 
       // command for subsys (i2c, UART, etc)
@@ -818,6 +928,10 @@ void serviceuser(void) {
               received =
                   bp_reverse_integer(received, mode_configuration.numbits);
             }
+            if (bus_pirate_configuration.batch_mode) {
+              write_batch_result(received, NO);
+              continue;
+            }
             bp_write_formatted_integer(received);
             bpSP;
           }
@@ -844,6 +958,10 @@ void serviceuser(void) {
           if (mode_configuration.little_endian == YES) {
             received = bp_reverse_integer(received, mode_configuration.numbits);
           }
+          if (bus_pirate_configuration.batch_mode) {
+            write_batch_result(received, NO);
+            continue;
+          }
           bp_write_formatted_integer(received);
           if (((mode_configuration.int16 == NO) &&
                (mode_configuration.numbits != 8)) ||
@@ -883,8 +1001,13 @@ void serviceuser(void) {
 
       case '.':
         BPMSG1098;
-        echo_state(
-            enabled_protocols[bus_pirate_configuration.bus_mode].data_state());
+        received =
+            enabled_protocols[bus_pirate_configuration.bus_mode].data_state();
+        if (bus_pirate_configuration.batch_mode) {
+          write_batch_result(received, YES);
+        } else {
+          echo_state(received);
+        }
         break;
 
       case '^':
@@ -902,8 +1025,13 @@ void serviceuser(void) {
         repeat = getrepeat() + 1;
         BPMSG1109;
         while (--repeat) {
-          echo_state(
-              enabled_protocols[bus_pirate_configuration.bus_mode].read_bit());
+          received =
+              enabled_protocols[bus_pirate_configuration.bus_mode].read_bit();
+          if (bus_pirate_configuration.batch_mode) {
+            write_batch_result(received, YES);
+            continue;
+          }
+          echo_state(received);
           bpSP;
         }
         BPMSG1107;
@@ -923,6 +1051,22 @@ void serviceuser(void) {
 
       cmdstart = (cmdstart + 1) & CMDLENMSK;
 
+#ifdef BP_ENABLE_COMMAND_REPEAT
+      if (mode_configuration.command_error == YES) {
+        repeatable = NO;
+      }
+#endif /* BP_ENABLE_COMMAND_REPEAT */
+
+      if ((mode_configuration.command_error == YES) && bus_pirate_configuration.batch_mode) {
+        /* Report the error position in compact form and skip the line. */
+        bus_pirate_configuration.quiet = NO;
+        user_serial_transmit_character('!');
+        bp_write_dec_byte((cmdstart - oldstart) & CMDLENMSK);
+        bus_pirate_configuration.quiet = YES;
+        mode_configuration.command_error = NO;
+        stop = YES;
+      }
+
       if (mode_configuration.command_error == YES) {
         BPMSG1110;
         if (cmdstart > oldstart) {
@@ -940,6 +1084,19 @@ void serviceuser(void) {
       }
     }
 
+#ifdef BP_ENABLE_COMMAND_REPEAT
+    /* Keep bus-only lines around for the repeat command. */
+    if (repeatable) {
+      terminal_ops_compile(oldstart);
+    }
+#endif /* BP_ENABLE_COMMAND_REPEAT */
+
+    /* Terminate the result line for the script line just run. */
+    if (bus_pirate_configuration.batch_mode) {
+      bus_pirate_configuration.quiet = NO;
+      bpBR;
+    }
+
     cmdstart = newstart;
     cmdend = newstart;
     menu_state.command_present = NO;
@@ -2203,3 +2360,72 @@ void switch_psu_off(void) {
   MSG_POWER_SUPPLIES_OFF;
   bpBR;
 }
+
+void receive_batch_script(void) {
+  uint16_t length = 0;
+  bool overflow = NO;
+  uint8_t character;
+
+  MSG_BATCH_MODE_READY;
+
+  for (;;) {
+    character = user_serial_read_byte();
+    if (character == ASCII_EOT) {
+      break;
+    }
+
+    if (length < BP_TERMINAL_BUFFER_SIZE) {
+      bus_pirate_configuration.terminal_input[length++] = character;
+    } else {
+      overflow = YES;
+    }
+  }
+
+  if (overflow) {
+    MSG_BATCH_MODE_SCRIPT_TOO_LONG;
+    return;
+  }
+
+  bus_pirate_configuration.batch_mode = YES;
+  menu_state.batch_offset = 0;
+  menu_state.batch_length = length;
+}
+
+bool load_batch_script_line(void) {
+  uint8_t character;
+
+  while (menu_state.batch_offset < menu_state.batch_length) {
+    character =
+        bus_pirate_configuration.terminal_input[menu_state.batch_offset++];
+
+    if ((character == ASCII_CR) || (character == ASCII_LF)) {
+      if (cmdend != cmdstart) {
+        return true;
+      }
+
+      /* Skip empty lines. */
+      continue;
+    }
+
+    /* Silently truncate lines that do not fit in the command buffer. */
+    if ((((cmdend + 1) & CMDLENMSK) != cmdstart) && (character >= 0x20) &&
+        (character < 0x7F)) {
+      cmdbuf[cmdend] = character;
+      cmdend = (cmdend + 1) & CMDLENMSK;
+    }
+  }
+
+  /* The last line may not be terminated. */
+  return cmdend != cmdstart;
+}
+
+void write_batch_result(const uint16_t value, const bool single_bit) {
+  bus_pirate_configuration.quiet = NO;
+  if (single_bit) {
+    echo_state(value);
+  } else {
+    bp_write_formatted_integer(value);
+  }
+  bpSP;
+  bus_pirate_configuration.quiet = YES;
+}
@@ -0,0 +1,178 @@
+/*
+ * This file is part of the Bus Pirate project
+ * (https://github.com/BusPirate/Bus_Pirate/).
+ *
+ * Written and maintained by the Bus Pirate project.
+ *
+ * To the extent possible under law, the project has waived all copyright and
+ * related or neighboring rights to Bus Pirate.  This work is published from
+ * United States.
+ *
+ * For details see: http://creativecommons.org/publicdomain/zero/1.0/
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.
+ */
+
+/**
+ * @file scheduler.c
+ *
+ * @brief Cooperative background task scheduler implementation file.
+ */
+
+#include "scheduler.h"
+
+#ifdef BP_ENABLE_SCHEDULER
+
+#include "base.h"
+
+/**
+ * @brief How many delay timer ticks make up a microsecond.
+ */
+#define SCHEDULER_TICKS_PER_MICROSECOND 2
+
+/**
+ * @brief How long the processor may rest before an interrupt wakes it up, in
+ * delay timer ticks.
+ *
+ * USB start-of-frame interrupts fire every millisecond.
+ */
+#define SCHEDULER_REST_TICKS (1000 * SCHEDULER_TICKS_PER_MICROSECOND)
+
+/**
+ * @brief A background task slot.
+ */
+typedef struct {
+  /** The function to call when the task is due, NULL if not running. */
+  bp_scheduler_callback_t callback;
+
+  /** The task period, in delay timer ticks. */
+  uint32_t period;
+
+  /** When the task is due next, in delay timer ticks. */
+  uint32_t deadline;
+} scheduler_task_t;
+
+/**
+ * @brief The background task slots.
+ */
+static scheduler_task_t tasks[BP_SCHEDULER_TASKS_COUNT];
+
+/**
+ * @brief Upper 16 bits of the scheduler clock, extending the delay timer.
+ */
+static uint16_t clock_high_word = 0;
+
+/**
+ * @brief Returns the current scheduler clock value.
+ *
+ * The clock extends the free-running delay timer to 32 bits by counting
+ * timer rollovers.  Rollovers are noticed only when the clock is read, so
+ * time spent away from the scheduler for longer than a timer period (about
+ * 32 milliseconds) is partially lost, which only makes due tasks run later.
+ *
+ * @return the current clock value, in delay timer ticks.
+ */
+static uint32_t scheduler_clock(void);
+
+/**
+ * @brief Checks whether the given deadline has passed.
+ *
+ * @param[in] deadline the deadline to check.
+ * @param[in] now the current clock value.
+ *
+ * @return true if the deadline has passed, false otherwise.
+ */
+static inline bool deadline_passed(const uint32_t deadline,
+                                   const uint32_t now);
+
+uint32_t scheduler_clock(void) {
+  uint16_t low_word;
+
+  if (IFS0bits.T1IF == ON) {
+    IFS0bits.T1IF = OFF;
+    clock_high_word++;
+  }
+
+  low_word = TMR1;
+
+  /* The timer may have rolled over right before being read. */
+  if (IFS0bits.T1IF == ON) {
+    IFS0bits.T1IF = OFF;
+    clock_high_word++;
+    low_word = TMR1;
+  }
+
+  return ((uint32_t)clock_high_word << 16) | low_word;
+}
+
+bool deadline_passed(const uint32_t deadline, const uint32_t now) {
+  return (int32_t)(now - deadline) >= 0;
+}
+
+void bp_scheduler_initialise(void) {
+  bp_scheduler_task_t task;
+
+  for (task = 0; task < BP_SCHEDULER_TASKS_COUNT; task++) {
+    tasks[task].callback = NULL;
+  }
+
+  clock_high_word = 0;
+  IFS0bits.T1IF = OFF;
+}
+
+void bp_scheduler_start_task(const bp_scheduler_task_t task,
+                             const bp_scheduler_callback_t callback,
+                             const uint32_t period_us) {
+  tasks[task].period = period_us * SCHEDULER_TICKS_PER_MICROSECOND;
+  tasks[task].deadline = scheduler_clock();
+  tasks[task].callback = callback;
+}
+
+void bp_scheduler_stop_task(const bp_scheduler_task_t task) {
+  tasks[task].callback = NULL;
+}
+
+bool bp_scheduler_service(void) {
+  scheduler_task_t *task;
+  uint32_t now = scheduler_clock();
+  bool output = false;
+
+  for (task = tasks; task < &tasks[BP_SCHEDULER_TASKS_COUNT]; task++) {
+    if ((task->callback == NULL) || !deadline_passed(task->deadline, now)) {
+      continue;
+    }
+
+    if (task->callback()) {
+      output = true;
+    }
+
+    /* Skip missed periods rather than running the task in a burst. */
+    task->deadline += task->period;
+    now = scheduler_clock();
+    if (deadline_passed(task->deadline, now)) {
+      task->deadline = now + task->period;
+    }
+  }
+
+  return output;
+}
+
+void bp_scheduler_wait(void) {
+#ifdef BUSPIRATEV4
+  const scheduler_task_t *task;
+  const uint32_t wake_up = scheduler_clock() + SCHEDULER_REST_TICKS;
+
+  for (task = tasks; task < &tasks[BP_SCHEDULER_TASKS_COUNT]; task++) {
+    if ((task->callback != NULL) && deadline_passed(task->deadline, wake_up)) {
+      return;
+    }
+  }
+
+  /* Any interrupt, including incoming USB data, ends the rest. */
+  Idle();
+#endif /* BUSPIRATEV4 */
+}
+
+#endif /* BP_ENABLE_SCHEDULER */
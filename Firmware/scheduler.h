@@ -0,0 +1,105 @@
+/*
+ * This file is part of the Bus Pirate project
+ * (https://github.com/BusPirate/Bus_Pirate/).
+ *
+ * Written and maintained by the Bus Pirate project.
+ *
+ * To the extent possible under law, the project has waived all copyright and
+ * related or neighboring rights to Bus Pirate.  This work is published from
+ * United States.
+ *
+ * For details see: http://creativecommons.org/publicdomain/zero/1.0/
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.
+ */
+
+/**
+ * @file scheduler.h
+ *
+ * @brief Cooperative background task scheduler definition file.
+ *
+ * Background tasks are kept in a fixed table, each with its own period and
+ * next deadline measured on the delay timer.  Due tasks are run whenever
+ * bp_scheduler_service is called, which happens while waiting for user input
+ * and between iterations of long running terminal commands.
+ */
+
+#ifndef BP_SCHEDULER_H
+#define BP_SCHEDULER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "configuration.h"
+
+#ifdef BP_ENABLE_SCHEDULER
+
+/**
+ * @brief Background task slots.
+ */
+typedef enum {
+  /** Current protocol's periodic update callback. */
+  BP_SCHEDULER_TASK_PROTOCOL = 0,
+  /** Continuous voltage probe display. */
+  BP_SCHEDULER_TASK_ADC_PROBE,
+  /** Number of task slots, not a valid slot. */
+  BP_SCHEDULER_TASKS_COUNT
+} bp_scheduler_task_t;
+
+/**
+ * @brief Background task callback.
+ *
+ * @return true if the task wrote anything to the serial port, false
+ * otherwise.
+ */
+typedef bool (*bp_scheduler_callback_t)(void);
+
+/**
+ * @brief Stops all background tasks and resets the scheduler clock.
+ *
+ * The delay timer must already be running when this is called.
+ */
+void bp_scheduler_initialise(void);
+
+/**
+ * @brief Starts a background task, or restarts it with new parameters if it
+ * is already running.
+ *
+ * @param[in] task the task slot to use.
+ * @param[in] callback the function to call when the task is due.
+ * @param[in] period_us the task period in microseconds, 0 to run the task at
+ * every scheduler pass.
+ */
+void bp_scheduler_start_task(const bp_scheduler_task_t task,
+                             const bp_scheduler_callback_t callback,
+                             const uint32_t period_us);
+
+/**
+ * @brief Stops a background task.
+ *
+ * @param[in] task the task slot to stop.
+ */
+void bp_scheduler_stop_task(const bp_scheduler_task_t task);
+
+/**
+ * @brief Runs all background tasks whose deadline has passed.
+ *
+ * @return true if any task wrote to the serial port, false otherwise.
+ */
+bool bp_scheduler_service(void);
+
+/**
+ * @brief Puts the processor to rest until the next interrupt, if no task is
+ * due before the next interrupt is expected.
+ *
+ * Only Bus Pirate v4 rests, as its USB interrupts fire at least once every
+ * millisecond.  Bus Pirate v3 polls its serial port, so this returns right
+ * away.
+ */
+void bp_scheduler_wait(void);
+
+#endif /* BP_ENABLE_SCHEDULER */
+
+#endif /* !BP_SCHEDULER_H */
@@ -391,12 +391,22 @@ void spi_run_macro(const uint16_t macro) {
     break;
 
   case SPI_MACRO_SNIFF_ON_CS_LOW:
+    if (bus_pirate_configuration.batch_mode) {
+      /* The sniffer ring buffer would overwrite the batch script. */
+      mode_configuration.command_error = YES;
+      break;
+    }
     MSG_SNIFFER_MESSAGE;
     MSG_ANY_KEY_TO_EXIT_PROMPT;
     spi_sniffer(SPI_SNIFF_ON_CS_LOW, true);
     break;
 
   case SPI_MACRO_SNIFF_ALL_TRAFFIC:
+    if (bus_pirate_configuration.batch_mode) {
+      /* The sniffer ring buffer would overwrite the batch script. */
+      mode_configuration.command_error = YES;
+      break;
+    }
     MSG_SNIFFER_MESSAGE;
     MSG_ANY_KEY_TO_EXIT_PROMPT;
     spi_sniffer(SPI_SNIFF_ALWAYS, true);
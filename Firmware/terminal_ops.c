@@ -0,0 +1,638 @@
+/*
+ * This file is part of the Bus Pirate project
+ * (https://github.com/BusPirate/Bus_Pirate/).
+ *
+ * Written and maintained by the Bus Pirate project.
+ *
+ * To the extent possible under law, the project has waived all copyright and
+ * related or neighboring rights to Bus Pirate.  This work is published from
+ * United States.
+ *
+ * For details see: http://creativecommons.org/publicdomain/zero/1.0/
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.
+ */
+
+/**
+ * @file terminal_ops.c
+ *
+ * @brief Precompiled terminal command lines implementation file.
+ */
+
+#include "terminal_ops.h"
+
+#ifdef BP_ENABLE_COMMAND_REPEAT
+
+#include <string.h>
+
+#include "aux_pin.h"
+#include "base.h"
+#include "core.h"
+#include "proc_menu.h"
+#include "scheduler.h"
+
+extern bus_pirate_configuration_t bus_pirate_configuration;
+extern mode_configuration_t mode_configuration;
+extern bus_pirate_protocol_t enabled_protocols[ENABLED_PROTOCOLS_COUNT];
+
+/**
+ * @brief Characters that can follow a read command to override the display
+ * base; lines using them are not compiled.
+ */
+static const char READ_DISPLAY_OVERRIDES[] = {'x', 'd', 'b', 'w'};
+
+/**
+ * @brief Terminal syntax characters for each operation code, used when
+ * printing operation lists back.
+ */
+static const char OP_SYMBOLS[] = {'[', '{', ']', '}', '0', 'r', '/', '\\', '-',
+                                  '_', '.', '^', '!', '&', '%', 'a', 'A'};
+
+/**
+ * @brief The cached operation list.
+ */
+static terminal_op_t compiled_ops[BP_COMMAND_REPEAT_MAX_OPERATIONS];
+
+/**
+ * @brief How many operations are in the cached operation list.
+ */
+static uint8_t compiled_ops_count = 0;
+
+/**
+ * @brief Handler executing a compiled operation as many times as its repeat
+ * count says.
+ *
+ * @param[in] op the operation to execute.
+ *
+ * @return true if anything was written to the serial port, false otherwise.
+ */
+typedef bool (*op_handler_t)(const terminal_op_t *op);
+
+/**
+ * @brief Bus or pin action taking no parameters and returning no data.
+ */
+typedef void (*op_action_t)(void);
+
+/**
+ * @brief The bus mode the handlers are currently bound to.
+ */
+static uint8_t bound_mode = 0xFF;
+
+/**
+ * @brief Handlers for each operation code, bound to the current bus mode.
+ *
+ * Operations the bus mode does not support are bound to run_unsupported, so
+ * the protocol's placeholder callbacks are never called.
+ */
+static op_handler_t bound_handlers[TERMINAL_OP_COUNT];
+
+/**
+ * @brief Actions for each operation code handled by run_action.
+ */
+static op_action_t bound_actions[TERMINAL_OP_COUNT];
+
+/**
+ * @brief The bound bus mode's write callback.
+ */
+static uint16_t (*bound_send)(uint16_t value);
+
+/**
+ * @brief The bound bus mode's read callback.
+ */
+static uint16_t (*bound_read)(void);
+
+/**
+ * @brief The bound bus mode's data line state callback.
+ */
+static uint16_t (*bound_data_state)(void);
+
+/**
+ * @brief The bound bus mode's bit read callback.
+ */
+static bool (*bound_read_bit)(void);
+
+/**
+ * @brief Whether a quiet repeat (+q) is running, whose results are dropped
+ * even in batch mode.
+ */
+static bool results_suppressed = NO;
+
+/**
+ * @brief Checks whether the read command at the current command buffer
+ * position overrides the display base.
+ *
+ * @return true if the display base is overridden, false otherwise.
+ */
+static bool read_overrides_display(void);
+
+/**
+ * @brief Lets a result through to the serial port while a batch script runs
+ * with the rest of its output suppressed.
+ *
+ * @return the quiet flag to restore with end_result.
+ */
+static bool begin_result(void);
+
+/**
+ * @brief Restores the quiet flag saved by begin_result.
+ *
+ * @param[in] was_quiet the value begin_result returned.
+ */
+static void end_result(const bool was_quiet);
+
+/**
+ * @brief Writes a value read from the bus to the serial port, followed by a
+ * space.
+ *
+ * @param[in] value the value to write.
+ */
+static void write_value(uint16_t value);
+
+/**
+ * @brief Writes a bit read from the bus to the serial port, followed by a
+ * space.
+ *
+ * @param[in] bit the bit to write.
+ */
+static void write_bit(const bool bit);
+
+/**
+ * @brief Binds an action handler for the given operation code.
+ *
+ * @param[in] code the operation code to bind.
+ * @param[in] action the action to run for the operation.
+ * @param[in] unsupported the placeholder action used by modes not supporting
+ * the operation.
+ */
+static void bind_action(const terminal_op_code_t code, const op_action_t action,
+                        const op_action_t unsupported);
+
+/**
+ * @brief Binds the operation handlers to the current bus mode's callbacks.
+ */
+static void bind_handlers(void);
+
+/**
+ * @brief Runs a parameterless bus or pin action.
+ */
+static bool run_action(const terminal_op_t *op);
+
+/**
+ * @brief Writes a value to the bus.
+ */
+static bool run_send(const terminal_op_t *op);
+
+/**
+ * @brief Reads a value from the bus.
+ */
+static bool run_read(const terminal_op_t *op);
+
+/**
+ * @brief Reads the state of the data line.
+ */
+static bool run_data_state(const terminal_op_t *op);
+
+/**
+ * @brief Reads a single bit from the bus.
+ */
+static bool run_read_bit(const terminal_op_t *op);
+
+/**
+ * @brief Waits for the given amount of microseconds.
+ */
+static bool run_delay_us(const terminal_op_t *op);
+
+/**
+ * @brief Waits for the given amount of milliseconds.
+ */
+static bool run_delay_ms(const terminal_op_t *op);
+
+/**
+ * @brief Reports an operation the current bus mode does not support.
+ */
+static bool run_unsupported(const terminal_op_t *op);
+
+bool read_overrides_display(void) {
+  const char next = cmdbuf[(cmdstart + 1) & CMDLENMSK];
+  size_t index;
+
+  for (index = 0; index < sizeof(READ_DISPLAY_OVERRIDES); index++) {
+    if (next == READ_DISPLAY_OVERRIDES[index]) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+uint16_t terminal_ops_parse(const uint16_t start, terminal_op_t *ops,
+                            const uint16_t capacity) {
+  const unsigned int saved_start = cmdstart;
+  const bool saved_error = mode_configuration.command_error;
+  terminal_op_t *op;
+  uint16_t count = 0;
+  bool valid = true;
+  char character;
+
+  mode_configuration.command_error = NO;
+  cmdstart = start;
+
+  while (valid && ((character = cmdbuf[cmdstart]) != 0x00)) {
+    if ((character == ' ') || (character == ',')) {
+      cmdstart = (cmdstart + 1) & CMDLENMSK;
+      continue;
+    }
+
+    if (count == capacity) {
+      valid = false;
+      break;
+    }
+
+    op = &ops[count];
+    op->numbits = 0;
+    op->repeat = 1;
+    op->value = 0;
+
+    switch (character) {
+    case '[':
+      op->code = TERMINAL_OP_START;
+      break;
+
+    case '{':
+      op->code = TERMINAL_OP_START_WITH_READ;
+      break;
+
+    case ']':
+      op->code = TERMINAL_OP_STOP;
+      break;
+
+    case '}':
+      op->code = TERMINAL_OP_STOP_FROM_READ;
+      break;
+
+    case '0':
+    case '1':
+    case '2':
+    case '3':
+    case '4':
+    case '5':
+    case '6':
+    case '7':
+    case '8':
+    case '9':
+      op->code = TERMINAL_OP_SEND;
+      op->value = getint();
+      cmdstart = (cmdstart - 1) & CMDLENMSK;
+      op->repeat = getrepeat();
+      op->numbits = getnumbits();
+      break;
+
+    case 'r':
+      if (read_overrides_display()) {
+        valid = false;
+        break;
+      }
+      op->code = TERMINAL_OP_READ;
+      op->repeat = getrepeat();
+      op->numbits = getnumbits();
+      break;
+
+    case '/':
+      op->code = TERMINAL_OP_CLOCK_HIGH;
+      break;
+
+    case '\\':
+      op->code = TERMINAL_OP_CLOCK_LOW;
+      break;
+
+    case '-':
+      op->code = TERMINAL_OP_DATA_HIGH;
+      break;
+
+    case '_':
+      op->code = TERMINAL_OP_DATA_LOW;
+      break;
+
+    case '.':
+      op->code = TERMINAL_OP_DATA_STATE;
+      break;
+
+    case '^':
+      op->code = TERMINAL_OP_CLOCK_PULSE;
+      op->repeat = getrepeat();
+      break;
+
+    case '!':
+      op->code = TERMINAL_OP_READ_BIT;
+      op->repeat = getrepeat();
+      break;
+
+    case '&':
+      op->code = TERMINAL_OP_DELAY_US;
+      op->value = getrepeat();
+      break;
+
+    case '%':
+      op->code = TERMINAL_OP_DELAY_MS;
+      op->value = getrepeat();
+      break;
+
+    case 'a':
+      op->code = TERMINAL_OP_AUX_LOW;
+      break;
+
+    case 'A':
+      op->code = TERMINAL_OP_AUX_HIGH;
+      break;
+
+    default:
+      valid = false;
+      break;
+    }
+
+    if (mode_configuration.command_error == YES) {
+      valid = false;
+    }
+
+    count++;
+    cmdstart = (cmdstart + 1) & CMDLENMSK;
+  }
+
+  cmdstart = saved_start;
+  mode_configuration.command_error = saved_error;
+
+  return valid ? count : 0;
+}
+
+bool terminal_ops_compile(const uint16_t start) {
+  terminal_op_t ops[BP_COMMAND_REPEAT_MAX_OPERATIONS];
+  uint16_t count;
+
+  count = terminal_ops_parse(start, ops, BP_COMMAND_REPEAT_MAX_OPERATIONS);
+  if (count == 0) {
+    return false;
+  }
+
+  memcpy(compiled_ops, ops, count * sizeof(terminal_op_t));
+  compiled_ops_count = count;
+
+  return true;
+}
+
+bool begin_result(void) {
+  const bool was_quiet = bus_pirate_configuration.quiet;
+
+  if (bus_pirate_configuration.batch_mode && !results_suppressed) {
+    bus_pirate_configuration.quiet = NO;
+  }
+
+  return was_quiet;
+}
+
+void end_result(const bool was_quiet) {
+  bus_pirate_configuration.quiet = was_quiet;
+}
+
+void write_value(uint16_t value) {
+  const bool was_quiet = begin_result();
+
+  if (mode_configuration.little_endian == YES) {
+    value = bp_reverse_integer(value, mode_configuration.numbits);
+  }
+  bp_write_formatted_integer(value);
+  bpSP;
+  end_result(was_quiet);
+}
+
+void write_bit(const bool bit) {
+  const bool was_quiet = begin_result();
+
+  user_serial_transmit_character(bit ? '1' : '0');
+  bpSP;
+  end_result(was_quiet);
+}
+
+void bind_action(const terminal_op_code_t code, const op_action_t action,
+                 const op_action_t unsupported) {
+  bound_actions[code] = action;
+  bound_handlers[code] = (action != unsupported) ? run_action : run_unsupported;
+}
+
+void bind_handlers(void) {
+  const bus_pirate_protocol_t *protocol;
+  const bus_pirate_protocol_t *none = &enabled_protocols[BP_HIZ];
+
+  bound_mode = bus_pirate_configuration.bus_mode;
+  protocol = &enabled_protocols[bound_mode];
+
+  bind_action(TERMINAL_OP_START, protocol->start, none->start);
+  bind_action(TERMINAL_OP_START_WITH_READ, protocol->start_with_read,
+              none->start_with_read);
+  bind_action(TERMINAL_OP_STOP, protocol->stop, none->stop);
+  bind_action(TERMINAL_OP_STOP_FROM_READ, protocol->stop_from_read,
+              none->stop_from_read);
+  bind_action(TERMINAL_OP_CLOCK_HIGH, protocol->clock_high, none->clock_high);
+  bind_action(TERMINAL_OP_CLOCK_LOW, protocol->clock_low, none->clock_low);
+  bind_action(TERMINAL_OP_DATA_HIGH, protocol->data_high, none->data_high);
+  bind_action(TERMINAL_OP_DATA_LOW, protocol->data_low, none->data_low);
+  bind_action(TERMINAL_OP_CLOCK_PULSE, protocol->clock_pulse,
+              none->clock_pulse);
+  bind_action(TERMINAL_OP_AUX_LOW, bp_aux_pin_set_low, NULL);
+  bind_action(TERMINAL_OP_AUX_HIGH, bp_aux_pin_set_high, NULL);
+
+  bound_send = protocol->send;
+  bound_handlers[TERMINAL_OP_SEND] =
+      (protocol->send != none->send) ? run_send : run_unsupported;
+
+  bound_read = protocol->read;
+  bound_handlers[TERMINAL_OP_READ] =
+      (protocol->read != none->read) ? run_read : run_unsupported;
+
+  bound_data_state = protocol->data_state;
+  bound_handlers[TERMINAL_OP_DATA_STATE] =
+      (protocol->data_state != none->data_state) ? run_data_state
+                                                 : run_unsupported;
+
+  bound_read_bit = protocol->read_bit;
+  bound_handlers[TERMINAL_OP_READ_BIT] =
+      (protocol->read_bit != none->read_bit) ? run_read_bit : run_unsupported;
+
+  bound_handlers[TERMINAL_OP_DELAY_US] = run_delay_us;
+  bound_handlers[TERMINAL_OP_DELAY_MS] = run_delay_ms;
+}
+
+bool run_action(const terminal_op_t *op) {
+  const op_action_t action = bound_actions[op->code];
+  uint16_t repeat;
+
+  for (repeat = 0; repeat < op->repeat; repeat++) {
+    action();
+  }
+
+  return NO;
+}
+
+bool run_send(const terminal_op_t *op) {
+  const bool reverse = (mode_configuration.little_endian == YES);
+  const bool echo = mode_configuration.write_with_read;
+  const uint16_t value =
+      reverse ? bp_reverse_integer(op->value, mode_configuration.numbits)
+              : op->value;
+  uint16_t repeat;
+  uint16_t received;
+
+  for (repeat = 0; repeat < op->repeat; repeat++) {
+    received = bound_send(value);
+    if (echo) {
+      write_value(received);
+    }
+  }
+
+  return echo;
+}
+
+bool run_read(const terminal_op_t *op) {
+  uint16_t repeat;
+
+  for (repeat = 0; repeat < op->repeat; repeat++) {
+    write_value(bound_read());
+  }
+
+  return YES;
+}
+
+bool run_data_state(const terminal_op_t *op) {
+  uint16_t repeat;
+
+  for (repeat = 0; repeat < op->repeat; repeat++) {
+    write_bit(bound_data_state());
+  }
+
+  return YES;
+}
+
+bool run_read_bit(const terminal_op_t *op) {
+  uint16_t repeat;
+
+  for (repeat = 0; repeat < op->repeat; repeat++) {
+    write_bit(bound_read_bit());
+  }
+
+  return YES;
+}
+
+bool run_delay_us(const terminal_op_t *op) {
+  bp_delay_us(op->value);
+  return NO;
+}
+
+bool run_delay_ms(const terminal_op_t *op) {
+  bp_delay_ms(op->value);
+  return NO;
+}
+
+bool run_unsupported(const terminal_op_t *op) {
+  MSG_COMMAND_HAS_NO_EFFECT;
+  mode_configuration.command_error = YES;
+  return NO;
+}
+
+bool terminal_ops_execute(const terminal_op_t *op) {
+  if (bound_mode != bus_pirate_configuration.bus_mode) {
+    bind_handlers();
+  }
+
+  if (op->numbits) {
+    mode_configuration.numbits = op->numbits;
+    mode_configuration.int16 = (op->numbits > 8) ? YES : NO;
+  }
+
+  return bound_handlers[op->code](op);
+}
+
+void terminal_ops_print(const terminal_op_t *op) {
+  switch (op->code) {
+  case TERMINAL_OP_SEND:
+    bp_write_formatted_integer(op->value);
+    break;
+
+  case TERMINAL_OP_DELAY_US:
+  case TERMINAL_OP_DELAY_MS:
+    user_serial_transmit_character(OP_SYMBOLS[op->code]);
+    user_serial_transmit_character(':');
+    bp_write_dec_word(op->value);
+    return;
+
+  default:
+    user_serial_transmit_character(OP_SYMBOLS[op->code]);
+    break;
+  }
+
+  if (op->repeat > 1) {
+    user_serial_transmit_character(':');
+    bp_write_dec_word(op->repeat);
+  }
+
+  if (op->numbits) {
+    user_serial_transmit_character(';');
+    bp_write_dec_byte(op->numbits);
+  }
+}
+
+bool terminal_ops_run(const uint16_t iterations, const bool quiet) {
+  const bool was_quiet = bus_pirate_configuration.quiet;
+  uint16_t iteration;
+  uint8_t index;
+  bool output;
+
+  if (compiled_ops_count == 0) {
+    return false;
+  }
+
+  /* Batch scripts run quiet but still get their results, unless +q. */
+  bus_pirate_configuration.quiet = quiet || was_quiet;
+  results_suppressed = quiet;
+
+  for (iteration = 0; iteration < iterations; iteration++) {
+    output = NO;
+
+    for (index = 0; index < compiled_ops_count; index++) {
+      if (terminal_ops_execute(&compiled_ops[index])) {
+        output = YES;
+      }
+
+      /* Operations not available in the current mode flag an error. */
+      if (mode_configuration.command_error == YES) {
+        bus_pirate_configuration.quiet = was_quiet;
+        results_suppressed = NO;
+        return true;
+      }
+    }
+
+    if (output) {
+      bpBR;
+    }
+
+#ifdef BP_ENABLE_SCHEDULER
+    /* Keep background tasks going, unless their output would be lost. */
+    if (!bus_pirate_configuration.quiet) {
+      bp_scheduler_service();
+    }
+#endif /* BP_ENABLE_SCHEDULER */
+
+    /* Stop on user request. */
+    if (user_serial_ready_to_read()) {
+      user_serial_read_byte();
+      break;
+    }
+  }
+
+  bus_pirate_configuration.quiet = was_quiet;
+  results_suppressed = NO;
+
+  return true;
+}
+
+#endif /* BP_ENABLE_COMMAND_REPEAT */
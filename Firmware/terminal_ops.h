@@ -0,0 +1,168 @@
+/*
+ * This file is part of the Bus Pirate project
+ * (https://github.com/BusPirate/Bus_Pirate/).
+ *
+ * Written and maintained by the Bus Pirate project.
+ *
+ * To the extent possible under law, the project has waived all copyright and
+ * related or neighboring rights to Bus Pirate.  This work is published from
+ * United States.
+ *
+ * For details see: http://creativecommons.org/publicdomain/zero/1.0/
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.
+ */
+
+/**
+ * @file terminal_ops.h
+ *
+ * @brief Precompiled terminal command lines definition file.
+ *
+ * Command lines made only of bus operations (start/stop conditions, writes,
+ * reads, clock and data line control, delays, and AUX pin control) can be
+ * compiled into a compact operation list that can be executed again without
+ * going through the text parser.
+ */
+
+#ifndef BP_TERMINAL_OPS_H
+#define BP_TERMINAL_OPS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "configuration.h"
+
+#ifdef BP_ENABLE_COMMAND_REPEAT
+
+/**
+ * @brief Bus operations a compiled command line can be made of.
+ */
+typedef enum {
+  /** Start condition, `[`. */
+  TERMINAL_OP_START = 0,
+  /** Start condition followed by a read, `{`. */
+  TERMINAL_OP_START_WITH_READ,
+  /** Stop condition, `]`. */
+  TERMINAL_OP_STOP,
+  /** Stop condition after a read, `}`. */
+  TERMINAL_OP_STOP_FROM_READ,
+  /** Value write, a number. */
+  TERMINAL_OP_SEND,
+  /** Value read, `r`. */
+  TERMINAL_OP_READ,
+  /** Clock line high, `/`. */
+  TERMINAL_OP_CLOCK_HIGH,
+  /** Clock line low, `\`. */
+  TERMINAL_OP_CLOCK_LOW,
+  /** Data line high, `-`. */
+  TERMINAL_OP_DATA_HIGH,
+  /** Data line low, `_`. */
+  TERMINAL_OP_DATA_LOW,
+  /** Data line state read, `.`. */
+  TERMINAL_OP_DATA_STATE,
+  /** Clock pulse, `^`. */
+  TERMINAL_OP_CLOCK_PULSE,
+  /** Single bit read, `!`. */
+  TERMINAL_OP_READ_BIT,
+  /** Microseconds delay, `&`. */
+  TERMINAL_OP_DELAY_US,
+  /** Milliseconds delay, `%`. */
+  TERMINAL_OP_DELAY_MS,
+  /** AUX pin low, `a`. */
+  TERMINAL_OP_AUX_LOW,
+  /** AUX pin high, `A`. */
+  TERMINAL_OP_AUX_HIGH,
+  /** Number of operation codes, not a valid operation. */
+  TERMINAL_OP_COUNT
+} __attribute__((packed)) terminal_op_code_t;
+
+/**
+ * @brief A single compiled bus operation.
+ */
+typedef struct {
+  /** The operation to perform. */
+  terminal_op_code_t code;
+
+  /** Data width to switch to before the operation, or 0 to leave it as is. */
+  uint8_t numbits;
+
+  /** How many times the operation should be performed. */
+  uint16_t repeat;
+
+  /** The value to write, or the delay length. */
+  uint16_t value;
+} __attribute__((packed)) terminal_op_t;
+
+/**
+ * @brief Parses the command line starting at the given command buffer offset
+ * into the given operation list.
+ *
+ * Parsing stops at the first NUL character.  The command buffer position and
+ * the command error flag are left as they were before the call.
+ *
+ * @param[in] start the command buffer offset the line starts at.
+ * @param[out] ops the operation list to fill.
+ * @param[in] capacity how many operations the list can hold.
+ *
+ * @return how many operations were parsed, or 0 if the line is empty, holds
+ * anything but bus operations, or does not fit in the list.
+ */
+uint16_t terminal_ops_parse(const uint16_t start, terminal_op_t *ops,
+                            const uint16_t capacity);
+
+/**
+ * @brief Executes a single operation, as many times as its repeat count says.
+ *
+ * Operations are dispatched through a handler table bound to the current bus
+ * mode's callbacks, which is rebuilt whenever the bus mode changes.  Values
+ * read from the bus are written to the serial port followed by a space.
+ * Operations not available in the current mode set the command error flag.
+ *
+ * @param[in] op the operation to execute.
+ *
+ * @return true if anything was written to the serial port, false otherwise.
+ */
+bool terminal_ops_execute(const terminal_op_t *op);
+
+/**
+ * @brief Writes the terminal syntax for the given operation to the serial
+ * port.
+ *
+ * @param[in] op the operation to write.
+ */
+void terminal_ops_print(const terminal_op_t *op);
+
+/**
+ * @brief Compiles the command line starting at the given command buffer
+ * offset, replacing the cached operation list on success.
+ *
+ * The command line must be terminated by a NUL character.  If the line
+ * contains anything but bus operations, the cached operation list is left
+ * untouched.
+ *
+ * @param[in] start the command buffer offset the line starts at.
+ *
+ * @return true if the line was compiled, false otherwise.
+ */
+bool terminal_ops_compile(const uint16_t start);
+
+/**
+ * @brief Executes the cached operation list the given number of times.
+ *
+ * Values read from the bus are written to the serial port separated by
+ * spaces, with one line per iteration.  In batch mode they all go on the
+ * script line's result line instead.  Execution stops early if a byte
+ * arrives on the serial port or if an operation raises an error.
+ *
+ * @param[in] iterations how many times the operation list should be run.
+ * @param[in] quiet true to suppress all output, false otherwise.
+ *
+ * @return false if there is no cached operation list, true otherwise.
+ */
+bool terminal_ops_run(const uint16_t iterations, const bool quiet);
+
+#endif /* BP_ENABLE_COMMAND_REPEAT */
+
+#endif /* !BP_TERMINAL_OPS_H */
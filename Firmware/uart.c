@@ -434,7 +434,7 @@ void uart_start(void) {
   uart_settings.echo_uart = ON;
 
   /* Start periodic service calls. */
-  mode_configuration.periodicService = ON;
+  bp_set_periodic_service_state(ON);
 
   MSG_UART_LIVE_DISPLAY_START;
 }
@@ -444,7 +444,7 @@ void uart_stop(void) {
   uart_settings.echo_uart = OFF;
 
   /* Stop periodic service calls. */
-  mode_configuration.periodicService = OFF;
+  bp_set_periodic_service_state(OFF);
 
   MSG_UART_LIVE_DISPLAY_STOP;
 }
@@ -0,0 +1,407 @@
+/*
+ * This file is part of the Bus Pirate project
+ * (https://github.com/BusPirate/Bus_Pirate/).
+ *
+ * Written and maintained by the Bus Pirate project.
+ *
+ * To the extent possible under law, the project has waived all copyright and
+ * related or neighboring rights to Bus Pirate.  This work is published from
+ * United States.
+ *
+ * For details see: http://creativecommons.org/publicdomain/zero/1.0/
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.
+ */
+
+/**
+ * @file user_macros.c
+ *
+ * @brief Flash-backed user macros implementation file.
+ *
+ * Each macro slot takes a whole flash erase page.  The first word of a page
+ * holds a marker telling whether the slot was ever written to, followed by
+ * the slot's operations, three words each, up to the first erased word.  Only
+ * the lower 16 bits of each program word are used.
+ */
+
+#include "user_macros.h"
+
+#ifdef BP_ENABLE_FLASH_MACROS
+
+#include "base.h"
+#include "proc_menu.h"
+#include "terminal_ops.h"
+
+extern mode_configuration_t mode_configuration;
+
+/**
+ * @brief Marker stored in the first word of a macro slot holding operations.
+ */
+#define MACRO_SLOT_MARKER 0xB9A5
+
+/**
+ * @brief How many program words an operation takes.
+ */
+#define MACRO_OP_WORDS 3
+
+/**
+ * @brief How many operations fit in a macro slot.
+ */
+#define MACRO_SLOT_OPERATIONS ((_FLASH_PAGE - 1) / MACRO_OP_WORDS)
+
+/**
+ * @brief Value read back from an erased program word, masked to 16 bits.
+ */
+#define ERASED_WORD 0xFFFF
+
+/**
+ * @brief NVMCON value to erase a flash page.
+ */
+#define NVM_ERASE_PAGE 0x4042
+
+/**
+ * @brief NVMCON value to program a flash row.
+ */
+#define NVM_PROGRAM_ROW 0x4001
+
+/**
+ * @brief NVMCON value to program a single flash word.
+ */
+#define NVM_PROGRAM_WORD 0x4003
+
+/**
+ * @brief Flash area holding the macro slots, one erase page each.
+ *
+ * The linker script's program region starts at 0x2000, right after the
+ * bootloader, and ends at 0x2A9F8.  A page aligned block can therefore
+ * neither overlap the bootloader nor share the last page with the
+ * configuration words at 0x2ABF8, which erasing a slot would wipe.
+ */
+static const uint16_t __attribute__((space(prog), aligned(_FLASH_PAGE * 2)))
+    macro_store[BP_USER_MACROS_COUNT][_FLASH_PAGE] = {{0}};
+
+/**
+ * @brief How many operations each macro slot holds.
+ */
+static uint16_t slot_lengths[BP_USER_MACROS_COUNT] = {0};
+
+/**
+ * @brief Returns the program memory address of the given macro slot.
+ *
+ * @param[in] slot the macro slot index.
+ *
+ * @return the address of the first word of the slot.
+ */
+static unsigned long slot_address(const uint8_t slot);
+
+/**
+ * @brief Returns one of the program words an operation list is stored as.
+ *
+ * @param[in] ops the operation list.
+ * @param[in] index the word index, starting from the first operation.
+ *
+ * @return the word to store.
+ */
+static uint16_t encode_word(const terminal_op_t *ops, const uint16_t index);
+
+/**
+ * @brief Reads an operation from a macro slot.
+ *
+ * @param[in] slot the macro slot index.
+ * @param[in] index the operation index.
+ * @param[out] op the operation to fill.
+ */
+static void read_operation(const uint8_t slot, const uint16_t index,
+                           terminal_op_t *op);
+
+/**
+ * @brief Runs the flash operation loaded in NVMCON and waits for it to end.
+ */
+static void commit_flash_operation(void);
+
+/**
+ * @brief Erases a macro slot and writes the given operations into it, one
+ * flash row at a time.
+ *
+ * @param[in] slot the macro slot index.
+ * @param[in] ops the operations to write.
+ * @param[in] count how many operations to write, possibly 0.
+ */
+static void write_slot(const uint8_t slot, const terminal_op_t *ops,
+                       const uint16_t count);
+
+/**
+ * @brief Appends the given operations to a non-empty macro slot, programming
+ * the erased words after the last stored operation.
+ *
+ * @param[in] slot the macro slot index.
+ * @param[in] ops the operations to append.
+ * @param[in] count how many operations to append.
+ */
+static void append_to_slot(const uint8_t slot, const terminal_op_t *ops,
+                           const uint16_t count);
+
+/**
+ * @brief Parses the macro body from the command buffer and stores it.
+ *
+ * @param[in] slot the macro slot index.
+ * @param[in] end the command buffer offset of the closing `>` character.
+ * @param[in] append true to append to the slot, false to replace it.
+ */
+static void store_macro(const uint8_t slot, const uint16_t end,
+                        const bool append);
+
+/**
+ * @brief Executes the operations held by a macro slot.
+ *
+ * @param[in] slot the macro slot index.
+ */
+static void run_macro(const uint8_t slot);
+
+/**
+ * @brief Lists the content of all macro slots.
+ */
+static void list_macros(void);
+
+unsigned long slot_address(const uint8_t slot) {
+  return __builtin_tbladdress(macro_store) +
+         ((unsigned long)slot * (_FLASH_PAGE * 2));
+}
+
+uint16_t encode_word(const terminal_op_t *ops, const uint16_t index) {
+  const terminal_op_t *op = &ops[index / MACRO_OP_WORDS];
+
+  switch (index % MACRO_OP_WORDS) {
+  case 0:
+    return op->code | (op->numbits << 8);
+
+  case 1:
+    return op->repeat;
+
+  default:
+    return op->value;
+  }
+}
+
+void read_operation(const uint8_t slot, const uint16_t index,
+                    terminal_op_t *op) {
+  const unsigned long address =
+      slot_address(slot) + ((1 + (index * MACRO_OP_WORDS)) << 1);
+  uint16_t word;
+
+  TBLPAG = (address >> 16) & 0xFF;
+  word = __builtin_tblrdl(address);
+  op->code = LO8(word);
+  op->numbits = HI8(word);
+  op->repeat = __builtin_tblrdl(address + 2);
+  op->value = __builtin_tblrdl(address + 4);
+}
+
+void commit_flash_operation(void) {
+  __builtin_write_NVM();
+  while (NVMCONbits.WR == 1) {
+  }
+  NVMCONbits.WREN = 0;
+}
+
+void write_slot(const uint8_t slot, const terminal_op_t *ops,
+                const uint16_t count) {
+  const unsigned long address = slot_address(slot);
+  const uint16_t words = (count > 0) ? 1 + (count * MACRO_OP_WORDS) : 0;
+  uint16_t offset = address & 0xFFFF;
+  uint16_t word;
+  uint16_t index;
+
+  /* Slots are page aligned, so the page register stays the same. */
+  TBLPAG = (address >> 16) & 0xFF;
+
+  NVMCON = NVM_ERASE_PAGE;
+  __builtin_tblwtl(offset, ERASED_WORD);
+  commit_flash_operation();
+
+  for (word = 0; word < words; word += _FLASH_ROW) {
+    NVMCON = NVM_PROGRAM_ROW;
+    for (index = word; index < (word + _FLASH_ROW); index++) {
+      if (index == 0) {
+        __builtin_tblwtl(offset, MACRO_SLOT_MARKER);
+      } else if (index < words) {
+        __builtin_tblwtl(offset, encode_word(ops, index - 1));
+      } else {
+        __builtin_tblwtl(offset, ERASED_WORD);
+      }
+      __builtin_tblwth(offset, 0xFF);
+      offset += 2;
+    }
+    commit_flash_operation();
+  }
+
+  slot_lengths[slot] = count;
+}
+
+void append_to_slot(const uint8_t slot, const terminal_op_t *ops,
+                    const uint16_t count) {
+  const unsigned long address = slot_address(slot);
+  uint16_t offset =
+      (address & 0xFFFF) + ((1 + (slot_lengths[slot] * MACRO_OP_WORDS)) << 1);
+  uint16_t index;
+
+  TBLPAG = (address >> 16) & 0xFF;
+
+  for (index = 0; index < (count * MACRO_OP_WORDS); index++) {
+    NVMCON = NVM_PROGRAM_WORD;
+    __builtin_tblwtl(offset, encode_word(ops, index));
+    __builtin_tblwth(offset, 0xFF);
+    commit_flash_operation();
+    offset += 2;
+  }
+
+  slot_lengths[slot] += count;
+}
+
+void store_macro(const uint8_t slot, const uint16_t end, const bool append) {
+  terminal_op_t ops[BP_COMMAND_REPEAT_MAX_OPERATIONS];
+  const uint16_t body = (cmdstart + 1) & CMDLENMSK;
+  uint16_t count = 0;
+
+  if (body != end) {
+    /* Terminate the body so it can be parsed like a whole line. */
+    cmdbuf[end] = 0x00;
+    count = terminal_ops_parse(body, ops, BP_COMMAND_REPEAT_MAX_OPERATIONS);
+    cmdbuf[end] = '>';
+
+    if (count == 0) {
+      mode_configuration.command_error = YES;
+      return;
+    }
+  }
+
+  if (!append || (slot_lengths[slot] == 0)) {
+    write_slot(slot, ops, count);
+    return;
+  }
+
+  if ((slot_lengths[slot] + count) > MACRO_SLOT_OPERATIONS) {
+    MSG_USER_MACRO_STORAGE_FULL;
+    return;
+  }
+
+  append_to_slot(slot, ops, count);
+}
+
+void run_macro(const uint8_t slot) {
+  terminal_op_t op;
+  uint16_t index;
+  bool output = NO;
+
+  for (index = 0; index < slot_lengths[slot]; index++) {
+    read_operation(slot, index, &op);
+    if (terminal_ops_execute(&op)) {
+      output = YES;
+    }
+
+    if (mode_configuration.command_error == YES) {
+      break;
+    }
+  }
+
+  if (output) {
+    bpBR;
+  }
+}
+
+void list_macros(void) {
+  terminal_op_t op;
+  uint16_t index;
+  uint8_t slot;
+
+  for (slot = 0; slot < BP_USER_MACROS_COUNT; slot++) {
+    bp_write_dec_byte(slot + 1);
+    bp_write_string(". <");
+    for (index = 0; index < slot_lengths[slot]; index++) {
+      if (index > 0) {
+        bpSP;
+      }
+      read_operation(slot, index, &op);
+      terminal_ops_print(&op);
+    }
+    bp_write_line(">");
+  }
+}
+
+void user_macros_init(void) {
+  const uint8_t tblpag_prev = TBLPAG;
+  unsigned long address;
+  uint16_t length;
+  uint8_t slot;
+
+  for (slot = 0; slot < BP_USER_MACROS_COUNT; slot++) {
+    address = slot_address(slot);
+    TBLPAG = (address >> 16) & 0xFF;
+
+    length = 0;
+    if (__builtin_tblrdl(address) == MACRO_SLOT_MARKER) {
+      address += 2;
+      while ((length < MACRO_SLOT_OPERATIONS) &&
+             (__builtin_tblrdl(address) != ERASED_WORD)) {
+        length++;
+        address += MACRO_OP_WORDS << 1;
+      }
+    }
+
+    slot_lengths[slot] = length;
+  }
+
+  TBLPAG = tblpag_prev;
+}
+
+void user_macros_handle_command(void) {
+  const uint8_t tblpag_prev = TBLPAG;
+  uint16_t end = (cmdstart + 1) & CMDLENMSK;
+  int slot;
+
+  /* Find the end of the macro command. */
+  while (cmdbuf[end] != '>') {
+    if (cmdbuf[end] == 0x00) {
+      mode_configuration.command_error = YES;
+      return;
+    }
+    end = (end + 1) & CMDLENMSK;
+  }
+
+  cmdstart = (cmdstart + 1) & CMDLENMSK;
+  slot = getint();
+
+  if (mode_configuration.command_error == NO) {
+    switch (cmdbuf[cmdstart]) {
+    case '>':
+      if (slot == 0) {
+        list_macros();
+      } else if (slot <= BP_USER_MACROS_COUNT) {
+        run_macro(slot - 1);
+      } else {
+        mode_configuration.command_error = YES;
+      }
+      break;
+
+    case '=':
+    case '+':
+      if ((slot > 0) && (slot <= BP_USER_MACROS_COUNT)) {
+        store_macro(slot - 1, end, cmdbuf[cmdstart] == '+');
+      } else {
+        mode_configuration.command_error = YES;
+      }
+      break;
+
+    default:
+      mode_configuration.command_error = YES;
+      break;
+    }
+  }
+
+  TBLPAG = tblpag_prev;
+  cmdstart = end;
+}
+
+#endif /* BP_ENABLE_FLASH_MACROS */
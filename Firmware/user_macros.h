@@ -0,0 +1,54 @@
+/*
+ * This file is part of the Bus Pirate project
+ * (https://github.com/BusPirate/Bus_Pirate/).
+ *
+ * Written and maintained by the Bus Pirate project.
+ *
+ * To the extent possible under law, the project has waived all copyright and
+ * related or neighboring rights to Bus Pirate.  This work is published from
+ * United States.
+ *
+ * For details see: http://creativecommons.org/publicdomain/zero/1.0/
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.
+ */
+
+/**
+ * @file user_macros.h
+ *
+ * @brief Flash-backed user macros definition file.
+ *
+ * User macros are kept in program flash as precompiled bus operation lists,
+ * one flash page per macro, so they survive resets and run without going
+ * through the text parser.
+ */
+
+#ifndef BP_USER_MACROS_H
+#define BP_USER_MACROS_H
+
+#include "configuration.h"
+
+#ifdef BP_ENABLE_FLASH_MACROS
+
+/**
+ * @brief Indexes the macros stored in flash.
+ *
+ * Must be called once at boot before any other macro function.
+ */
+void user_macros_init(void);
+
+/**
+ * @brief Handles a macro command from the command buffer.
+ *
+ * The command buffer position must be on the opening `<` character, and is
+ * left on the closing `>` character.  Supported forms are `<0>` to list all
+ * macros, `<N>` to run macro N, `<N=...>` to replace macro N, and `<N+...>`
+ * to append to macro N.  Malformed commands set the command error flag.
+ */
+void user_macros_handle_command(void);
+
+#endif /* BP_ENABLE_FLASH_MACROS */
+
+#endif /* !BP_USER_MACROS_H */
@@ -8,9 +8,11 @@
 #ifndef WIN32
 #define TRUE 1
 #define FALSE 0
-#define Sleep(x) usleep(x);
 #endif
 
+//a Bus Pirate answers BBIO entry within a few ms, retries cover the rest
+#define BBIO_REPLY_TIMEOUT_MS 100
+
 const char *modes[]={
     "BBIO",
     "SPI",
@@ -37,7 +39,6 @@ uint32_t BP_WriteToPirate(int fd, char * val) {
 
 
     serial_write(fd, val, 1);
-    Sleep(1);
     res = serial_read(fd, &ret, 1);
 
 	if( ret != '\x01') {
@@ -60,7 +61,6 @@ uint32_t BP_WriteToPirateNoCheck(int fd, char * val) {
 
 
     serial_write(fd, val, 1);
-    Sleep(1);
     res = serial_read(fd, &ret, 1);
 
 	return 0;
@@ -92,8 +92,7 @@ int BP_EnableBinary(int fd)   // should return BBIO if ok, ERR if not
 		serial_write(fd, tmp, 1);
 		tries++;
 	//	printf("tries: %i Ret %i\n",tries,ret);
-		usleep(1);
-		ret = serial_read(fd, tmp, 5);
+		ret = serial_read_timeout(fd, tmp, 5, 5, BBIO_REPLY_TIMEOUT_MS);
 		if (modem==TRUE)
 		{
             printf("\n Modem Responded = %i\n",ret);
@@ -138,7 +137,6 @@ int BP_EnableMode(int fd, char bbmode)
 	//printf("Sending 0X%X to port\n",tmp[0]);
 	serial_write(fd, tmp, 1);
 	tries++;
-	 usleep(1);
 	ret = serial_read(fd, tmp, 4);
 	if (modem==TRUE)
 		{
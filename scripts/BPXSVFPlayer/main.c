@@ -2,6 +2,8 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <string.h>
+#include <ctype.h>
+#include <limits.h>
 #include <sys/stat.h>
 #include <fcntl.h>
 #ifdef WIN32
@@ -14,6 +16,9 @@
 
 #include "serial.h"
 #include "buspirate.h"
+#include "trace.h"
+#include "xsvf.h"
+#include "svf.h"
 
 
 #define  JTAG_RESET        0x01
@@ -31,9 +36,11 @@
 #define XSVF_ERROR_LAST            0x07
 #define XSVF_READY_FOR_DATA        0xFF
 
+//the firmware may be busy with XWAIT delays or erasing between requests
+#define XSVF_REPLY_TIMEOUT_MS      5000
+#define CHAIN_SCAN_TIMEOUT_MS      1000
+
 #ifndef WIN32
-//#define usleep(x) Sleep(x);
-#define Sleep(x) usleep(x);
 #define TRUE 1
 #define FALSE 0
 #endif
@@ -48,10 +55,19 @@ int cnt=0;
 uint8_t *bin_buf;
 uint32_t bin_buf_size;
 #define FREE(x) if(x) free(x);
-#define MAX_BUFFER 4096  //255 bytes
+#define MAX_BUFFER 4096  //chunk buffer of the firmware's XSVF player, see Firmware/jtag/ports.c
 
 //http://www.whereisian.com/files/j-xsvf_002.swf
 
+//SVF input is converted here instead of running SVF2XSVF first
+static int is_svf_file(const char *name)
+{
+	size_t len = strlen(name);
+
+	return len > 4 && name[len - 4] == '.' && tolower((unsigned char)name[len - 3]) == 's'
+	       && tolower((unsigned char)name[len - 2]) == 'v' && tolower((unsigned char)name[len - 1]) == 'f';
+}
+
 int print_usage(char * appname)
 {
 		//print usage
@@ -59,15 +75,22 @@ int print_usage(char * appname)
 		printf("\n");
 	    printf(" Help Menu\n");
         printf(" Usage:              \n");
-		printf("   %s  -p device -f filename.xsvf -s speed [-x] [-r] \n ",appname);
+		printf("   %s  -p device -f filename.xsvf -s speed [-x] [-r] [-t trace.txt] \n ",appname);
+		printf("   %s  -p device -f filename.svf -s speed [-S] \n ",appname);
+		printf("   %s  -f filename.svf -o filename.xsvf \n ",appname);
+		printf("   %s  -b trace.txt -f filename.xsvf \n ",appname);
 		printf("\n");
 		printf("   Example Usage:   %s -p COM1 -s 115200 -f example.xsvf  \n",appname);
 		printf("\n");
 		printf("           Where: -p device is port e.g.  COM1  \n");
 		printf("                  -s Speed is port Speed  default is 115200 \n");
-		printf("                  -f Filename of XSVF file \n");
+		printf("                  -f Filename of XSVF file, or of an SVF file to convert on the fly \n");
+		printf("                  -S Convert SVF while sending instead of all before starting \n");
+		printf("                  -o Save the XSVF converted from SVF, without -p only convert \n");
 		printf("                  -x Perform a JTAG Chain Scan by sending 0x02 command. -f is optional. \n");
 		printf("                  -r Perform a JTAG Reset  Scan by sending 0x01 command. -f is optional. \n");
+		printf("                  -t Record the firmware's request timing to a trace file \n");
+		printf("                  -b Benchmark: replay a recorded trace instead of using a Bus Pirate \n");
 		printf("\n");
 
         printf("-----------------------------------------------------------------------------\n");
@@ -81,8 +104,15 @@ int main(int argc, char** argv)
 	int opt;
 	uint8_t buffer[MAX_BUFFER]={0};
 	uint8_t temp[2]={0};  // command buffer
+	struct iovec chunk[2];  // chunk length and data go out in one write
+	xsvf_stats_t stats;
+	int stats_ok;
+	double started=0, sent_at=0, elapsed;
+	long totalSize=0;
+	int chunks=0;
+	FILE *trace=NULL;
 //	struct stat stbuf;
-	int fd,timeout_counter;
+	int fd = -1,timeout_counter;
 	int res,c, nparam_bytechunks, bytePointer, readSize;
 	long fileSize;
 	FILE *XSVF;
@@ -92,6 +122,12 @@ int main(int argc, char** argv)
 	char *param_speed = NULL;
 	char *param_XSVF=NULL;
 	char *param_bytechunks=NULL;
+	char *param_trace=NULL;
+	char *param_benchmark=NULL;
+	char *param_output=NULL;
+	svf_converter_t *svf=NULL;
+	int  svf_stream=FALSE;
+	FILE *output;
 	int  jtag_reset=FALSE;
     int  chainscan=FALSE;
 
@@ -121,7 +157,7 @@ int main(int argc, char** argv)
 	}
 
 
-	while ((opt = getopt(argc, argv, "s:p:f:rx")) != -1) {
+	while ((opt = getopt(argc, argv, "s:p:f:rxt:b:So:")) != -1) {
 
 		switch (opt) {
 			case 'p':  // device   eg. com1 com12 etc
@@ -146,6 +182,22 @@ int main(int argc, char** argv)
 
 				break;
 
+			case 't':
+				param_trace = strdup(optarg);
+				break;
+
+			case 'b':
+				param_benchmark = strdup(optarg);
+				break;
+
+			case 'S':
+				svf_stream=TRUE;
+				break;
+
+			case 'o':
+				param_output = strdup(optarg);
+				break;
+
 			case 's':
 				if (param_speed != NULL) {
 					printf(" Speed should be set: eg  115200 \n");
@@ -163,12 +215,22 @@ int main(int argc, char** argv)
 		}
 	}
 
-	if (param_port==NULL){
+	if (param_output!=NULL && (param_XSVF==NULL || !is_svf_file(param_XSVF) || svf_stream==TRUE)) {
+		printf(" -o saves a whole converted SVF file, it needs an .svf file and no -S\n");
+		exit(-1);
+	}
+
+	if (param_port==NULL && param_benchmark==NULL && (param_output==NULL || jtag_reset==TRUE || chainscan==TRUE)){
 		printf(" No serial port specified\n");
 		print_usage(argv[0]);
 		exit(-1);
 	}
 
+	if (param_benchmark!=NULL && (jtag_reset==TRUE || chainscan==TRUE || param_trace!=NULL)) {
+		printf(" -x, -r and -t need a Bus Pirate, they do not go with -b\n");
+		exit(-1);
+	}
+
     nparam_bytechunks=MAX_BUFFER;
 
 	if (param_speed==NULL) {
@@ -176,20 +238,21 @@ int main(int argc, char** argv)
 	}
 
 
-	fd = serial_open(param_port);
-	if (fd < 0) {
-		fprintf(stderr, " Error opening serial port\n");
-		return -1;
-	}
+	if (param_port!=NULL && param_benchmark==NULL) {
+		fd = serial_open(param_port);
+		if (fd < 0) {
+			fprintf(stderr, " Error opening serial port\n");
+			return -1;
+		}
 
-	//setup port and speed
-	serial_setup(fd,(speed_t) atoi(param_speed)); 
+		//setup port and speed
+		serial_setup(fd,(speed_t) atoi(param_speed)); 
+	}
 
 	if (jtag_reset==TRUE){
         printf(" Performing Reset..\n");
         temp[0]=0x01;
         serial_write( fd, (char *)temp, 1 );
-        Sleep(1);
         printf(" Done \n\n");
 	}
 
@@ -201,21 +264,17 @@ int main(int argc, char** argv)
 		printf(" Performing Chain Scan..\n");
 		temp[0]=0x02;
 		serial_write( fd, (char *)temp, 1 );
-		Sleep(1);
-		res=0;
-		timeout_counter=0;
-
-		while (res==0) {
-			res= serial_read(fd, (char *)buffer, sizeof(buffer));
-			Sleep(1);
-			timeout_counter++;
-			if (timeout_counter>=5) {
-			printf(" Got no reply for a Chain scan\n");
-			} else {
-			printf(" Waiting for a chain scan reply\n");
-			}
+
+		//the reply is a byte count, then that many ID bytes
+		res = serial_read_timeout(fd, (char *)buffer, 1, 1, CHAIN_SCAN_TIMEOUT_MS);
+		if (res == 1 && buffer[0] > 0) {
+			c = serial_read_timeout(fd, (char *)&buffer[1], buffer[0], buffer[0], CHAIN_SCAN_TIMEOUT_MS);
+			if (c > 0)
+				res += c;
 		}
-		if (res >0) {
+		if (res <= 0) {
+			printf(" Got no reply for a Chain scan\n");
+		} else {
 			printf(" Chain Scan Result:" );
 			for(c=0;c<res;c++){
 			printf(" %02X",buffer[c]);
@@ -225,11 +284,46 @@ int main(int argc, char** argv)
 		}
 	}
 
-   if (param_XSVF !=NULL) {
+   if (param_XSVF != NULL && is_svf_file(param_XSVF)) {
+		svf = svf_open(param_XSVF);
+		if (svf == NULL)
+			exit(-1);
+
+		//converting it all first stops on SVF errors before the device is touched,
+		//-S only makes the first chunk and converts the rest while the firmware works
+		if (svf_convert(svf, svf_stream ? MAX_BUFFER : LONG_MAX) < 0)
+			exit(-1);
+		bin_buf = svf_xsvf(svf, &fileSize);
+		totalSize = fileSize;
+		stats_ok = 0;
+		if (svf_done(svf)) {
+			printf(" Converted SVF to %ld bytes of XSVF\n", fileSize);
+			stats_ok = (xsvf_scan(bin_buf, fileSize, &stats) == 0);
+			printf(" %lu XSVF commands, %llu TCKs of shifting\n", stats.commands, stats.shift_tcks);
+		} else {
+			printf(" Converting SVF while sending\n");
+		}
+
+		if (param_output != NULL) {
+			output = fopen(param_output, "wb");
+			if (output == NULL || fwrite(bin_buf, 1, fileSize, output) != (size_t)fileSize) {
+				printf(" Error writing XSVF file %s\n", param_output);
+				exit(-1);
+			}
+			fclose(output);
+			printf(" Saved XSVF file %s\n", param_output);
+			if (param_port == NULL && param_benchmark == NULL) {
+				svf_close(svf);
+				return 0;
+			}
+		}
+
+	} else if (param_XSVF !=NULL) {
 		//open the XSVF file
             XSVF = fopen(param_XSVF, "rb");
             if (XSVF == NULL) {
                 printf(" Error opening file\n");
+                exit(-1);
             }
             fseek(XSVF, 0, SEEK_END);
             fileSize = ftell(XSVF);
@@ -251,22 +345,44 @@ int main(int argc, char** argv)
 
             fclose(XSVF);
 
+            //the whole file is in memory, size up the work before sending it
+            stats_ok = (xsvf_scan(bin_buf, fileSize, &stats) == 0);
+            printf(" %lu XSVF commands, %llu TCKs of shifting%s\n", stats.commands, stats.shift_tcks,
+                   stats_ok ? "" : " before an unsupported command");
+            totalSize = fileSize;
+
 
 	} else {
 		printf(" No file specified. Need an input xsvf file \n");
 		exit(-1);
 	}
-	printf(" Opening Bus Pirate on %s at %sbps, using XSVF file %s \n", param_port, param_speed,param_XSVF);
+	if (param_benchmark!=NULL) {
+		printf(" Replaying firmware trace %s, using XSVF file %s \n", param_benchmark, param_XSVF);
+		fd = trace_replay_start(param_benchmark, (svf == NULL || svf_done(svf)) ? fileSize : LONG_MAX);
+		if (fd < 0)
+			exit(-1);
+	} else {
+		printf(" Opening Bus Pirate on %s at %sbps, using XSVF file %s \n", param_port, param_speed,param_XSVF);
+	}
+
+	if (param_trace!=NULL) {
+		trace = fopen(param_trace, "w");
+		if (trace == NULL) {
+			printf(" Error creating trace file %s\n", param_trace);
+			exit(-1);
+		}
+	}
 
 	// Enter XSVF Player Mode
 	//Open the port and send 0x03 to enter XSVF player mode
 	printf(" Entering XSVF Player Mode\n");
 	temp[0]=0x03;
 	serial_write( fd, (char *)temp, 1 );
+	started = sent_at = trace_now();
+	readSize = 0;
 
 	// Wait for 0xFF, if <0xFF then it is finished or error codes (see below)
     bytePointer=0; //where we are in the byte buffer array
-    readSize=MAX_BUFFER; //hack this to be a full chunk
     cnt=0;
     printf(" Waiting for first data request...");
 	while(1) {
@@ -275,9 +391,11 @@ int main(int argc, char** argv)
 			timeout_counter=0;
 			timer_out=0;   // 0 if ok, else -1 if exit
 			while(1) {
-				res= serial_read(fd, (char *)buffer, sizeof(buffer));
+				res= serial_read_timeout(fd, (char *)buffer, 1, 1, XSVF_REPLY_TIMEOUT_MS);
 				if(res>0){
                     printf("ok\n");
+                    if (trace != NULL)
+                        fprintf(trace, "%d %ld\n", readSize, (long)((trace_now() - sent_at) * 1e6));
 				  // wait for 0xFF and send data, or error
 					if ((buffer[0]!=XSVF_READY_FOR_DATA) || (fileSize==0)) {
 					    c=buffer[0];
@@ -325,7 +443,6 @@ int main(int argc, char** argv)
                      break; //break loop and send data
 				}else{
 					printf("\n Waiting for reply...");
-				//	Sleep(1);
 					timeout_counter++;
 					if(timeout_counter > 4){
 						printf("\n No reply.... Quitting.\n ");
@@ -335,37 +452,68 @@ int main(int argc, char** argv)
 					}
 				}
 			}
-            if (fileSize==0) {
+            //the firmware is done or failed, whatever is left of the file is not wanted
+            if (fileSize==0 || buffer[0]!=XSVF_READY_FOR_DATA) {
 			       break;
 			}
 
             if (timer_out==-1)
                 break;
-            //send data
-            if(fileSize<MAX_BUFFER){
-                readSize=fileSize;
-            }
+            //send data, as much as the firmware buffer holds
+            readSize = (fileSize < MAX_BUFFER) ? fileSize : MAX_BUFFER;
 			//send to bp
 			temp[0]=(readSize>>8);
 			temp[1]=readSize;
 			cnt=cnt+readSize;
 
 			printf(" Sending %i Bytes (%04X)...",readSize, cnt);
-			serial_write( fd, (char *)temp,2 );
-			serial_write( fd, (char *) &bin_buf[bytePointer],readSize );
+			chunk[0].iov_base = temp;
+			chunk[0].iov_len = 2;
+			chunk[1].iov_base = &bin_buf[bytePointer];
+			chunk[1].iov_len = readSize;
+			serial_writev( fd, chunk, 2 );
+			sent_at = trace_now();
+			chunks++;
 			bytePointer=bytePointer+readSize;//start 1 chunk in next itme
 			fileSize=fileSize-readSize; //deincrement the remaining byte count
 
+			//make the next chunk while the firmware works through this one
+			if (svf != NULL && !svf_done(svf)) {
+				if (svf_convert(svf, bytePointer + MAX_BUFFER) < 0) {
+					printf(" SVF conversion failed, stopping\n");
+					break;
+				}
+				bin_buf = svf_xsvf(svf, &totalSize);
+				fileSize = totalSize - bytePointer;
+			}
+
 	}
 
+    if (trace != NULL)
+        fclose(trace);
+
+    if (svf != NULL && svf_stream == TRUE && svf_done(svf))
+        stats_ok = (xsvf_scan(bin_buf, totalSize, &stats) == 0);
+
+    elapsed = trace_now() - started;
+    if (elapsed > 0 && chunks > 0) {
+        printf(" Sent %ld bytes in %d chunks in %.3fs: %.0f bytes/s", totalSize - fileSize, chunks, elapsed,
+               (totalSize - fileSize) / elapsed);
+        if (stats_ok && fileSize == 0)
+            printf(", %.0f TCK/s", stats.shift_tcks / elapsed);
+        printf("\n");
+    }
+
     printf(" Thank you for playing! :-)\n\n");
 #ifdef WIN32
-    fclose(XSVF);
 	FREE(param_port);
  	FREE(param_speed);
     FREE(param_bytechunks);
     FREE(param_XSVF);
-    FREE( bin_buf);
+    if (svf != NULL)
+        svf_close(svf);
+    else
+        FREE( bin_buf);
 #endif
     return 0;
  }  //end main()
@@ -24,117 +24,105 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <fcntl.h>
+#include <errno.h>
 
 #include <string.h>
 
+#ifndef WIN32
+#include <poll.h>
+#include <time.h>
+#endif
+
 #include "serial.h"
 extern int disable_comport;
 extern char *dumpfile;
 #ifdef WIN32
 extern HANDLE dumphandle;
 #endif
-#ifndef WIN32
-//#define usleep(x) Sleep(x);
-#define Sleep(x) usleep(x);
-#endif
-/*
-#ifdef WIN32
-	int write(int fd, const void* buf, int len)
-	{
-		HANDLE hCom = (HANDLE)fd;
-		int res = 0;
-		unsigned long bwritten = 0;
-
-
-		res = WriteFile(hCom, buf, len, &bwritten, NULL);
-
-		if( res == FALSE ) {
-			return -1;
-		} else {
-			return bwritten;
-		}
-	}
-
-	int read(int fd, void* buf, int len)
-	{
-		HANDLE hCom = (HANDLE)fd;
-		int res = 0;
-		unsigned long bread = 0;
-
-		res = ReadFile(hCom, buf, len, &bread, NULL);
-
-		if( res == FALSE ) {
-			return -1;
-		} else {
-			return bread;
-		}
-	}
-
-	int close(int fd)
-	{
-		HANDLE hCom = (HANDLE)fd;
-
-		CloseHandle(hCom);
-		return 0;
-	}
 
-	int open(const char* path, unsigned long flags)
-	{
-		static char full_path[32] = {0};
+/* longest vector serial_writev accepts */
+#define SERIAL_MAX_IOVEC 8
 
-		HANDLE hCom = NULL;
+#ifndef WIN32
+static long serial_now_ms(void)
+{
+	struct timespec now;
 
-		if( path[0] != '\\' ) {
-			_snprintf(full_path, sizeof(full_path) - 1, "\\\\.\\%s", path);
-			path = full_path;
-		}
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec * 1000L) + (now.tv_nsec / 1000000L);
+}
 
-		hCom = CreateFileA(path, GENERIC_WRITE | GENERIC_READ, 0, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+/* 1 when the events are ready, 0 when the deadline passed, -1 on errors or hangups */
+static int serial_wait(int fd, short events, long deadline)
+{
+	struct pollfd pfd;
+	long left;
+	int ret;
 
-		if( !hCom || hCom == INVALID_HANDLE_VALUE ) {
-			return -1;
-		} else {
-			return (int)hCom;
-		}
-	}
+	do {
+		left = deadline - serial_now_ms();
+		if (left < 0)
+			left = 0;
 
-	int __stdcall select(int nfds, fd_set* readfds, fd_set* writefds, fd_set* exceptfs, const struct timeval* timeout)
-	{
-		time_t maxtc = time(0) + (timeout->tv_sec);
-		COMSTAT cs = {0};
-		unsigned long dwErrors = 0;
+		pfd.fd = fd;
+		pfd.events = events;
+		pfd.revents = 0;
+		ret = poll(&pfd, 1, (int)left);
+	} while (ret < 0 && errno == EINTR);
 
-		if( readfds->fd_count != 1 ) {
-			return -1;
-		}
+	if (ret > 0 && !(pfd.revents & events))
+		return -1;
 
-		while( time(0) <= maxtc )
-		{ //only one file supported
-			if( ClearCommError( (HANDLE)readfds->fd_array[0], 0, &cs) != TRUE ){
-				return -1;
-			}
+	return ret;
+}
 
-			if( cs.cbInQue > 0 ) {
-				return 1;
-			}
+static int serial_hungup(int fd)
+{
+	struct pollfd pfd;
 
-			Sleep(10);
-		}
+	pfd.fd = fd;
+	pfd.events = POLLIN;
+	pfd.revents = 0;
+	if (poll(&pfd, 1, 0) < 0)
 		return 0;
-	}
-	unsigned int sleep(unsigned int sec)
-	{
-		Sleep(sec * 1000);
 
-		return 0;
+	return (pfd.revents & (POLLHUP | POLLERR | POLLNVAL)) != 0;
+}
+
+/* the command line passes plain numbers, termios wants its Bxxx constants */
+static speed_t serial_speed_constant(speed_t speed)
+{
+	switch (speed) {
+		case 9600:
+			return B9600;
+		case 19200:
+			return B19200;
+		case 38400:
+			return B38400;
+		case 57600:
+			return B57600;
+		case 115200:
+			return B115200;
+		case 230400:
+			return B230400;
+#ifdef B460800
+		case 460800:
+			return B460800;
+#endif
+#ifdef B921600
+		case 921600:
+			return B921600;
+#endif
+		default:
+			return speed;
 	}
-#else
+}
 #endif
-*/
+
 int serial_setup(int fd, speed_t speed)
 {
 #ifdef WIN32
-	COMMTIMEOUTS timeouts;
+	COMMTIMEOUTS timeouts = {0};
 	DCB dcb = {0};
 	HANDLE hCom = (HANDLE)fd;
 
@@ -149,12 +137,10 @@ int serial_setup(int fd, speed_t speed)
 		return -1;
 	}
 
-
-	timeouts.ReadIntervalTimeout = 100;
-	timeouts.ReadTotalTimeoutMultiplier = 10;
-	timeouts.ReadTotalTimeoutConstant = 100;
+	//read timeouts are set for each serial_read_timeout call
+	timeouts.ReadIntervalTimeout = MAXDWORD;
 	timeouts.WriteTotalTimeoutMultiplier = 10;
-	timeouts.WriteTotalTimeoutConstant = 100;
+	timeouts.WriteTotalTimeoutConstant = SERIAL_WRITE_TIMEOUT_MS;
 
 	if (!SetCommTimeouts(hCom, &timeouts)) {
 		return -1;
@@ -165,20 +151,21 @@ int serial_setup(int fd, speed_t speed)
 	struct termios t_opt;
 
 	/* set the serial port parameters */
-	fcntl(fd, F_SETFL, 0);
+	fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
 	tcgetattr(fd, &t_opt);
-	cfsetispeed(&t_opt, speed);
-	cfsetospeed(&t_opt, speed);
+	cfsetispeed(&t_opt, serial_speed_constant(speed));
+	cfsetospeed(&t_opt, serial_speed_constant(speed));
 	t_opt.c_cflag |= (CLOCAL | CREAD);
 	t_opt.c_cflag &= ~PARENB;
 	t_opt.c_cflag &= ~CSTOPB;
 	t_opt.c_cflag &= ~CSIZE;
 	t_opt.c_cflag |= CS8;
-	t_opt.c_lflag &= ~(ICANON | ECHO | ECHOE | ISIG);
-	t_opt.c_iflag &= ~(IXON | IXOFF | IXANY);
+	t_opt.c_lflag &= ~(ICANON | ECHO | ECHOE | ISIG | IEXTEN);
+	t_opt.c_iflag &= ~(IXON | IXOFF | IXANY | ICRNL | INLCR | IGNCR | ISTRIP | BRKINT);
 	t_opt.c_oflag &= ~OPOST;
+	//never block in the driver, serial_read_timeout waits in poll() instead
 	t_opt.c_cc[VMIN] = 0;
-	t_opt.c_cc[VTIME] = 10;
+	t_opt.c_cc[VTIME] = 0;
 	tcflush(fd, TCIFLUSH);
 	tcsetattr(fd, TCSANOW, &t_opt);
 #endif
@@ -187,85 +174,164 @@ int serial_setup(int fd, speed_t speed)
 
 int serial_write(int fd, char *buf, int size)
 {
-	int ret = 0;
+	struct iovec iov;
+
+	iov.iov_base = buf;
+	iov.iov_len = size;
+
+	return serial_writev(fd, &iov, 1);
+}
+
+int serial_writev(int fd, const struct iovec *iov, int count)
+{
+	int total = 0;
+	int sent = 0;
+	int i;
 #ifdef WIN32
 	HANDLE hCom = (HANDLE)fd;
-	int res = 0;
 	unsigned long bwritten = 0;
 
+	for (i = 0; i < count; i++) {
+		total += iov[i].iov_len;
 
-	res = WriteFile(hCom, buf, size, &bwritten, NULL);
+		if (iov[i].iov_len == 0)
+			continue;
 
-	//printf("Serial: Written %i bytes:  ",size);
-    //int i;
-    //for (i = 0; i < size; i++){
-		//printf("%02X ", buf[i]);
-	//}
-	//printf("\n");
+		if (!WriteFile(hCom, iov[i].iov_base, iov[i].iov_len, &bwritten, NULL)) {
+			break;
+		}
 
-	if( res == FALSE ) {
-		ret = -1;
-	} else {
-		ret = bwritten;
+		sent += bwritten;
+		if (bwritten != iov[i].iov_len)
+			break;
 	}
 #else
-	ret = write(fd, buf, size);
-#endif
+	struct iovec vec[SERIAL_MAX_IOVEC];
+	struct iovec *cur = vec;
+	long deadline;
+	int ret;
 
-	//fprintf(stderr, "size = %d ret = %d\n", size, ret);
-	//buspirate_print_buffer(buf, size);
+	if (count > SERIAL_MAX_IOVEC)
+		return -1;
 
-   	if (ret != size)
-	    	fprintf(stderr, "Error sending data");
-	return ret;
+	memcpy(vec, iov, count * sizeof(struct iovec));
+	for (i = 0; i < count; i++)
+		total += iov[i].iov_len;
+
+	//the timeout runs from the last progress, not from the start
+	deadline = serial_now_ms() + SERIAL_WRITE_TIMEOUT_MS;
+
+	while (count > 0) {
+		ret = writev(fd, cur, count);
+
+		if (ret < 0) {
+			if (errno == EINTR)
+				continue;
 
+			if ((errno == EAGAIN || errno == EWOULDBLOCK) && serial_wait(fd, POLLOUT, deadline) > 0)
+				continue;
 
+			break;
+		}
+
+		sent += ret;
+		deadline = serial_now_ms() + SERIAL_WRITE_TIMEOUT_MS;
+
+		//skip what went out, the last vector may be partly written
+		while (count > 0 && (size_t)ret >= cur->iov_len) {
+			ret -= cur->iov_len;
+			cur++;
+			count--;
+		}
+
+		if (count > 0) {
+			cur->iov_base = (char *)cur->iov_base + ret;
+			cur->iov_len -= ret;
+		}
+	}
+#endif
+
+	if (sent != total)
+		fprintf(stderr, "Error sending data");
+
+	return sent;
 }
 
 int serial_read(int fd, char *buf, int size)
+{
+	return serial_read_timeout(fd, buf, size, size, SERIAL_READ_TIMEOUT_MS);
+}
+
+int serial_read_timeout(int fd, char *buf, int min, int size, int timeout_ms)
 {
 	int len = 0;
-	int ret = 0;
-#ifndef WIN32
-	int timeout = 0;
-#endif
 #ifdef WIN32
+	COMMTIMEOUTS timeouts = {0};
 	HANDLE hCom = (HANDLE)fd;
 	unsigned long bread = 0;
+	DWORD start = GetTickCount();
+	DWORD elapsed;
+	int waiting;
 
-	ret = ReadFile(hCom, buf, size, &bread, NULL);
-
-	if( ret == FALSE || ret==-1 || bread<1) {
-		len= -1;
-	} else {
-		len=bread;
-	}
+	timeouts.WriteTotalTimeoutMultiplier = 10;
+	timeouts.WriteTotalTimeoutConstant = SERIAL_WRITE_TIMEOUT_MS;
 
-#else
 	while (len < size) {
-		ret = read(fd, buf+len, size-len);
-		if (ret == -1){
-			//printf("ret -1");
+		waiting = (len < min);
+		elapsed = GetTickCount() - start;
+
+		if (waiting && elapsed >= (DWORD)timeout_ms)
+			break;
+
+		//wait for the first byte while short of min, otherwise only take what is buffered
+		timeouts.ReadIntervalTimeout = MAXDWORD;
+		timeouts.ReadTotalTimeoutMultiplier = waiting ? MAXDWORD : 0;
+		timeouts.ReadTotalTimeoutConstant = waiting ? (timeout_ms - elapsed) : 0;
+
+		if (!SetCommTimeouts(hCom, &timeouts) || !ReadFile(hCom, buf + len, size - len, &bread, NULL))
 			return -1;
-		}
 
-		if (ret == 0) {
-			timeout++;
+		len += bread;
 
-			if (timeout >= 10)
-				break;
+		if (!waiting)
+			break;
+	}
+#else
+	long deadline = serial_now_ms() + timeout_ms;
+	int ret;
+
+	while (len < size) {
+		ret = read(fd, buf + len, size - len);
 
+		if (ret > 0) {
+			len += ret;
 			continue;
 		}
 
-		len += ret;
+		if (ret < 0 && errno == EINTR)
+			continue;
+
+		if (ret < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+			return -1;
+
+		//with VMIN 0 a tty returns 0 when it is empty, only a hangup shows in poll()
+		if (ret == 0 && serial_hungup(fd))
+			return len ? len : -1;
+
+		//nothing buffered right now
+		if (len >= min)
+			break;
+
+		ret = serial_wait(fd, POLLIN, deadline);
+		if (ret < 0)
+			return len ? len : -1;
+
+		if (ret == 0)
+			break;
 	}
 #endif
-	//printf("should have read = %i actual size = %i \n", size, len);
-	//fprintf(stderr, "should have read = %d actual size = %d \n", size, len);
-	//buspirate_print_buffer(buf, len);
 
-return len;
+	return len;
 }
 
 int serial_open(char *port)
@@ -298,7 +364,7 @@ int serial_open(char *port)
         }
     }
 #else
-	fd = open(port, O_RDWR | O_NOCTTY);
+	fd = open(port, O_RDWR | O_NOCTTY | O_NONBLOCK);
 	if (fd == -1) {
 		fprintf(stderr, "Could not open serial port.");
 		return -1;
@@ -326,122 +392,3 @@ int serial_close(int fd)
 	return 0;
 }
 
-/*
-int readWithTimeout(int fd, uint8_t *out, int length, int timeout)
-{
-	fd_set fds;
-	struct timeval tv = {timeout, 0};
-	int res = -1;
-	int got = 0;
-
-	do {
-
-		FD_ZERO(&fds);
-		FD_SET(fd, &fds);
-
-		res = select(fd + 1, &fds, NULL, NULL, &tv);
-
-		if( res > 0 ) {
-			res = read(fd, out, length);
-			if( res > 0 ) {
-				length -= res;
-				got    += res;
-				out    += res;
-			} else {
-				break;
-			}
-		} else {
-			return res;
-		}
-	} while( length > 0);
-
-	return got;
-}
-
-int configurePort(int fd, unsigned long baudrate)
-{
-#ifdef WIN32
-	COMMTIMEOUTS timeouts;
-	DCB dcb = {0};
-	HANDLE hCom = (HANDLE)fd;
-
-	dcb.DCBlength = sizeof(dcb);
-
-	dcb.BaudRate = baudrate;
-	dcb.ByteSize = 8;
-	dcb.Parity = NOPARITY;
-	dcb.StopBits = ONESTOPBIT;
-
-	if( !SetCommState(hCom, &dcb) ){
-		return -1;
-	}
-
-
-	timeouts.ReadIntervalTimeout = 100;
-	timeouts.ReadTotalTimeoutMultiplier = 10;
-	timeouts.ReadTotalTimeoutConstant = 100;
-	timeouts.WriteTotalTimeoutMultiplier = 10;
-	timeouts.WriteTotalTimeoutConstant = 100;
-
-	if (!SetCommTimeouts(hCom, &timeouts)) {
-		return -1;
-	}
-
-	return (int)hCom;
-#else
-    speed_t baud = B921600;
-	struct termios g_new_tio;
-
-	switch (baudrate) {
-		case 921600:
-			baud = B921600;
-			break;
-		case 115200:
-			baud = B115200;
-			break;
-		case 1000000:
-			baud = B1000000;
-			break;
-		case 1500000:
-			baud = B1500000;
-		default:
-			printf("unknown speed setting \n");
-			return -1;
-			break;
-	}
-
-	memset(&g_new_tio, 0x00 , sizeof(g_new_tio));
-	cfmakeraw(&g_new_tio);
-
-	g_new_tio.c_cflag |=  (CS8 | CLOCAL | CREAD);
-	g_new_tio.c_cflag &= ~(PARENB | CSTOPB | CSIZE);
-	g_new_tio.c_oflag = 0;
-	g_new_tio.c_lflag = 0;
-
-	g_new_tio.c_cc[VTIME] = 0;
-	g_new_tio.c_cc[VMIN] = 1;
-
-#ifdef MACOSX
-
-	if( tcsetattr(fd, TCSANOW, &g_new_tio) < 0 ) {
-		return -1;
-	}
-
-	return ioctl( fd, IOSSIOSPEED, &baud );
-#else
-	cfsetispeed (&g_new_tio, baudrate);
-	cfsetospeed (&g_new_tio, baudrate);
-
-	tcflush(fd, TCIOFLUSH);
-
-	return tcsetattr(fd, TCSANOW, &g_new_tio);
-#endif //#ifdef MACOSX
-
-#endif
-}
-
-int openPort(const char* dev, unsigned long flags)
-{
-	return open(dev, O_RDWR | O_NOCTTY | O_NDELAY | flags);
-}
-*/
@@ -22,43 +22,6 @@
  */
 #ifndef MYSERIAL_H_
 #define MYSERIAL_H_
-/*
-#ifdef WIN32
-	#include <windows.h>
-	#include <time.h>
-
-	#define O_NOCTTY 0
-	#define O_NDELAY 0
-	#define B115200 115200
-	#define B921600 921600
-
-	#define OS WINDOWS
-
-    int write(int fd, const void* buf, int len);
-    int read(int fd, void* buf, int len);
-    int close(int fd);
-    int open(const char* path, unsigned long flags);
-    int __stdcall select(int nfds, fd_set* readfds, fd_set* writefds, fd_set* exceptfs, const struct timeval* timeout);
-
-#else
-	#include <unistd.h>
-	#include <termios.h>
-	#include <sys/select.h>
-	#include <sys/types.h>
-	#include <sys/time.h>
-
-	#ifdef MACOSX
-		#include <IOKit/serial/ioss.h>
-		#include <sys/ioctl.h>
-
-		#define B1500000 1500000
-		#define B1000000 1000000
-		#define B921600  921600
-	#endif
-
-#endif
-*/
-
 #include <stdint.h>
 
 #ifdef WIN32
@@ -76,12 +39,33 @@ typedef long speed_t;
 #include <sys/select.h>
 #include <sys/types.h>
 #include <sys/time.h>
+#include <sys/uio.h>
 
 #endif
 
+#ifdef WIN32
+/* same layout as the POSIX one, so callers can build vectors portably */
+struct iovec {
+	void *iov_base;
+	size_t iov_len;
+};
+#endif
+
+/* how long serial_read and serial_write wait before giving up */
+#define SERIAL_READ_TIMEOUT_MS 1000
+#define SERIAL_WRITE_TIMEOUT_MS 1000
+
+/*
+ * serial_read_timeout waits until at least min bytes arrived or timeout_ms
+ * passed, then also takes whatever else is already buffered, up to size
+ * bytes.  It returns the number of bytes read, which is short on timeouts,
+ * or -1 on errors.  serial_read waits for all size bytes.
+ */
 int serial_setup(int fd, speed_t speed);
 int serial_write(int fd, char *buf, int size);
+int serial_writev(int fd, const struct iovec *iov, int count);
 int serial_read(int fd, char *buf, int size);
+int serial_read_timeout(int fd, char *buf, int min, int size, int timeout_ms);
 int serial_open(char *port);
 int serial_close(int fd);
 
@@ -0,0 +1,754 @@
+/*
+ * This file is part of the Bus Pirate project (http://code.google.com/p/the-bus-pirate/).
+ *
+ * Written and maintained by the Bus Pirate project and http://dangerousprototypes.com
+ *
+ * To the extent possible under law, the project has
+ * waived all copyright and related or neighboring rights to Bus Pirate. This
+ * work is published from United States.
+ *
+ * For details see: http://creativecommons.org/publicdomain/zero/1.0/.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "svf.h"
+#include "xsvf.h"
+
+#define SVF_MAX_VECTOR_BITS (50 * 8)  // MAX_LEN bytes per vector, see Firmware/jtag/lenval.h
+#define SVF_XREPEAT         16        // XSDRTDO retries after a RUNTEST, as SVF2XSVF does
+#define SVF_MAX_TOKENS      32
+#define SVF_MAX_SCAN_BITS   (1UL << 28)
+#define SVF_DEFAULT_FREQ    1e6       // RUNTEST TCK counts are taken as microseconds without a FREQUENCY
+
+/* TAP states, in XSTATE numbering */
+#define STATE_RESET   0x00
+#define STATE_IDLE    0x01
+#define STATE_DRPAUSE 0x06
+#define STATE_IRPAUSE 0x0D
+
+static const char *svf_state_names[] = {
+	"RESET", "IDLE", "DRSELECT", "DRCAPTURE", "DRSHIFT", "DREXIT1", "DRPAUSE", "DREXIT2",
+	"DRUPDATE", "IRSELECT", "IRCAPTURE", "IRSHIFT", "IREXIT1", "IRPAUSE", "IREXIT2", "IRUPDATE"
+};
+
+typedef struct {
+	const char *text;
+	long len;
+} svf_token_t;
+
+/*
+ * One of the SIR, SDR, HIR, HDR, TIR and TDR registers.  Vectors are kept
+ * least significant bit first, bit 0 is the first one shifted.
+ */
+typedef struct {
+	uint32_t bits;
+	uint8_t *tdi;
+	uint8_t *tdo;
+	uint8_t *mask;
+	int has_tdi;
+	int has_tdo;
+} svf_register_t;
+
+enum { REG_SIR, REG_SDR, REG_HIR, REG_HDR, REG_TIR, REG_TDR, REG_SCAN, REG_COUNT };
+
+struct svf_converter {
+	char *text;
+	long size;
+	long pos;
+	int line;
+	int done;
+
+	uint8_t *out;
+	long length;
+	long capacity;
+
+	double frequency;
+	int run_state;
+	int end_state;         // -1 until a RUNTEST names one, then the run_state is used
+	svf_register_t reg[REG_COUNT];  // REG_SCAN is the last SIR or SDR with its header and trailer
+
+	/* the last SIR or SDR is held back to see whether a RUNTEST follows it */
+	int pending;           // REG_SIR, REG_SDR or -1
+
+	/* what the firmware's player was told so far */
+	uint32_t xruntest;
+	uint32_t xsdrsize;
+	int xendir;
+	int xenddr;
+	uint8_t *xtdomask;
+	uint32_t xtdomask_bits;
+	int warned_trst;
+};
+
+static int svf_error(svf_converter_t *svf, const char *what)
+{
+	fprintf(stderr, " SVF line %d: %s\n", svf->line, what);
+	return -1;
+}
+
+static int svf_reserve(svf_converter_t *svf, long bytes)
+{
+	uint8_t *out;
+	long capacity = svf->capacity ? svf->capacity : 64 * 1024;
+
+	if (svf->length + bytes <= svf->capacity)
+		return 0;
+
+	while (capacity < svf->length + bytes)
+		capacity *= 2;
+	out = realloc(svf->out, capacity);
+	if (out == NULL) {
+		fprintf(stderr, " Out of memory converting SVF\n");
+		return -1;
+	}
+	svf->out = out;
+	svf->capacity = capacity;
+	return 0;
+}
+
+static int svf_put(svf_converter_t *svf, uint32_t value, int bytes)
+{
+	if (svf_reserve(svf, bytes) < 0)
+		return -1;
+
+	while (bytes-- > 0)
+		svf->out[svf->length++] = value >> (8 * bytes);
+	return 0;
+}
+
+static int svf_emit(svf_converter_t *svf, int command, uint32_t value, int bytes)
+{
+	if (svf_put(svf, command, 1) < 0)
+		return -1;
+	return svf_put(svf, value, bytes);
+}
+
+static int svf_get_bit(const uint8_t *vector, uint32_t bit)
+{
+	return (vector[bit >> 3] >> (bit & 7)) & 1;
+}
+
+/* copies bits of src into dst from bit offset on, dst starts out cleared */
+static void svf_put_bits(uint8_t *dst, uint32_t offset, const uint8_t *src, uint32_t bits)
+{
+	uint32_t i;
+
+	for (i = 0; i < bits; i++)
+		if (svf_get_bit(src, i))
+			dst[(offset + i) >> 3] |= 1 << ((offset + i) & 7);
+}
+
+/* XSVF vectors are most significant byte first, the last byte is shifted first */
+static void svf_xsvf_vector(uint8_t *dst, const uint8_t *src, uint32_t offset, uint32_t bits)
+{
+	uint32_t bytes = (bits + 7) / 8;
+	uint32_t i;
+
+	if ((offset & 7) == 0) {
+		for (i = 0; i < bytes; i++)
+			dst[bytes - 1 - i] = src[(offset >> 3) + i];
+	} else {
+		memset(dst, 0, bytes);
+		for (i = 0; i < bits; i++)
+			if (svf_get_bit(src, offset + i))
+				dst[bytes - 1 - (i >> 3)] |= 1 << (i & 7);
+	}
+	if (bits & 7)
+		dst[0] &= (1 << (bits & 7)) - 1;
+}
+
+static int svf_emit_vector(svf_converter_t *svf, const uint8_t *src, uint32_t offset, uint32_t bits)
+{
+	if (svf_reserve(svf, (bits + 7) / 8) < 0)
+		return -1;
+
+	svf_xsvf_vector(svf->out + svf->length, src, offset, bits);
+	svf->length += (bits + 7) / 8;
+	return 0;
+}
+
+/* skips blanks and ! or // comments up to the next token */
+static void svf_skip(svf_converter_t *svf)
+{
+	while (svf->pos < svf->size) {
+		char c = svf->text[svf->pos];
+
+		if (c == '!' || (c == '/' && svf->pos + 1 < svf->size && svf->text[svf->pos + 1] == '/')) {
+			while (svf->pos < svf->size && svf->text[svf->pos] != '\n')
+				svf->pos++;
+		} else if (isspace((unsigned char)c)) {
+			if (c == '\n')
+				svf->line++;
+			svf->pos++;
+		} else {
+			break;
+		}
+	}
+}
+
+/*
+ * Splits the next statement into tokens.  A (...) group is one token
+ * without its parentheses.  Returns the token count, 0 at the end of the
+ * file, -1 on errors.
+ */
+static int svf_statement(svf_converter_t *svf, svf_token_t *tokens)
+{
+	int count = 0;
+
+	for (;;) {
+		svf_token_t *tok;
+
+		svf_skip(svf);
+		if (svf->pos >= svf->size) {
+			if (count)
+				return svf_error(svf, "statement without ';' at the end of the file");
+			return 0;
+		}
+		if (svf->text[svf->pos] == ';') {
+			svf->pos++;
+			if (count)
+				return count;
+			continue;
+		}
+		if (count == SVF_MAX_TOKENS)
+			return svf_error(svf, "statement too long");
+
+		tok = &tokens[count++];
+		if (svf->text[svf->pos] == '(') {
+			tok->text = &svf->text[++svf->pos];
+			while (svf->pos < svf->size && svf->text[svf->pos] != ')') {
+				if (svf->text[svf->pos] == '\n')
+					svf->line++;
+				svf->pos++;
+			}
+			if (svf->pos >= svf->size)
+				return svf_error(svf, "missing ')'");
+			tok->len = &svf->text[svf->pos++] - tok->text;
+		} else {
+			tok->text = &svf->text[svf->pos];
+			while (svf->pos < svf->size && !isspace((unsigned char)svf->text[svf->pos])
+				   && svf->text[svf->pos] != ';' && svf->text[svf->pos] != '(')
+				svf->pos++;
+			tok->len = &svf->text[svf->pos] - tok->text;
+		}
+	}
+}
+
+static int svf_is(const svf_token_t *tok, const char *word)
+{
+	long i;
+
+	for (i = 0; i < tok->len; i++)
+		if (word[i] == 0 || toupper((unsigned char)tok->text[i]) != word[i])
+			return 0;
+	return word[i] == 0;
+}
+
+static int svf_state(const svf_token_t *tok)
+{
+	int i;
+
+	for (i = 0; i < (int)(sizeof(svf_state_names) / sizeof(svf_state_names[0])); i++)
+		if (svf_is(tok, svf_state_names[i]))
+			return i;
+	return -1;
+}
+
+static int svf_number(const svf_token_t *tok, double *value)
+{
+	char number[64];
+	char *end;
+
+	if (tok->len == 0 || tok->len >= (long)sizeof(number))
+		return -1;
+	memcpy(number, tok->text, tok->len);
+	number[tok->len] = 0;
+	*value = strtod(number, &end);
+	return (*end == 0 && *value >= 0) ? 0 : -1;
+}
+
+/* reads a hex (...) value into an LSB first vector of bits bits */
+static int svf_hex(svf_converter_t *svf, const svf_token_t *tok, uint8_t *vector, uint32_t bits)
+{
+	uint32_t nibble = 0;
+	long i;
+
+	memset(vector, 0, (bits + 7) / 8);
+	for (i = tok->len - 1; i >= 0; i--) {
+		int c = toupper((unsigned char)tok->text[i]);
+		int digit;
+
+		if (isspace(c))
+			continue;
+		if (c >= '0' && c <= '9')
+			digit = c - '0';
+		else if (c >= 'A' && c <= 'F')
+			digit = c - 'A' + 10;
+		else
+			return svf_error(svf, "bad hex digit");
+
+		//leading zeros past the register length are harmless
+		if (nibble * 4 < bits)
+			vector[nibble / 2] |= digit << (4 * (nibble & 1));
+		else if (digit)
+			return svf_error(svf, "value longer than the register");
+		nibble++;
+	}
+	if (bits & 7)
+		vector[bits / 8] &= (1 << (bits & 7)) - 1;
+	return 0;
+}
+
+static int svf_resize(svf_register_t *reg, uint32_t bits)
+{
+	uint32_t bytes = (bits + 7) / 8 + 1;
+
+	reg->tdi = realloc(reg->tdi, bytes);
+	reg->tdo = realloc(reg->tdo, bytes);
+	reg->mask = realloc(reg->mask, bytes);
+	if (reg->tdi == NULL || reg->tdo == NULL || reg->mask == NULL) {
+		fprintf(stderr, " Out of memory converting SVF\n");
+		return -1;
+	}
+	memset(reg->tdi, 0, bytes);
+	memset(reg->tdo, 0, bytes);
+	memset(reg->mask, 0, bytes);
+	reg->bits = bits;
+	return 0;
+}
+
+/*
+ * SIR, SDR, HIR, HDR, TIR or TDR: length [TDI (..)] [TDO (..)] [MASK (..)]
+ * [SMASK (..)].  TDI and MASK carry over while the length stays the same,
+ * TDO applies to this scan only.
+ */
+static int svf_register(svf_converter_t *svf, svf_register_t *reg, svf_token_t *tokens, int count)
+{
+	double length;
+	uint32_t bits;
+	int i;
+
+	if (count < 2 || svf_number(&tokens[1], &length) < 0 || length > SVF_MAX_SCAN_BITS)
+		return svf_error(svf, "bad scan length");
+	bits = (uint32_t)length;
+
+	if (bits != reg->bits || reg->tdi == NULL) {
+		if (svf_resize(reg, bits) < 0)
+			return -1;
+		memset(reg->mask, 0xFF, (bits + 7) / 8);
+		reg->has_tdi = (bits == 0);
+	}
+	reg->has_tdo = 0;
+
+	for (i = 2; i < count; i += 2) {
+		if (i + 1 >= count)
+			return svf_error(svf, "scan parameter without a value");
+		if (svf_is(&tokens[i], "TDI")) {
+			if (svf_hex(svf, &tokens[i + 1], reg->tdi, bits) < 0)
+				return -1;
+			reg->has_tdi = 1;
+		} else if (svf_is(&tokens[i], "TDO")) {
+			if (svf_hex(svf, &tokens[i + 1], reg->tdo, bits) < 0)
+				return -1;
+			reg->has_tdo = 1;
+		} else if (svf_is(&tokens[i], "MASK")) {
+			if (svf_hex(svf, &tokens[i + 1], reg->mask, bits) < 0)
+				return -1;
+		} else if (!svf_is(&tokens[i], "SMASK")) {
+			//SMASK only marks TDI bits as don't care, they get shifted anyway
+			return svf_error(svf, "unknown scan parameter");
+		}
+	}
+	if (!reg->has_tdi)
+		return svf_error(svf, "scan without TDI");
+	return 0;
+}
+
+/* joins header, data and trailer into REG_SCAN, the header goes first */
+static int svf_compose(svf_converter_t *svf, int data, int header, int trailer)
+{
+	svf_register_t *parts[3] = { &svf->reg[header], &svf->reg[data], &svf->reg[trailer] };
+	svf_register_t *scan = &svf->reg[REG_SCAN];
+	uint32_t offset = 0;
+	int i;
+
+	if (svf_resize(scan, parts[0]->bits + parts[1]->bits + parts[2]->bits) < 0)
+		return -1;
+
+	scan->has_tdo = 0;
+	for (i = 0; i < 3; i++) {
+		if (parts[i]->bits == 0)
+			continue;
+		if (parts[i]->tdi == NULL || !parts[i]->has_tdi)
+			return svf_error(svf, "header or trailer without TDI");
+		svf_put_bits(scan->tdi, offset, parts[i]->tdi, parts[i]->bits);
+		if (parts[i]->has_tdo) {
+			svf_put_bits(scan->tdo, offset, parts[i]->tdo, parts[i]->bits);
+			svf_put_bits(scan->mask, offset, parts[i]->mask, parts[i]->bits);
+			scan->has_tdo = 1;
+		}
+		offset += parts[i]->bits;
+	}
+	return 0;
+}
+
+static int svf_xsdrsize(svf_converter_t *svf, uint32_t bits)
+{
+	if (svf->xsdrsize == bits)
+		return 0;
+	svf->xsdrsize = bits;
+	return svf_emit(svf, XSDRSIZE, bits, 4);
+}
+
+static int svf_xtdomask(svf_converter_t *svf, const svf_register_t *scan)
+{
+	uint32_t bytes = (scan->bits + 7) / 8;
+	uint8_t *mask;
+
+	if (svf_reserve(svf, 1 + bytes) < 0)
+		return -1;
+
+	//build it in place, keep it only when it differs from what the player has
+	mask = svf->out + svf->length + 1;
+	svf_xsvf_vector(mask, scan->mask, 0, scan->bits);
+	if (svf->xtdomask != NULL && svf->xtdomask_bits == scan->bits && !memcmp(svf->xtdomask, mask, bytes))
+		return 0;
+
+	svf->xtdomask = realloc(svf->xtdomask, bytes + 1);
+	if (svf->xtdomask == NULL) {
+		fprintf(stderr, " Out of memory converting SVF\n");
+		return -1;
+	}
+	memcpy(svf->xtdomask, mask, bytes);
+	svf->xtdomask_bits = scan->bits;
+	svf->out[svf->length] = XTDOMASK;
+	svf->length += 1 + bytes;
+	return 0;
+}
+
+static int svf_segmented(const svf_converter_t *svf)
+{
+	return svf->pending == REG_SDR && svf->reg[REG_SCAN].bits > SVF_MAX_VECTOR_BITS;
+}
+
+/*
+ * Data registers too long for the firmware go out as XSDRB, XSDRC.. XSDRE.
+ * Those do not take a mask, so the segments also break where the mask
+ * changes: checked runs use XSDRTDOB/C/E, unchecked runs XSDRB/C/E, and the
+ * two mix freely as both stay in DRSHIFT until the E.
+ */
+static int svf_segments(svf_converter_t *svf, const svf_register_t *scan)
+{
+	uint32_t offset, bits;
+	int check, first, last;
+
+	for (offset = 0; offset < scan->bits; offset += bits) {
+		check = scan->has_tdo && svf_get_bit(scan->mask, offset);
+		for (bits = 1; offset + bits < scan->bits && bits < SVF_MAX_VECTOR_BITS; bits++)
+			if ((scan->has_tdo && svf_get_bit(scan->mask, offset + bits)) != check)
+				break;
+		first = (offset == 0);
+		last = (offset + bits == scan->bits);
+
+		if (svf_xsdrsize(svf, bits) < 0)
+			return -1;
+		if (check) {
+			if (svf_emit(svf, first ? XSDRTDOB : last ? XSDRTDOE : XSDRTDOC, 0, 0) < 0
+				|| svf_emit_vector(svf, scan->tdi, offset, bits) < 0
+				|| svf_emit_vector(svf, scan->tdo, offset, bits) < 0)
+				return -1;
+		} else {
+			if (svf_emit(svf, first ? XSDRB : last ? XSDRE : XSDRC, 0, 0) < 0
+				|| svf_emit_vector(svf, scan->tdi, offset, bits) < 0)
+				return -1;
+		}
+	}
+	return 0;
+}
+
+/* sends the held back scan, runtest is the wait in microseconds that follows it */
+static int svf_flush(svf_converter_t *svf, uint32_t runtest)
+{
+	const svf_register_t *scan = &svf->reg[REG_SCAN];
+	int pending = svf->pending;
+
+	if (pending < 0)
+		return 0;
+	svf->pending = -1;
+
+	if (pending == REG_SDR && scan->bits > SVF_MAX_VECTOR_BITS)
+		return svf_segments(svf, scan);
+
+	if (svf->xruntest != runtest) {
+		svf->xruntest = runtest;
+		if (svf_emit(svf, XRUNTEST, runtest, 4) < 0)
+			return -1;
+	}
+
+	if (pending == REG_SIR) {
+		if (scan->bits > SVF_MAX_VECTOR_BITS)
+			return svf_error(svf, "SIR longer than the firmware's vectors");
+		//TDO on SIR is not checked, the firmware's XSIR has no expected value
+		if (scan->bits <= 0xFF) {
+			if (svf_emit(svf, XSIR, scan->bits, 1) < 0)
+				return -1;
+		} else {
+			if (svf_emit(svf, XSIR2, scan->bits, 2) < 0)
+				return -1;
+		}
+		return svf_emit_vector(svf, scan->tdi, 0, scan->bits);
+	}
+
+	if (svf_xsdrsize(svf, scan->bits) < 0)
+		return -1;
+	if (!scan->has_tdo)
+		return svf_emit(svf, XSDR, 0, 0) < 0 ? -1 : svf_emit_vector(svf, scan->tdi, 0, scan->bits);
+	if (svf_xtdomask(svf, scan) < 0 || svf_emit(svf, XSDRTDO, 0, 0) < 0
+		|| svf_emit_vector(svf, scan->tdi, 0, scan->bits) < 0)
+		return -1;
+	return svf_emit_vector(svf, scan->tdo, 0, scan->bits);
+}
+
+static int svf_endxr(svf_converter_t *svf, svf_token_t *tokens, int count, int is_ir)
+{
+	int pause = is_ir ? STATE_IRPAUSE : STATE_DRPAUSE;
+	int state;
+
+	if (count != 2 || ((state = svf_state(&tokens[1])) != STATE_IDLE && state != pause))
+		return svf_error(svf, "the firmware only ends scans in IDLE or PAUSE");
+	state = (state == pause);
+
+	if (is_ir && svf->xendir != state) {
+		svf->xendir = state;
+		return svf_emit(svf, XENDIR, state, 1);
+	}
+	if (!is_ir && svf->xenddr != state) {
+		svf->xenddr = state;
+		return svf_emit(svf, XENDDR, state, 1);
+	}
+	return 0;
+}
+
+/*
+ * RUNTEST [run_state] [run_count TCK|SCK] [min_time SEC [MAXIMUM max_time SEC]]
+ * [ENDSTATE end_state].  Right after a scan that ends in IDLE it becomes the
+ * scan's XRUNTEST, elsewhere an XWAIT.
+ */
+static int svf_runtest(svf_converter_t *svf, svf_token_t *tokens, int count)
+{
+	double usecs = 0, value, frequency;
+	uint32_t wait;
+	int i = 1;
+	int state;
+
+	if (i < count && (state = svf_state(&tokens[i])) >= 0) {
+		svf->run_state = state;
+		i++;
+	}
+	while (i < count) {
+		if (svf_is(&tokens[i], "ENDSTATE") && i + 1 < count && (state = svf_state(&tokens[i + 1])) >= 0) {
+			svf->end_state = state;
+			i += 2;
+		} else if (svf_is(&tokens[i], "MAXIMUM") && i + 2 < count) {
+			i += 3;  //the firmware cannot time out a wait
+		} else if (svf_number(&tokens[i], &value) == 0 && i + 1 < count) {
+			if (svf_is(&tokens[i + 1], "SEC")) {
+				value *= 1e6;
+			} else if (svf_is(&tokens[i + 1], "TCK") || svf_is(&tokens[i + 1], "SCK")) {
+				frequency = svf->frequency > 0 ? svf->frequency : SVF_DEFAULT_FREQ;
+				value = value * 1e6 / frequency;
+			} else {
+				return svf_error(svf, "RUNTEST needs TCK, SCK or SEC");
+			}
+			if (value > usecs)
+				usecs = value;
+			i += 2;
+		} else {
+			return svf_error(svf, "bad RUNTEST");
+		}
+	}
+	if (usecs > 0xFFFFFFFFu)
+		return svf_error(svf, "RUNTEST too long");
+	wait = (uint32_t)usecs;
+	if (wait < usecs)
+		wait++;
+
+	state = svf->end_state >= 0 ? svf->end_state : svf->run_state;
+	if (svf->pending >= 0 && !svf_segmented(svf) && svf->run_state == STATE_IDLE
+		&& (svf->pending == REG_SIR ? svf->xendir : svf->xenddr) == 0) {
+		if (svf_flush(svf, wait) < 0)
+			return -1;
+		return state == STATE_IDLE ? 0 : svf_emit(svf, XSTATE, state, 1);
+	}
+
+	if (svf_flush(svf, 0) < 0 || svf_emit(svf, XWAIT, (svf->run_state << 8) | state, 2) < 0)
+		return -1;
+	return svf_put(svf, wait, 4);
+}
+
+/* STATE [path..] stable_state, the firmware finds its own way between stable states */
+static int svf_goto(svf_converter_t *svf, svf_token_t *tokens, int count)
+{
+	int i, state;
+
+	if (count < 2)
+		return svf_error(svf, "STATE without a state");
+	for (i = 1; i < count; i++) {
+		if ((state = svf_state(&tokens[i])) < 0)
+			return svf_error(svf, "unknown TAP state");
+		if (i == count - 1 && state != STATE_RESET && state != STATE_IDLE
+			&& state != STATE_DRPAUSE && state != STATE_IRPAUSE)
+			return svf_error(svf, "STATE must end in a stable state");
+	}
+	return svf_emit(svf, XSTATE, state, 1);
+}
+
+/* turns the next statement into XSVF, returns 0 at the end of the file */
+static int svf_next(svf_converter_t *svf)
+{
+	svf_token_t tokens[SVF_MAX_TOKENS];
+	double value;
+	int count;
+
+	count = svf_statement(svf, tokens);
+	if (count <= 0)
+		return count;
+
+	//a scan waits for the next statement, only a RUNTEST may join it
+	if (svf_is(&tokens[0], "RUNTEST"))
+		return svf_runtest(svf, tokens, count) < 0 ? -1 : 1;
+	if (svf_flush(svf, 0) < 0)
+		return -1;
+
+	if (svf_is(&tokens[0], "SIR") || svf_is(&tokens[0], "SDR")) {
+		int data = svf_is(&tokens[0], "SIR") ? REG_SIR : REG_SDR;
+
+		if (svf_register(svf, &svf->reg[data], tokens, count) < 0
+			|| svf_compose(svf, data, data == REG_SIR ? REG_HIR : REG_HDR, data == REG_SIR ? REG_TIR : REG_TDR) < 0)
+			return -1;
+		svf->pending = data;
+	} else if (svf_is(&tokens[0], "HIR")) {
+		return svf_register(svf, &svf->reg[REG_HIR], tokens, count) < 0 ? -1 : 1;
+	} else if (svf_is(&tokens[0], "HDR")) {
+		return svf_register(svf, &svf->reg[REG_HDR], tokens, count) < 0 ? -1 : 1;
+	} else if (svf_is(&tokens[0], "TIR")) {
+		return svf_register(svf, &svf->reg[REG_TIR], tokens, count) < 0 ? -1 : 1;
+	} else if (svf_is(&tokens[0], "TDR")) {
+		return svf_register(svf, &svf->reg[REG_TDR], tokens, count) < 0 ? -1 : 1;
+	} else if (svf_is(&tokens[0], "ENDIR") || svf_is(&tokens[0], "ENDDR")) {
+		return svf_endxr(svf, tokens, count, svf_is(&tokens[0], "ENDIR")) < 0 ? -1 : 1;
+	} else if (svf_is(&tokens[0], "STATE")) {
+		return svf_goto(svf, tokens, count) < 0 ? -1 : 1;
+	} else if (svf_is(&tokens[0], "FREQUENCY")) {
+		//no value means full speed, the Bus Pirate has only the one anyway
+		svf->frequency = 0;
+		if (count >= 2 && svf_number(&tokens[1], &value) == 0)
+			svf->frequency = value;
+	} else if (svf_is(&tokens[0], "TRST")) {
+		//the Bus Pirate has no TRST pin
+		if (!svf->warned_trst && !(count == 2 && svf_is(&tokens[1], "ABSENT"))) {
+			fprintf(stderr, " SVF line %d: TRST ignored\n", svf->line);
+			svf->warned_trst = 1;
+		}
+	} else {
+		return svf_error(svf, "unsupported statement");
+	}
+	return 1;
+}
+
+/* loads the SVF text, nothing is converted until svf_convert() */
+svf_converter_t *svf_open(const char *path)
+{
+	svf_converter_t *svf;
+	FILE *file;
+	long size;
+
+	file = fopen(path, "rb");
+	if (file == NULL) {
+		fprintf(stderr, " Error opening SVF file %s\n", path);
+		return NULL;
+	}
+	fseek(file, 0, SEEK_END);
+	size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	svf = calloc(1, sizeof(*svf));
+	if (svf == NULL || size < 0 || (svf->text = malloc(size + 1)) == NULL
+		|| (long)fread(svf->text, 1, size, file) != size) {
+		fprintf(stderr, " Error reading SVF file %s\n", path);
+		fclose(file);
+		svf_close(svf);
+		return NULL;
+	}
+	fclose(file);
+
+	svf->size = size;
+	svf->line = 1;
+	svf->run_state = STATE_IDLE;
+	svf->end_state = -1;
+	svf->pending = -1;
+
+	if (svf_emit(svf, XREPEAT, SVF_XREPEAT, 1) < 0) {
+		svf_close(svf);
+		return NULL;
+	}
+	return svf;
+}
+
+/*
+ * Converts until at least want bytes of XSVF are ready or the SVF ends, which
+ * adds the XCOMPLETE.  Returns 0, or -1 after printing the error.
+ */
+int svf_convert(svf_converter_t *svf, long want)
+{
+	int res;
+
+	while (!svf->done && svf->length < want) {
+		res = svf_next(svf);
+		if (res < 0)
+			return -1;
+		if (res == 0) {
+			if (svf_flush(svf, 0) < 0 || svf_emit(svf, XCOMPLETE, 0, 0) < 0)
+				return -1;
+			svf->done = 1;
+		}
+	}
+	return 0;
+}
+
+int svf_done(const svf_converter_t *svf)
+{
+	return svf->done;
+}
+
+/* the XSVF made so far, it moves as more is converted */
+uint8_t *svf_xsvf(const svf_converter_t *svf, long *length)
+{
+	*length = svf->length;
+	return svf->out;
+}
+
+void svf_close(svf_converter_t *svf)
+{
+	int i;
+
+	if (svf == NULL)
+		return;
+	for (i = 0; i < REG_COUNT; i++) {
+		free(svf->reg[i].tdi);
+		free(svf->reg[i].tdo);
+		free(svf->reg[i].mask);
+	}
+	free(svf->xtdomask);
+	free(svf->out);
+	free(svf->text);
+	free(svf);
+}
@@ -0,0 +1,43 @@
+/*
+ * This file is part of the Bus Pirate project (http://code.google.com/p/the-bus-pirate/).
+ *
+ * Written and maintained by the Bus Pirate project and http://dangerousprototypes.com
+ *
+ * To the extent possible under law, the project has
+ * waived all copyright and related or neighboring rights to Bus Pirate. This
+ * work is published from United States.
+ *
+ * For details see: http://creativecommons.org/publicdomain/zero/1.0/.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ */
+/*
+ * SVF to XSVF conversion
+ *
+ * Replaces the separate SVF2XSVF step: the SVF text is parsed a statement at
+ * a time and turned into the XSVF the firmware's player (XAPP058 v5.01)
+ * understands, so conversion can run ahead of the transfer.
+ *
+ * Covered: SIR, SDR, HIR, HDR, TIR, TDR, RUNTEST, STATE, ENDIR, ENDDR and
+ * FREQUENCY.  TRST is ignored, PIO and PIOMAP are refused.  A RUNTEST right
+ * after a scan becomes the XRUNTEST of that scan, so XC9500 retries work;
+ * any other RUNTEST becomes an XWAIT.  Data registers longer than the
+ * firmware's vector buffer are split into XSDRB/C/E segments.
+ *
+ */
+#ifndef SVF_H_
+#define SVF_H_
+
+#include <stdint.h>
+
+typedef struct svf_converter svf_converter_t;
+
+svf_converter_t *svf_open(const char *path);
+int svf_convert(svf_converter_t *svf, long want);
+int svf_done(const svf_converter_t *svf);
+uint8_t *svf_xsvf(const svf_converter_t *svf, long *length);
+void svf_close(svf_converter_t *svf);
+
+#endif
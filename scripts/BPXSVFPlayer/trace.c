@@ -0,0 +1,189 @@
+/*
+ * This file is part of the Bus Pirate project (http://code.google.com/p/the-bus-pirate/).
+ *
+ * Written and maintained by the Bus Pirate project and http://dangerousprototypes.com
+ *
+ * To the extent possible under law, the project has
+ * waived all copyright and related or neighboring rights to Bus Pirate. This
+ * work is published from United States.
+ *
+ * For details see: http://creativecommons.org/publicdomain/zero/1.0/.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#endif
+
+#include "serial.h"
+#include "trace.h"
+
+#define XSVF_PLAYER_COMMAND 0x03
+#define XSVF_REQUEST        0xFF
+#define XSVF_DONE           0x00
+#define TRACE_MAX_CHUNK     4096
+
+typedef struct {
+	long bytes;
+	long device_us;
+} trace_entry_t;
+
+double trace_now(void)
+{
+#ifdef WIN32
+	return GetTickCount() / 1000.0;
+#else
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + (now.tv_nsec / 1e9);
+#endif
+}
+
+#ifndef WIN32
+static int trace_load(const char *path, trace_entry_t **entries)
+{
+	FILE *fp = fopen(path, "r");
+	trace_entry_t *list = NULL;
+	trace_entry_t entry;
+	int count = 0;
+	int capacity = 0;
+
+	if (fp == NULL)
+		return -1;
+
+	while (fscanf(fp, "%ld %ld", &entry.bytes, &entry.device_us) == 2) {
+		if (count == capacity) {
+			capacity = capacity ? capacity * 2 : 256;
+			list = realloc(list, capacity * sizeof(trace_entry_t));
+			if (list == NULL) {
+				fclose(fp);
+				return -1;
+			}
+		}
+		list[count++] = entry;
+	}
+
+	fclose(fp);
+	*entries = list;
+	return count;
+}
+
+static void trace_sleep_us(long us)
+{
+	struct timespec ts;
+
+	if (us <= 0)
+		return;
+
+	ts.tv_sec = us / 1000000;
+	ts.tv_nsec = (us % 1000000) * 1000;
+	nanosleep(&ts, NULL);
+}
+
+/* the firmware side of the replay, never returns */
+static void trace_replay(int fd, trace_entry_t *entries, int count, long file_size)
+{
+	uint8_t chunk[TRACE_MAX_CHUNK];
+	uint8_t reply;
+	long received = 0;
+	long length;
+	long us;
+	double rate = 0;
+	int i;
+
+	if (serial_read_timeout(fd, (char *)chunk, 1, 1, SERIAL_READ_TIMEOUT_MS) != 1 || chunk[0] != XSVF_PLAYER_COMMAND)
+		_exit(1);
+
+	trace_sleep_us(entries[0].device_us);
+
+	for (i = 1; ; i++) {
+		reply = XSVF_REQUEST;
+		serial_write(fd, (char *)&reply, 1);
+
+		if (serial_read(fd, (char *)chunk, 2) != 2)
+			_exit(1);
+
+		length = (chunk[0] << 8) | chunk[1];
+		if (length > TRACE_MAX_CHUNK || serial_read(fd, (char *)chunk, length) != length)
+			_exit(1);
+
+		received += length;
+
+		//scale by bytes, the chunks need not match the recorded ones
+		if (i < count && entries[i].bytes > 0)
+			rate = (double)entries[i].device_us / entries[i].bytes;
+
+		us = (long)(rate * length);
+		trace_sleep_us(us);
+
+		if (received >= file_size)
+			break;
+	}
+
+	reply = XSVF_DONE;
+	serial_write(fd, (char *)&reply, 1);
+	_exit(0);
+}
+#endif
+
+/* returns the player's end of the replay link, or -1 */
+int trace_replay_start(const char *path, long file_size)
+{
+#ifdef WIN32
+	fprintf(stderr, " Trace replay needs a POSIX system\n");
+	return -1;
+#else
+	trace_entry_t *entries = NULL;
+	int count;
+	int fds[2];
+
+	count = trace_load(path, &entries);
+	if (count <= 0) {
+		fprintf(stderr, " Could not read trace %s\n", path);
+		return -1;
+	}
+
+	if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) < 0) {
+		perror("socketpair");
+		free(entries);
+		return -1;
+	}
+
+	//both ends go through serial_read_timeout, which waits in poll()
+	fcntl(fds[0], F_SETFL, O_NONBLOCK);
+	fcntl(fds[1], F_SETFL, O_NONBLOCK);
+
+	switch (fork()) {
+		case -1:
+			perror("fork");
+			close(fds[0]);
+			close(fds[1]);
+			free(entries);
+			return -1;
+		case 0:
+			close(fds[0]);
+			trace_replay(fds[1], entries, count, file_size);
+			break;
+		default:
+			break;
+	}
+
+	close(fds[1]);
+	free(entries);
+	return fds[0];
+#endif
+}
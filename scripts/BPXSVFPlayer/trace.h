@@ -0,0 +1,34 @@
+/*
+ * This file is part of the Bus Pirate project (http://code.google.com/p/the-bus-pirate/).
+ *
+ * Written and maintained by the Bus Pirate project and http://dangerousprototypes.com
+ *
+ * To the extent possible under law, the project has
+ * waived all copyright and related or neighboring rights to Bus Pirate. This
+ * work is published from United States.
+ *
+ * For details see: http://creativecommons.org/publicdomain/zero/1.0/.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ */
+/*
+ * Firmware request traces
+ *
+ * A trace is a text file with one line per reply of the firmware's XSVF
+ * player: the size of the chunk it had just been sent (0 for the first
+ * request) and how many microseconds passed between that chunk going out
+ * and the reply coming back.  -t records one during a real run, -b replays
+ * it: a child process stands in for the Bus Pirate on a socket, taking the
+ * recorded time per byte for every chunk, so host side changes can be
+ * timed without hardware.
+ *
+ */
+#ifndef TRACE_H_
+#define TRACE_H_
+
+double trace_now(void);
+int trace_replay_start(const char *path, long file_size);
+
+#endif
@@ -0,0 +1,128 @@
+/*
+ * This file is part of the Bus Pirate project (http://code.google.com/p/the-bus-pirate/).
+ *
+ * Written and maintained by the Bus Pirate project and http://dangerousprototypes.com
+ *
+ * To the extent possible under law, the project has
+ * waived all copyright and related or neighboring rights to Bus Pirate. This
+ * work is published from United States.
+ *
+ * For details see: http://creativecommons.org/publicdomain/zero/1.0/.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include <string.h>
+
+#include "xsvf.h"
+
+static uint32_t xsvf_get(const uint8_t *buf, int bytes)
+{
+	uint32_t value = 0;
+	int i;
+
+	for (i = 0; i < bytes; i++)
+		value = (value << 8) | buf[i];
+
+	return value;
+}
+
+/*
+ * Fills stats from the commands in buf.  Returns 0 when the whole stream was
+ * understood, -1 when it stops at a truncated or unsupported command, in
+ * which case stats covers the commands before it.
+ */
+int xsvf_scan(const uint8_t *buf, long size, xsvf_stats_t *stats)
+{
+	long pos = 0;
+	long need;
+	uint32_t sdr_bits = 0;
+	uint32_t sdr_bytes = 0;
+	uint32_t ir_bits;
+	const uint8_t *end;
+
+	memset(stats, 0, sizeof(*stats));
+
+	while (pos < size) {
+		const uint8_t *cmd = buf + pos + 1;
+		long left = size - pos - 1;
+
+		switch (buf[pos]) {
+			case XCOMPLETE:
+				stats->commands++;
+				stats->complete = 1;
+				return 0;
+			case XTDOMASK:
+			case XSDRB:
+			case XSDRC:
+			case XSDRE:
+				need = sdr_bytes;
+				break;
+			case XSDR:
+				need = sdr_bytes;
+				stats->shift_tcks += sdr_bits;
+				break;
+			case XSDRTDO:
+			case XSDRTDOB:
+			case XSDRTDOC:
+			case XSDRTDOE:
+			case XSETSDRMASKS:
+				need = 2 * sdr_bytes;
+				if (buf[pos] != XSETSDRMASKS)
+					stats->shift_tcks += sdr_bits;
+				break;
+			case XSIR:
+				if (left < 1)
+					return -1;
+				ir_bits = cmd[0];
+				need = 1 + ((ir_bits + 7) / 8);
+				stats->shift_tcks += ir_bits;
+				break;
+			case XSIR2:
+				if (left < 2)
+					return -1;
+				ir_bits = xsvf_get(cmd, 2);
+				need = 2 + ((ir_bits + 7) / 8);
+				stats->shift_tcks += ir_bits;
+				break;
+			case XRUNTEST:
+				need = 4;
+				break;
+			case XSDRSIZE:
+				if (left < 4)
+					return -1;
+				sdr_bits = xsvf_get(cmd, 4);
+				sdr_bytes = (sdr_bits + 7) / 8;
+				need = 4;
+				break;
+			case XREPEAT:
+			case XSTATE:
+			case XENDIR:
+			case XENDDR:
+				need = 1;
+				break;
+			case XWAIT:
+				need = 1 + 1 + 4;
+				break;
+			case XCOMMENT:
+				end = memchr(cmd, 0, left);
+				if (!end)
+					return -1;
+				need = (end - cmd) + 1;
+				break;
+			default:
+				//XSDRINC payloads depend on the mask bits, not worth following
+				return -1;
+		}
+
+		if (need > left)
+			return -1;
+
+		stats->commands++;
+		pos += 1 + need;
+	}
+
+	return 0;
+}
@@ -0,0 +1,60 @@
+/*
+ * This file is part of the Bus Pirate project (http://code.google.com/p/the-bus-pirate/).
+ *
+ * Written and maintained by the Bus Pirate project and http://dangerousprototypes.com
+ *
+ * To the extent possible under law, the project has
+ * waived all copyright and related or neighboring rights to Bus Pirate. This
+ * work is published from United States.
+ *
+ * For details see: http://creativecommons.org/publicdomain/zero/1.0/.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ */
+/*
+ * XSVF stream helpers
+ *
+ * Command codes, and a walk over an XSVF file the way the firmware's player
+ * (XAPP058) does it, without touching any hardware, to size up the work in it.
+ *
+ */
+#ifndef XSVF_H_
+#define XSVF_H_
+
+#include <stdint.h>
+
+/* XSVF commands, see Xilinx XAPP503 */
+#define XCOMPLETE    0x00
+#define XTDOMASK     0x01
+#define XSIR         0x02
+#define XSDR         0x03
+#define XRUNTEST     0x04
+#define XREPEAT      0x07
+#define XSDRSIZE     0x08
+#define XSDRTDO      0x09
+#define XSETSDRMASKS 0x0A
+#define XSDRINC      0x0B
+#define XSDRB        0x0C
+#define XSDRC        0x0D
+#define XSDRE        0x0E
+#define XSDRTDOB     0x0F
+#define XSDRTDOC     0x10
+#define XSDRTDOE     0x11
+#define XSTATE       0x12
+#define XENDIR       0x13
+#define XENDDR       0x14
+#define XSIR2        0x15
+#define XCOMMENT     0x16
+#define XWAIT        0x17
+
+typedef struct {
+	unsigned long commands;
+	unsigned long long shift_tcks;  // TCK cycles spent shifting IR and DR bits
+	int complete;                   // 1 when XCOMPLETE was reached
+} xsvf_stats_t;
+
+int xsvf_scan(const uint8_t *buf, long size, xsvf_stats_t *stats);
+
+#endif
@@ -0,0 +1,647 @@
+/*
+ * This file is part of the Bus Pirate project (http://code.google.com/p/the-bus-pirate/).
+ *
+ * Written and maintained by the Bus Pirate project and http://dangerousprototypes.com
+ *
+ * To the extent possible under law, the project has
+ * waived all copyright and related or neighboring rights to Bus Pirate. This
+ * work is published from United States.
+ *
+ * For details see: http://creativecommons.org/publicdomain/zero/1.0/.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ */
+/*
+ * Binary mode emulator on a pseudo terminal
+ *
+ * Answers the binary mode commands the way Firmware/binary_io.c and the
+ * protocol handlers do, with a 25 series flash on SPI, a 24 series EEPROM
+ * at 0xA0 on I2C and two devices on 1-Wire.  Every block read from the pty
+ * waits -L microseconds before it is answered, like the USB serial latency
+ * a real Bus Pirate adds, so round trips cost what they cost on hardware.
+ *
+ * Usage: bbio-emulator [-L latency_us] [-l link] [-v]
+ *
+ */
+
+#define _XOPEN_SOURCE 600
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <termios.h>
+
+#define FLASH_SIZE  (1024 * 1024)
+#define EEPROM_SIZE 256
+#define EEPROM_ADDR 0xA0
+#define BUF_SIZE    (64 * 1024)
+
+enum { MODE_TERMINAL = -1, MODE_BBIO, MODE_SPI, MODE_I2C, MODE_UART, MODE_1WIRE, MODE_RAW };
+
+static const char *mode_id[] = { "BBIO1", "SPI1", "I2C1", "ART1", "1W01", "RAW1" };
+
+static const uint8_t onewire_ids[2][8] = {
+	{ 0x28, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x8A },
+	{ 0x10, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0x01, 0x2F },
+};
+
+static int mode = MODE_TERMINAL;
+static int zeros;            // 0x00s in a row in the terminal
+static int sniffing;
+static int bridge;
+static int raw_3wire;
+static int verbose;
+
+static uint8_t out[BUF_SIZE * 4];
+static int out_len;
+
+/* the flash, contents are a function of the address */
+static int flash_state;      // bytes into the command since CS went low
+static uint8_t flash_cmd;
+static uint32_t flash_addr;
+
+/* the EEPROM */
+static uint8_t eeprom[EEPROM_SIZE];
+static uint8_t eeprom_ptr;
+static int i2c_state;        // 0 idle, 1 address next, 2 pointer next, 3 data
+static int i2c_read;
+
+static uint8_t flash_byte(uint32_t addr)
+{
+	return (uint8_t)((addr * 7) ^ (addr >> 8));
+}
+
+static void put(uint8_t c)
+{
+	out[out_len++] = c;
+}
+
+static void put_str(const char *s)
+{
+	while (*s)
+		put(*s++);
+}
+
+static void flash_cs(int high)
+{
+	(void)high;
+	flash_state = 0;
+}
+
+static uint8_t flash_xfer(uint8_t mosi)
+{
+	int state = flash_state++;
+
+	if (state == 0) {
+		flash_cmd = mosi;
+		flash_addr = 0;
+		return 0xFF;
+	}
+
+	switch (flash_cmd) {
+		case 0x03:
+			if (state <= 3) {
+				flash_addr = (flash_addr << 8) | mosi;
+				return 0xFF;
+			}
+			return flash_byte(flash_addr++ % FLASH_SIZE);
+		case 0x9F:
+			return (state == 1) ? 0xEF : (state == 2) ? 0x40 : (state == 3) ? 0x14 : 0xFF;
+		case 0x05:
+			return 0x00;
+		default:
+			return 0xFF;
+	}
+}
+
+/* 0x00 ACK, 0x01 NACK, like the firmware reports them */
+static uint8_t i2c_write(uint8_t value)
+{
+	switch (i2c_state) {
+		case 1:
+			if ((value & 0xFE) != EEPROM_ADDR) {
+				i2c_state = 0;
+				return 0x01;
+			}
+			i2c_read = value & 0x01;
+			i2c_state = i2c_read ? 3 : 2;
+			return 0x00;
+		case 2:
+			eeprom_ptr = value;
+			i2c_state = 3;
+			return 0x00;
+		case 3:
+			if (i2c_read)
+				return 0x01;
+			eeprom[eeprom_ptr++] = value;
+			return 0x00;
+		default:
+			return 0x01;
+	}
+}
+
+static uint8_t i2c_read_byte(void)
+{
+	if (i2c_state == 3 && i2c_read)
+		return eeprom[eeprom_ptr++];
+	return 0xFF;
+}
+
+static uint16_t be16(const uint8_t *p)
+{
+	return (p[0] << 8) | p[1];
+}
+
+/* commands every protocol mode shares; 1 if handled */
+static int common_command(uint8_t c)
+{
+	if (c == 0x00) {
+		mode = MODE_BBIO;
+		put_str(mode_id[MODE_BBIO]);
+		return 1;
+	}
+	if (c == 0x01) {
+		put_str(mode_id[mode]);
+		return 1;
+	}
+	if ((c & 0xF0) == 0x40) {
+		put(0x01);
+		return 1;
+	}
+	return 0;
+}
+
+static int spi_command(const uint8_t *in, int avail)
+{
+	uint8_t c = in[0];
+	int n, i, wlen, rlen;
+
+	if (common_command(c))
+		return 1;
+
+	switch (c >> 4) {
+		case 0x0:
+			switch (c) {
+				case 0x02:
+				case 0x03:
+					flash_cs(c & 0x01);
+					put(0x01);
+					return 1;
+				case 0x04:
+				case 0x05:
+					if (avail < 5)
+						return 0;
+					wlen = be16(in + 1);
+					rlen = be16(in + 3);
+					if (wlen > 4096 || rlen > 4096 || (wlen == 0 && rlen == 0)) {
+						put(0x00);
+						return 5;
+					}
+					if (avail < 5 + wlen)
+						return 0;
+					if (c == 0x04)
+						flash_cs(0);
+					for (i = 0; i < wlen; i++)
+						flash_xfer(in[5 + i]);
+					if (rlen > 0) {
+						put(0x01);
+						for (i = 0; i < rlen; i++)
+							put(flash_xfer(0xFF));
+					}
+					if (c == 0x04)
+						flash_cs(1);
+					return 5 + wlen;
+				case 0x0E:
+				case 0x0F:
+					put(0x01);
+					put_str("[\\\x9F\xFF\\\xFF\xEF\\\xFF\x40\\\xFF\x14]");
+					sniffing = 1;
+					return 1;
+			}
+			break;
+		case 0x1:
+			n = (c & 0x0F) + 1;
+			if (avail < 1 + n)
+				return 0;
+			put(0x01);
+			for (i = 0; i < n; i++)
+				put(flash_xfer(in[1 + i]));
+			return 1 + n;
+		case 0x6:
+			put((c & 0x0F) < 8 ? 0x01 : 0x00);
+			return 1;
+		case 0x8:
+			put(0x01);
+			return 1;
+	}
+
+	put(0x00);
+	return 1;
+}
+
+static int i2c_command(const uint8_t *in, int avail)
+{
+	uint8_t c = in[0];
+	int n, i, wlen, rlen, ok;
+
+	if (common_command(c))
+		return 1;
+
+	switch (c) {
+		case 0x02:
+			i2c_state = 1;
+			put(0x01);
+			return 1;
+		case 0x03:
+			i2c_state = 0;
+			put(0x01);
+			return 1;
+		case 0x04:
+			put(i2c_read_byte());
+			return 1;
+		case 0x06:
+		case 0x07:
+			put(0x01);
+			return 1;
+		case 0x08:
+			if (avail < 5)
+				return 0;
+			wlen = be16(in + 1);
+			rlen = be16(in + 3);
+			if (avail < 5 + wlen)
+				return 0;
+			i2c_state = 1;
+			ok = (wlen > 0);
+			for (i = 0; i < wlen && ok; i++)
+				ok = (i2c_write(in[5 + i]) == 0x00);
+			if (ok && rlen > 0 && wlen > 1) {
+				i2c_state = 1;
+				ok = (i2c_write(in[5] | 0x01) == 0x00);
+			}
+			if (!ok) {
+				put(0x00);
+			} else {
+				put(0x01);
+				for (i = 0; i < rlen; i++)
+					put(i2c_read_byte());
+			}
+			i2c_state = 0;
+			return 5 + wlen;
+	}
+
+	switch (c >> 4) {
+		case 0x1:
+			n = (c & 0x0F) + 1;
+			if (avail < 1 + n)
+				return 0;
+			put(0x01);
+			for (i = 0; i < n; i++)
+				put(i2c_write(in[1 + i]));
+			return 1 + n;
+		case 0x6:
+			put((c & 0x0F) < 4 ? 0x01 : 0x00);
+			return 1;
+	}
+
+	put(0x00);
+	return 1;
+}
+
+static int uart_command(const uint8_t *in, int avail)
+{
+	uint8_t c = in[0];
+	int n, i;
+
+	if (common_command(c))
+		return 1;
+
+	switch (c) {
+		case 0x02:
+		case 0x03:
+			put(0x01);
+			return 1;
+		case 0x07:
+			if (avail < 3)
+				return 0;
+			put(0x01);
+			put(0x01);
+			put(0x01);
+			return 3;
+		case 0x0F:
+			put(0x01);
+			bridge = 1;
+			return 1;
+	}
+
+	switch (c >> 4) {
+		case 0x1:
+			n = (c & 0x0F) + 1;
+			if (avail < 1 + n)
+				return 0;
+			put(0x01);
+			for (i = 0; i < n; i++)
+				put(0x01);
+			return 1 + n;
+		case 0x6:
+		case 0x8:
+		case 0x9:
+			put(0x01);
+			return 1;
+	}
+
+	put(0x00);
+	return 1;
+}
+
+static int onewire_command(const uint8_t *in, int avail)
+{
+	uint8_t c = in[0];
+	int n, i;
+
+	if (common_command(c))
+		return 1;
+
+	switch (c) {
+		case 0x02:
+			put(0x01);
+			return 1;
+		case 0x04:
+			put(0xA5);
+			return 1;
+		case 0x08:
+		case 0x09:
+			put(0x01);
+			if (c == 0x08) {
+				for (i = 0; i < 8; i++)
+					put(onewire_ids[0][i]);
+				for (i = 0; i < 8; i++)
+					put(onewire_ids[1][i]);
+			}
+			for (i = 0; i < 8; i++)
+				put(0xFF);
+			return 1;
+	}
+
+	switch (c >> 4) {
+		case 0x1:
+			n = (c & 0x0F) + 1;
+			if (avail < 1 + n)
+				return 0;
+			put(0x01);
+			for (i = 0; i < n; i++)
+				put(0x01);
+			return 1 + n;
+		case 0x2:
+			put(0x01);
+			return 1;
+	}
+
+	put(0x00);
+	return 1;
+}
+
+static int raw_command(const uint8_t *in, int avail)
+{
+	uint8_t c = in[0];
+	int n, i;
+
+	if (common_command(c))
+		return 1;
+
+	switch (c) {
+		case 0x02:
+		case 0x03:
+		case 0x04:
+		case 0x05:
+		case 0x09:
+		case 0x0A:
+		case 0x0B:
+		case 0x0C:
+		case 0x0D:
+			put(0x01);
+			return 1;
+		case 0x06:
+			put(0x5A);
+			return 1;
+		case 0x07:
+			put(0x01);
+			return 1;
+		case 0x08:
+			put(0x00);
+			return 1;
+	}
+
+	switch (c >> 4) {
+		case 0x1:
+			n = (c & 0x0F) + 1;
+			if (avail < 1 + n)
+				return 0;
+			put(0x01);
+			//the 3-wire firmware does not acknowledge each byte
+			for (i = 0; i < n && !raw_3wire; i++)
+				put(0x01);
+			return 1 + n;
+		case 0x2:
+			put(0x01);
+			return 1;
+		case 0x3:
+			if (avail < 2)
+				return 0;
+			put(0x01);
+			put(0x01);
+			return 2;
+		case 0x6:
+			put((c & 0x0F) < 4 ? 0x01 : 0x00);
+			return 1;
+		case 0x8:
+			raw_3wire = (c & 0x04) != 0;
+			put(0x01);
+			return 1;
+	}
+
+	put(0x00);
+	return 1;
+}
+
+static int bbio_command(uint8_t c)
+{
+	if (c == 0x00) {
+		put_str(mode_id[MODE_BBIO]);
+	} else if (c >= 0x01 && c <= 0x05) {
+		mode = c;
+		raw_3wire = 0;
+		i2c_state = 0;
+		flash_cs(1);
+		put_str(mode_id[mode]);
+	} else if (c == 0x0F) {
+		mode = MODE_TERMINAL;
+		zeros = 0;
+		put(0x01);
+	} else if (c == 0x14) {
+		put(0x02);      //ADC, 678 is 13V behind the HVP adapter's divider
+		put(0xA6);
+	} else if (c & 0x80) {
+		put(c & 0x1F);  //pin states
+	} else if ((c & 0xE0) == 0x40) {
+		put(c & 0x1F);  //pin directions
+	} else {
+		put(0x00);
+	}
+	return 1;
+}
+
+/* one command from in, 0 if it is not all there yet */
+static int command(const uint8_t *in, int avail)
+{
+	if (bridge) {
+		put(in[0]);  //loop the UART back
+		return 1;
+	}
+
+	if (sniffing) {
+		//a byte from the host stops the sniffer
+		sniffing = 0;
+		return 1;
+	}
+
+	switch (mode) {
+		case MODE_TERMINAL:
+			if (in[0] == 0x00) {
+				if (++zeros == 20) {
+					mode = MODE_BBIO;
+					put_str(mode_id[MODE_BBIO]);
+				}
+			} else {
+				zeros = 0;
+			}
+			return 1;
+		case MODE_BBIO:
+			return bbio_command(in[0]);
+		case MODE_SPI:
+			return spi_command(in, avail);
+		case MODE_I2C:
+			return i2c_command(in, avail);
+		case MODE_UART:
+			return uart_command(in, avail);
+		case MODE_1WIRE:
+			return onewire_command(in, avail);
+		case MODE_RAW:
+		default:
+			return raw_command(in, avail);
+	}
+}
+
+static int write_all(int fd, const uint8_t *buf, int size)
+{
+	int res;
+
+	while (size > 0) {
+		res = write(fd, buf, size);
+		if (res < 0 && errno == EINTR)
+			continue;
+		if (res <= 0)
+			return -1;
+		buf += res;
+		size -= res;
+	}
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	static uint8_t in[BUF_SIZE];
+	struct termios t_opt;
+	char *link_path = NULL;
+	long latency_us = 1000;
+	int master, slave, opt, len = 0, used, res, i;
+	const char *name;
+
+	while ((opt = getopt(argc, argv, "L:l:v")) != -1) {
+		switch (opt) {
+			case 'L':
+				latency_us = atol(optarg);
+				break;
+			case 'l':
+				link_path = optarg;
+				break;
+			case 'v':
+				verbose = 1;
+				break;
+			default:
+				fprintf(stderr, "Usage: %s [-L latency_us] [-l link] [-v]\n", argv[0]);
+				return 1;
+		}
+	}
+
+	master = posix_openpt(O_RDWR | O_NOCTTY);
+	if (master < 0 || grantpt(master) < 0 || unlockpt(master) < 0 || (name = ptsname(master)) == NULL) {
+		perror("pty");
+		return 1;
+	}
+
+	//hold the slave open so the master keeps working between clients
+	slave = open(name, O_RDWR | O_NOCTTY);
+	if (slave < 0) {
+		perror(name);
+		return 1;
+	}
+	tcgetattr(slave, &t_opt);
+	cfmakeraw(&t_opt);
+	tcsetattr(slave, TCSANOW, &t_opt);
+
+	if (link_path != NULL) {
+		unlink(link_path);
+		if (symlink(name, link_path) < 0) {
+			perror(link_path);
+			return 1;
+		}
+	}
+
+	printf("%s\n", name);
+	fflush(stdout);
+
+	for (i = 0; i < EEPROM_SIZE; i++)
+		eeprom[i] = i ^ 0x5A;
+
+	for (;;) {
+		res = read(master, in + len, sizeof(in) - len);
+		if (res < 0 && errno == EINTR)
+			continue;
+		if (res <= 0)
+			break;
+
+		if (latency_us > 0)
+			usleep(latency_us);
+
+		len += res;
+		used = 0;
+		while (used < len && out_len < (int)sizeof(out) - 2 * BUF_SIZE) {
+			res = command(in + used, len - used);
+			if (res == 0)
+				break;
+			if (verbose)
+				fprintf(stderr, "mode %d cmd %02X len %d\n", mode, in[used], res);
+			used += res;
+		}
+		memmove(in, in + used, len - used);
+		len -= used;
+
+		if (out_len > 0 && write_all(master, out, out_len) < 0)
+			break;
+		out_len = 0;
+	}
+
+	if (link_path != NULL)
+		unlink(link_path);
+	close(slave);
+	close(master);
+	return 0;
+}
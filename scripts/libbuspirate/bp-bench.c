@@ -0,0 +1,266 @@
+/*
+ * This file is part of the Bus Pirate project (http://code.google.com/p/the-bus-pirate/).
+ *
+ * Written and maintained by the Bus Pirate project and http://dangerousprototypes.com
+ *
+ * To the extent possible under law, the project has
+ * waived all copyright and related or neighboring rights to Bus Pirate. This
+ * work is published from United States.
+ *
+ * For details see: http://creativecommons.org/publicdomain/zero/1.0/.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ */
+/*
+ * libbuspirate benchmark
+ *
+ * Reads a 25 series SPI flash and a 24 series I2C EEPROM one command per
+ * round trip, the way the BP_WriteToPirate tools do, then with the same
+ * commands pipelined, and checks both read the same.  Run it against
+ * bbio-emulator, or a Bus Pirate with those chips attached (the flash
+ * contents are only compared between the runs then).
+ *
+ * Usage: bp-bench -d port [-s speed] [-n bytes] [-w window] [-e]
+ *        -e  check the data against what bbio-emulator returns
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "bpserial.h"
+#include "libbuspirate.h"
+
+#define CHUNK 4096
+
+static int check_emulator;
+
+static uint8_t emulator_flash_byte(uint32_t addr)
+{
+	return (uint8_t)((addr * 7) ^ (addr >> 8));
+}
+
+static int check(const char *name, const uint8_t *data, const uint8_t *reference, int length)
+{
+	int i;
+
+	for (i = 0; i < length; i++) {
+		if (reference != NULL && data[i] != reference[i])
+			break;
+		if (reference == NULL && check_emulator && data[i] != emulator_flash_byte(i))
+			break;
+	}
+	if (i < length) {
+		fprintf(stderr, "%s: data differs at %d\n", name, i);
+		return -1;
+	}
+	return 0;
+}
+
+static void report(const char *name, long ms, int bytes, int commands)
+{
+	if (ms < 1)
+		ms = 1;
+	printf("  %-36s %6ld ms %9.1f KB/s %6d commands\n", name, ms, bytes / 1.024 / ms, commands);
+}
+
+/* 0x03 read, then 16 byte bulk transfers */
+static int spi_read_bulk(bp_t *bp, uint8_t *data, int length, int pipelined, int *commands)
+{
+	uint8_t cmd[4] = { 0x03, 0x00, 0x00, 0x00 };
+	uint8_t ff[16];
+	int i, res;
+
+	memset(ff, 0xFF, sizeof(ff));
+	if (pipelined)
+		bp_batch_begin(bp);
+
+	res = bp_spi_cs(bp, 0);
+	if (res == BP_OK)
+		res = bp_spi_transfer(bp, cmd, NULL, sizeof(cmd));
+	for (i = 0; i < length && res == BP_OK; i += 16)
+		res = bp_spi_transfer(bp, ff, data + i, (length - i < 16) ? length - i : 16);
+	if (res == BP_OK)
+		res = bp_spi_cs(bp, 1);
+
+	*commands = 3 + (length + 15) / 16;
+	if (pipelined) {
+		i = bp_batch_end(bp);
+		if (res == BP_OK)
+			res = i;
+	}
+	return res;
+}
+
+/* 0x04 write-then-read, a 0x03 read per chunk */
+static int spi_read_write_then_read(bp_t *bp, uint8_t *data, int length, int pipelined, int *commands)
+{
+	uint8_t cmd[4];
+	int i, n, res = BP_OK;
+
+	if (pipelined)
+		bp_batch_begin(bp);
+
+	for (i = 0; i < length && res == BP_OK; i += CHUNK) {
+		n = (length - i < CHUNK) ? length - i : CHUNK;
+		cmd[0] = 0x03;
+		cmd[1] = i >> 16;
+		cmd[2] = i >> 8;
+		cmd[3] = i;
+		res = bp_spi_write_read(bp, cmd, sizeof(cmd), data + i, n, 1);
+	}
+
+	*commands = (length + CHUNK - 1) / CHUNK;
+	if (pipelined) {
+		n = bp_batch_end(bp);
+		if (res == BP_OK)
+			res = n;
+	}
+	return res;
+}
+
+/* random reads, one byte per write-then-read */
+static int i2c_read(bp_t *bp, uint8_t *data, int length, int pipelined)
+{
+	uint8_t cmd[2];
+	int i, res = BP_OK;
+
+	if (pipelined)
+		bp_batch_begin(bp);
+
+	for (i = 0; i < length && res == BP_OK; i++) {
+		cmd[0] = 0xA0;
+		cmd[1] = i;
+		res = bp_i2c_write_read(bp, cmd, 2, data + i, 1);
+	}
+
+	if (pipelined) {
+		i = bp_batch_end(bp);
+		if (res == BP_OK)
+			res = i;
+	}
+	return res;
+}
+
+typedef int (*spi_reader_t)(bp_t *bp, uint8_t *data, int length, int pipelined, int *commands);
+
+static int run_spi(bp_t *bp, const char *name, spi_reader_t reader, int pipelined, uint8_t *data,
+	const uint8_t *reference, int length)
+{
+	long start;
+	int commands, res;
+
+	memset(data, 0, length);
+	start = bp_serial_now_ms();
+	res = reader(bp, data, length, pipelined, &commands);
+	if (res < 0) {
+		fprintf(stderr, "%s: %s\n", name, bp_strerror(res));
+		return -1;
+	}
+	report(name, bp_serial_now_ms() - start, length, commands);
+	return check(name, data, reference, length);
+}
+
+int main(int argc, char **argv)
+{
+	char *port = NULL;
+	long speed = 115200;
+	int length = 64 * 1024;
+	int window = 0;
+	uint8_t *reference, *data;
+	uint8_t eeprom[2][256];
+	long start;
+	bp_t *bp;
+	int opt, res, failed = 0;
+
+	while ((opt = getopt(argc, argv, "d:s:n:w:e")) != -1) {
+		switch (opt) {
+			case 'd':
+				port = optarg;
+				break;
+			case 's':
+				speed = atol(optarg);
+				break;
+			case 'n':
+				length = atoi(optarg);
+				break;
+			case 'w':
+				window = atoi(optarg);
+				break;
+			case 'e':
+				check_emulator = 1;
+				break;
+			default:
+				port = NULL;
+				break;
+		}
+	}
+
+	if (port == NULL || length < 1) {
+		fprintf(stderr, "Usage: %s -d port [-s speed] [-n bytes] [-w window] [-e]\n", argv[0]);
+		return 1;
+	}
+
+	bp = bp_open(port, speed);
+	if (bp == NULL) {
+		fprintf(stderr, "Could not open %s\n", port);
+		return 1;
+	}
+	if (window > 0)
+		bp_set_window(bp, window);
+
+	reference = malloc(length);
+	data = malloc(length);
+
+	res = bp_enter_mode(bp, BP_MODE_SPI);
+	if (res == BP_OK)
+		res = bp_peripherals(bp, BP_PERIPH_POWER);
+	if (res == BP_OK)
+		res = bp_config(bp, BP_SPI_OUT_3V3 | BP_SPI_CKE_ACTIVE);
+	if (res < 0) {
+		fprintf(stderr, "SPI setup: %s\n", bp_strerror(res));
+		return 1;
+	}
+
+	printf("SPI flash, %d bytes\n", length);
+	failed |= run_spi(bp, "bulk, one command per round trip", spi_read_bulk, 0, reference, NULL, length);
+	failed |= run_spi(bp, "bulk, pipelined", spi_read_bulk, 1, data, reference, length);
+	failed |= run_spi(bp, "write-then-read, one per round trip", spi_read_write_then_read, 0, data, reference, length);
+	failed |= run_spi(bp, "write-then-read, pipelined", spi_read_write_then_read, 1, data, reference, length);
+
+	res = bp_enter_mode(bp, BP_MODE_I2C);
+	if (res < 0) {
+		fprintf(stderr, "I2C setup: %s\n", bp_strerror(res));
+		return 1;
+	}
+
+	printf("I2C EEPROM, 256 random reads\n");
+	start = bp_serial_now_ms();
+	res = i2c_read(bp, eeprom[0], 256, 0);
+	if (res < 0) {
+		fprintf(stderr, "I2C: %s\n", bp_strerror(res));
+		failed = 1;
+	}
+	report("one command per round trip", bp_serial_now_ms() - start, 256, 256);
+
+	start = bp_serial_now_ms();
+	res = i2c_read(bp, eeprom[1], 256, 1);
+	if (res < 0) {
+		fprintf(stderr, "I2C: %s\n", bp_strerror(res));
+		failed = 1;
+	}
+	report("pipelined", bp_serial_now_ms() - start, 256, 256);
+	failed |= check("I2C", eeprom[1], eeprom[0], 256);
+
+	bp_reset(bp);
+	bp_close(bp);
+	free(reference);
+	free(data);
+
+	printf("%s\n", failed ? "FAILED" : "OK");
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,300 @@
+/*
+ * This file is part of the Bus Pirate project (http://code.google.com/p/the-bus-pirate/).
+ *
+ * Written and maintained by the Bus Pirate project and http://dangerousprototypes.com
+ *
+ * To the extent possible under law, the project has
+ * waived all copyright and related or neighboring rights to Bus Pirate. This
+ * work is published from United States.
+ *
+ * For details see: http://creativecommons.org/publicdomain/zero/1.0/.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <errno.h>
+
+#ifndef WIN32
+#include <unistd.h>
+#include <termios.h>
+#include <poll.h>
+#include <time.h>
+#endif
+
+#include "bpserial.h"
+
+#define BP_SERIAL_WRITE_TIMEOUT_MS 1000
+
+long bp_serial_now_ms(void)
+{
+#ifdef WIN32
+	return GetTickCount();
+#else
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec * 1000L) + (now.tv_nsec / 1000000L);
+#endif
+}
+
+#ifndef WIN32
+/* the caller passes plain numbers, termios wants its Bxxx constants */
+static speed_t bp_serial_speed_constant(long speed)
+{
+	switch (speed) {
+		case 9600:
+			return B9600;
+		case 19200:
+			return B19200;
+		case 38400:
+			return B38400;
+		case 57600:
+			return B57600;
+		case 115200:
+			return B115200;
+		case 230400:
+			return B230400;
+#ifdef B460800
+		case 460800:
+			return B460800;
+#endif
+#ifdef B921600
+		case 921600:
+			return B921600;
+#endif
+		default:
+			return speed;
+	}
+}
+#endif
+
+#ifndef WIN32
+static int bp_serial_hungup(int fd)
+{
+	struct pollfd pfd;
+
+	pfd.fd = fd;
+	pfd.events = POLLIN;
+	pfd.revents = 0;
+	if (poll(&pfd, 1, 0) < 0)
+		return 0;
+
+	return (pfd.revents & (POLLHUP | POLLERR | POLLNVAL)) != 0;
+}
+#endif
+
+int bp_serial_open(const char *port)
+{
+#ifdef WIN32
+	char full_path[32] = {0};
+	HANDLE hCom;
+
+	if (port[0] != '\\') {
+		_snprintf(full_path, sizeof(full_path) - 1, "\\\\.\\%s", port);
+		port = full_path;
+	}
+
+	hCom = CreateFileA(port, GENERIC_WRITE | GENERIC_READ, 0, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (!hCom || hCom == INVALID_HANDLE_VALUE)
+		return -1;
+
+	return (int)hCom;
+#else
+	return open(port, O_RDWR | O_NOCTTY | O_NONBLOCK);
+#endif
+}
+
+int bp_serial_setup(int fd, long speed)
+{
+#ifdef WIN32
+	COMMTIMEOUTS timeouts = {0};
+	DCB dcb = {0};
+	HANDLE hCom = (HANDLE)fd;
+
+	dcb.DCBlength = sizeof(dcb);
+	dcb.BaudRate = speed;
+	dcb.ByteSize = 8;
+	dcb.Parity = NOPARITY;
+	dcb.StopBits = ONESTOPBIT;
+
+	if (!SetCommState(hCom, &dcb))
+		return -1;
+
+	//reads return at once with what is buffered, bp_serial_wait does the waiting
+	timeouts.ReadIntervalTimeout = MAXDWORD;
+	timeouts.WriteTotalTimeoutMultiplier = 10;
+	timeouts.WriteTotalTimeoutConstant = BP_SERIAL_WRITE_TIMEOUT_MS;
+
+	if (!SetCommTimeouts(hCom, &timeouts))
+		return -1;
+#else
+	struct termios t_opt;
+
+	if (tcgetattr(fd, &t_opt) < 0)
+		return -1;
+
+	cfsetispeed(&t_opt, bp_serial_speed_constant(speed));
+	cfsetospeed(&t_opt, bp_serial_speed_constant(speed));
+	t_opt.c_cflag |= (CLOCAL | CREAD);
+	t_opt.c_cflag &= ~PARENB;
+	t_opt.c_cflag &= ~CSTOPB;
+	t_opt.c_cflag &= ~CSIZE;
+	t_opt.c_cflag |= CS8;
+	t_opt.c_lflag &= ~(ICANON | ECHO | ECHOE | ISIG | IEXTEN);
+	t_opt.c_iflag &= ~(IXON | IXOFF | IXANY | ICRNL | INLCR | IGNCR | ISTRIP | BRKINT);
+	t_opt.c_oflag &= ~OPOST;
+	t_opt.c_cc[VMIN] = 0;
+	t_opt.c_cc[VTIME] = 0;
+	tcflush(fd, TCIFLUSH);
+	if (tcsetattr(fd, TCSANOW, &t_opt) < 0)
+		return -1;
+#endif
+	return 0;
+}
+
+/* returns whether the port was non-blocking before */
+int bp_serial_nonblock(int fd, int on)
+{
+#ifdef WIN32
+	(void)fd;
+	(void)on;
+	return 1;
+#else
+	int flags = fcntl(fd, F_GETFL);
+
+	if (flags < 0)
+		return 0;
+
+	fcntl(fd, F_SETFL, on ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK));
+	return (flags & O_NONBLOCK) != 0;
+#endif
+}
+
+/* bytes the port took, 0 if it takes nothing right now, -1 on errors */
+int bp_serial_write(int fd, const uint8_t *buf, int size)
+{
+#ifdef WIN32
+	unsigned long bwritten = 0;
+
+	if (!WriteFile((HANDLE)fd, buf, size, &bwritten, NULL))
+		return -1;
+
+	return bwritten;
+#else
+	int ret;
+
+	do {
+		ret = write(fd, buf, size);
+	} while (ret < 0 && errno == EINTR);
+
+	if (ret < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+		return 0;
+
+	return ret;
+#endif
+}
+
+/* bytes that were buffered, 0 if there were none, -1 on errors or hangups */
+int bp_serial_read(int fd, uint8_t *buf, int size)
+{
+#ifdef WIN32
+	unsigned long bread = 0;
+
+	if (!ReadFile((HANDLE)fd, buf, size, &bread, NULL))
+		return -1;
+
+	return bread;
+#else
+	int ret;
+
+	do {
+		ret = read(fd, buf, size);
+	} while (ret < 0 && errno == EINTR);
+
+	if (ret < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+		return 0;
+
+	//with VMIN 0 a tty returns 0 when it is empty, a hangup shows in poll()
+	if (ret == 0 && bp_serial_hungup(fd))
+		return -1;
+
+	return ret;
+#endif
+}
+
+/* 1 when there is something to read (or room to write), 0 on timeout, -1 on errors */
+int bp_serial_wait(int fd, int want_write, int timeout_ms)
+{
+#ifdef WIN32
+	long deadline = bp_serial_now_ms() + timeout_ms;
+	COMSTAT cs = {0};
+	unsigned long errors = 0;
+
+	//WriteFile blocks, so only reads are waited for
+	if (want_write)
+		return 1;
+
+	for (;;) {
+		if (!ClearCommError((HANDLE)fd, &errors, &cs))
+			return -1;
+
+		if (cs.cbInQue > 0)
+			return 1;
+
+		if (bp_serial_now_ms() >= deadline)
+			return 0;
+
+		Sleep(1);
+	}
+#else
+	struct pollfd pfd;
+	long deadline = bp_serial_now_ms() + timeout_ms;
+	long left;
+	int ret;
+
+	do {
+		left = deadline - bp_serial_now_ms();
+		if (left < 0)
+			left = 0;
+
+		pfd.fd = fd;
+		pfd.events = POLLIN | (want_write ? POLLOUT : 0);
+		pfd.revents = 0;
+		ret = poll(&pfd, 1, (int)left);
+	} while (ret < 0 && errno == EINTR);
+
+	if (ret > 0 && !(pfd.revents & (POLLIN | POLLOUT)))
+		return -1;
+
+	return ret;
+#endif
+}
+
+/* drops whatever the port has buffered */
+void bp_serial_discard(int fd)
+{
+#ifdef WIN32
+	PurgeComm((HANDLE)fd, PURGE_RXCLEAR);
+#else
+	uint8_t buf[256];
+
+	tcflush(fd, TCIFLUSH);
+	while (bp_serial_read(fd, buf, sizeof(buf)) > 0)
+		;
+#endif
+}
+
+void bp_serial_close(int fd)
+{
+#ifdef WIN32
+	CloseHandle((HANDLE)fd);
+#else
+	close(fd);
+#endif
+}
@@ -0,0 +1,44 @@
+/*
+ * This file is part of the Bus Pirate project (http://code.google.com/p/the-bus-pirate/).
+ *
+ * Written and maintained by the Bus Pirate project and http://dangerousprototypes.com
+ *
+ * To the extent possible under law, the project has
+ * waived all copyright and related or neighboring rights to Bus Pirate. This
+ * work is published from United States.
+ *
+ * For details see: http://creativecommons.org/publicdomain/zero/1.0/.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ */
+/*
+ * Non-blocking serial port for libbuspirate
+ *
+ * Based on the poll() serial layer of the XSVF player.  Reads and writes
+ * never wait: they return what the port took or had, and bp_serial_wait()
+ * is the only place that sleeps.  The functions are prefixed so the
+ * library links next to the serial.c every tool carries.
+ *
+ */
+#ifndef BPSERIAL_H_
+#define BPSERIAL_H_
+
+#include <stdint.h>
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+int bp_serial_open(const char *port);
+int bp_serial_setup(int fd, long speed);
+int bp_serial_nonblock(int fd, int on);
+int bp_serial_write(int fd, const uint8_t *buf, int size);
+int bp_serial_read(int fd, uint8_t *buf, int size);
+int bp_serial_wait(int fd, int want_write, int timeout_ms);
+void bp_serial_discard(int fd);
+void bp_serial_close(int fd);
+long bp_serial_now_ms(void);
+
+#endif
@@ -0,0 +1,1151 @@
+/*
+ * This file is part of the Bus Pirate project (http://code.google.com/p/the-bus-pirate/).
+ *
+ * Written and maintained by the Bus Pirate project and http://dangerousprototypes.com
+ *
+ * To the extent possible under law, the project has
+ * waived all copyright and related or neighboring rights to Bus Pirate. This
+ * work is published from United States.
+ *
+ * For details see: http://creativecommons.org/publicdomain/zero/1.0/.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bpserial.h"
+#include "libbuspirate.h"
+
+#define BP_BBIO_TRIES   25
+#define BP_BBIO_WAIT_MS 20   // per 0x00 sent
+#define BP_QUIET_MS     10   // no more input for this long means the port is drained
+#define BP_BULK_MAX     16   // bytes per 0x1n command
+
+/* what the firmware answers to a command */
+#define REPLY_DATA   0   // rxlen bytes
+#define REPLY_ACKS   1   // rxlen bytes, each 0x01
+#define REPLY_ACKED  2   // 0x01, then rxlen bytes
+#define REPLY_STATUS 3   // 0x01 and rxlen bytes, or a lone 0x00 when it failed
+
+typedef struct {
+	uint8_t reply;
+	int rxlen;
+	uint8_t *rx;     // where the data goes, NULL drops it
+	int got;         // reply bytes taken so far
+	int end;         // offset in tx just past the command
+	int cost;        // command and reply bytes, counted against the window
+} bp_op_t;
+
+struct bp {
+	int fd;
+	int owned;       // opened by bp_open, closed by bp_close
+	int was_nonblocking;
+	int timeout_ms;
+	int window;
+	bp_mode_t mode;
+	int raw_3wire;
+	int streaming;   // sniffer, UART echo or bridge: the port carries bus data, not replies
+
+	uint8_t tx[BP_QUEUE_BYTES];
+	int tx_queued;   // command bytes in tx
+	int tx_allowed;  // of them, the ones the window lets out
+	int tx_sent;     // of them, the ones written
+
+	bp_op_t ops[BP_QUEUE_OPS];
+	unsigned op_head;    // next free
+	unsigned op_admit;   // first one not yet let out
+	unsigned op_tail;    // oldest one waiting for its reply
+	int in_flight;       // cost of the ops let out and not answered
+
+	int batch;
+	int error;       // first error since the queue was last drained
+	int broken;      // lost track of the replies, only bp_enter_bbio helps
+};
+
+static const char bp_mode_id[][5] = { "BBIO", "SPI1", "I2C1", "ART1", "1W01", "RAW1" };
+
+const char *bp_strerror(int error)
+{
+	switch (error) {
+		case BP_OK:
+			return "OK";
+		case BP_ERR_IO:
+			return "serial port error";
+		case BP_ERR_TIMEOUT:
+			return "no reply from the Bus Pirate";
+		case BP_ERR_FAILED:
+			return "the Bus Pirate reported a failure";
+		case BP_ERR_PROTOCOL:
+			return "unexpected reply, lost sync with the Bus Pirate";
+		case BP_ERR_ARG:
+			return "not possible in this mode";
+		default:
+			return "unknown error";
+	}
+}
+
+static bp_t *bp_new(int fd, int owned)
+{
+	bp_t *bp = calloc(1, sizeof(*bp));
+
+	if (bp == NULL)
+		return NULL;
+
+	bp->fd = fd;
+	bp->owned = owned;
+	bp->timeout_ms = BP_TIMEOUT_MS;
+	bp->window = BP_WINDOW_DEFAULT;
+	bp->mode = BP_MODE_TERMINAL;
+	bp->was_nonblocking = bp_serial_nonblock(fd, 1);
+	return bp;
+}
+
+bp_t *bp_open(const char *port, long speed)
+{
+	int fd = bp_serial_open(port);
+	bp_t *bp;
+
+	if (fd == -1)
+		return NULL;
+
+	if (bp_serial_setup(fd, speed) < 0) {
+		bp_serial_close(fd);
+		return NULL;
+	}
+
+	bp = bp_new(fd, 1);
+	if (bp == NULL)
+		bp_serial_close(fd);
+	return bp;
+}
+
+/* takes a port the caller opened and set up; bp_detach hands it back */
+bp_t *bp_attach(int fd)
+{
+	return bp_new(fd, 0);
+}
+
+int bp_detach(bp_t *bp)
+{
+	int fd = bp->fd;
+
+	if (!bp->was_nonblocking)
+		bp_serial_nonblock(fd, 0);
+	free(bp);
+	return fd;
+}
+
+void bp_close(bp_t *bp)
+{
+	int fd = bp->fd;
+	int owned = bp->owned;
+
+	bp_detach(bp);
+	if (owned)
+		bp_serial_close(fd);
+}
+
+int bp_fd(bp_t *bp)
+{
+	return bp->fd;
+}
+
+void bp_set_timeout(bp_t *bp, int timeout_ms)
+{
+	bp->timeout_ms = timeout_ms;
+}
+
+void bp_set_window(bp_t *bp, int bytes)
+{
+	bp->window = (bytes > 0) ? bytes : 1;
+}
+
+bp_mode_t bp_mode(bp_t *bp)
+{
+	return bp->mode;
+}
+
+/*
+ * The queue
+ */
+
+static void bp_drop_queue(bp_t *bp)
+{
+	bp->tx_queued = bp->tx_allowed = bp->tx_sent = 0;
+	bp->op_head = bp->op_admit = bp->op_tail = 0;
+	bp->in_flight = 0;
+}
+
+/* anything that leaves the replies unaccounted for ends up here */
+static int bp_fail(bp_t *bp, int error)
+{
+	if (bp->error == BP_OK)
+		bp->error = error;
+	if (error != BP_ERR_FAILED) {
+		bp->broken = 1;
+		bp_drop_queue(bp);
+	}
+	return error;
+}
+
+static int bp_reply_size(int reply, int rxlen)
+{
+	return (reply == REPLY_ACKED || reply == REPLY_STATUS) ? rxlen + 1 : rxlen;
+}
+
+/* ops that get no reply are done once their command went out */
+static void bp_retire(bp_t *bp)
+{
+	bp_op_t *op;
+
+	while (bp->op_tail != bp->op_admit) {
+		op = &bp->ops[bp->op_tail % BP_QUEUE_OPS];
+		if (bp_reply_size(op->reply, op->rxlen) != 0 || op->end > bp->tx_sent)
+			break;
+		bp->in_flight -= op->cost;
+		bp->op_tail++;
+	}
+
+	if (bp->op_tail == bp->op_head)
+		bp_drop_queue(bp);
+}
+
+/* lets as many queued ops out as the window allows */
+static void bp_admit(bp_t *bp)
+{
+	bp_op_t *op;
+
+	while (bp->op_admit != bp->op_head) {
+		op = &bp->ops[bp->op_admit % BP_QUEUE_OPS];
+		//one op always goes, however long it is
+		if (bp->in_flight > 0 && bp->in_flight + op->cost > bp->window)
+			break;
+		bp->in_flight += op->cost;
+		bp->tx_allowed = op->end;
+		bp->op_admit++;
+	}
+}
+
+/* writes what the window allows without blocking; returns bytes still unsent */
+int bp_send(bp_t *bp)
+{
+	int res;
+
+	if (bp->broken)
+		return BP_ERR_PROTOCOL;
+
+	bp_admit(bp);
+	while (bp->tx_sent < bp->tx_allowed) {
+		res = bp_serial_write(bp->fd, bp->tx + bp->tx_sent, bp->tx_allowed - bp->tx_sent);
+		if (res < 0)
+			return bp_fail(bp, BP_ERR_IO);
+		if (res == 0)
+			break;
+		bp->tx_sent += res;
+	}
+	bp_retire(bp);
+
+	return bp->tx_queued - bp->tx_sent;
+}
+
+/* matches reply bytes to the ops waiting for them */
+static int bp_take(bp_t *bp, const uint8_t *buf, int size)
+{
+	bp_op_t *op;
+	int n, want, i;
+
+	while (size > 0) {
+		bp_retire(bp);
+		if (bp->op_tail == bp->op_admit)
+			return bp_fail(bp, BP_ERR_PROTOCOL);
+
+		op = &bp->ops[bp->op_tail % BP_QUEUE_OPS];
+
+		if (op->got == 0 && (op->reply == REPLY_ACKED || op->reply == REPLY_STATUS)) {
+			if (*buf == 0x00 && op->reply == REPLY_STATUS) {
+				bp_fail(bp, BP_ERR_FAILED);
+				op->got = op->rxlen + 1;
+			} else if (*buf != 0x01) {
+				return bp_fail(bp, BP_ERR_PROTOCOL);
+			} else {
+				op->got = 1;
+			}
+			buf++;
+			size--;
+		} else {
+			want = bp_reply_size(op->reply, op->rxlen) - op->got;
+			n = (size < want) ? size : want;
+
+			if (op->reply == REPLY_ACKS) {
+				for (i = 0; i < n; i++) {
+					if (buf[i] != 0x01)
+						return bp_fail(bp, BP_ERR_PROTOCOL);
+				}
+			} else if (op->rx != NULL) {
+				memcpy(op->rx + op->got - (op->reply == REPLY_DATA ? 0 : 1), buf, n);
+			}
+
+			op->got += n;
+			buf += n;
+			size -= n;
+		}
+
+		if (op->got == bp_reply_size(op->reply, op->rxlen)) {
+			bp->in_flight -= op->cost;
+			bp->op_tail++;
+		}
+	}
+
+	bp_retire(bp);
+	return BP_OK;
+}
+
+/* takes the replies that are in without blocking; returns the ops still outstanding */
+int bp_poll(bp_t *bp)
+{
+	uint8_t buf[4096];
+	int res;
+
+	if (bp->broken)
+		return BP_ERR_PROTOCOL;
+
+	do {
+		res = bp_serial_read(bp->fd, buf, sizeof(buf));
+		if (res < 0)
+			return bp_fail(bp, BP_ERR_IO);
+		if (res > 0 && bp_take(bp, buf, res) < 0)
+			return bp->error;
+	} while (res == (int)sizeof(buf));
+
+	return bp_pending(bp);
+}
+
+int bp_pending(bp_t *bp)
+{
+	return bp->op_head - bp->op_tail;
+}
+
+/* for poll loops: whether bp_send has something it could not write yet */
+int bp_want_write(bp_t *bp)
+{
+	bp_admit(bp);
+	return bp->tx_sent < bp->tx_allowed;
+}
+
+/* moves the queue along, blocking up to the timeout when nothing happens */
+static int bp_pump(bp_t *bp)
+{
+	unsigned tail = bp->op_tail;
+	int sent = bp->tx_sent;
+	int res;
+
+	res = bp_send(bp);
+	if (res >= 0)
+		res = bp_poll(bp);
+	if (res <= 0)
+		return res;
+
+	if (bp->op_tail != tail || bp->tx_sent != sent)
+		return res;
+
+	res = bp_serial_wait(bp->fd, bp_want_write(bp), bp->timeout_ms);
+	if (res < 0)
+		return bp_fail(bp, BP_ERR_IO);
+	if (res == 0)
+		return bp_fail(bp, BP_ERR_TIMEOUT);
+	return 1;
+}
+
+/* sends everything queued and waits for all replies; returns the first error */
+int bp_flush(bp_t *bp)
+{
+	int error;
+
+	while (bp_pending(bp) > 0 && bp_pump(bp) > 0)
+		;
+
+	error = bp->error;
+	if (bp->broken && error == BP_OK)
+		error = BP_ERR_PROTOCOL;
+	bp->error = BP_OK;
+	return error;
+}
+
+void bp_batch_begin(bp_t *bp)
+{
+	bp->batch++;
+}
+
+int bp_batch_end(bp_t *bp)
+{
+	if (bp->batch > 0)
+		bp->batch--;
+	if (bp->batch > 0)
+		return BP_OK;
+	return bp_flush(bp);
+}
+
+/* makes room for a command, draining the queue if it is full */
+static uint8_t *bp_reserve(bp_t *bp, int txlen)
+{
+	if (bp->op_tail == bp->op_head)
+		bp_drop_queue(bp);
+
+	while (bp->op_head - bp->op_tail >= BP_QUEUE_OPS || bp->tx_queued + txlen > BP_QUEUE_BYTES) {
+		//move the unsent part of tx to the front first
+		if (bp->tx_sent > 0) {
+			unsigned i;
+
+			memmove(bp->tx, bp->tx + bp->tx_sent, bp->tx_queued - bp->tx_sent);
+			for (i = bp->op_tail; i != bp->op_head; i++)
+				bp->ops[i % BP_QUEUE_OPS].end -= bp->tx_sent;
+			bp->tx_queued -= bp->tx_sent;
+			bp->tx_allowed -= bp->tx_sent;
+			bp->tx_sent = 0;
+			continue;
+		}
+		if (bp_pump(bp) < 0)
+			return NULL;
+		if (bp->op_tail == bp->op_head)
+			bp_drop_queue(bp);
+	}
+
+	return bp->tx + bp->tx_queued;
+}
+
+/* queues a command; outside a batch it also waits for the reply */
+static int bp_queue(bp_t *bp, const uint8_t *cmd, int cmdlen, const uint8_t *data, int datalen,
+	int reply, uint8_t *rx, int rxlen)
+{
+	uint8_t *out;
+	bp_op_t *op;
+
+	if (bp->broken)
+		return BP_ERR_PROTOCOL;
+	if (bp->streaming)
+		return BP_ERR_ARG;
+
+	out = bp_reserve(bp, cmdlen + datalen);
+	if (out == NULL)
+		return bp->batch ? BP_OK : bp_flush(bp);
+
+	memcpy(out, cmd, cmdlen);
+	if (datalen > 0)
+		memcpy(out + cmdlen, data, datalen);
+	bp->tx_queued += cmdlen + datalen;
+
+	op = &bp->ops[bp->op_head % BP_QUEUE_OPS];
+	op->reply = reply;
+	op->rx = rx;
+	op->rxlen = rxlen;
+	op->got = 0;
+	op->end = bp->tx_queued;
+	op->cost = cmdlen + datalen + bp_reply_size(reply, rxlen);
+	bp->op_head++;
+
+	if (bp->batch)
+		return BP_OK;
+	return bp_flush(bp);
+}
+
+/* closes the batch a command split in pieces ran in */
+static int bp_bulk_end(bp_t *bp, int res)
+{
+	int end = bp_batch_end(bp);
+
+	return (res < 0) ? res : end;
+}
+
+static int bp_command(bp_t *bp, uint8_t cmd)
+{
+	return bp_queue(bp, &cmd, 1, NULL, 0, REPLY_ACKS, NULL, 1);
+}
+
+/*
+ * Modes
+ */
+
+/* reads until the port stays quiet, keeping the tail of it */
+static int bp_collect(bp_t *bp, char *seen, int size, int *len, int wait_ms)
+{
+	uint8_t buf[256];
+	int res, n;
+
+	while ((res = bp_serial_wait(bp->fd, 0, wait_ms)) > 0) {
+		res = bp_serial_read(bp->fd, buf, sizeof(buf));
+		if (res < 0)
+			return BP_ERR_IO;
+
+		n = (res < size) ? res : size;
+		if (*len + n > size) {
+			memmove(seen, seen + (*len + n - size), size - n);
+			*len = size - n;
+		}
+		memcpy(seen + *len, buf + res - n, n);
+		*len += n;
+		wait_ms = BP_QUIET_MS;
+	}
+
+	return (res < 0) ? BP_ERR_IO : BP_OK;
+}
+
+static int bp_contains(const char *seen, int len, const char *id)
+{
+	int idlen = strlen(id);
+	int i;
+
+	for (i = 0; i + idlen <= len; i++) {
+		if (memcmp(seen + i, id, idlen) == 0)
+			return 1;
+	}
+	return 0;
+}
+
+/* waits for an exact reply, for the commands that change modes */
+static int bp_expect(bp_t *bp, const char *reply, int length)
+{
+	char buf[16];
+	long deadline = bp_serial_now_ms() + bp->timeout_ms;
+	int got = 0, res;
+
+	while (got < length) {
+		res = bp_serial_read(bp->fd, (uint8_t *)buf + got, length - got);
+		if (res < 0)
+			return BP_ERR_IO;
+		got += res;
+		if (got == length)
+			break;
+
+		res = bp_serial_wait(bp->fd, 0, deadline - bp_serial_now_ms());
+		if (res < 0)
+			return BP_ERR_IO;
+		if (res == 0)
+			return BP_ERR_TIMEOUT;
+	}
+
+	return (memcmp(buf, reply, length) == 0) ? BP_OK : BP_ERR_PROTOCOL;
+}
+
+static int bp_write_all(bp_t *bp, const uint8_t *buf, int size)
+{
+	int res;
+
+	while (size > 0) {
+		res = bp_serial_write(bp->fd, buf, size);
+		if (res < 0)
+			return BP_ERR_IO;
+		if (res == 0 && bp_serial_wait(bp->fd, 1, bp->timeout_ms) <= 0)
+			return BP_ERR_TIMEOUT;
+		buf += res;
+		size -= res;
+	}
+	return BP_OK;
+}
+
+/*
+ * Sends 0x00 until "BBIO1" comes back.  From the terminal it takes 20 of
+ * them, from a protocol mode (or the sniffer) the first one leaves the mode
+ * and the next one is answered.  This is also how a broken link is
+ * resynced: whatever the queue still had in the air is thrown away.
+ */
+int bp_enter_bbio(bp_t *bp)
+{
+	static const uint8_t zero = 0x00;
+	char seen[64];
+	int len = 0, tries, res;
+
+	bp_drop_queue(bp);
+	bp_serial_discard(bp->fd);
+	bp->broken = 0;
+	bp->error = BP_OK;
+	bp->streaming = 0;
+
+	for (tries = 0; tries < BP_BBIO_TRIES; tries++) {
+		res = bp_write_all(bp, &zero, 1);
+		if (res == BP_OK)
+			res = bp_collect(bp, seen, sizeof(seen), &len, BP_BBIO_WAIT_MS);
+		if (res < 0) {
+			bp->broken = 1;
+			return res;
+		}
+
+		if (bp_contains(seen, len, "BBIO1")) {
+			//the 0x00s sent meanwhile are answered too
+			bp_collect(bp, seen, sizeof(seen), &len, BP_QUIET_MS);
+			bp->mode = BP_MODE_BBIO;
+			return BP_OK;
+		}
+	}
+
+	bp->broken = 1;
+	return BP_ERR_TIMEOUT;
+}
+
+int bp_enter_mode(bp_t *bp, bp_mode_t mode)
+{
+	uint8_t cmd = mode;
+	int res;
+
+	if (mode <= BP_MODE_BBIO || mode > BP_MODE_RAW)
+		return (mode == BP_MODE_BBIO) ? bp_enter_bbio(bp) : BP_ERR_ARG;
+
+	if (bp->mode != BP_MODE_BBIO || bp->broken || bp->streaming) {
+		res = bp_enter_bbio(bp);
+		if (res < 0)
+			return res;
+	}
+
+	res = bp_write_all(bp, &cmd, 1);
+	if (res == BP_OK)
+		res = bp_expect(bp, bp_mode_id[mode], 4);
+	if (res < 0) {
+		bp->broken = 1;
+		return res;
+	}
+
+	bp->mode = mode;
+	bp->raw_3wire = 0;
+	return BP_OK;
+}
+
+/* back to the user terminal */
+int bp_reset(bp_t *bp)
+{
+	static const uint8_t reset = 0x0F;
+	int res;
+
+	res = bp_enter_bbio(bp);
+	if (res == BP_OK)
+		res = bp_write_all(bp, &reset, 1);
+	if (res == BP_OK)
+		res = bp_expect(bp, "\x01", 1);
+	if (res == BP_OK)
+		bp->mode = BP_MODE_TERMINAL;
+	return res;
+}
+
+/* bus data after a command that turns the port into a stream */
+int bp_read(bp_t *bp, uint8_t *buf, int size, int timeout_ms)
+{
+	int res;
+
+	res = bp_serial_read(bp->fd, buf, size);
+	if (res != 0)
+		return (res < 0) ? BP_ERR_IO : res;
+
+	res = bp_serial_wait(bp->fd, 0, timeout_ms);
+	if (res <= 0)
+		return (res < 0) ? BP_ERR_IO : 0;
+
+	res = bp_serial_read(bp->fd, buf, size);
+	return (res < 0) ? BP_ERR_IO : res;
+}
+
+/* sends a command that is acknowledged with 0x01 and then streams */
+static int bp_start_stream(bp_t *bp, uint8_t cmd)
+{
+	int res;
+
+	res = bp_flush(bp);
+	if (res < 0)
+		return res;
+
+	res = bp_write_all(bp, &cmd, 1);
+	if (res == BP_OK)
+		res = bp_expect(bp, "\x01", 1);
+	if (res < 0) {
+		bp->broken = 1;
+		return res;
+	}
+
+	bp->streaming = 1;
+	return BP_OK;
+}
+
+/*
+ * BBIO
+ */
+
+int bp_bb_direction(bp_t *bp, uint8_t inputs, uint8_t *pins)
+{
+	uint8_t cmd = 0x40 | (inputs & 0x1F);
+
+	if (bp->mode != BP_MODE_BBIO)
+		return BP_ERR_ARG;
+	return bp_queue(bp, &cmd, 1, NULL, 0, REPLY_DATA, pins, 1);
+}
+
+int bp_bb_pins(bp_t *bp, uint8_t on, uint8_t *pins)
+{
+	uint8_t cmd = 0x80 | (on & 0x7F);
+
+	if (bp->mode != BP_MODE_BBIO)
+		return BP_ERR_ARG;
+	return bp_queue(bp, &cmd, 1, NULL, 0, REPLY_DATA, pins, 1);
+}
+
+/* voltage probe, 10 bits of 3.3V; waits for the reading even inside a batch */
+int bp_adc(bp_t *bp, uint16_t *value)
+{
+	static const uint8_t cmd = 0x14;
+	uint8_t raw[2];
+	int res;
+
+	if (bp->mode != BP_MODE_BBIO)
+		return BP_ERR_ARG;
+
+	res = bp_queue(bp, &cmd, 1, NULL, 0, REPLY_DATA, raw, 2);
+	if (res == BP_OK)
+		res = bp_flush(bp);
+	if (res == BP_OK)
+		*value = (raw[0] << 8) | raw[1];
+	return res;
+}
+
+/*
+ * Any mode
+ */
+
+int bp_peripherals(bp_t *bp, uint8_t flags)
+{
+	if (bp->mode <= BP_MODE_BBIO)
+		return BP_ERR_ARG;
+	return bp_command(bp, 0x40 | (flags & 0x0F));
+}
+
+int bp_speed(bp_t *bp, uint8_t speed)
+{
+	static const uint8_t speeds[] = { 0, 8, 4, 11, 0, 4 };
+
+	if (bp->mode <= BP_MODE_BBIO || speed >= speeds[bp->mode])
+		return BP_ERR_ARG;
+	return bp_command(bp, 0x60 | speed);
+}
+
+int bp_config(bp_t *bp, uint8_t flags)
+{
+	int res;
+
+	switch (bp->mode) {
+		case BP_MODE_SPI:
+		case BP_MODE_RAW:
+			if (flags > 0x0F)
+				return BP_ERR_ARG;
+			break;
+		case BP_MODE_UART:
+			if (flags > 0x1F)
+				return BP_ERR_ARG;
+			break;
+		default:
+			return BP_ERR_ARG;
+	}
+
+	res = bp_command(bp, 0x80 | flags);
+	if (bp->mode == BP_MODE_RAW)
+		bp->raw_3wire = (flags & BP_RAW_3WIRE) != 0;
+	return res;
+}
+
+/*
+ * SPI
+ */
+
+int bp_spi_cs(bp_t *bp, int high)
+{
+	if (bp->mode != BP_MODE_SPI)
+		return BP_ERR_ARG;
+	return bp_command(bp, high ? 0x03 : 0x02);
+}
+
+/* full duplex, in may be NULL; 16 bytes per command */
+int bp_spi_transfer(bp_t *bp, const uint8_t *out, uint8_t *in, int length)
+{
+	uint8_t cmd;
+	int n, res = BP_OK;
+
+	if (bp->mode != BP_MODE_SPI)
+		return BP_ERR_ARG;
+
+	bp_batch_begin(bp);
+	while (length > 0 && res == BP_OK) {
+		n = (length > BP_BULK_MAX) ? BP_BULK_MAX : length;
+		cmd = 0x10 | (n - 1);
+		res = bp_queue(bp, &cmd, 1, out, n, REPLY_ACKED, in, n);
+		out += n;
+		if (in != NULL)
+			in += n;
+		length -= n;
+	}
+	return bp_bulk_end(bp, res);
+}
+
+/*
+ * 0x04/0x05 write-then-read, 0x05 leaves CS alone.  The firmware only
+ * answers when there is something to read, so write-only commands are
+ * done once they are sent.
+ */
+int bp_spi_write_read(bp_t *bp, const uint8_t *out, int out_length, uint8_t *in, int in_length, int cs)
+{
+	uint8_t cmd[5];
+
+	if (bp->mode != BP_MODE_SPI)
+		return BP_ERR_ARG;
+
+	//the firmware rejects these before taking the data, which would then run as commands
+	if (out_length < 0 || in_length < 0 || out_length > BP_WRITE_READ_MAX || in_length > BP_WRITE_READ_MAX)
+		return BP_ERR_ARG;
+	if (out_length == 0 && in_length == 0)
+		return BP_ERR_ARG;
+
+	cmd[0] = cs ? 0x04 : 0x05;
+	cmd[1] = out_length >> 8;
+	cmd[2] = out_length;
+	cmd[3] = in_length >> 8;
+	cmd[4] = in_length;
+
+	if (in_length == 0)
+		return bp_queue(bp, cmd, 5, out, out_length, REPLY_DATA, NULL, 0);
+	return bp_queue(bp, cmd, 5, out, out_length, REPLY_ACKED, in, in_length);
+}
+
+/* the stream that follows goes to bp_read; bp_enter_bbio stops it */
+int bp_spi_sniff(bp_t *bp, int cs_low_only)
+{
+	if (bp->mode != BP_MODE_SPI)
+		return BP_ERR_ARG;
+	return bp_start_stream(bp, cs_low_only ? 0x0F : 0x0E);
+}
+
+/*
+ * I2C
+ */
+
+int bp_i2c_start(bp_t *bp)
+{
+	if (bp->mode != BP_MODE_I2C)
+		return BP_ERR_ARG;
+	return bp_command(bp, 0x02);
+}
+
+int bp_i2c_stop(bp_t *bp)
+{
+	if (bp->mode != BP_MODE_I2C)
+		return BP_ERR_ARG;
+	return bp_command(bp, 0x03);
+}
+
+int bp_i2c_ack(bp_t *bp, int nack)
+{
+	if (bp->mode != BP_MODE_I2C)
+		return BP_ERR_ARG;
+	return bp_command(bp, nack ? 0x07 : 0x06);
+}
+
+int bp_i2c_read_byte(bp_t *bp, uint8_t *value)
+{
+	static const uint8_t cmd = 0x04;
+
+	if (bp->mode != BP_MODE_I2C)
+		return BP_ERR_ARG;
+	return bp_queue(bp, &cmd, 1, NULL, 0, REPLY_DATA, value, 1);
+}
+
+/* acks gets one byte per byte written, 0x00 for ACK; it may be NULL */
+int bp_i2c_write(bp_t *bp, const uint8_t *out, int length, uint8_t *acks)
+{
+	uint8_t cmd;
+	int n, res = BP_OK;
+
+	if (bp->mode != BP_MODE_I2C)
+		return BP_ERR_ARG;
+
+	bp_batch_begin(bp);
+	while (length > 0 && res == BP_OK) {
+		n = (length > BP_BULK_MAX) ? BP_BULK_MAX : length;
+		cmd = 0x10 | (n - 1);
+		res = bp_queue(bp, &cmd, 1, out, n, REPLY_ACKED, acks, n);
+		out += n;
+		if (acks != NULL)
+			acks += n;
+		length -= n;
+	}
+	return bp_bulk_end(bp, res);
+}
+
+/*
+ * 0x08 write-then-read: start, out (the first byte is the address), a
+ * restart with the read address if there is something to read, in, stop.
+ * No ACK from the device is BP_ERR_FAILED.
+ */
+int bp_i2c_write_read(bp_t *bp, const uint8_t *out, int out_length, uint8_t *in, int in_length)
+{
+	uint8_t cmd[5];
+
+	if (bp->mode != BP_MODE_I2C)
+		return BP_ERR_ARG;
+	if (out_length < 1 || in_length < 0 || out_length > BP_WRITE_READ_MAX || in_length > BP_WRITE_READ_MAX)
+		return BP_ERR_ARG;
+
+	cmd[0] = 0x08;
+	cmd[1] = out_length >> 8;
+	cmd[2] = out_length;
+	cmd[3] = in_length >> 8;
+	cmd[4] = in_length;
+	return bp_queue(bp, cmd, 5, out, out_length, REPLY_STATUS, in, in_length);
+}
+
+/*
+ * UART
+ */
+
+int bp_uart_write(bp_t *bp, const uint8_t *out, int length)
+{
+	uint8_t cmd;
+	int n, res = BP_OK;
+
+	if (bp->mode != BP_MODE_UART)
+		return BP_ERR_ARG;
+
+	bp_batch_begin(bp);
+	while (length > 0 && res == BP_OK) {
+		n = (length > BP_BULK_MAX) ? BP_BULK_MAX : length;
+		cmd = 0x10 | (n - 1);
+		res = bp_queue(bp, &cmd, 1, out, n, REPLY_ACKS, NULL, n + 1);
+		out += n;
+		length -= n;
+	}
+	return bp_bulk_end(bp, res);
+}
+
+/*
+ * With echo on, received UART data is mixed into the replies, so the port
+ * becomes a stream for bp_read.  Turning it off again cannot tell its
+ * acknowledgement from the data, it just drains the port.
+ */
+int bp_uart_echo(bp_t *bp, int on)
+{
+	static const uint8_t off = 0x03;
+	char seen[1];
+	int len = 0, res;
+
+	if (bp->mode != BP_MODE_UART)
+		return BP_ERR_ARG;
+	if (on)
+		return bp_start_stream(bp, 0x02);
+	if (!bp->streaming)
+		return bp_command(bp, 0x03);
+
+	res = bp_write_all(bp, &off, 1);
+	if (res == BP_OK)
+		res = bp_collect(bp, seen, sizeof(seen), &len, BP_QUIET_MS);
+	if (res == BP_OK)
+		bp->streaming = 0;
+	return res;
+}
+
+/* custom baud rate, BRG = (Fcy / (4 * baud)) - 1 */
+int bp_uart_brg(bp_t *bp, uint16_t brg)
+{
+	uint8_t cmd[3];
+
+	if (bp->mode != BP_MODE_UART)
+		return BP_ERR_ARG;
+
+	cmd[0] = 0x07;
+	cmd[1] = brg >> 8;
+	cmd[2] = brg;
+	return bp_queue(bp, cmd, 3, NULL, 0, REPLY_ACKS, NULL, 3);
+}
+
+/* transparent bridge, only a power cycle gets the Bus Pirate out of it */
+int bp_uart_bridge(bp_t *bp)
+{
+	if (bp->mode != BP_MODE_UART)
+		return BP_ERR_ARG;
+	return bp_start_stream(bp, 0x0F);
+}
+
+/*
+ * 1-Wire
+ */
+
+int bp_1wire_reset(bp_t *bp)
+{
+	if (bp->mode != BP_MODE_1WIRE)
+		return BP_ERR_ARG;
+	return bp_command(bp, 0x02);
+}
+
+int bp_1wire_read_byte(bp_t *bp, uint8_t *value)
+{
+	static const uint8_t cmd = 0x04;
+
+	if (bp->mode != BP_MODE_1WIRE)
+		return BP_ERR_ARG;
+	return bp_queue(bp, &cmd, 1, NULL, 0, REPLY_DATA, value, 1);
+}
+
+int bp_1wire_write(bp_t *bp, const uint8_t *out, int length)
+{
+	uint8_t cmd;
+	int n, res = BP_OK;
+
+	if (bp->mode != BP_MODE_1WIRE)
+		return BP_ERR_ARG;
+
+	bp_batch_begin(bp);
+	while (length > 0 && res == BP_OK) {
+		n = (length > BP_BULK_MAX) ? BP_BULK_MAX : length;
+		cmd = 0x10 | (n - 1);
+		res = bp_queue(bp, &cmd, 1, out, n, REPLY_ACKS, NULL, n + 1);
+		out += n;
+		length -= n;
+	}
+	return bp_bulk_end(bp, res);
+}
+
+/*
+ * ROM (or alarm) search.  The reply length depends on the bus, so this
+ * drains the queue and runs on its own.  Returns the number of devices
+ * found, ids beyond max_ids are read and dropped.
+ */
+int bp_1wire_search(bp_t *bp, int alarm, uint8_t (*ids)[8], int max_ids)
+{
+	static const uint8_t last[8] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+	uint8_t cmd = alarm ? 0x09 : 0x08;
+	uint8_t id[8];
+	int found = 0, got, res;
+	long deadline;
+
+	if (bp->mode != BP_MODE_1WIRE)
+		return BP_ERR_ARG;
+
+	res = bp_flush(bp);
+	if (res == BP_OK)
+		res = bp_write_all(bp, &cmd, 1);
+	if (res == BP_OK)
+		res = bp_expect(bp, "\x01", 1);
+
+	while (res == BP_OK) {
+		deadline = bp_serial_now_ms() + bp->timeout_ms;
+		for (got = 0; got < 8 && res == BP_OK; ) {
+			res = bp_serial_read(bp->fd, id + got, 8 - got);
+			if (res < 0)
+				res = BP_ERR_IO;
+			else if ((got += res) < 8)
+				res = (bp_serial_wait(bp->fd, 0, deadline - bp_serial_now_ms()) > 0) ? BP_OK : BP_ERR_TIMEOUT;
+			else
+				res = BP_OK;
+		}
+		if (res < 0 || memcmp(id, last, 8) == 0)
+			break;
+
+		if (found < max_ids)
+			memcpy(ids[found], id, 8);
+		found++;
+	}
+
+	if (res < 0) {
+		bp->broken = 1;
+		return res;
+	}
+	return found;
+}
+
+/*
+ * Raw-wire
+ */
+
+static int bp_raw_command(bp_t *bp, uint8_t cmd)
+{
+	if (bp->mode != BP_MODE_RAW)
+		return BP_ERR_ARG;
+	return bp_command(bp, cmd);
+}
+
+int bp_raw_i2c_start(bp_t *bp)
+{
+	return bp_raw_command(bp, 0x02);
+}
+
+int bp_raw_i2c_stop(bp_t *bp)
+{
+	return bp_raw_command(bp, 0x03);
+}
+
+int bp_raw_cs(bp_t *bp, int high)
+{
+	return bp_raw_command(bp, high ? 0x05 : 0x04);
+}
+
+int bp_raw_read_byte(bp_t *bp, uint8_t *value)
+{
+	static const uint8_t cmd = 0x06;
+
+	if (bp->mode != BP_MODE_RAW)
+		return BP_ERR_ARG;
+	return bp_queue(bp, &cmd, 1, NULL, 0, REPLY_DATA, value, 1);
+}
+
+int bp_raw_read_bit(bp_t *bp, uint8_t *value)
+{
+	static const uint8_t cmd = 0x07;
+
+	if (bp->mode != BP_MODE_RAW)
+		return BP_ERR_ARG;
+	return bp_queue(bp, &cmd, 1, NULL, 0, REPLY_DATA, value, 1);
+}
+
+/* in 3-wire mode the firmware acknowledges the command but not each byte */
+int bp_raw_write(bp_t *bp, const uint8_t *out, int length)
+{
+	uint8_t cmd;
+	int n, res = BP_OK;
+
+	if (bp->mode != BP_MODE_RAW)
+		return BP_ERR_ARG;
+
+	bp_batch_begin(bp);
+	while (length > 0 && res == BP_OK) {
+		n = (length > BP_BULK_MAX) ? BP_BULK_MAX : length;
+		cmd = 0x10 | (n - 1);
+		res = bp_queue(bp, &cmd, 1, out, n, REPLY_ACKS, NULL, bp->raw_3wire ? 1 : n + 1);
+		out += n;
+		length -= n;
+	}
+	return bp_bulk_end(bp, res);
+}
+
+/* up to 8 bits, acknowledged once for the command and once when done */
+int bp_raw_bits(bp_t *bp, uint8_t value, int count)
+{
+	uint8_t cmd[2];
+
+	if (bp->mode != BP_MODE_RAW || count < 1 || count > 8)
+		return BP_ERR_ARG;
+
+	cmd[0] = 0x30 | (count - 1);
+	cmd[1] = value;
+	return bp_queue(bp, cmd, 2, NULL, 0, REPLY_ACKS, NULL, 2);
+}
+
+int bp_raw_ticks(bp_t *bp, int count)
+{
+	int n, res = BP_OK;
+
+	if (bp->mode != BP_MODE_RAW)
+		return BP_ERR_ARG;
+
+	bp_batch_begin(bp);
+	while (count > 0 && res == BP_OK) {
+		n = (count > BP_BULK_MAX) ? BP_BULK_MAX : count;
+		res = bp_command(bp, 0x20 | (n - 1));
+		count -= n;
+	}
+	return bp_bulk_end(bp, res);
+}
@@ -0,0 +1,170 @@
+/*
+ * This file is part of the Bus Pirate project (http://code.google.com/p/the-bus-pirate/).
+ *
+ * Written and maintained by the Bus Pirate project and http://dangerousprototypes.com
+ *
+ * To the extent possible under law, the project has
+ * waived all copyright and related or neighboring rights to Bus Pirate. This
+ * work is published from United States.
+ *
+ * For details see: http://creativecommons.org/publicdomain/zero/1.0/.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ */
+/*
+ * libbuspirate - host side of the binary modes (Firmware/binary_io.c)
+ *
+ * Every operation is queued as a command: the bytes to send and the reply
+ * the firmware gives for them.  Outside a batch an operation sends its
+ * command and waits for the reply, like the old BP_WriteToPirate.  Between
+ * bp_batch_begin() and bp_batch_end() operations only queue; the commands
+ * then go out back to back and the replies are matched up as they arrive,
+ * so a batch costs one round trip instead of one per command.  Data read
+ * inside a batch is only valid, and errors are only reported, once
+ * bp_batch_end() returned.
+ *
+ * bp_send() and bp_poll() move the queue along without ever blocking, for
+ * callers that wait on bp_fd() in their own poll loop.
+ *
+ * The window caps how many bytes (commands plus their replies) may be on
+ * the wire unanswered.  The v4 is flow controlled over USB and takes a lot;
+ * the v3 polls a 4 byte UART FIFO, so keep the window small there if the
+ * batches hold long replies.
+ *
+ */
+#ifndef LIBBUSPIRATE_H_
+#define LIBBUSPIRATE_H_
+
+#include <stdint.h>
+
+#define BP_OK            0
+#define BP_ERR_IO       -1   // the port failed or went away
+#define BP_ERR_TIMEOUT  -2   // no reply in time
+#define BP_ERR_FAILED   -3   // the firmware answered 0x00, e.g. no I2C ACK
+#define BP_ERR_PROTOCOL -4   // a reply that does not fit, the link is out of sync
+#define BP_ERR_ARG      -5   // not possible in this mode or with these lengths
+
+#define BP_TIMEOUT_MS       1000
+#define BP_WINDOW_DEFAULT   4096
+#define BP_QUEUE_OPS        1024
+#define BP_QUEUE_BYTES      (64 * 1024)
+
+#define BP_WRITE_READ_MAX   4096   // BP_TERMINAL_BUFFER_SIZE in the firmware
+
+typedef enum {
+	BP_MODE_TERMINAL = -1,
+	BP_MODE_BBIO = 0x00,
+	BP_MODE_SPI = 0x01,
+	BP_MODE_I2C = 0x02,
+	BP_MODE_UART = 0x03,
+	BP_MODE_1WIRE = 0x04,
+	BP_MODE_RAW = 0x05
+} bp_mode_t;
+
+/* 0100wxyz - peripherals, the same in every mode */
+#define BP_PERIPH_POWER   0x08
+#define BP_PERIPH_PULLUPS 0x04
+#define BP_PERIPH_AUX     0x02
+#define BP_PERIPH_CS      0x01
+
+/* BBIO pins, 010xxxxx sets AUX to CS as inputs, 1xxxxxxx sets them all */
+#define BP_PIN_POWER      0x40
+#define BP_PIN_PULLUP     0x20
+#define BP_PIN_AUX        0x10
+#define BP_PIN_MOSI       0x08
+#define BP_PIN_CLK        0x04
+#define BP_PIN_MISO       0x02
+#define BP_PIN_CS         0x01
+
+/* 1000wxyz - SPI configuration */
+#define BP_SPI_OUT_3V3    0x08   // otherwise HiZ
+#define BP_SPI_CKP_HIGH   0x04   // clock idles high
+#define BP_SPI_CKE_ACTIVE 0x02   // output changes on the active to idle edge
+#define BP_SPI_SMP_END    0x01   // input sampled at the end of the clock
+
+/* 1000wxyz - raw-wire configuration */
+#define BP_RAW_OUT_3V3    0x08
+#define BP_RAW_3WIRE      0x04
+#define BP_RAW_LSB_FIRST  0x02
+
+typedef struct bp bp_t;
+
+/* the port */
+bp_t *bp_open(const char *port, long speed);
+bp_t *bp_attach(int fd);
+int bp_detach(bp_t *bp);
+void bp_close(bp_t *bp);
+int bp_fd(bp_t *bp);
+void bp_set_timeout(bp_t *bp, int timeout_ms);
+void bp_set_window(bp_t *bp, int bytes);
+const char *bp_strerror(int error);
+
+/*
+ * Modes; these drain the queue first and always wait for their reply.
+ * The sniffer, UART echo and the UART bridge turn the port into a stream of
+ * bus data for bp_read(), queued operations fail until bp_enter_bbio().
+ */
+int bp_enter_bbio(bp_t *bp);
+int bp_enter_mode(bp_t *bp, bp_mode_t mode);
+bp_mode_t bp_mode(bp_t *bp);
+int bp_reset(bp_t *bp);
+int bp_read(bp_t *bp, uint8_t *buf, int size, int timeout_ms);
+
+/* queuing */
+void bp_batch_begin(bp_t *bp);
+int bp_batch_end(bp_t *bp);
+int bp_flush(bp_t *bp);
+int bp_send(bp_t *bp);
+int bp_poll(bp_t *bp);
+int bp_pending(bp_t *bp);
+int bp_want_write(bp_t *bp);
+
+/* BBIO; pins gets AUX to CS as read back and may be NULL */
+int bp_bb_direction(bp_t *bp, uint8_t inputs, uint8_t *pins);
+int bp_bb_pins(bp_t *bp, uint8_t on, uint8_t *pins);
+int bp_adc(bp_t *bp, uint16_t *value);
+
+/* any mode */
+int bp_peripherals(bp_t *bp, uint8_t flags);
+int bp_speed(bp_t *bp, uint8_t speed);
+int bp_config(bp_t *bp, uint8_t flags);
+
+/* SPI */
+int bp_spi_cs(bp_t *bp, int high);
+int bp_spi_transfer(bp_t *bp, const uint8_t *out, uint8_t *in, int length);
+int bp_spi_write_read(bp_t *bp, const uint8_t *out, int out_length, uint8_t *in, int in_length, int cs);
+int bp_spi_sniff(bp_t *bp, int cs_low_only);
+
+/* I2C */
+int bp_i2c_start(bp_t *bp);
+int bp_i2c_stop(bp_t *bp);
+int bp_i2c_ack(bp_t *bp, int nack);
+int bp_i2c_read_byte(bp_t *bp, uint8_t *value);
+int bp_i2c_write(bp_t *bp, const uint8_t *out, int length, uint8_t *acks);
+int bp_i2c_write_read(bp_t *bp, const uint8_t *out, int out_length, uint8_t *in, int in_length);
+
+/* UART */
+int bp_uart_write(bp_t *bp, const uint8_t *out, int length);
+int bp_uart_echo(bp_t *bp, int on);
+int bp_uart_brg(bp_t *bp, uint16_t brg);
+int bp_uart_bridge(bp_t *bp);
+
+/* 1-Wire */
+int bp_1wire_reset(bp_t *bp);
+int bp_1wire_read_byte(bp_t *bp, uint8_t *value);
+int bp_1wire_write(bp_t *bp, const uint8_t *out, int length);
+int bp_1wire_search(bp_t *bp, int alarm, uint8_t (*ids)[8], int max_ids);
+
+/* raw-wire */
+int bp_raw_cs(bp_t *bp, int high);
+int bp_raw_i2c_start(bp_t *bp);
+int bp_raw_i2c_stop(bp_t *bp);
+int bp_raw_read_byte(bp_t *bp, uint8_t *value);
+int bp_raw_read_bit(bp_t *bp, uint8_t *value);
+int bp_raw_write(bp_t *bp, const uint8_t *out, int length);
+int bp_raw_bits(bp_t *bp, uint8_t value, int count);
+int bp_raw_ticks(bp_t *bp, int count);
+
+#endif
@@ -47,15 +47,10 @@ Repeat from 2
 #include <string.h>
 #include <windef.h>
 
-#include "..\framework\buspirate.h"
-#include "..\framework\serial.h"
+#include "libbuspirate.h"
 
 
-int modem =FALSE;   //set this to TRUE of testing a MODEM
 int verbose = 0;
-//int disable_comport = 0;   //1 to say yes, disable comport, any value to enable port default is 0 meaning port is enable.
-int dumphandle;     // use by dump file when using the -d dumfile.txt parameter
-char *dumpfile;
 
 int print_usage(char * appname)
 {
@@ -86,14 +81,13 @@ int print_usage(char * appname)
 int main(int argc, char** argv)
 {
 	int opt;
-    char buffer[256] = {0};
-	int fd;
+	uint8_t buffer[2] = {0};
+	bp_t *bp;
 	int res,c;
 
 	int flag=0,firsttime=0;
 	char *param_port = NULL;
 	char *param_speed = NULL;
-   	char ret,i;
 
 	printf("-------------------------------------------------------------------------------------\n");
 	printf("\n");
@@ -108,7 +102,7 @@ int main(int argc, char** argv)
 		exit(-1);
 	}
 
-	while ((opt = getopt(argc, argv, "ms:p:")) != -1) {
+	while ((opt = getopt(argc, argv, "s:p:")) != -1) {
        // printf("%c  \n",opt);
 		switch (opt) {
 
@@ -187,95 +181,68 @@ int main(int argc, char** argv)
 //
 
 		printf(" Opening Bus Pirate on %s at %sbps...\n", param_port, param_speed);
-		fd = serial_open(param_port);
-		if (fd < 0) {
+		bp = bp_open(param_port, atol(param_speed));
+		if (bp == NULL) {
 			fprintf(stderr, " Error opening serial port\n");
 			return -1;
 		}
-        //Set Speed of port
-		serial_setup(fd,(speed_t) param_speed);
 
 		printf(" Configuring Bus Pirate ....\n");
 
-		//go into binary bitbang mode
-		printf(" Going into Binary Bitbang mode..\n");
-		if(BP_EnableBinary(fd)!=BBIO){
-			printf(" Buspirate cannot switch to binary bitbang mode :( \n");
-			return -1;
-		}
-		else
-			printf(" ..ok\n\n");
-
+		//go into binary bitbang mode, then SPI mode
 		printf(" Going into SPI mode..");
-
-		if(BP_EnableMode(fd, SPI)!=SPI){
-			printf(" Buspirate cannot switch to SPI mode :( \n");
+		res = bp_enter_mode(bp, BP_MODE_SPI);
+		if (res != BP_OK) {
+			printf(" Buspirate cannot switch to SPI mode :( %s\n", bp_strerror(res));
 			return -1;
 		}
 		else
 			printf(" ..ok\n\n");
+
 		//0100wxyz - Configure peripherals w=power, x=pull-ups, y=AUX, z=CS
-		i=0x40;
-		i|=0x08;//power on
-		i|=0x01; //CS high
 		printf(" Power on...\n");
-		BP_WriteToPirate(fd,&i);
+		res = bp_peripherals(bp, BP_PERIPH_POWER | BP_PERIPH_CS);
 
 		//1000wxyz - SPI config, w=HiZ/3.3v, x=CKP idle, y=CKE edge, z=SMP sample
-		// 10001110
 		// 3. Enable power, normal pin outputs
-		i=0x80;
-		i|=0x02;
-		//i|=0x04;
-		// w=hiZ/3.3v
-		i|=0x08;
 		printf(" Enabling  power, normal pin outputs..\n");
-		BP_WriteToPirate(fd,&i);
+		if (res == BP_OK)
+			res = bp_config(bp, BP_SPI_OUT_3V3 | BP_SPI_CKE_ACTIVE);
 
 		//
 		//Start self-test
 
-		// Set CS high
-		i=0x03;
-		printf(" CS High : 0x03....\n");
-		BP_WriteToPirate(fd,&i);
-
-		// Set CS low
-		i=0x02;
-		printf(" CS Low : 0x02....\n\n");
-		BP_WriteToPirate(fd,&i);
+		// Set CS high, then low
+		printf(" CS High, CS Low....\n\n");
+		if (res == BP_OK)
+			res = bp_spi_cs(bp, 1);
+		if (res == BP_OK)
+			res = bp_spi_cs(bp, 0);
 
-		//  Send 0x1A
+		//  Send 0x1A, read one byte
 		printf(" Sending  0x1A....\n");
-		buffer[0]=0x11;//number of bytes
-		buffer[1]=0x1a; //command to MMA7455
-		buffer[2]=0xff; //read one byte
-		serial_write(fd, buffer, 3);
-		Sleep(1);
-		// Read one byte
-		res = serial_read(fd, buffer, 3);
-		if (res!=0) {
+		buffer[0]=0x1a; //command to MMA7455
+		buffer[1]=0xff; //read one byte
+		if (res == BP_OK)
+			res = bp_spi_transfer(bp, buffer, buffer, 2);
+		if (res == BP_OK) {
 			printf(" Got reply:  ");
-			printf("0X%02X ",buffer[2]);
+			printf("0X%02X ",buffer[1]);
 			printf(" \n\n");
-			if (buffer[2] !=0x1D)
+			if (buffer[1] !=0x1D)
 				printf(" Self test status with MMA7455L breakout board: !!!! FAILED! !!!! \n\n");
 			else
 				printf(" Self test status with MMA7455L breakout board: **** PASS! *****\n\n");
 		}else{
-			printf("FAIL! Got No Reply\n");
+			printf("FAIL! %s\n", bp_strerror(res));
 		}
 
 		// Set CS high
-		i=0x03;
-		printf(" CS High : 0x03....\n");
-		BP_WriteToPirate(fd,&i);
+		printf(" CS High....\n");
+		bp_spi_cs(bp, 1);
 
 		printf(" Exiting SPI mode/reseting Buspirate..\n");
-		i=0x00;
-		serial_write(fd, &i, 1);
-		Sleep(1);
-		res = serial_read(fd, buffer, sizeof(buffer));
+		bp_enter_bbio(bp);
 
 		//  pause after the result
 
@@ -291,10 +258,10 @@ int main(int argc, char** argv)
 			}
 		}
 
-		res = serial_write( fd, "\x00", 1);  //reset buspirate
+		bp_reset(bp);  //reset buspirate
 
 		//close port so they can attach the next Bus Pirate
-		serial_close(fd);
+		bp_close(bp);
 
 
 		//TODO: Loop back to pause after this
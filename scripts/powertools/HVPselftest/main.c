@@ -26,15 +26,10 @@
 #include <string.h>
 #include <windef.h>
 
-#include "..\framework\buspirate.h"
-#include "..\framework\serial.h"
+#include "libbuspirate.h"
 
 
-int modem =FALSE;   //set this to TRUE of testing a MODEM
 int verbose = 0;
-//int disable_comport = 0;   //1 to say yes, disable comport, any value to enable port default is 0 meaning port is enable.
-int dumphandle;     // use by dump file when using the -d dumfile.txt parameter
-char *dumpfile;
 
 int print_usage(char * appname)
 {
@@ -65,9 +60,9 @@ int print_usage(char * appname)
 int main(int argc, char** argv)
 {
 	int opt;
-	char  ADCraw[2]={0};
-	int fd;
-	int res,c,adc;
+	uint16_t adc=0;
+	bp_t *bp;
+	int res,c;
 	float voltage,vout ;
 	int flag=0,firsttime=0;
 	char *param_port = NULL;
@@ -86,7 +81,7 @@ int main(int argc, char** argv)
 		exit(-1);
 	}
 
-	while ((opt = getopt(argc, argv, "ms:p:")) != -1) {
+	while ((opt = getopt(argc, argv, "s:p:")) != -1) {
        // printf("%c  \n",opt);
 		switch (opt) {
 
@@ -105,9 +100,6 @@ int main(int argc, char** argv)
 				param_speed = strdup(optarg);
 
 				break;
-			case 'm':    //modem debugging for testing
-                   modem =TRUE;   // enable modem mode
-				break;
 
 			default:
 				printf(" Invalid argument %c", opt);
@@ -131,19 +123,18 @@ int main(int argc, char** argv)
 	flag=0;
 
     printf(" Opening Bus Pirate on %s at %sbps...\n", param_port, param_speed);
-    fd = serial_open(param_port);
-    if (fd < 0) {
+    bp = bp_open(param_port, atol(param_speed));
+    if (bp == NULL) {
         fprintf(stderr, " Error opening serial port\n");
         return -1;
     }
-    //Set Speed of port
-    serial_setup(fd,(speed_t) param_speed);
 
     //printf(" Configuring Bus Pirate HVP Adapter...\n");
     //go into binary bitbang mode
     printf(" Going into Binary Bitbang mode..");
-    if(BP_EnableBinary(fd)!=BBIO){
-        printf(" Buspirate cannot switch to binary bitbang mode :( \n");
+    res = bp_enter_bbio(bp);
+    if (res != BP_OK) {
+        printf(" Buspirate cannot switch to binary bitbang mode :( %s\n", bp_strerror(res));
         return -1;
     }
 
@@ -191,12 +182,12 @@ int main(int argc, char** argv)
 
         printf(" Configuring pin direction: 01001100...\n");
         //printf(" sending 01000000...");
-        BP_WriteToPirateNoCheck(fd,"\x4C");
+        bp_bb_direction(bp, BP_PIN_MOSI | BP_PIN_CLK, NULL);
         //printf("OK\n");
        //1xxxxxxx - Set on (1) or off (0): POWER|PULLUP|AUX|MOSI|CLK|MISO|CS
        //11000000 - on :  poweronly = 0xC0
         printf(" Sending Command to power on : 11010000....");
-        BP_WriteToPirateNoCheck(fd,"\xD2");//c0
+        bp_bb_pins(bp, BP_PIN_POWER | BP_PIN_AUX | BP_PIN_MISO, NULL);
         printf("OK\n");
         Sleep(100);
 
@@ -206,21 +197,9 @@ int main(int argc, char** argv)
         // 00010100 = 0x14
 
 		printf(" Voltage Probe measurement...,sending 00010100 \n");
-		serial_write( fd, "\x14",1 );
-		res=0;
-		while(res==0){
-            Sleep(1); //how long wait for a reply?
-            res = serial_read(fd, ADCraw, 2);
-        }
-        //for debugging without hardware using only modem, use -m to pass
-		if (modem==TRUE){
-		    res=2;
-            ADCraw[0]=0x02;
-            ADCraw[1]=0xA6;
-		}
-        // comment the above if with hardware
-        if (res!=2){
-           printf(" Expecting 2 bytes returned but got %i instead\n",res);
+		res = bp_adc(bp, &adc);
+        if (res != BP_OK){
+           printf(" No voltage reading: %s\n", bp_strerror(res));
            printf(" Voltage Measurement: !!!!FAIL!!!! \n");
         }
         else
@@ -232,12 +211,10 @@ int main(int argc, char** argv)
            // Actual voltage: (678/1024)*3.3volts=2.18volts
            // Scale for resistor divider: Vin = (Vout*(R1+R2))/R2 = (2.18volts*(49K+10K))/10K = 12.86volts (ideal is 13volts)
 
-            adc = ADCraw[0] << 8;
-            adc |= (ADCraw[1]&0x00ff);
 			vout= ((float)adc/1024.0f)*3.3f;
 			voltage =(vout*(49.0f+10.0f))/10.0f;
 
-			printf(" ADC Reading: %2.1f Volts (%02X, %02X)\n",voltage, (char)ADCraw[0], ((char)ADCraw[1]&0xff));
+			printf(" ADC Reading: %2.1f Volts (%02X, %02X)\n",voltage, adc >> 8, adc & 0xff);
 			if(voltage > 10.5 ){
                 printf(" Voltage Measurement: ****PASS**** \n");
             }else{
@@ -248,12 +225,12 @@ int main(int argc, char** argv)
 
         printf(" Pins to input: 01011111...\n");
         //printf(" sending 01000000...");
-        BP_WriteToPirateNoCheck(fd,"\x5F");
+        bp_bb_direction(bp, BP_PIN_AUX | BP_PIN_MOSI | BP_PIN_CLK | BP_PIN_MISO | BP_PIN_CS, NULL);
     	//power off
 	    //1xxxxxxx - Set on (1) or off (0): POWER|PULLUP|AUX|MOSI|CLK|MISO|CS
 		   //10000000 - off :  power only = 0x80
            printf( " powering off.....\n");
-		   BP_WriteToPirateNoCheck(fd,"\x80");
+		   bp_bb_pins(bp, 0, NULL);
 
 
 		//TODO: Loop back to pause after this
@@ -266,9 +243,9 @@ int main(int argc, char** argv)
 			   c = getch();
 			   if(c == 27){
 					printf("\n Esc key hit, stopping...\n");
-                    res = serial_write( fd, "\x0F", 1);  //exit BBIO
+                    bp_reset(bp);  //exit BBIO
                     //close port so they can attach the next Bus Pirate
-                    serial_close(fd);
+                    bp_close(bp);
 					printf(" (Bye for now!)\n");
 					exit(-1);
 				}else {//make space only
@@ -21,7 +21,6 @@
 #include <string.h>
 #include <windef.h>
 
-#include "..\framework\buspirate.h"
 #include "..\framework\serial.h"
 
 
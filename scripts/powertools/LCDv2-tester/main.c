@@ -21,15 +21,10 @@
 #include <string.h>
 #include <windef.h>
 
-#include "..\framework\buspirate.h"
-#include "..\framework\serial.h"
+#include "libbuspirate.h"
 
 
-int modem =FALSE;   //set this to TRUE of testing a MODEM
 int verbose = 0;
-//int disable_comport = 0;   //1 to say yes, disable comport, any value to enable port default is 0 meaning port is enable.
-int dumphandle;     // use by dump file when using the -d dumfile.txt parameter
-char *dumpfile;
 
 int print_usage(char * appname)
 	{
@@ -60,8 +55,8 @@ int print_usage(char * appname)
 int main(int argc, char** argv)
 {
   int opt;
-  char buffer[256] = {0}, i;
-  int fd;
+  static const uint8_t low = 0x00, high = 0xFF;
+  bp_t *bp;
   int res,c;
   int flag=0,firsttime=0;
   char *param_port = NULL;
@@ -82,7 +77,7 @@ if (argc <= 1)  {
 		exit(-1);
 	}
 
-while ((opt = getopt(argc, argv, "ms:d:")) != -1) {
+while ((opt = getopt(argc, argv, "s:d:")) != -1) {
        // printf("%c  \n",opt);
 		switch (opt) {
 
@@ -101,9 +96,6 @@ while ((opt = getopt(argc, argv, "ms:d:")) != -1) {
 				param_speed = strdup(optarg);
 
 				break;
-			case 'm':    //modem debugging for testing
-                   modem =TRUE;   // enable modem mode
-				break;
 
 			default:
 				printf(" Invalid argument %c", opt);
@@ -137,8 +129,8 @@ while ((opt = getopt(argc, argv, "ms:d:")) != -1) {
     //
 
 	printf(" Opening Bus Pirate on %s at %sbps...\n", param_port, param_speed);
-	fd = serial_open(param_port);
-	if (fd < 0) {
+	bp = bp_open(param_port, atol(param_speed));
+	if (bp == NULL) {
 		fprintf(stderr, " Error opening serial port\n");
 		return -1;
 	}
@@ -146,19 +138,11 @@ while ((opt = getopt(argc, argv, "ms:d:")) != -1) {
     //
 	// Enter binary mode, then enter a protocol mode
 	//
-	serial_setup(fd,(speed_t) param_speed);
-
-
     fprintf(stderr, " Configuring Bus Pirate...\n");
-    //BP_EnableMode(fd, SPI); //enter BBIO then SPI
-    if(BP_EnableBinary(fd)!=BBIO){
-        fprintf(stderr, " Buspirate cannot switch to binary mode :( \n");
-        return -1;
-    }
-
     fprintf(stderr, " Switch to SPI...\n");
-    if(BP_EnableMode(fd , SPI)!=SPI){
-        fprintf(stderr, " Buspirate cannot switch to SPI mode :( \n");
+    res = bp_enter_mode(bp, BP_MODE_SPI); //enter BBIO then SPI
+    if (res != BP_OK){
+        fprintf(stderr, " Buspirate cannot switch to SPI mode :( %s\n", bp_strerror(res));
         fprintf(stderr, " Exiting...\n");
         return -1;
     }
@@ -205,17 +189,14 @@ while ((opt = getopt(argc, argv, "ms:d:")) != -1) {
 
         //fprintf(stderr, " SPI power on...\n");
 
-        i=0x48;//power on, CS low, etc.
-        if (BP_WriteToPirate(fd, &i))
+        if (bp_peripherals(bp, BP_PERIPH_POWER))//power on, CS low, etc.
              printf("WARNING.. Not Good\n");
 
 
         //fprintf(stderr, " SPI pin setup...\n");
     //configure according to user settings
     //1000wxyz - SPI config, w=HiZ/3.3v, x=CKP idle, y=CKE edge, z=SMP sample
-        i=0x80;
-        i|=0x0A;
-        if (BP_WriteToPirate(fd, &i))
+        if (bp_config(bp, BP_SPI_OUT_3V3 | BP_SPI_CKE_ACTIVE))
              printf("WARNING.. Not Good\n");
 
         printf(" LED and all outputs should blink!!!\n ");
@@ -224,35 +205,15 @@ while ((opt = getopt(argc, argv, "ms:d:")) != -1) {
         printf(" Press any key to continue...\n");
         firsttime=1;
         while(1){
-            i=0x10;//send data
-            if (BP_WriteToPirate(fd, &i))
-                 printf("WARNING.. Not Good\n");
-
-             i=0x00;//data
-             BP_WriteToPirateNoCheck(fd, &i);
-
-            i=0x03;//cs High
-            if (BP_WriteToPirate(fd, &i))
-                 printf("WARNING.. Not Good\n");
-
-            i=0x02;//cs low
-            if (BP_WriteToPirate(fd, &i))
-                 printf("WARNING.. Not Good\n");
-
-
-             i=0x10;//send data
-            if (BP_WriteToPirate(fd, &i))
-                 printf("WARNING.. Not Good\n");
-
-             i=0xFF;//data
-             BP_WriteToPirateNoCheck(fd, &i);
-
-            i=0x03;//cs High
-            if (BP_WriteToPirate(fd, &i))
-                 printf("WARNING.. Not Good\n");
-
-            i=0x02;//cs low
-            if (BP_WriteToPirate(fd, &i))
+            //one round trip per blink
+            bp_batch_begin(bp);
+            bp_spi_transfer(bp, &low, NULL, 1);
+            bp_spi_cs(bp, 1);
+            bp_spi_cs(bp, 0);
+            bp_spi_transfer(bp, &high, NULL, 1);
+            bp_spi_cs(bp, 1);
+            bp_spi_cs(bp, 0);
+            if (bp_batch_end(bp))
                  printf("WARNING.. Not Good\n");
 
             Sleep(1);
@@ -264,17 +225,14 @@ while ((opt = getopt(argc, argv, "ms:d:")) != -1) {
 
         //fprintf(stderr, " SPI power off...\n");
 
-        i=0x40;//power on, CS low, etc.
-        if (BP_WriteToPirate(fd, &i))
+        if (bp_peripherals(bp, 0))
              printf("WARNING.. Not Good\n");
 
 
         //fprintf(stderr, " SPI pin hiz...\n");
     //configure according to user settings
     //1000wxyz - SPI config, w=HiZ/3.3v, x=CKP idle, y=CKE edge, z=SMP sample
-        i=0x80;
-        i|=0x02;
-        if (BP_WriteToPirate(fd, &i))
+        if (bp_config(bp, BP_SPI_CKE_ACTIVE))
              printf("WARNING.. Not Good\n");
 
         //TODO: Loop back to pause after this
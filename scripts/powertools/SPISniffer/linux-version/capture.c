@@ -0,0 +1,266 @@
+/*
+ * This file is part of the Bus Pirate project (http://code.google.com/p/the-bus-pirate/).
+ *
+ * Written and maintained by the Bus Pirate project and http://dangerousprototypes.com
+ *
+ * To the extent possible under law, the project has
+ * waived all copyright and related or neighboring rights to Bus Pirate. This
+ * work is published from United States.
+ *
+ * For details see: http://creativecommons.org/publicdomain/zero/1.0/.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "capture.h"
+
+#ifndef O_BINARY
+#define O_BINARY 0
+#endif
+
+#define PCAP_MAGIC         0xA1B2C3D4
+#define PCAP_SNAPLEN       262144
+#define PCAP_LINKTYPE_USER 147
+
+static const char hex_digits[] = "0123456789ABCDEF";
+
+static void *capture_writer(void *arg)
+{
+	capture_t *capture = arg;
+	unsigned long long tail;
+	size_t offset, length;
+	ssize_t res;
+
+	pthread_mutex_lock(&capture->lock);
+	for (;;) {
+		while (capture->head == capture->tail && !capture->closing)
+			pthread_cond_wait(&capture->more, &capture->lock);
+		if (capture->head == capture->tail)
+			break;
+
+		//write the part up to the end of the ring, the rest goes next round
+		tail = capture->tail;
+		offset = tail % CAPTURE_RING_SIZE;
+		length = capture->head - tail;
+		if (length > CAPTURE_RING_SIZE - offset)
+			length = CAPTURE_RING_SIZE - offset;
+		pthread_mutex_unlock(&capture->lock);
+
+		while (length > 0) {
+			res = write(capture->fd, capture->ring + offset, length);
+			if (res < 0 && errno == EINTR)
+				continue;
+			if (res <= 0) {
+				capture->error = 1;
+				res = length;  //keep draining so the decoder never blocks on a dead file
+			}
+			offset += res;
+			length -= res;
+			tail += res;
+		}
+
+		pthread_mutex_lock(&capture->lock);
+		capture->tail = tail;
+		pthread_cond_signal(&capture->room);
+	}
+	pthread_mutex_unlock(&capture->lock);
+
+	return NULL;
+}
+
+/* hands the staged output to the writer thread, waits if the ring is full */
+void capture_flush(capture_t *capture)
+{
+	size_t done = 0, offset, length;
+
+	pthread_mutex_lock(&capture->lock);
+	while (done < capture->staged) {
+		if (capture->head - capture->tail == CAPTURE_RING_SIZE) {
+			capture->stalls++;
+			while (capture->head - capture->tail == CAPTURE_RING_SIZE)
+				pthread_cond_wait(&capture->room, &capture->lock);
+		}
+
+		offset = capture->head % CAPTURE_RING_SIZE;
+		length = CAPTURE_RING_SIZE - (capture->head - capture->tail);
+		if (length > CAPTURE_RING_SIZE - offset)
+			length = CAPTURE_RING_SIZE - offset;
+		if (length > capture->staged - done)
+			length = capture->staged - done;
+
+		memcpy(capture->ring + offset, capture->stage + done, length);
+		capture->head += length;
+		done += length;
+		pthread_cond_signal(&capture->more);
+	}
+	pthread_mutex_unlock(&capture->lock);
+
+	capture->staged = 0;
+}
+
+static uint8_t *capture_reserve(capture_t *capture, size_t length)
+{
+	if (capture->staged + length > CAPTURE_STAGE_SIZE)
+		capture_flush(capture);
+	return capture->stage + capture->staged;
+}
+
+static uint8_t *capture_put_le(uint8_t *out, uint64_t value, int bytes)
+{
+	while (bytes-- > 0) {
+		*out++ = value;
+		value >>= 8;
+	}
+	return out;
+}
+
+static uint8_t *capture_put_hex(uint8_t *out, uint8_t value)
+{
+	*out++ = '0';
+	*out++ = 'x';
+	*out++ = hex_digits[value >> 4];
+	*out++ = hex_digits[value & 0x0F];
+	return out;
+}
+
+/* the decoder callback, context is the capture_t */
+void capture_transaction(void *context, const sniff_transaction_t *transaction)
+{
+	capture_t *capture = context;
+	uint32_t count = transaction->count;
+	uint8_t *start, *out;
+	uint32_t i;
+
+	if (capture->format == CAPTURE_TEXT) {
+		start = out = capture_reserve(capture, 16 + count * 10);
+		if (transaction->flags & SNIFF_FLAG_RESYNC) {
+			memcpy(out, "Sync\n", 5);
+			out += 5;
+		}
+		*out++ = '[';
+		for (i = 0; i < count; i++) {
+			out = capture_put_hex(out, transaction->mosi[i]);
+			*out++ = '(';
+			out = capture_put_hex(out, transaction->miso[i]);
+			*out++ = ')';
+		}
+		if (!(transaction->flags & (SNIFF_FLAG_SPLIT | SNIFF_FLAG_OPEN | SNIFF_FLAG_SYNC_LOST)))
+			*out++ = ']';
+		*out++ = '\n';
+	} else {
+		start = out = capture_reserve(capture, 16 + 1 + count * 2);
+		if (capture->format == CAPTURE_PCAP) {
+			out = capture_put_le(out, transaction->timestamp_us / 1000000, 4);
+			out = capture_put_le(out, transaction->timestamp_us % 1000000, 4);
+			out = capture_put_le(out, 1 + count * 2, 4);
+			out = capture_put_le(out, 1 + count * 2, 4);
+		} else {
+			out = capture_put_le(out, transaction->timestamp_us, 8);
+			out = capture_put_le(out, count, 4);
+		}
+		*out++ = transaction->flags;
+		memcpy(out, transaction->mosi, count);
+		out += count;
+		memcpy(out, transaction->miso, count);
+		out += count;
+	}
+
+	capture->staged += out - start;
+}
+
+/* the stream as it came from the port, in hex */
+void capture_raw(capture_t *capture, const uint8_t *buf, long size)
+{
+	uint8_t *out;
+	long i;
+
+	for (i = 0; i < size; i++) {
+		out = capture_reserve(capture, 3);
+		out[0] = hex_digits[buf[i] >> 4];
+		out[1] = hex_digits[buf[i] & 0x0F];
+		out[2] = ' ';
+		capture->staged += 3;
+	}
+}
+
+/* path NULL is stdout */
+int capture_open(capture_t *capture, const char *path, capture_format_t format)
+{
+	uint8_t *out;
+
+	memset(capture, 0, sizeof(*capture));
+	capture->format = format;
+
+	if (path == NULL) {
+		capture->fd = STDOUT_FILENO;
+	} else {
+		capture->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_BINARY, 0644);
+		if (capture->fd < 0) {
+			fprintf(stderr, " Error creating capture file %s\n", path);
+			return -1;
+		}
+	}
+
+	capture->stage = malloc(CAPTURE_STAGE_SIZE);
+	capture->ring = malloc(CAPTURE_RING_SIZE);
+	if (capture->stage == NULL || capture->ring == NULL) {
+		fprintf(stderr, " Error allocating capture buffers\n");
+		return -1;
+	}
+
+	pthread_mutex_init(&capture->lock, NULL);
+	pthread_cond_init(&capture->more, NULL);
+	pthread_cond_init(&capture->room, NULL);
+	if (pthread_create(&capture->thread, NULL, capture_writer, capture) != 0) {
+		fprintf(stderr, " Error starting the capture writer\n");
+		return -1;
+	}
+
+	out = capture->stage;
+	if (format == CAPTURE_BIN) {
+		memcpy(out, "BPSNIFF\x01", 8);
+		capture->staged = 8;
+	} else if (format == CAPTURE_PCAP) {
+		out = capture_put_le(out, PCAP_MAGIC, 4);
+		out = capture_put_le(out, 2, 2);  //version 2.4
+		out = capture_put_le(out, 4, 2);
+		out = capture_put_le(out, 0, 4);  //GMT
+		out = capture_put_le(out, 0, 4);  //timestamp accuracy
+		out = capture_put_le(out, PCAP_SNAPLEN, 4);
+		out = capture_put_le(out, PCAP_LINKTYPE_USER, 4);
+		capture->staged = out - capture->stage;
+	}
+	return 0;
+}
+
+/* flushes everything, stops the writer and closes the file; -1 if writing failed */
+int capture_close(capture_t *capture)
+{
+	capture_flush(capture);
+
+	pthread_mutex_lock(&capture->lock);
+	capture->closing = 1;
+	pthread_cond_signal(&capture->more);
+	pthread_mutex_unlock(&capture->lock);
+	pthread_join(capture->thread, NULL);
+
+	if (capture->fd != STDOUT_FILENO)
+		close(capture->fd);
+
+	pthread_mutex_destroy(&capture->lock);
+	pthread_cond_destroy(&capture->more);
+	pthread_cond_destroy(&capture->room);
+	free(capture->stage);
+	free(capture->ring);
+
+	return capture->error ? -1 : 0;
+}
@@ -0,0 +1,77 @@
+/*
+ * This file is part of the Bus Pirate project (http://code.google.com/p/the-bus-pirate/).
+ *
+ * Written and maintained by the Bus Pirate project and http://dangerousprototypes.com
+ *
+ * To the extent possible under law, the project has
+ * waived all copyright and related or neighboring rights to Bus Pirate. This
+ * work is published from United States.
+ *
+ * For details see: http://creativecommons.org/publicdomain/zero/1.0/.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ */
+/*
+ * Sniffer capture output
+ *
+ * Transactions are formatted into a staging buffer while a read block is
+ * decoded, then handed in one piece to a ring drained by a writer thread,
+ * so a slow terminal or disk does not hold up reading the port.
+ *
+ * Formats:
+ *  text  [0xMOSI(0xMISO)...] per line, "Sync" before a transaction after a
+ *        sync loss, as the sniffer always printed
+ *  bin   "BPSNIFF" 0x01, then per transaction: timestamp in microseconds
+ *        (8 bytes), byte pair count (4 bytes), flags (1 byte), the MOSI
+ *        bytes, the MISO bytes; numbers are little endian
+ *  pcap  libpcap file with LINKTYPE_USER0 packets holding the flags byte,
+ *        the MOSI bytes and the MISO bytes of one transaction
+ *
+ */
+#ifndef CAPTURE_H_
+#define CAPTURE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#include "decoder.h"
+
+#define CAPTURE_STAGE_SIZE (1024 * 1024)        // holds the text of the longest transaction
+#define CAPTURE_RING_SIZE  (16 * 1024 * 1024)
+
+typedef enum {
+	CAPTURE_TEXT,
+	CAPTURE_BIN,
+	CAPTURE_PCAP
+} capture_format_t;
+
+typedef struct {
+	int fd;
+	capture_format_t format;
+
+	uint8_t *stage;
+	size_t staged;
+
+	uint8_t *ring;
+	unsigned long long head;    // total bytes put in the ring
+	unsigned long long tail;    // total bytes written out
+	pthread_t thread;
+	pthread_mutex_t lock;
+	pthread_cond_t more;
+	pthread_cond_t room;
+	int closing;
+	int error;
+
+	unsigned long long stalls;  // times the ring was full and decoding waited
+} capture_t;
+
+int capture_open(capture_t *capture, const char *path, capture_format_t format);
+void capture_transaction(void *context, const sniff_transaction_t *transaction);
+void capture_raw(capture_t *capture, const uint8_t *buf, long size);
+void capture_flush(capture_t *capture);
+int capture_close(capture_t *capture);
+
+#endif
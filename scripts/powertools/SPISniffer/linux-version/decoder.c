@@ -0,0 +1,142 @@
+/*
+ * This file is part of the Bus Pirate project (http://code.google.com/p/the-bus-pirate/).
+ *
+ * Written and maintained by the Bus Pirate project and http://dangerousprototypes.com
+ *
+ * To the extent possible under law, the project has
+ * waived all copyright and related or neighboring rights to Bus Pirate. This
+ * work is published from United States.
+ *
+ * For details see: http://creativecommons.org/publicdomain/zero/1.0/.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include <string.h>
+
+#include "decoder.h"
+
+#define CS_LOW   '['
+#define CS_HIGH  ']'
+#define DATA     '\\'
+
+enum {
+	STATE_IDLE,    // waiting for CS low
+	STATE_HUNT,    // lost sync, skipping to the next CS low
+	STATE_FRAME,   // CS is low, waiting for data or CS high
+	STATE_MOSI,
+	STATE_MISO
+};
+
+void decoder_init(sniff_decoder_t *decoder, sniff_callback_t callback, void *context)
+{
+	memset(&decoder->stats, 0, sizeof(decoder->stats));
+	decoder->state = STATE_IDLE;
+	decoder->count = 0;
+	decoder->flags = 0;
+	decoder->callback = callback;
+	decoder->context = context;
+}
+
+static void decoder_emit(sniff_decoder_t *decoder, uint32_t count, uint8_t flags, uint64_t timestamp_us)
+{
+	sniff_transaction_t transaction;
+
+	transaction.mosi = decoder->mosi;
+	transaction.miso = decoder->miso;
+	transaction.count = count;
+	transaction.flags = flags;
+	transaction.timestamp_us = timestamp_us;
+
+	decoder->stats.transactions++;
+	decoder->stats.pairs += count;
+	decoder->callback(decoder->context, &transaction);
+}
+
+/*
+ * Decodes a block as read from the port.  The state is kept in locals while
+ * walking the block and only written back at the end.
+ */
+void decoder_feed(sniff_decoder_t *decoder, const uint8_t *buf, long size, uint64_t timestamp_us)
+{
+	const uint8_t *end = buf + size;
+	int state = decoder->state;
+	uint32_t count = decoder->count;
+	uint8_t flags = decoder->flags;
+	uint8_t c;
+
+	decoder->stats.bytes += size;
+
+	while (buf < end) {
+		c = *buf++;
+
+		switch (state) {
+			case STATE_MOSI:
+				decoder->mosi[count] = c;
+				state = STATE_MISO;
+				break;
+
+			case STATE_MISO:
+				decoder->miso[count++] = c;
+				state = STATE_FRAME;
+				if (count == SNIFF_MAX_PAIRS) {
+					decoder_emit(decoder, count, flags | SNIFF_FLAG_SPLIT, timestamp_us);
+					count = 0;
+					flags = 0;
+				}
+				break;
+
+			case STATE_FRAME:
+				if (c == DATA) {
+					state = STATE_MOSI;
+				} else if (c == CS_HIGH) {
+					decoder_emit(decoder, count, flags, timestamp_us);
+					count = 0;
+					flags = 0;
+					state = STATE_IDLE;
+				} else {
+					decoder->stats.sync_losses++;
+					decoder_emit(decoder, count, flags | SNIFF_FLAG_SYNC_LOST, timestamp_us);
+					count = 0;
+					//a '[' without the ']' before it still starts a transaction
+					flags = SNIFF_FLAG_RESYNC;
+					state = (c == CS_LOW) ? STATE_FRAME : STATE_HUNT;
+				}
+				break;
+
+			case STATE_IDLE:
+				if (c == CS_LOW) {
+					state = STATE_FRAME;
+				} else {
+					decoder->stats.sync_losses++;
+					state = STATE_HUNT;
+				}
+				break;
+
+			case STATE_HUNT:
+			default:
+				if (c == CS_LOW) {
+					flags = SNIFF_FLAG_RESYNC;
+					state = STATE_FRAME;
+				}
+				break;
+		}
+	}
+
+	decoder->state = state;
+	decoder->count = count;
+	decoder->flags = flags;
+}
+
+/* hands out a transaction still open when the capture stops */
+void decoder_finish(sniff_decoder_t *decoder, uint64_t timestamp_us)
+{
+	if (decoder->state == STATE_FRAME || decoder->state == STATE_MOSI || decoder->state == STATE_MISO)
+		decoder_emit(decoder, decoder->count, decoder->flags | SNIFF_FLAG_OPEN, timestamp_us);
+
+	decoder->state = STATE_IDLE;
+	decoder->count = 0;
+	decoder->flags = 0;
+}
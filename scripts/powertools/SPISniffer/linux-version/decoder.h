@@ -0,0 +1,72 @@
+/*
+ * This file is part of the Bus Pirate project (http://code.google.com/p/the-bus-pirate/).
+ *
+ * Written and maintained by the Bus Pirate project and http://dangerousprototypes.com
+ *
+ * To the extent possible under law, the project has
+ * waived all copyright and related or neighboring rights to Bus Pirate. This
+ * work is published from United States.
+ *
+ * For details see: http://creativecommons.org/publicdomain/zero/1.0/.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ */
+/*
+ * Binary mode SPI sniffer stream decoder
+ *
+ * The firmware (spi_sniffer() in Firmware/spi.c) sends '[' when CS goes
+ * low, '\' MOSI MISO for every byte on the bus and ']' when CS goes high.
+ * The decoder takes whatever block the port returned and turns it into one
+ * callback per CS transaction.  Anything that does not fit the framing is
+ * a sync loss: the open transaction is handed out flagged, bytes are
+ * skipped up to the next '[' and the transaction started there is flagged
+ * as well.
+ *
+ */
+#ifndef DECODER_H_
+#define DECODER_H_
+
+#include <stdint.h>
+
+#define SNIFF_MAX_PAIRS      65536  // longer transactions are handed out in pieces
+
+#define SNIFF_FLAG_SYNC_LOST 0x01   // framing broke inside it, it may be cut short
+#define SNIFF_FLAG_RESYNC    0x02   // first one after a sync loss, its start is a guess
+#define SNIFF_FLAG_SPLIT     0x04   // continues in the next transaction, CS stayed low
+#define SNIFF_FLAG_OPEN      0x08   // the capture ended before CS went high
+
+typedef struct {
+	const uint8_t *mosi;
+	const uint8_t *miso;
+	uint32_t count;               // byte pairs
+	uint8_t flags;
+	uint64_t timestamp_us;        // host time of the block that closed it
+} sniff_transaction_t;
+
+typedef void (*sniff_callback_t)(void *context, const sniff_transaction_t *transaction);
+
+typedef struct {
+	unsigned long long bytes;     // stream bytes decoded
+	unsigned long long pairs;
+	unsigned long long transactions;
+	unsigned long long sync_losses;
+} sniff_stats_t;
+
+typedef struct {
+	int state;
+	uint32_t count;
+	uint8_t flags;
+	uint8_t mosi[SNIFF_MAX_PAIRS];
+	uint8_t miso[SNIFF_MAX_PAIRS];
+	sniff_callback_t callback;
+	void *context;
+	sniff_stats_t stats;
+} sniff_decoder_t;
+
+void decoder_init(sniff_decoder_t *decoder, sniff_callback_t callback, void *context);
+void decoder_feed(sniff_decoder_t *decoder, const uint8_t *buf, long size, uint64_t timestamp_us);
+void decoder_finish(sniff_decoder_t *decoder, uint64_t timestamp_us);
+
+#endif
@@ -18,6 +18,9 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <string.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <sys/time.h>
 
 #ifdef WIN32
 #include <conio.h>
@@ -26,8 +29,10 @@
 //#include <curses.h>
 #endif
 
-#include "buspirate.h"
+#include "libbuspirate.h"
 #include "serial.h"
+#include "decoder.h"
+#include "capture.h"
 
 int modem =FALSE;   //set this to TRUE of testing a MODEM
 int verbose = 0;
@@ -35,7 +40,23 @@ int disable_comport = 0;   //1 to say yes, disable comport, any value to enable
 int dumphandle;     // use by dump file when using the -d dumfile.txt parameter
 char *dumpfile;
 
-#define SPI 0x01
+#define READ_BLOCK_SIZE 65536  //whatever the port has buffered, up to this, is decoded in one go
+
+static volatile sig_atomic_t stop = 0;
+
+static void stop_handler(int sig)
+{
+    (void)sig;
+    stop = 1;
+}
+
+static uint64_t now_us(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return (uint64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+}
 
 int print_usage(char * appname)
 	{
@@ -45,7 +66,8 @@ int print_usage(char * appname)
 	  printf("-------------------------------------------------------\n");
 		printf("\n");
         printf(" Usage:              \n");
-		printf("   %s  -d device -e 1 -p 0 \n ",appname);
+		printf("   %s  -d device -e 1 -p 0 [-o capture -f text|bin|pcap] \n ",appname);
+		printf("   %s  -i stream.raw [-o capture -f text|bin|pcap] \n ",appname);
 		printf("\n");
 		printf("   Example Usage:   %s COM1 -s Speed -e 1 -p 0 \n",appname);
 		printf("\n");
@@ -54,6 +76,9 @@ int print_usage(char * appname)
 		printf("                  -e ClockEdge is 0 or 1  default is 1 \n");
 		printf("                  -p Polarity  is 0 or 1  default is 0 \n");
 		printf("                  -r RawData is 0 or 1  default is 0 \n");
+		printf("                  -o Capture file, default is the screen \n");
+		printf("                  -f Capture format text, bin or pcap  default is text \n");
+		printf("                  -i Decode a saved sniffer stream instead of a port \n");
 		printf("\n");
 
         printf("\n");
@@ -70,15 +95,25 @@ int main(int argc, char** argv)
 {
 int opt;
   char buffer[256] = {0}, i;
+  static uint8_t block[READ_BLOCK_SIZE];
+  sniff_decoder_t *decoder;
+  capture_t capture;
+  bp_t *bp;
+  capture_format_t format = CAPTURE_TEXT;
+  uint64_t started, decode_us = 0, t;
+  double elapsed;
+  int input = -1, raw;
   int fd;
-  int res,c;
-  int new_state,state=0;
+  int res;
 
   char *param_port = NULL;
   char *param_speed = NULL;
   char *param_polarity=NULL;
   char *param_clockedge=NULL;
   char *param_rawdata=NULL;
+  char *param_output=NULL;
+  char *param_format=NULL;
+  char *param_input=NULL;
 
 //  int clock_edge;
 // int polarity;
@@ -105,7 +140,7 @@ if (argc <= 1)  {
 		exit(-1);
 	}
 
-while ((opt = getopt(argc, argv, "ms:p:e:d:r:")) != -1) {
+while ((opt = getopt(argc, argv, "ms:p:e:d:r:o:f:i:")) != -1) {
        // printf("%c  \n",opt);
 		switch (opt) {
 
@@ -147,6 +182,15 @@ while ((opt = getopt(argc, argv, "ms:p:e:d:r:")) != -1) {
 				}
 				param_rawdata = strdup(optarg);
 
+				break;
+			case 'o':
+				param_output = strdup(optarg);
+				break;
+			case 'f':
+				param_format = strdup(optarg);
+				break;
+			case 'i':
+				param_input = strdup(optarg);
 				break;
 			case 'm':    //modem debugging for testing
                    modem =TRUE;   // enable modem mode
@@ -166,7 +210,22 @@ while ((opt = getopt(argc, argv, "ms:p:e:d:r:")) != -1) {
 
     //param_port=strdup("COM3");
     //Set default if NULL
-    if (param_port==NULL){
+    if (param_format!=NULL) {
+        if (strcmp(param_format, "bin")==0)
+            format=CAPTURE_BIN;
+        else if (strcmp(param_format, "pcap")==0)
+            format=CAPTURE_PCAP;
+        else if (strcmp(param_format, "text")!=0) {
+            printf("Capture format should be text, bin or pcap\n");
+            exit(-1);
+        }
+        if (format!=CAPTURE_TEXT && param_output==NULL) {
+            printf("Binary captures need a file, use -o\n");
+            exit(-1);
+        }
+    }
+
+    if (param_port==NULL && param_input==NULL){
         printf("No serial port set\n");
 		print_usage(argv[0]);
 		exit(-1);
@@ -185,6 +244,29 @@ while ((opt = getopt(argc, argv, "ms:p:e:d:r:")) != -1) {
           param_rawdata=strdup("0");
 
 
+    raw = (strncmp(param_rawdata, "1", 1)==0);
+
+    decoder = malloc(sizeof(*decoder));
+    if (decoder==NULL || capture_open(&capture, param_output, format) < 0) {
+        fprintf(stderr, "Error setting up the capture\n");
+        exit(-1);
+    }
+    decoder_init(decoder, capture_transaction, &capture);
+
+    signal(SIGINT, stop_handler);
+    signal(SIGTERM, stop_handler);
+
+    if (param_input!=NULL) {
+        input = open(param_input, O_RDONLY);
+        if (input < 0) {
+            fprintf(stderr, "Error opening %s\n", param_input);
+            exit(-1);
+        }
+        fd = input;
+        fprintf(stderr, " Decoding %s...\n", param_input);
+        goto sniff;
+    }
+
     printf("\n  Parameters used: Device = %s,  Speed = %s, Clock Edge= %s, Polarity= %s\n\n",param_port,param_speed,param_clockedge,param_polarity);
 
 
@@ -230,23 +312,34 @@ while ((opt = getopt(argc, argv, "ms:p:e:d:r:")) != -1) {
 
 
           fprintf(stderr, " Configuring Bus Pirate...\n");
-   	      BP_EnableMode(fd, SPI); //enter BBIO then SPI
+          printf(" Entering binary mode...\n");
+          bp = bp_attach(fd);
+          res = bp_enter_mode(bp, BP_MODE_SPI); //enter BBIO then SPI
     //
 	//Start sniffer
 	//
 
     //configure according to user settings
     //1000wxyz - SPI config, w=HiZ/3.3v, x=CKP idle, y=CKE edge, z=SMP sample
-            i=0x80;
+            i=0;
             if(strncmp(param_clockedge, "1", 1)==0)
-                i|=0x02;
+                i|=BP_SPI_CKE_ACTIVE;
             if(strncmp(param_polarity, "1", 1)==0)
-                i|=0x04;
+                i|=BP_SPI_CKP_HIGH;
 
-            BP_WriteToPirate(fd, &i);
+            if (res==BP_OK)
+                res = bp_config(bp, i);
 
-    //start the sniffer
-             serial_write( fd, "\x0E", 1);
+    //start the sniffer, it acknowledges with 0x01 before the stream starts
+            if (res==BP_OK)
+                res = bp_spi_sniff(bp, 0);
+
+            //the stream is read straight from the port below
+            bp_detach(bp);
+            if (res!=BP_OK) {
+                fprintf(stderr, "Buspirate did not respond correctly :( %s\n", bp_strerror(res));
+                exit(-1);
+            }
 
     //
     // Done with setup
@@ -254,75 +347,79 @@ while ((opt = getopt(argc, argv, "ms:p:e:d:r:")) != -1) {
 	}
 
 
-	printf(" (OK) Happy sniffing! Press ESC to stop.\n");
+	fprintf(stderr, " (OK) Happy sniffing! Press %s to stop.\n",
+#ifdef WIN32
+	        "ESC"
+#else
+	        "Ctrl-C"
+#endif
+	        );
+
+sniff:
+    //the capture goes to the same stdout from the writer thread
+    fflush(stdout);
 
     //
-    // Loop and print input from the serial port
+    // Decode whatever the port has, in big blocks, until stopped
     //
-	 while(1){
-
-        usleep(1);
-        res= serial_read(fd, buffer, 100);
-
-        if(res>0){
-            for(c=0; c<res; c++){
-            if(strncmp(param_rawdata, "1", 1)==0) printf("%02X ", (uint8_t)buffer[c]);
-	    else {
-		switch(state) {
-			default:
-			case 0:	// waiting CS active
-				if (buffer[c]==0x5B) {
-					printf("[");
-					new_state=1;
-		  		} else {
-					printf("Sync\n");
-					new_state=0;
-				}
-				break;
-			case 1:	// check for data or CS inactive
-				if (buffer[c]==0x5C) {
-					new_state=2;
-				} else if (buffer[c]==0x5D) {
-					printf("]\n");
-					new_state=0;
-				} else {
-					printf("Sync\n");
-					new_state=0;
-				}
-				break;
-			case 2:	// MPI
-				printf("0x%02X(", (uint8_t) buffer[c]);
-				new_state=3;
-				break;
-			case 3:	// MPO
-				printf("0x%02X)", (uint8_t) buffer[c]);
-				new_state=1;
-				break;
-		}
-		state=new_state;
-	    }
-            }
+	started = now_us();
+	while (!stop) {
+
+        if (input >= 0)
+            res = read(input, block, sizeof(block));
+        else
+            res = serial_read_block(fd, (char *)block, sizeof(block));
+
+        if (res < 0 || (res == 0 && input >= 0))
+            break;
+
+        if (res > 0) {
+            t = now_us();
+            if (raw)
+                capture_raw(&capture, block, res);
+            else
+                decoder_feed(decoder, block, res, t);
+            decode_us += now_us() - t;
+
+            //one hand over to the writer thread per block
+            capture_flush(&capture);
         }
 
 #ifdef WIN32
         if(kbhit()){
-           c = getch();
-
-           if(c == 27){
-                printf("\n Esc key hit, stopping...\n");
-                printf(" Clean up Bus Pirate...\n");
-                buffer[0]=0x00;//exit sniffer
-                buffer[1]=0x00;//exit spi
-                buffer[2]=0x0f;//exit BBIO
-                res = serial_write( fd, buffer, 3);
-                printf(" (Bye for now!)\n");
-                break;
+           res = getch();
+
+           if(res == 27){
+                fprintf(stderr, "\n Esc key hit, stopping...\n");
+                stop = 1;
             }
         }
 #endif
 
     }    //hit enter to stop
 
+    if (input < 0) {
+        fprintf(stderr, " Clean up Bus Pirate...\n");
+        buffer[0]=0x00;//exit sniffer
+        buffer[1]=0x00;//exit spi
+        buffer[2]=0x0f;//exit BBIO
+        res = serial_write( fd, buffer, 3);
+        fprintf(stderr, " (Bye for now!)\n");
+    }
+
+    decoder_finish(decoder, now_us());
+    if (capture_close(&capture) < 0)
+        fprintf(stderr, " Error writing the capture\n");
+
+    elapsed = (now_us() - started) / 1e6;
+    fprintf(stderr, " Read %llu bytes in %.2fs, %llu transactions, %llu byte pairs, %llu sync losses\n",
+            decoder->stats.bytes, elapsed, decoder->stats.transactions, decoder->stats.pairs,
+            decoder->stats.sync_losses);
+    if (decode_us > 0)
+        fprintf(stderr, " Decoding took %.3fs, %.1f MB/s, the writer was waited for %llu times\n",
+                decode_us / 1e6, decoder->stats.bytes / (double)decode_us, capture.stalls);
+    free(decoder);
+
 #define FREE(x) if(x) free(x);
 
 	FREE(param_port);
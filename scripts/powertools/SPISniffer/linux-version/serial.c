@@ -24,6 +24,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <fcntl.h>
+#include <errno.h>
 
 #include <string.h>
 
@@ -276,6 +277,29 @@ else
 return len;
 }
 
+/*
+ * One read of whatever the port has buffered, up to size bytes.  Waits no
+ * longer than the VTIME (or COMMTIMEOUTS) set by serial_setup() when nothing
+ * is there, and then returns 0.
+ */
+int serial_read_block(int fd, char *buf, int size)
+{
+	int ret;
+#ifdef WIN32
+	HANDLE hCom = (HANDLE)fd;
+	unsigned long bread = 0;
+
+	if (!ReadFile(hCom, buf, size, &bread, NULL))
+		return -1;
+	ret = bread;
+#else
+	ret = read(fd, buf, size);
+	if (ret < 0 && errno == EINTR)
+		ret = 0;
+#endif
+	return ret;
+}
+
 int serial_open(char *port)
 {
 	int fd;
@@ -82,6 +82,7 @@ typedef long speed_t;
 int serial_setup(int fd, speed_t speed);
 int serial_write(int fd, char *buf, int size);
 int serial_read(int fd, char *buf, int size);
+int serial_read_block(int fd, char *buf, int size);
 int serial_open(char *port);
 int serial_close(int fd);
 
@@ -11,7 +11,7 @@
 //#include <curses.h>
 #endif
 
-#include "..\framework\buspirate.h"
+#include "libbuspirate.h"
 #include "..\framework\serial.h"
 
  int modem =FALSE;   //set this to TRUE of testing a MODEM
@@ -21,7 +21,6 @@ int disable_comport = 0;   //1 to say yes, disable comport, any value to enable
  int dumphandle;     // use by dump file when using the -d dumfile.txt parameter
  char *dumpfile;
 
-#define SPI 0x01
 #ifndef WIN32
 #define usleep(x) Sleep(x);
 #endif
@@ -59,6 +58,7 @@ int print_usage(char * appname)
 
    char buffer[256] = {0}, i;
    int fd;
+   bp_t *bp;
    int res,c;
 
 
@@ -213,16 +213,13 @@ while ((opt = getopt(argc, argv, "ms:p:e:d:r:")) != -1) {
  	          res= serial_read(fd, buffer, sizeof(buffer));
  	          printf("\n %s\n",buffer);
  	}
-
+    else
+    {
     fprintf(stderr, " Configuring Bus Pirate...\n");
-  	      //BP_EnableMode(fd, SPI); //enter BBIO then SPI
-  	if(BP_EnableBinary(fd)!=BBIO){
-             fprintf(stderr, " Buspirate cannot switch to binary mode :( \n");
-             fprintf(stderr, " Exiting...\n");
-             return -1;
-   	 }
-    if(BP_EnableMode(fd , SPI)!=SPI){
-             fprintf(stderr, " Buspirate cannot switch to SPI mode :( \n");
+    bp = bp_attach(fd);
+    res = bp_enter_mode(bp, BP_MODE_SPI); //enter BBIO then SPI
+    if (res != BP_OK){
+             fprintf(stderr, " Buspirate cannot switch to SPI mode :( %s\n", bp_strerror(res));
              fprintf(stderr, " Exiting...\n");
              return -1;
      }
@@ -230,26 +227,33 @@ while ((opt = getopt(argc, argv, "ms:p:e:d:r:")) != -1) {
      //configure according to user settings
      //1000wxyz - SPI config, w=HiZ/3.3v, x=CKP idle, y=CKE edge, z=SMP sample
     printf(" Setting Clockedge/Polarity ......");
-    i=0x80;
+    i=0;
     if(strncmp(param_clockedge, "1", 1)==0){
         printf(" CKE=1");
-        i|=0x02;
+        i|=BP_SPI_CKE_ACTIVE;
     }
 
 
     if(strncmp(param_polarity, "1", 1)==0){
         printf(" CKP=1");
-        i|=0x04;
+        i|=BP_SPI_CKP_HIGH;
     }
 
 
-    if (BP_WriteToPirate(fd, &i)==0)
+    if (bp_config(bp, i)==BP_OK)
          printf("OK\n");
     else
          printf("WARNING.. Not Good\n");
 
-     //start the sniffer
-    serial_write( fd, "\x0E", 1);
+     //start the sniffer, the stream is read straight from the port below
+    res = bp_spi_sniff(bp, 0);
+    bp_detach(bp);
+    if (res != BP_OK){
+             fprintf(stderr, " Buspirate did not start the sniffer :( %s\n", bp_strerror(res));
+             fprintf(stderr, " Exiting...\n");
+             return -1;
+     }
+    }
      //
      // Done with setup
      //
@@ -21,7 +21,7 @@
 #include <string.h>
 #include <windef.h>
 
-#include "..\framework\buspirate.h"
+#include "libbuspirate.h"
 #include "..\framework\serial.h"
 
 
@@ -63,6 +63,7 @@ int main(int argc, char** argv)
   int opt;
   char buffer[256] = {0}, i;
   int fd;
+  bp_t *bp;
   int res,c;
   int flag=0,firsttime=0;
   char *param_port = NULL;
@@ -227,9 +228,12 @@ while ((opt = getopt(argc, argv, "mRs:d:")) != -1) {
 
 
           fprintf(stderr, " Configuring Bus Pirate...\n");
-   	      //BP_EnableMode(fd, SPI); //enter BBIO then SPI
-   	      if(BP_EnableBinary(fd)!=BBIO){
-                fprintf(stderr, " Buspirate cannot switch to binary mode :( \n");
+          //the self-test result is read straight from the port below
+          bp = bp_attach(fd);
+          res = bp_enter_bbio(bp);
+          bp_detach(bp);
+          if(res!=BP_OK){
+                fprintf(stderr, " Buspirate cannot switch to binary mode :( %s\n", bp_strerror(res));
                 return -1;
    	 }
     //
@@ -66,6 +66,20 @@ def unquote_string(string):
     return new_string.getvalue()
 
 
+def quote_string(string):
+    quoted = io.StringIO()
+
+    for character in string:
+        if character in MAPPING_OUT:
+            quoted.write(MAPPING_OUT[character])
+        elif (ord(character) < 0x20) or (ord(character) > 0x7E):
+            quoted.write('\\x%02X' % ord(character))
+        else:
+            quoted.write(character)
+
+    return quoted.getvalue()
+
+
 def get_messages(handle):
     read_lines = []
 
@@ -98,6 +112,139 @@ def get_messages(handle):
     return read_lines
 
 
+# Dictionary tokens take the byte values not used by plain ASCII text.  Each
+# token expands into a pair of symbols, either plain characters or other
+# tokens, in a byte-pair encoding fashion.
+FIRST_TOKEN = 0x80
+MAX_TOKENS = 0x100 - FIRST_TOKEN
+
+# The firmware expands tokens with a fixed-size stack, so keep the token
+# nesting level bounded.
+MAX_TOKEN_DEPTH = 8
+
+
+def replace_pair(symbols, pair, token):
+    replaced = []
+    index = 0
+
+    while index < len(symbols):
+        if (index < len(symbols) - 1) and \
+           (symbols[index] == pair[0]) and (symbols[index + 1] == pair[1]):
+            replaced.append(token)
+            index += 2
+        else:
+            replaced.append(symbols[index])
+            index += 1
+
+    return replaced
+
+
+def build_dictionary(lines):
+    sequences = []
+    for row in lines:
+        symbols = [ord(character) for character in row[2]]
+        for symbol in symbols:
+            if symbol == 0 or symbol >= FIRST_TOKEN:
+                raise Exception('Invalid character 0x%02X in %s' %
+                                (symbol, row[0]))
+        sequences.append(symbols)
+
+    dictionary = []
+    depths = {}
+
+    while len(dictionary) < MAX_TOKENS:
+        counts = {}
+        for symbols in sequences:
+            for index in range(len(symbols) - 1):
+                pair = (symbols[index], symbols[index + 1])
+                counts[pair] = counts.get(pair, 0) + 1
+
+        candidates = [(count, pair) for pair, count in counts.items()
+                      if max(depths.get(pair[0], 0),
+                             depths.get(pair[1], 0)) < MAX_TOKEN_DEPTH]
+        if len(candidates) == 0:
+            break
+
+        # Highest count first, lowest pair value on ties to keep the output
+        # stable across runs.
+        count, pair = min(candidates, key=lambda item: (-item[0], item[1]))
+
+        # Each dictionary entry costs two bytes, and replacing a pair saves
+        # one byte per occurrence.
+        if count <= 2:
+            break
+
+        token = FIRST_TOKEN + len(dictionary)
+        dictionary.append(pair)
+        depths[token] = max(depths.get(pair[0], 0),
+                            depths.get(pair[1], 0)) + 1
+        sequences = [replace_pair(symbols, pair, token)
+                     for symbols in sequences]
+
+    for row, symbols in zip(lines, sequences):
+        row[2] = ''.join(chr(symbol) for symbol in symbols)
+
+    return dictionary, max(depths.values(), default=0)
+
+
+def expand_token(dictionary, symbol):
+    if symbol < FIRST_TOKEN:
+        return chr(symbol)
+
+    pair = dictionary[symbol - FIRST_TOKEN]
+    return expand_token(dictionary, pair[0]) + \
+        expand_token(dictionary, pair[1])
+
+
+def pack_words(symbols):
+    # Program memory words hold three bytes each, returned here as the values
+    # obtained by the firmware via TBLRDL and TBLRDH respectively.
+    padded = symbols + [0] * (-len(symbols) % 3)
+    return [(padded[index] | (padded[index + 1] << 8), padded[index + 2])
+            for index in range(0, len(padded), 3)]
+
+
+def read_packed_byte(words, offset):
+    low, high = words[offset // 3]
+    return (low & 0xFF, low >> 8, high & 0xFF)[offset % 3]
+
+
+def unpack_message(words, dictionary_words, token_depth):
+    # Mirrors bp_message_write_buffer in Firmware/messages.c.
+    decoded = io.StringIO()
+
+    for low, high in words:
+        for symbol in (low & 0xFF, low >> 8, high & 0xFF):
+            if symbol == 0:
+                return decoded.getvalue()
+
+            pending = [symbol]
+            while len(pending) > 0:
+                symbol = pending.pop()
+                if symbol < FIRST_TOKEN:
+                    decoded.write(chr(symbol))
+                    continue
+
+                entry = (symbol - FIRST_TOKEN) << 1
+                pending.append(read_packed_byte(dictionary_words, entry + 1))
+                pending.append(read_packed_byte(dictionary_words, entry))
+                if len(pending) > token_depth + 1:
+                    raise Exception('Token expansion stack overflow')
+
+    raise Exception('Unterminated message')
+
+
+def verify_messages(originals, lines, dictionary, token_depth):
+    dictionary_words = pack_words(
+        [symbol for pair in dictionary for symbol in pair])
+
+    for original, row in zip(originals, lines):
+        words = pack_words([ord(character) for character in row[2]] + [0])
+        if unpack_message(words, dictionary_words, token_depth) != original:
+            raise Exception('Packed message %s does not decode back to its '
+                            'original text' % row[0])
+
+
 parser = argparse.ArgumentParser(
     description='Pack Bus Pirate strings into something that can be '
                 'included by the firmware.')
@@ -111,8 +258,24 @@ parser.add_argument('guard', metavar='GUARD', type=str,
 
 args = parser.parse_args()
 lines = get_messages(args.source)
+originals = [row[2] for row in lines]
+dictionary, token_depth = build_dictionary(lines)
+verify_messages(originals, lines, dictionary, token_depth)
 
 with open(args.outbase + '.s', 'w') as assembly_output:
+    assembly_output.write('\t; Message dictionary\n')
+    for index in range(len(dictionary)):
+        expansion = expand_token(dictionary, FIRST_TOKEN + index)
+        assembly_output.write('\t; <%d> "%s"\n' % (
+            FIRST_TOKEN + index, quote_string(expansion)))
+    assembly_output.write('\t.section .text.bp_message_dictionary, code\n')
+    assembly_output.write('\t.global _bp_message_dictionary\n')
+    assembly_output.write('_bp_message_dictionary:\n')
+    if len(dictionary) > 0:
+        assembly_output.write('\t.pbyte %s\n' % ', '.join(
+            '0x%02X' % symbol for pair in dictionary for symbol in pair))
+    assembly_output.write('\n')
+
     for row in sorted(lines):
         assembly_output.write('\t; %s\n' % row[0])
         assembly_output.write('\t.section .text.%s, code\n' % row[0])
@@ -152,6 +315,13 @@ with open(args.outbase + '.h', 'w') as header_output:
     header_output.write('#ifndef BP_MESSAGES_%s_H\n' % args.guard.upper())
     header_output.write('#define BP_MESSAGES_%s_H\n\n' % args.guard.upper())
 
+    header_output.write('#define BP_MESSAGE_FIRST_TOKEN 0x%02X\n' %
+                        FIRST_TOKEN)
+    header_output.write('#define BP_MESSAGE_TOKEN_DEPTH %d\n' % token_depth)
+    header_output.write('void bp_message_dictionary(void);\n')
+    header_output.write('#define BP_MESSAGE_DICTIONARY '
+                        '__builtin_tbladdress(bp_message_dictionary)\n\n')
+
     for row in sorted(lines):
         call = BUFFER_WRITE_CALL if row[1] == '0' else LINE_WRITE_CALL
         header_output.write('void %s_str(void);\n' % row[0])
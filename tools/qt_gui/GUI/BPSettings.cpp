@@ -194,9 +194,7 @@ void BPSettingsGui::resetBBIO()
 
 void BPSettingsGui::getBuffer()
 {
-	parent->bp->serial->flush();
 	parent->bp->dumpBuffer();
-	parent->bp->serial->flush();
 }
 
 BPSettingsGui::~BPSettingsGui()
@@ -216,17 +214,6 @@ void BPSettingsGui::SaveSettings()
 	parent->cfg->Save();
 }
 
-void BPSettingsGui::setConfigSettings()
-{
-	qDebug() << "set Port Settings";
-	parent->bp->serial->setPortName(s_port->text());
-	parent->bp->serial->setBaudRate((BaudRateType)usable_baud_rate->value(s_baud->currentText(), BAUD115200)); //BAUD115200
-	parent->bp->serial->setDataBits((DataBitsType)s_databits->currentIndex());  //DATA_8
-	parent->bp->serial->setStopBits((StopBitsType)s_stopbits->currentIndex());  //STOP_1
-	parent->bp->serial->setParity((ParityType)s_parity->currentIndex());      //PAR_NONE
-	parent->bp->serial->setFlowControl((FlowType)s_flow->currentIndex());      //FLOW_OFF
-}
-
 void BPSettingsGui::openPort()
 {
 	QString qmsg = QString("Bus Pirate Ready");
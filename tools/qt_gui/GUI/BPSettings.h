@@ -76,7 +76,6 @@ public:
 	QComboBox *s_flow;
 	QMap<QString, int> *usable_baud_rate;
 	MainWidgetFrame *parent;
-	void setConfigSettings();
 	//void setupBusPirate();
 public slots:
 	void SaveSettings();
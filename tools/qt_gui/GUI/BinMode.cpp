@@ -5,64 +5,440 @@
 #include "BPSettings.h"
 #include "BinMode.h"
 
+/* progress is passed on at most this often */
+#define REPORT_INTERVAL_MS 100
+
+BinJob::BinJob(const QString &name)
+{
+	this->id = 0;
+	this->name = name;
+}
+
+BinJob::~BinJob()
+{
+}
+
+BinModeWorker::BinModeWorker(QextSerialPort *port)
+{
+	serial = port;
+	next_id = 1;
+	current_id = 0;
+}
+
+BinModeWorker::~BinModeWorker()
+{
+	qDeleteAll(jobs);
+}
+
+int BinModeWorker::enqueue(BinJob *job)
+{
+	lock.lock();
+	job->id = next_id++;
+	jobs.enqueue(job);
+	lock.unlock();
+	QMetaObject::invokeMethod(this, "run_queue", Qt::QueuedConnection);
+	return job->id;
+}
+
+/* drops the queued jobs and asks the running one to stop */
+void BinModeWorker::cancel(void)
+{
+	QQueue<BinJob *> dropped;
+
+	lock.lock();
+	dropped.swap(jobs);
+	abort_requested.storeRelease(1);
+	lock.unlock();
+
+	while (!dropped.isEmpty())
+	{
+		BinJob *job = dropped.dequeue();
+		emit finished(job->id, false, QString("%1...Cancelled").arg(job->name));
+		delete job;
+	}
+}
+
+bool BinModeWorker::cancelled(void)
+{
+	return abort_requested.loadAcquire() != 0;
+}
+
+int BinModeWorker::pending(void)
+{
+	QMutexLocker locker(&lock);
+	return jobs.size() + (current_id ? 1 : 0);
+}
+
+void BinModeWorker::report(qint64 done, qint64 total)
+{
+	if (done < total && report_timer.elapsed() < REPORT_INTERVAL_MS)
+		return;
+	report_timer.restart();
+	emit progress(current_id, done, total);
+}
+
+void BinModeWorker::log(const QString &msg)
+{
+	emit message(current_id, msg);
+}
+
+/* bytes a job captured, for the GUI to show */
+void BinModeWorker::output(const QByteArray &bytes)
+{
+	emit data(current_id, bytes);
+}
+
+void BinModeWorker::run_queue(void)
+{
+	BinJob *job;
+	QString msg;
+	bool ok;
+
+	for (;;)
+	{
+		lock.lock();
+		if (jobs.isEmpty())
+		{
+			lock.unlock();
+			return;
+		}
+		job = jobs.dequeue();
+		current_id = job->id;
+		abort_requested.storeRelease(0);
+		lock.unlock();
+
+		emit started(job->id, job->name);
+		report_timer.start();
+		if (serial->isOpen())
+		{
+			/* whatever a synchronous call left unread would offset the replies */
+			discard();
+			ok = job->run(this);
+		} else {
+			job->error = "port not open";
+			ok = false;
+		}
+
+		if (ok)
+			msg = QString("%1...Success!").arg(job->name);
+		else if (cancelled())
+			msg = QString("%1...Cancelled").arg(job->name);
+		else if (job->error.isEmpty())
+			msg = QString("%1...Failed").arg(job->name);
+		else
+			msg = QString("%1...Failed (%2)").arg(job->name).arg(job->error);
+
+		lock.lock();
+		current_id = 0;
+		lock.unlock();
+		emit finished(job->id, ok, msg);
+		delete job;
+	}
+}
+
+/* the port is set up here, on the thread it lives on, then opened */
+bool BinModeWorker::open(const QString &name, int baud, int databits, int stopbits, int parity, int flow)
+{
+	serial->setPortName(name);
+	serial->setBaudRate((BaudRateType)baud);
+	serial->setDataBits((DataBitsType)databits);
+	serial->setStopBits((StopBitsType)stopbits);
+	serial->setParity((ParityType)parity);
+	serial->setFlowControl((FlowType)flow);
+	serial->setTimeout(100);
+	/* a fresh open drops the input the tty buffered (TCSAFLUSH), and every
+	   call drains the port before it starts; flush() would discard TX too */
+	return serial->open(QIODevice::ReadWrite);
+}
+
+void BinModeWorker::close(void)
+{
+	serial->close();
+}
+
+/*
+ * Reads until rx_len bytes are in. Gives up when nothing arrived for
+ * timeout_ms, a short reply is returned as it is.
+ */
+QByteArray BinModeWorker::receive(int rx_len, int timeout_ms)
+{
+	QElapsedTimer idle;
+	QByteArray rx;
+	qint64 got = 0, n;
+
+	rx.resize(rx_len);
+	idle.start();
+	while (got < rx_len && idle.elapsed() < timeout_ms)
+	{
+		/* wakes up as soon as bytes come in, the notifier does not run during jobs;
+		   elapsed() may have passed timeout_ms already, and a negative wait is forever */
+		serial->waitForReadyRead(qMax<qint64>(0, timeout_ms - idle.elapsed()));
+		n = serial->read(rx.data() + got, rx_len - got);
+		if (n < 0)
+			break;
+		if (n > 0)
+			idle.restart();
+		got += n;
+	}
+	rx.resize(got);
+	return rx;
+}
+
+/* writes tx and reads its rx_len byte reply */
+QByteArray BinModeWorker::transfer(const QByteArray &tx, int rx_len, int timeout_ms)
+{
+	if (!serial->isOpen())
+		return QByteArray();
+	if (!tx.isEmpty() && serial->write(tx) != tx.size())
+		return QByteArray();
+	return receive(rx_len, timeout_ms);
+}
+
+/* writes tx and reads whatever comes back until the port goes quiet */
+QByteArray BinModeWorker::collect(const QByteArray &tx, int quiet_ms)
+{
+	QByteArray rx, chunk;
+
+	if (!serial->isOpen())
+		return rx;
+	if (!tx.isEmpty())
+		serial->write(tx);
+	do {
+		chunk = receive(256, quiet_ms);
+		rx.append(chunk);
+	} while (chunk.size() == 256);
+	return rx;
+}
+
+/*
+ * Sends the commands back to back, as far ahead of their replies as the
+ * window allows, and splits the replies by their lengths. Stops at the
+ * first short reply; the list then has fewer replies than commands.
+ */
+QList<QByteArray> BinModeWorker::pipeline(const QList<BinCommand> &cmds, int window)
+{
+	QList<QByteArray> replies;
+	QByteArray rx;
+	int sent = 0, in_flight = 0, cost;
+
+	if (!serial->isOpen())
+		return replies;
+
+	while (replies.size() < cmds.size())
+	{
+		/* the oldest unanswered command always goes, whatever it costs */
+		while (sent < cmds.size())
+		{
+			cost = cmds[sent].tx.size() + cmds[sent].rx_len;
+			if (sent > replies.size() && in_flight + cost > window)
+				break;
+			if (serial->write(cmds[sent].tx) != cmds[sent].tx.size())
+				return replies;
+			in_flight += cost;
+			sent++;
+		}
+
+		const BinCommand &cmd = cmds[replies.size()];
+		rx = receive(cmd.rx_len);
+		in_flight -= cmd.tx.size() + cmd.rx_len;
+		if (rx.size() != cmd.rx_len)
+			break;
+		replies.append(rx);
+	}
+	return replies;
+}
+
+/* drops whatever came in unasked, e.g. the tail of a reply that timed out */
+void BinModeWorker::discard(void)
+{
+	qint64 n;
+
+	if (!serial->isOpen())
+		return;
+	while ((n = serial->bytesAvailable()) > 0)
+		serial->read(n);
+}
+
+void BinModeWorker::send(const QByteArray &tx)
+{
+	if (!serial->isOpen())
+		return;
+	serial->write(tx);
+}
+
 BinMode::BinMode(MainWidgetFrame *parent) : QWidget(parent)
 {
 	this->parent = parent;
-	serial = new QextSerialPort("/dev/bus_pirate", QextSerialPort::Polling);
+	port_is_open = false;
+	qRegisterMetaType<qint64>("qint64");
+	qRegisterMetaType<BinCommand>("BinCommand");
+	qRegisterMetaType<QList<BinCommand> >("QList<BinCommand>");
+	qRegisterMetaType<QList<QByteArray> >("QList<QByteArray>");
+	serial = new QextSerialPort("/dev/bus_pirate", QextSerialPort::EventDriven);
+	serial->setLowLatency(true);
+	io = new BinModeWorker(serial);
+	io_thread = new QThread(this);
+	serial->moveToThread(io_thread);
+	io->moveToThread(io_thread);
+
+	connect(io, SIGNAL(started(int,QString)), this, SIGNAL(job_started(int,QString)));
+	connect(io, SIGNAL(progress(int,qint64,qint64)), this, SIGNAL(job_progress(int,qint64,qint64)));
+	connect(io, SIGNAL(message(int,QString)), this, SIGNAL(job_message(int,QString)));
+	connect(io, SIGNAL(data(int,QByteArray)), this, SIGNAL(job_data(int,QByteArray)));
+	connect(io, SIGNAL(finished(int,bool,QString)), this, SIGNAL(job_finished(int,bool,QString)));
+
+	io_thread->start();
 }
 
 BinMode::~BinMode()
 {
+	cancel();
 	port_close();
+	io_thread->quit();
+	io_thread->wait();
+	delete io;
+	delete serial;
+}
+
+/*
+ * The synchronous calls run on the I/O thread after whatever was queued
+ * before them. Each starts on a drained port, so a reply that came too
+ * late for the call before can not offset this one. While a job runs
+ * they fail at once and say so in the status bar: waiting on the worker
+ * would freeze the GUI, Cancel included, until the job is done.
+ */
+QByteArray BinMode::transfer(const QByteArray &tx, int rx_len, int timeout_ms)
+{
+	QByteArray rx;
+	if (busy())
+	{
+		refused("command");
+		return rx;
+	}
+	QMetaObject::invokeMethod(io, "discard", Qt::QueuedConnection);
+	QMetaObject::invokeMethod(io, "transfer", Qt::BlockingQueuedConnection,
+		Q_RETURN_ARG(QByteArray, rx), Q_ARG(QByteArray, tx), Q_ARG(int, rx_len), Q_ARG(int, timeout_ms));
+	return rx;
+}
+
+QByteArray BinMode::collect(const QByteArray &tx)
+{
+	QByteArray rx;
+	if (busy())
+	{
+		refused("command");
+		return rx;
+	}
+	QMetaObject::invokeMethod(io, "discard", Qt::QueuedConnection);
+	QMetaObject::invokeMethod(io, "collect", Qt::BlockingQueuedConnection,
+		Q_RETURN_ARG(QByteArray, rx), Q_ARG(QByteArray, tx), Q_ARG(int, BINMODE_QUIET_MS));
+	return rx;
+}
+
+QList<QByteArray> BinMode::pipeline(const QList<BinCommand> &cmds)
+{
+	QList<QByteArray> replies;
+	if (busy())
+	{
+		refused("commands");
+		return replies;
+	}
+	QMetaObject::invokeMethod(io, "discard", Qt::QueuedConnection);
+	QMetaObject::invokeMethod(io, "pipeline", Qt::BlockingQueuedConnection,
+		Q_RETURN_ARG(QList<QByteArray>, replies), Q_ARG(QList<BinCommand>, cmds), Q_ARG(int, BINMODE_WINDOW));
+	return replies;
+}
+
+/* commands answered with a single 0x01 */
+int BinMode::acked(char cmd)
+{
+	return transfer(QByteArray(1, cmd), 1) == QByteArray(1, 0x01);
+}
+
+/* false when the bytes were not sent, like the commands around them */
+bool BinMode::write_raw(const QByteArray &data)
+{
+	if (busy())
+	{
+		refused("data");
+		return false;
+	}
+	QMetaObject::invokeMethod(io, "send", Qt::QueuedConnection, Q_ARG(QByteArray, data));
+	return true;
+}
+
+void BinMode::refused(const char *what)
+{
+	QString msg = QString("Bus Pirate busy, %1 not sent").arg(what);
+	qDebug() << msg;
+	QCoreApplication::sendEvent(parent->parent, new BPStatusMsgEvent(msg));
+}
+
+int BinMode::submit(BinJob *job)
+{
+	return io->enqueue(job);
+}
+
+bool BinMode::busy(void)
+{
+	return io->pending() > 0;
+}
+
+/* as last opened or closed from here, the port itself is the I/O thread's */
+bool BinMode::is_open(void)
+{
+	return port_is_open;
+}
+
+void BinMode::cancel(void)
+{
+	io->cancel();
 }
 
 QByteArray BinMode::dumpBuffer()
 {
 	QByteArray resp;
 	qDebug() << "Dump Buffers";
-	do {
-		serial->flush();
-		resp = serial->readAll();
-		serial->flush();
-		qDebug() << resp.data();
-	} while (!resp.isEmpty());
+	resp = collect(QByteArray());
+	qDebug() << resp.data();
 	return resp;
 }
 
 /* Port Manipulation */
 bool BinMode::port_open()
 {
-	qDebug() << "port_open" << parent->settings->s_port->text();
-	serial->setPortName(parent->settings->s_port->text());
-	serial->setBaudRate((BaudRateType)parent->settings->usable_baud_rate->value(parent->settings->s_baud->currentText(), BAUD115200)); //BAUD115200
-	serial->setDataBits((DataBitsType)parent->settings->s_databits->currentIndex());  //DATA_8
-	serial->setStopBits((StopBitsType)parent->settings->s_stopbits->currentIndex());  //STOP_1
-	serial->setParity((ParityType)parent->settings->s_parity->currentIndex());      //PAR_NONE
-	serial->setFlowControl((FlowType)parent->settings->s_flow->currentIndex());      //FLOW_OFF
-	serial->setTimeout(100);
-	bool ret = serial->open(QIODevice::ReadWrite);
-	serial->flush();
-	qDebug() << "Serial Port Closed:" << serial->portName() << "is open-" << serial->isOpen();
+	bool ret = false;
+	BPSettingsGui *settings = parent->settings;
+	QString name = settings->s_port->text();
+	qDebug() << "port_open" << name;
+	if (busy())
+		return port_is_open;
+	QMetaObject::invokeMethod(io, "open", Qt::BlockingQueuedConnection, Q_RETURN_ARG(bool, ret),
+		Q_ARG(QString, name),
+		Q_ARG(int, settings->usable_baud_rate->value(settings->s_baud->currentText(), BAUD115200)), //BAUD115200
+		Q_ARG(int, settings->s_databits->currentIndex()),  //DATA_8
+		Q_ARG(int, settings->s_stopbits->currentIndex()),  //STOP_1
+		Q_ARG(int, settings->s_parity->currentIndex()),    //PAR_NONE
+		Q_ARG(int, settings->s_flow->currentIndex()));     //FLOW_OFF
+	port_is_open = ret;
+	qDebug() << "Serial Port Opened:" << name << "is open-" << ret;
 	return ret;
 }
 
 void BinMode::port_close()
 {
-	serial->flush();
-	serial->close();
-	qDebug() << "Serial Port Closed:" << serial->portName() << "is open-" << serial->isOpen();
+	/* the close waits for the running job, have it stop first */
+	cancel();
+	QMetaObject::invokeMethod(io, "close", Qt::BlockingQueuedConnection);
+	port_is_open = false;
+	qDebug() << "Serial Port Closed";
 }
 
+/* any command byte, the reply length is not known */
 QByteArray BinMode::command(unsigned short command)
 {
 	char data = (command);
-	QByteArray res;
-	serial->flush();
-	serial->write(&data, 1);
-	serial->flush();
-	res = serial->readAll();
-	serial->flush();
-	return res;
+	return collect(QByteArray(&data, 1));
 }
 
 /* BBIO */
@@ -70,13 +446,10 @@ int BinMode::enter_mode_bbio(void)
 {
 	int ret=0;
 	QByteArray res;
-	if (reset_bbio()) return ret;
-	serial->flush();
-	serial->write("\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00", 20);
-	serial->flush();
-	res = serial->readAll();
-	serial->flush();
-	if (res.contains("BBIO")) ret = 1;
+	if (reset_bbio()) return 1;
+	/* the terminal needs up to 20 0x00s, each one after that answers BBIO1 again */
+	res = collect(QByteArray(20, '\0'));
+	if (res.contains("BBIO1")) ret = 1;
 	if (ret) qDebug() << "BBIO Ready!";
 	return ret;
 }
@@ -86,26 +459,18 @@ int BinMode::reset_bbio(void)
 	QByteArray version_string;
 	int ret = 0;
 
-	serial->flush();
-	serial->write("\x00", 1);
-	serial->flush();
-	version_string = serial->readAll();
-	serial->flush();
-	if (version_string.contains("BBIO")) ret = 1;
+	/* the terminal does not answer a single 0x00, don't wait long for it */
+	version_string = transfer(QByteArray(1, '\0'), 5, BINMODE_QUIET_MS * 2);
+	if (version_string == "BBIO1") ret = 1;
 	qDebug() << "BBIO - text:" << version_string;
 	return ret;
 }
 
 QByteArray BinMode::reset_hardware(void)
 {
-	QByteArray buspirate_info, resp;
-	serial->flush();
-	serial->write("\x0F", 1);
-	serial->flush();
-	serial->read(1);
-	serial->flush();
-	buspirate_info = serial->readAll();
-	serial->flush();
+	QByteArray buspirate_info;
+	/* 0x01, then the terminal's version text */
+	buspirate_info = collect(QByteArray(1, 0x0F)).mid(1);
 	qDebug() << "reset BP:" << buspirate_info;
 	return buspirate_info;
 }
@@ -113,11 +478,7 @@ QByteArray BinMode::reset_hardware(void)
 QByteArray BinMode::reset_user_terminal(void)
 {
 	QByteArray resp;
-	serial->flush();
-	serial->write("\n\n\n\n\n\n\n\n\n\n#\n", 12);
-	serial->flush();
-	resp = serial->readAll();
-	serial->flush();
+	resp = collect(QByteArray("\n\n\n\n\n\n\n\n\n\n#\n", 12));
 	qDebug() << "reset user term:" << resp;
 	return resp;
 }
@@ -127,12 +488,8 @@ int BinMode::enter_mode_spi(void)
 {
 	QByteArray version_string;
 	int ret = 0;
-	serial->flush();
-	serial->write("\x01", 1);
-	serial->flush();
-	version_string = serial->readAll();
-	serial->flush();
-	if (version_string.contains("SPI")) ret = 1;
+	version_string = transfer(QByteArray(1, 0x01), 4);
+	if (version_string == "SPI1") ret = 1;
 	qDebug() << "SPI - text: " << version_string;
 	return ret;
 }
@@ -141,12 +498,8 @@ int BinMode::enter_mode_i2c(void)
 {
 	int ret = 0;
 	QByteArray version_string;
-	serial->flush();
-	serial->write("\x02", 1);
-	serial->flush();
-	version_string = serial->readAll();
-	serial->flush();
-	if (version_string.contains("I2C")) ret = 1;
+	version_string = transfer(QByteArray(1, 0x02), 4);
+	if (version_string == "I2C1") ret = 1;
 	qDebug() << "I2C text: " << version_string;
 	return ret;
 }
@@ -155,12 +508,8 @@ int BinMode::enter_mode_uart(void)
 {
 	int ret = 0;
 	QByteArray version_string;
-	serial->flush();
-	serial->write("\x03", 1);
-	serial->flush();
-	version_string = serial->readAll();
-	serial->flush();
-	if (version_string.contains("ART")) ret = 1;
+	version_string = transfer(QByteArray(1, 0x03), 4);
+	if (version_string == "ART1") ret = 1;
 	qDebug() << "UART text: " << version_string;
 	return ret;
 }
@@ -169,12 +518,8 @@ int BinMode::enter_mode_onewire(void)
 {
 	int ret = 0;
 	QByteArray version_string;
-	serial->flush();
-	serial->write("\x04", 1);
-	serial->flush();
-	version_string = serial->readAll();
-	serial->flush();
-	if (version_string.contains("1W")) ret = 1;
+	version_string = transfer(QByteArray(1, 0x04), 4);
+	if (version_string == "1W01") ret = 1;
 	qDebug() << "1Wire text: " << version_string;
 	return ret;
 }
@@ -182,279 +527,121 @@ int BinMode::enter_mode_onewire(void)
 /* BBIO Pin Settings */
 int BinMode::raw_set_io(unsigned short pins)
 {
-	int ret = 0;
 	char data = (0x40|pins);
-	QByteArray resp;
-	serial->flush();
-	serial->write(&data, 1);
-	serial->flush();
-	resp = serial->readAll();
-	serial->flush();
-	if (resp.contains("\x01")) ret = 1;
 	qDebug() << "raw set io:" << data;
-	return ret;
+	return acked(data);
 }
 
 int BinMode::raw_set_pins(unsigned short pins)
 {
-	int ret = 0;
 	char data = (0x80|pins);
-	QByteArray resp;
-	serial->flush();
-	serial->write(&data, 1);
-	serial->flush();
-	resp = serial->readAll();
-	serial->flush();
-	if (resp.contains("\x01")) ret = 1;
 	qDebug() << "raw set pins:" << data;
-	return ret;
+	return acked(data);
 }
 
 /* Self Test Methods */
+/* the error count comes once the test is through; the long test waits for the button */
 QByteArray BinMode::test_mode_short(void)
 {
-	QByteArray resp;
-	serial->flush();
-	serial->write("\x10", 1);
-	serial->flush();
-	resp = serial->readAll();
-	serial->flush();
-	return resp;
+	return transfer(QByteArray(1, 0x10), 1, 5000);
 }
 
 QByteArray BinMode::test_mode_long(void)
 {
-	QByteArray resp;
-	serial->flush();
-	serial->write("\x11", 1);
-	serial->flush();
-	resp = serial->readAll();
-	serial->flush();
-	return resp;
+	return transfer(QByteArray(1, 0x11), 1, 30000);
 }
 
 /* Common Interfaces Methods */
 QByteArray BinMode::bbio_mode_version(void)
 {
-	QByteArray resp;
-	serial->flush();
-	serial->write("\x01", 1);
-	serial->flush();
-	resp = serial->readAll();
-	serial->flush();
-	return resp;
+	return transfer(QByteArray(1, 0x01), 4);
 }
 
+/* 0001xxxx: 0x01, then a byte back for every byte sent */
 QByteArray BinMode::bbio_bulk_trans(QByteArray data, unsigned short size)
 {
-	int i = 0;
-	QByteArray cmd_response;
-	QByteArray data_response;
-	char cmd_data = (0x10|(size-1));
-	serial->flush();
-	serial->write(&cmd_data, 1);
-	serial->flush();
-	cmd_response = serial->readAll();
-	serial->flush();
-	serial->write(data, size);
-	serial->flush();
-	data_response = serial->readAll();
-	serial->flush();
-	if (cmd_response.contains("\x01")) return data_response;
-	qDebug() << "bulk trans:" << data_response.toHex();
-	return data_response;
+	QByteArray tx, resp;
+	tx.append((char)(0x10|(size-1)));
+	tx.append(data.left(size));
+	resp = transfer(tx, size + 1);
+	if (resp.startsWith('\x01')) return resp.mid(1);
+	qDebug() << "bulk trans:" << resp.toHex();
+	return QByteArray();
 }
 
 int BinMode::bbio_speed_set(unsigned short speed)
 {
-	char data = (0x60|speed);
-	QByteArray res;
-	int ret = 0;
-	serial->flush();
-	serial->write(&data, 1);
-	serial->flush();
-	res = serial->readAll();
-	serial->flush();
-	if (res.contains("\x01")) ret=1;
-	return ret;
+	return acked(0x60|speed);
 }
 
 QByteArray BinMode::bbio_speed_read(void)
 {
-	QByteArray res;
-	serial->flush();
-	serial->write("\x70");
-	serial->flush();
-	res = serial->readAll();
-	serial->flush();
-	return res;
+	return transfer(QByteArray(1, 0x70), 1);
 }
 
 int BinMode::bbio_peripherial_set(unsigned short pins)
 {
-	char data = (0x40|pins);
-	int ret = 0;
-	bool Ok;
-	QByteArray res;
-	serial->flush();
-	serial->write(&data, 1);
-	serial->flush();
-	res = serial->readAll();
-	serial->flush();
-	if (res.contains("\x01")) ret=1;
-	return ret;
+	return acked(0x40|pins);
 }
 
 QByteArray BinMode::bbio_peripherial_read(void)
 {
-	QByteArray res;
-	serial->flush();
-	serial->write("\x50");
-	serial->flush();
-	res = serial->readAll();
-	serial->flush();
-	return res;
+	return transfer(QByteArray(1, 0x50), 1);
 }
 
 /* SPI methods */
 int BinMode::spi_cs_low(void)
 {
-	int ret = 0;
-	QByteArray res;
-	serial->flush();
-	serial->write("\x02", 1);
-	serial->flush();
-	res = serial->readAll();
-	serial->flush();
-	if (res.contains("\x01")) ret = 1;
-	return ret;
+	return acked(0x02);
 }
 
 int BinMode::spi_cs_high(void)
 {
-	int ret = 0;
-	QByteArray res;
-	serial->flush();
-	serial->write("\x03", 1);
-	serial->flush();
-	res = serial->readAll();
-	serial->flush();
-	if (res.contains("\x01")) ret=1;
-	return ret;
+	return acked(0x03);
 }
 
 int BinMode::spi_nibble_high(unsigned short nibble)
 {
-	int ret = 0;
-	QByteArray resp;
-	char nib = (0x30|nibble);
-	serial->flush();
-	serial->write(&nib, 1);
-	serial->flush();
-	resp = serial->readAll();
-	serial->flush();
-	if (resp.contains("\x01")) ret = 1;
-	return ret;
+	return acked(0x30|nibble);
 }
 
 QByteArray BinMode::spi_nibble_low(unsigned short nibble)
 {
-	QByteArray ret;
-	char nib = (0x20|nibble);
-	serial->flush();
-	serial->write(&nib, 1);
-	serial->flush();
-	ret = serial->readAll();
-	serial->flush();
-	return ret;
+	return transfer(QByteArray(1, (char)(0x20|nibble)), 1);
 }
 
 int BinMode::spi_configure_set(unsigned short spi_cfg)
 {
-	char data = (0x80|spi_cfg);
-	int ret = 0;
-	QByteArray res;
-	serial->flush();
-	serial->write(&data, 1);
-	serial->flush();
-	res = serial->readAll();
-	serial->flush();
-	if (res.contains("\x01")) ret=1;
-	return ret;
+	return acked(0x80|spi_cfg);
 }
 
 QByteArray BinMode::spi_configure_read(void)
 {
-	QByteArray resp;
-	serial->flush();
-	serial->write("\x90", 1);
-	serial->flush();
-	resp = serial->readAll();
-	serial->flush();
-	return resp;
+	return transfer(QByteArray(1, (char)0x90), 1);
 }
 
 /* I2C Methods */
 int BinMode::i2c_start(void)
 {
-	int ret = 0;
-	QByteArray res;
-	serial->flush();
-	serial->write("\x02", 1);
-	serial->flush();
-	res = serial->readAll();
-	serial->flush();
-	if (res.contains("\x01")) ret = 1;
-	return ret;
+	return acked(0x02);
 }
 
 int BinMode::i2c_stop(void)
 {
-	int ret = 0;
-	QByteArray res;
-	serial->flush();
-	serial->write("\x03", 1);
-	serial->flush();
-	res = serial->readAll();
-	serial->flush();
-	if (res.contains("\x01")) ret = 1;
-	return ret;
+	return acked(0x03);
 }
 
 QByteArray BinMode::i2c_byte_read(void)
 {
-	QByteArray res;
-	serial->flush();
-	serial->write("\x04", 1);
-	serial->flush();
-	res = serial->readAll();
-	serial->flush();
-	return res;
+	return transfer(QByteArray(1, 0x04), 1);
 }
 
 int BinMode::i2c_ack_send(void)
 {
-	int ret = 0;
-	QByteArray res;
-	serial->flush();
-	serial->write("\x05", 1);
-	serial->flush();
-	res = serial->readAll();
-	serial->flush();
-	if (res.contains("\x01")) ret = 1;
-	return ret;
+	return acked(0x06);
 }
 
 int BinMode::i2c_nack_send(void)
 {
-	int ret = 0;
-	QByteArray res;
-	serial->flush();
-	serial->write("\x06", 1);
-	serial->flush();
-	res = serial->readAll();
-	serial->flush();
-	if (res.contains("\x01")) ret = 1;
-	return ret;
+	return acked(0x07);
 }
-
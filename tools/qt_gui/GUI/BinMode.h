@@ -1,6 +1,10 @@
 #ifndef __BINMODE_H
 #define __BINMODE_H
 
+#include <QThread>
+#include <QMutex>
+#include <QQueue>
+#include <QElapsedTimer>
 #include "qextserialport/qextserialport.h"
 
 #define     WREN         0x06 // A:0 U:0 D:0
@@ -15,10 +19,102 @@
 #define     SE           0xD8 // A:3 U:0 D:0
 #define     DP           0xB9 // A:0 U:0 D:0
 #define     RDP          0xAB // A:0 U:0 D:0
+#define     SSE          0x20 // A:3 U:0 D:0
+
+/* how long a reply may stall before it is given up on */
+#define     BINMODE_TIMEOUT_MS 1000
+/* replies of unknown length (text) end when the port stays quiet this long */
+#define     BINMODE_QUIET_MS   50
+/*
+ * Bytes, commands plus their replies, a pipeline keeps unanswered. The v4
+ * is flow controlled over USB; the v3 reads its UART from a 4 byte FIFO
+ * while it answers, so commands with long replies go one at a time.
+ */
+#define     BINMODE_WINDOW     4096
 
 class MainWidgetFrame;
+class BinModeWorker;
+
+/* a command and the number of bytes the firmware answers it with */
+class BinCommand
+{
+public:
+	BinCommand() : rx_len(0) {}
+	BinCommand(const QByteArray &tx, int rx_len) : tx(tx), rx_len(rx_len) {}
+	QByteArray tx;
+	int rx_len;
+};
+Q_DECLARE_METATYPE(BinCommand)
+
+/*
+ * A long operation (chip read, programming...) run on the I/O thread.
+ * run() talks to the Bus Pirate only through the worker it is handed,
+ * reports with io->report()/io->log() and returns false with error set
+ * when it fails. The worker deletes the job once it has finished.
+ */
+class BinJob
+{
+public:
+	BinJob(const QString &name);
+	virtual ~BinJob();
+	virtual bool run(BinModeWorker *io) = 0;
+	int id;
+	QString name;
+	QString error;
+};
+
+/*
+ * Owns the serial port on its own thread. The synchronous BinMode calls
+ * are queued to it one by one, jobs are run back to back from a queue
+ * without going through the GUI event loop between commands.
+ */
+class BinModeWorker : public QObject
+{
+Q_OBJECT
+public:
+	BinModeWorker(QextSerialPort *port);
+	~BinModeWorker();
+
+	/* Job Queue, callable from any thread */
+	int        enqueue(BinJob *job);
+	void       cancel(void);
+	bool       cancelled(void);
+	int        pending(void);
+
+	/* For jobs, on the I/O thread */
+	QByteArray receive(int rx_len, int timeout_ms = BINMODE_TIMEOUT_MS);
+	void       report(qint64 done, qint64 total);
+	void       log(const QString &msg);
+	void       output(const QByteArray &data);
+	QextSerialPort *serial;
+public slots:
+	bool       open(const QString &name, int baud, int databits, int stopbits, int parity, int flow);
+	void       close(void);
+	QByteArray transfer(const QByteArray &tx, int rx_len, int timeout_ms = BINMODE_TIMEOUT_MS);
+	QByteArray collect(const QByteArray &tx, int quiet_ms = BINMODE_QUIET_MS);
+	QList<QByteArray> pipeline(const QList<BinCommand> &cmds, int window = BINMODE_WINDOW);
+	void       discard(void);
+	void       send(const QByteArray &tx);
+signals:
+	void       started(int id, const QString &name);
+	void       progress(int id, qint64 done, qint64 total);
+	void       message(int id, const QString &msg);
+	void       data(int id, const QByteArray &data);
+	void       finished(int id, bool ok, const QString &msg);
+private slots:
+	void       run_queue(void);
+private:
+	QMutex lock;
+	QQueue<BinJob *> jobs;
+	QAtomicInt abort_requested;
+	int next_id;
+	int current_id;
+	QElapsedTimer report_timer;
+};
+
 class BinMode : public QWidget
 {
+Q_OBJECT
 public:
 	/* Construct */
 	BinMode(MainWidgetFrame *ss);
@@ -73,13 +169,37 @@ public:
 	int        i2c_ack_send(void);
 	int        i2c_nack_send(void);
 
-	/* Serial Port Access */
+	/* Raw Access, goes out in order with the commands */
+	bool       write_raw(const QByteArray &data);
+	QList<QByteArray> pipeline(const QList<BinCommand> &cmds);
+
+	/* Jobs */
+	int        submit(BinJob *job);
+	bool       busy(void);
+	bool       is_open(void);
+
+	/* Serial Port Access, the port lives on the I/O thread */
 	QextSerialPort *serial;
+	BinModeWorker *io;
 	MainWidgetFrame *parent;
 public slots:
 	/* Port Manipulation */
 	bool       port_open(void);
 	void       port_close(void);
+	void       cancel(void);
+signals:
+	void       job_started(int id, const QString &name);
+	void       job_progress(int id, qint64 done, qint64 total);
+	void       job_message(int id, const QString &msg);
+	void       job_data(int id, const QByteArray &data);
+	void       job_finished(int id, bool ok, const QString &msg);
+private:
+	QByteArray transfer(const QByteArray &tx, int rx_len, int timeout_ms = BINMODE_TIMEOUT_MS);
+	QByteArray collect(const QByteArray &tx);
+	int        acked(char cmd);
+	void       refused(const char *what);
+	QThread *io_thread;
+	bool port_is_open;
 };
 
 #endif
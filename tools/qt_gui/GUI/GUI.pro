@@ -32,6 +32,7 @@ HEADERS += 	\
 			BPSettings.h \
 			Events.h \
 			Interface.h \
+			LogView.h \
 			MainWin.h
 
 SOURCES += 	\
@@ -44,7 +45,8 @@ SOURCES += 	\
 			#Interface_power.cpp \
 			Interface_rawtext.cpp \
 			Interface_rawwire.cpp \
-			#Interface_spi.cpp \
+			Interface_spi.cpp \
+			LogView.cpp \
 			MainWin.cpp \
 			main.cpp
 
@@ -31,7 +31,9 @@ enum spi_cfg
 };
 
 class MainWidgetFrame;
-/*class SpiGui : public QWidget
+class LogView;
+class HexView;
+class SpiGui : public QWidget
 {
 Q_OBJECT
 public:
@@ -39,16 +41,25 @@ public:
 private slots:
 	void read_spi();
 	void write_spi();
+	void verify_spi();
 	void spi_chip_id();
+	void job_progress(int id, qint64 done, qint64 total);
+	void job_message(int id, const QString &msg);
+	void job_data(int id, const QByteArray &data);
+	void job_finished(int id, bool ok, const QString &msg);
 private:
+	void start_job(int op);
 	MainWidgetFrame *parent;
 	QLineEdit *file;
-	QTextEdit *msglog;
-protected:
-	virtual void customEvent(QEvent *ev);
+	QLineEdit *chip_size;
+	QLabel *rate;
+	LogView *msglog;
+	HexView *hexview;
+	QElapsedTimer job_timer;
+	int job_id;
 public:
 	void postMsgEvent(const char* msg);
-};*/
+};
 
 class I2CGui : public QWidget
 {
@@ -62,13 +73,11 @@ private:
 	QLineEdit *file;
 	QLineEdit *file_size;
 	QLineEdit *start_addr;
-	QTextEdit *msglog;
+	LogView *msglog;
 private slots:
 	void search_i2c(void);
 	void write_i2c(void);
 	void read_i2c(void);
-protected:
-	virtual void customEvent(QEvent *ev);
 public:
 	void postMsgEvent(const char* msg);
 };
@@ -81,7 +90,7 @@ private:
 	MainWidgetFrame *parent;
 	QLineEdit *device_addr;
 	QLineEdit *file;
-	QTextEdit *msglog;
+	LogView *msglog;
 	QLineEdit *dev_rom_read;
 	QLineEdit *dev_rom_skip;
 	QLineEdit *dev_rom_match;
@@ -94,8 +103,6 @@ private:
 	QLineEdit *dev_status_read;
 	QLineEdit *dev_status_write;
 	
-protected:
-	virtual void customEvent(QEvent *ev);
 public:
 	void postMsgEvent(const char* msg);
 };
@@ -108,9 +115,7 @@ private:
 	MainWidgetFrame *parent;
 	QLineEdit *device_addr;
 	QLineEdit *file;
-	QTextEdit *msglog;
-protected:
-	virtual void customEvent(QEvent *ev);
+	LogView *msglog;
 public:
 	void postMsgEvent(const char* msg);
 };
@@ -124,9 +129,7 @@ private:
 	MainWidgetFrame *parent;
 	QLineEdit *device_addr;
 	QLineEdit *file;
-	QTextEdit *msglog;
-protected:
-	virtual void customEvent(QEvent *ev);
+	LogView *msglog;
 public:
 	void postMsgEvent(const char* msg);
 };
@@ -134,15 +137,13 @@ public:
 class RawTextGui : public QWidget
 {
 Q_OBJECT
-protected:
-	virtual void customEvent(QEvent *ev);
 public:
 	RawTextGui(MainWidgetFrame *p);
 	void postMsgEvent(const char* msg);
 private slots:
 	void ExecuteFile(void);
 private:
-	QTextEdit *msglog;
+	LogView *msglog;
 	QLineEdit *raw_file;
 	MainWidgetFrame *parent;
 };
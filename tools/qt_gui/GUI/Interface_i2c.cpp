@@ -4,6 +4,7 @@
 #include "MainWin.h"
 #include "Interface.h"
 #include "Events.h"
+#include "LogView.h"
 
 I2CGui::I2CGui(MainWidgetFrame *parent) : QWidget(parent)
 {
@@ -46,8 +47,7 @@ I2CGui::I2CGui(MainWidgetFrame *parent) : QWidget(parent)
 	file_size = new QLineEdit;
 	file_size->setValidator(new QRegExpValidator(rx_int, this));
 
-	msglog = new QTextEdit;
-	msglog->setReadOnly(true);
+	msglog = new LogView;
 	
 	hlayout->addWidget(scan);
 	hlayout->addWidget(read_btn);
@@ -83,31 +83,53 @@ I2CGui::I2CGui(MainWidgetFrame *parent) : QWidget(parent)
 
 void I2CGui::search_i2c()
 {
+	QList<BinCommand> cmds;
+	QList<QByteArray> replies;
 	QString dev_addr;
 	QString start_msg = "Getting I2C Devices...";
 	QString end_msg = "Getting I2C Devices...Success!";
-	int i = 0, dev=0, addr=0;
-	char rw;
-	QCoreApplication::sendEvent(parent->parent, new BPStatusMsgEvent(start_msg));
-	for (i=0; i<0x100; i++)
+	QString fail_msg = "Getting I2C Devices...Failed";
+	int dev = 0, r = 0;
+	bool ack;
+
+	if (parent->bp->busy())
 	{
-		dev = i;
-		addr = i>>1;
+		postMsgEvent("Bus Pirate busy.");
+		return;
+	}
 
-		parent->bp->i2c_start();
-		parent->bp->serial->write((char*)&dev, 1);
-		parent->bp->i2c_byte_read();
-		if ((addr & 0x01)==0) 
+	QCoreApplication::sendEvent(parent->parent, new BPStatusMsgEvent(start_msg));
+
+	/* all addresses in one pipeline: start, the address as a 1 byte bulk
+	   write, a byte read and NACK for the read addresses, stop */
+	for (dev=0; dev<0x100; dev++)
+	{
+		cmds << BinCommand(QByteArray(1, 0x02), 1);
+		cmds << BinCommand(QByteArray(1, 0x10) + (char)dev, 2);
+		if (dev & 0x01)
 		{
-			rw = 'W';
-		} else {
-			parent->bp->i2c_byte_read();
-			parent->bp->i2c_ack_send();
-			rw = 'R';
+			cmds << BinCommand(QByteArray(1, 0x04), 1);
+			cmds << BinCommand(QByteArray(1, 0x07), 1);
 		}
-		parent->bp->i2c_stop();
+		cmds << BinCommand(QByteArray(1, 0x03), 1);
+	}
+
+	replies = parent->bp->pipeline(cmds);
+	if (replies.size() != cmds.size())
+	{
+		QCoreApplication::sendEvent(parent->parent, new BPStatusMsgEvent(fail_msg));
+		return;
+	}
+
+	for (dev=0; dev<0x100; dev++)
+	{
+		/* the bulk write answers 0x01, then 0x00 when the byte was ACKed */
+		ack = replies[r + 1].at(1) == 0x00;
+		r += (dev & 0x01) ? 5 : 3;
+		if (!ack)
+			continue;
 
-		dev_addr = QString("%1 (%2 %3)").arg(dev, 0, 16).arg(addr, 0, 16).arg(rw);
+		dev_addr = QString("%1 (%2 %3)").arg(dev, 0, 16).arg(dev >> 1, 0, 16).arg((dev & 0x01) ? 'R' : 'W');
 		postMsgEvent(dev_addr.toLatin1());
 	}
 	QCoreApplication::sendEvent(parent->parent, new BPStatusMsgEvent(end_msg));
@@ -120,6 +142,12 @@ void I2CGui::write_i2c(void)
 	QString start_msg = "Writing I2C Device...";
 	QString end_msg = "Writing I2C Device...Done!";
 
+	if (parent->bp->busy())
+	{
+		postMsgEvent("Bus Pirate busy.");
+		return;
+	}
+
 	QFile qfile(file->text());
 	if (!qfile.open(QIODevice::ReadOnly))
 		return;
@@ -129,12 +157,12 @@ void I2CGui::write_i2c(void)
 	// i2c start
 	parent->bp->i2c_start();
 	// write chip address (w)
-	parent->bp->serial->write((char*)device_addr_write->text().toInt(&ok, 16), 1);
+	parent->bp->write_raw(QByteArray(1, (char)device_addr_write->text().toInt(&ok, 16)));
 	// write memory address
-	parent->bp->serial->write((char*)start_addr->text().toInt(&ok, 16), 1);
+	parent->bp->write_raw(QByteArray(1, (char)start_addr->text().toInt(&ok, 16)));
 	// values to write
 	data = qfile.readAll();
-	parent->bp->serial->write(data.data(), sizeof(data.data()));
+	parent->bp->write_raw(data);
 	// i2c stop
 	parent->bp->i2c_stop();
 
@@ -152,6 +180,12 @@ void I2CGui::read_i2c(void)
 	QString start_msg = "Reading I2C Device...";
 	QString end_msg = "Reading I2C Device...Done!";
 
+	if (parent->bp->busy())
+	{
+		postMsgEvent("Bus Pirate busy.");
+		return;
+	}
+
 	QFile qfile(file->text());
 	if (!qfile.open(QIODevice::WriteOnly))
 		return;
@@ -160,16 +194,16 @@ void I2CGui::read_i2c(void)
 	// i2c start
 	parent->bp->i2c_start();
 	// write chip (w) address
-	parent->bp->serial->write((char*)device_addr_write->text().toInt(&ok, 16), 1);
+	parent->bp->write_raw(QByteArray(1, (char)device_addr_write->text().toInt(&ok, 16)));
 	// write memory address
-	parent->bp->serial->write((char*)start_addr->text().toInt(&ok, 16), 1);
+	parent->bp->write_raw(QByteArray(1, (char)start_addr->text().toInt(&ok, 16)));
 	// i2c stop
 	parent->bp->i2c_stop();
 
 	// i2c start
 	parent->bp->i2c_start();
 	// write chip (r) address
-	parent->bp->serial->write((char*)device_addr_read->text().toInt(&ok, 16), 1);
+	parent->bp->write_raw(QByteArray(1, (char)device_addr_read->text().toInt(&ok, 16)));
 
 	for (i=0; i<fsize; i++)
 	{
@@ -187,17 +221,8 @@ void I2CGui::read_i2c(void)
 	QCoreApplication::sendEvent(parent->parent, new BPStatusMsgEvent(end_msg));
 }
 
-void I2CGui::customEvent(QEvent *ev)
-{
-	if (static_cast<BPEventType>(ev->type()) == I2CLogMsgEventType)
-	{
-		msglog->append(dynamic_cast<I2CLogMsgEvent* >(ev)->msg);
-	}
-}
-
 void I2CGui::postMsgEvent(const char* msg)
 {
-	QString qmsg = QString(msg);
-	QCoreApplication::sendEvent(this, new I2CLogMsgEvent(qmsg));
+	msglog->append(QString(msg));
 }
 
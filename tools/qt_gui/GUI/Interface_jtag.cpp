@@ -4,23 +4,15 @@
 #include "MainWin.h"
 #include "Interface.h"
 #include "Events.h"
+#include "LogView.h"
 
 JtagGui::JtagGui(MainWidgetFrame *parent) : QWidget(parent)
 {
 	this->parent = parent;
 }
 
-void JtagGui::customEvent(QEvent *ev)
-{
-	if (static_cast<BPEventType>(ev->type()) == JtagLogMsgEventType)
-	{
-		msglog->append(dynamic_cast<JtagLogMsgEvent* >(ev)->msg);
-	}
-}
-
 void JtagGui::postMsgEvent(const char* msg)
 {
-	QString qmsg = QString(msg);
-	QCoreApplication::sendEvent(this, new JtagLogMsgEvent(qmsg));
+	msglog->append(QString(msg));
 }
 
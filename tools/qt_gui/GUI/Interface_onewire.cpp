@@ -4,6 +4,7 @@
 #include "MainWin.h"
 #include "Interface.h"
 #include "Events.h"
+#include "LogView.h"
 
 OneWireGui::OneWireGui(MainWidgetFrame *p) : QWidget(p)
 {
@@ -27,8 +28,7 @@ OneWireGui::OneWireGui(MainWidgetFrame *p) : QWidget(p)
 	QHBoxLayout *file_input_layout = new QHBoxLayout;
 	QHBoxLayout *dev_input_layout = new QHBoxLayout;
 	
-	msglog = new QTextEdit;
-	msglog->setReadOnly(true);
+	msglog = new LogView;
 	device_addr = new QLineEdit;
 	
 	dev_rom_read = new QLineEdit("0x33");
@@ -54,17 +54,8 @@ OneWireGui::OneWireGui(MainWidgetFrame *p) : QWidget(p)
 	setLayout(vlayout);
 }
 
-void OneWireGui::customEvent(QEvent *ev)
-{
-	if (static_cast<BPEventType>(ev->type()) == OneWireLogMsgEventType)
-	{
-		msglog->append(dynamic_cast<OneWireLogMsgEvent* >(ev)->msg);
-	}
-}
-
 void OneWireGui::postMsgEvent(const char* msg)
 {
-	QString qmsg = QString(msg);
-	QCoreApplication::sendEvent(this, new OneWireLogMsgEvent(qmsg));
+	msglog->append(QString(msg));
 }
 
@@ -117,7 +117,5 @@ void PowerGui::setupBusPirate()
 
 void PowerGui::getBuffer()
 {
-	parent->bp->serial->flush();
 	parent->bp->dumpBuffer();
-	parent->bp->serial->flush();
 }
@@ -4,6 +4,7 @@
 #include "MainWin.h"
 #include "Interface.h"
 #include "Events.h"
+#include "LogView.h"
 
 /* Interface: Raw Ascii Text */
 RawTextGui::RawTextGui(MainWidgetFrame *parent) : QWidget(parent)
@@ -15,7 +16,7 @@ RawTextGui::RawTextGui(MainWidgetFrame *parent) : QWidget(parent)
 	raw_file = new QLineEdit("test_hex_ascii.txt");
 	QPushButton *button = new QPushButton("Run");
 	QLabel *log_label = new QLabel("Log: ");
-	msglog = new QTextEdit;
+	msglog = new LogView;
 	
 	connect(button, SIGNAL(clicked()), this, SLOT(ExecuteFile()));
 
@@ -29,18 +30,9 @@ RawTextGui::RawTextGui(MainWidgetFrame *parent) : QWidget(parent)
 	setLayout(vlayout);
 }
 
-void RawTextGui::customEvent(QEvent *ev)
-{
-	if (static_cast<BPEventType>(ev->type()) == AsciiHexLogMsgEventType)
-	{
-		msglog->append(dynamic_cast<AsciiHexLogMsgEvent* >(ev)->msg);
-	}
-}
-
 void RawTextGui::postMsgEvent(const char* msg)
 {
-	QString qmsg = QString(msg);
-	QCoreApplication::sendEvent(this, new AsciiHexLogMsgEvent(qmsg));
+	msglog->append(QString(msg));
 }
 
 void RawTextGui::ExecuteFile()
@@ -74,7 +66,7 @@ void RawTextGui::ExecuteFile()
 		response = parent->bp->command(d);
 		qmsg = str.arg(i++, 3, 10, QChar('0')).arg(byte.data())
 			.arg(d, 3, 10, QChar('0')).arg(response.toHex().data());
-		QCoreApplication::sendEvent(this, new AsciiHexLogMsgEvent(qmsg));
+		msglog->append(qmsg);
 	}
 	QCoreApplication::sendEvent(parent->parent, new BPStatusMsgEvent(qmsg_success));
 }
@@ -4,6 +4,7 @@
 #include "MainWin.h"
 #include "Interface.h"
 #include "Events.h"
+#include "LogView.h"
 
 RawWireGui::RawWireGui(MainWidgetFrame *p) : QWidget(p)
 {
@@ -17,8 +18,7 @@ RawWireGui::RawWireGui(MainWidgetFrame *p) : QWidget(p)
 	
 	device_addr = new QLineEdit;
 	file = new QLineEdit;
-	msglog = new QTextEdit;
-	msglog->setReadOnly(true);
+	msglog = new LogView;
 	
 	QVBoxLayout *vlayout = new QVBoxLayout;
 	QHBoxLayout *hlayout = new QHBoxLayout;
@@ -39,17 +39,8 @@ RawWireGui::RawWireGui(MainWidgetFrame *p) : QWidget(p)
 	setLayout(vlayout);
 }
 
-void RawWireGui::customEvent(QEvent *ev)
-{
-	if (static_cast<BPEventType>(ev->type()) == RawWireLogMsgEventType)
-	{
-		msglog->append(dynamic_cast<RawWireLogMsgEvent* >(ev)->msg);
-	}
-}
-
 void RawWireGui::postMsgEvent(const char* msg)
 {
-	QString qmsg = QString(msg);
-	QCoreApplication::sendEvent(this, new RawWireLogMsgEvent(qmsg));
+	msglog->append(QString(msg));
 }
 
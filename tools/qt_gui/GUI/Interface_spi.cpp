@@ -5,251 +5,503 @@
 #include "MainWin.h"
 #include "Interface.h"
 #include "Events.h"
+#include "LogView.h"
+
+#define SPI_SECTOR_SIZE  4096
+#define SPI_PAGE_SIZE    256
+#define SPI_READ_CHUNK   4096      /* BP_TERMINAL_BUFFER_SIZE, the most one write-then-read returns */
+#define SPI_MAX_SIZE     0x1000000 /* 3 byte addresses */
+#define SPI_STATUS_WIP   0x01
+
+/*
+ * 25 series flash dump/program/verify, run as a job on the I/O thread.
+ * Everything goes through the SPI write-then-read command (0x04), which
+ * asserts CS around the transfer: 4KB of data per command instead of 16
+ * bytes per bulk transfer.
+ */
+class SpiFlashJob : public BinJob
+{
+public:
+	enum Op { Identify, Read, Program, Verify };
+	SpiFlashJob(Op op, const QString &path, qint64 size);
+	bool run(BinModeWorker *io);
+private:
+	bool setup(BinModeWorker *io);
+	bool identify(BinModeWorker *io);
+	bool write_read(BinModeWorker *io, const QByteArray &out, uchar *in, int in_len);
+	bool wait_ready(BinModeWorker *io, int timeout_ms);
+	bool write_enable(BinModeWorker *io);
+	bool read_flash(BinModeWorker *io, quint32 addr, uchar *in, int len);
+	bool erase_sector(BinModeWorker *io, quint32 addr);
+	bool program_page(BinModeWorker *io, quint32 addr, const uchar *data, int len);
+	bool dump(BinModeWorker *io, uchar *map);
+	bool program(BinModeWorker *io, const uchar *map, qint64 length);
+	bool verify(BinModeWorker *io, const uchar *map, qint64 length);
+	Op op;
+	QString path;
+	qint64 size;
+};
+
+static const char *spi_job_names[] = {
+	"Getting SPI Chip Id", "Reading SPI Chip", "Writing SPI Chip", "Verifying SPI Chip"
+};
+
+SpiFlashJob::SpiFlashJob(Op op, const QString &path, qint64 size) : BinJob(spi_job_names[op])
+{
+	this->op = op;
+	this->path = path;
+	this->size = size;
+}
+
+static QByteArray spi_address_command(uchar cmd, quint32 addr)
+{
+	QByteArray out;
+	out.append((char)cmd);
+	out.append((char)(addr >> 16));
+	out.append((char)(addr >> 8));
+	out.append((char)addr);
+	return out;
+}
+
+/* one byte command answered with 0x01 */
+static bool spi_simple_command(BinModeWorker *io, uchar cmd)
+{
+	return io->transfer(QByteArray(1, (char)cmd), 1) == QByteArray(1, 0x01);
+}
+
+bool SpiFlashJob::setup(BinModeWorker *io)
+{
+	/* answers SPI1 from bbio mode and in SPI mode */
+	if (io->transfer(QByteArray("\x01", 1), 4) != "SPI1")
+	{
+		error = "no SPI mode, enter BBIO mode first";
+		return false;
+	}
+	/* power, aux, CS high; 4MHz; 3.3v outputs, output on active to idle (mode 0) */
+	if (!spi_simple_command(io, 0x4B) || !spi_simple_command(io, 0x66) || !spi_simple_command(io, 0x8A))
+	{
+		error = "SPI configuration";
+		return false;
+	}
+	return true;
+}
+
+/* 0x04: wlen, rlen (big endian), data; 0x01 then the read data, nothing when rlen is 0 */
+bool SpiFlashJob::write_read(BinModeWorker *io, const QByteArray &out, uchar *in, int in_len)
+{
+	QByteArray cmd, rx;
+
+	cmd.append((char)0x04);
+	cmd.append((char)(out.size() >> 8));
+	cmd.append((char)out.size());
+	cmd.append((char)(in_len >> 8));
+	cmd.append((char)in_len);
+	cmd.append(out);
+
+	rx = io->transfer(cmd, in_len ? in_len + 1 : 0);
+	if (in_len == 0)
+		return true;
+	if (rx.size() != in_len + 1 || rx.at(0) != 0x01)
+	{
+		error = rx.isEmpty() ? "no reply" : "write-then-read failed";
+		return false;
+	}
+	memcpy(in, rx.constData() + 1, in_len);
+	return true;
+}
+
+bool SpiFlashJob::identify(BinModeWorker *io)
+{
+	uchar id[3];
+
+	if (!write_read(io, QByteArray(1, (char)RDID), id, 3))
+		return false;
+	io->log(QString("ChipID: 0x%1 0x%2 0x%3").arg(id[0], 2, 16, QChar('0'))
+		.arg(id[1], 2, 16, QChar('0')).arg(id[2], 2, 16, QChar('0')));
+
+	if ((id[0] == 0xFF && id[1] == 0xFF) || (id[0] == 0x00 && id[1] == 0x00))
+	{
+		error = "no chip";
+		return false;
+	}
+
+	/* most 25 series parts give the size as a power of two in the third byte */
+	if (size == 0)
+	{
+		if (id[2] < 0x10 || id[2] > 0x18)
+		{
+			if (op == Identify)
+				return true;
+			error = "unknown size, set the chip size";
+			return false;
+		}
+		size = (qint64)1 << id[2];
+	}
+	io->log(QString("Size: %1K").arg(size / 1024));
+	return true;
+}
+
+bool SpiFlashJob::wait_ready(BinModeWorker *io, int timeout_ms)
+{
+	QElapsedTimer timer;
+	uchar status;
+
+	timer.start();
+	do {
+		if (!write_read(io, QByteArray(1, (char)RDSR), &status, 1))
+			return false;
+		if (!(status & SPI_STATUS_WIP))
+			return true;
+	} while (timer.elapsed() < timeout_ms);
+	error = "chip stays busy";
+	return false;
+}
+
+bool SpiFlashJob::write_enable(BinModeWorker *io)
+{
+	return write_read(io, QByteArray(1, (char)WREN), 0, 0);
+}
+
+bool SpiFlashJob::read_flash(BinModeWorker *io, quint32 addr, uchar *in, int len)
+{
+	return write_read(io, spi_address_command(READ, addr), in, len);
+}
+
+bool SpiFlashJob::erase_sector(BinModeWorker *io, quint32 addr)
+{
+	if (!write_enable(io) || !write_read(io, spi_address_command(SSE, addr), 0, 0))
+		return false;
+	return wait_ready(io, 2000);
+}
+
+/* len up to a page from addr on; the bytes not sent keep what they hold */
+bool SpiFlashJob::program_page(BinModeWorker *io, quint32 addr, const uchar *data, int len)
+{
+	QByteArray out = spi_address_command(PP, addr);
+
+	out.append((const char *)data, len);
+	if (!write_enable(io) || !write_read(io, out, 0, 0))
+		return false;
+	return wait_ready(io, 100);
+}
+
+bool SpiFlashJob::dump(BinModeWorker *io, uchar *map)
+{
+	qint64 addr;
+	int len;
+
+	for (addr = 0; addr < size; addr += len)
+	{
+		if (io->cancelled())
+			return false;
+		len = (int)qMin((qint64)SPI_READ_CHUNK, size - addr);
+		if (!read_flash(io, (quint32)addr, map + addr, len))
+			return false;
+		io->output(QByteArray((const char *)map + addr, len));
+		io->report(addr + len, size);
+	}
+	return true;
+}
+
+/*
+ * Sector by sector: sectors that already match are skipped, a sector is
+ * only erased when a bit has to go from 0 to 1, only pages that differ
+ * are programmed, and each sector is read back once it is written. Only
+ * the file's bytes are sent; past its end an erased last sector stays
+ * blank. The caller makes sure the file fits in the chip.
+ */
+bool SpiFlashJob::program(BinModeWorker *io, const uchar *map, qint64 length)
+{
+	uchar chip[SPI_SECTOR_SIZE];
+	qint64 addr;
+	int len, i, page;
+	bool erase;
+
+	for (addr = 0; addr < length; addr += SPI_SECTOR_SIZE)
+	{
+		if (io->cancelled())
+			return false;
+		len = (int)qMin((qint64)SPI_SECTOR_SIZE, length - addr);
+		/* the whole sector, but not past the end of the chip */
+		if (!read_flash(io, (quint32)addr, chip, (int)qMin((qint64)SPI_SECTOR_SIZE, size - addr)))
+			return false;
+		if (memcmp(chip, map + addr, len) == 0)
+		{
+			io->report(addr + len, length);
+			continue;
+		}
+
+		erase = false;
+		for (i = 0; i < len && !erase; i++)
+			erase = (chip[i] & map[addr + i]) != map[addr + i];
+		if (erase)
+		{
+			if (!erase_sector(io, (quint32)addr))
+				return false;
+			memset(chip, 0xFF, sizeof(chip));
+		}
+
+		for (page = 0; page < len; page += SPI_PAGE_SIZE)
+		{
+			int n = qMin(SPI_PAGE_SIZE, len - page);
+
+			if (memcmp(map + addr + page, chip + page, n) == 0)
+				continue;
+			if (!program_page(io, (quint32)(addr + page), map + addr + page, n))
+				return false;
+		}
+
+		if (!read_flash(io, (quint32)addr, chip, len))
+			return false;
+		if (memcmp(chip, map + addr, len) != 0)
+		{
+			error = QString("sector at 0x%1 does not verify").arg(addr, 6, 16, QChar('0'));
+			return false;
+		}
+		io->report(addr + len, length);
+	}
+	return true;
+}
+
+bool SpiFlashJob::verify(BinModeWorker *io, const uchar *map, qint64 length)
+{
+	uchar chip[SPI_READ_CHUNK];
+	qint64 addr;
+	int len, i;
+
+	for (addr = 0; addr < length; addr += len)
+	{
+		if (io->cancelled())
+			return false;
+		len = (int)qMin((qint64)SPI_READ_CHUNK, length - addr);
+		if (!read_flash(io, (quint32)addr, chip, len))
+			return false;
+		for (i = 0; i < len; i++)
+		{
+			if (chip[i] != map[addr + i])
+			{
+				error = QString("differs at 0x%1").arg(addr + i, 6, 16, QChar('0'));
+				return false;
+			}
+		}
+		io->report(addr + len, length);
+	}
+	return true;
+}
+
+bool SpiFlashJob::run(BinModeWorker *io)
+{
+	QFile qfile(path);
+	uchar *map = 0;
+	qint64 length = 0;
+	bool ok, spi;
+
+	spi = setup(io);
+	if (!spi || !identify(io))
+		goto done;
+	if (size > SPI_MAX_SIZE)
+	{
+		error = "chips over 16MB need 4 byte addresses";
+		goto done;
+	}
+
+	switch (op)
+	{
+	case Identify:
+		break;
+	case Read:
+		if (!qfile.open(QIODevice::ReadWrite | QIODevice::Truncate) || !qfile.resize(size))
+		{
+			error = qfile.errorString();
+			goto done;
+		}
+		map = qfile.map(0, size);
+		if (!map)
+		{
+			error = qfile.errorString();
+			goto done;
+		}
+		dump(io, map);
+		break;
+	case Program:
+	case Verify:
+		if (!qfile.open(QIODevice::ReadOnly))
+		{
+			error = qfile.errorString();
+			goto done;
+		}
+		length = qfile.size();
+		if (length > size)
+		{
+			error = QString("file is larger than the chip (%1K)").arg(size / 1024);
+			goto done;
+		}
+		map = length ? qfile.map(0, length) : 0;
+		if (length && !map)
+		{
+			error = qfile.errorString();
+			goto done;
+		}
+		if (op == Program)
+			program(io, map, length);
+		else
+			verify(io, map, length);
+		break;
+	}
+
+done:
+	if (map)
+		qfile.unmap(map);
+	qfile.close();
+	ok = error.isEmpty() && !io->cancelled();
+
+	/* CS back up and out of SPI mode, the way the other tabs expect it */
+	if (spi)
+	{
+		spi_simple_command(io, 0x03);
+		io->transfer(QByteArray("\x00", 1), 5);
+	}
+	return ok;
+}
 
 SpiGui::SpiGui(MainWidgetFrame *parent) : QWidget(parent)
 {
 	this->parent=parent;
+	job_id = 0;
 
 	QLabel *file_label = new QLabel("File: ");
+	QLabel *size_label = new QLabel("Chip Size: ");
 	QLabel *log_label = new QLabel("Log: ");
 
 	QPushButton *read_btn = new QPushButton("Read SPI");
 	QPushButton *write_btn = new QPushButton("Write SPI");
+	QPushButton *verify_btn = new QPushButton("Verify SPI");
 	QPushButton *chip_id_btn = new QPushButton("SPI Chip ID");
 
+	QRegExp rx_int("^\\d{1,}[KMkm]{,1}");
+
 	file = new QLineEdit;
-	msglog = new QTextEdit;
-	msglog->setReadOnly(true);
+	chip_size = new QLineEdit;
+	chip_size->setPlaceholderText("from chip id");
+	chip_size->setValidator(new QRegExpValidator(rx_int, this));
+	rate = new QLabel;
+	msglog = new LogView;
+	hexview = new HexView;
 
 	QVBoxLayout *vlayout = new QVBoxLayout;
 	QHBoxLayout *hlayout = new QHBoxLayout;
 
 	connect(read_btn, SIGNAL(clicked()), this, SLOT(read_spi()));
 	connect(write_btn, SIGNAL(clicked()), this, SLOT(write_spi()));
+	connect(verify_btn, SIGNAL(clicked()), this, SLOT(verify_spi()));
 	connect(chip_id_btn, SIGNAL(clicked()), this, SLOT(spi_chip_id()));
+	connect(parent->bp, SIGNAL(job_progress(int,qint64,qint64)), this, SLOT(job_progress(int,qint64,qint64)));
+	connect(parent->bp, SIGNAL(job_message(int,QString)), this, SLOT(job_message(int,QString)));
+	connect(parent->bp, SIGNAL(job_data(int,QByteArray)), this, SLOT(job_data(int,QByteArray)));
+	connect(parent->bp, SIGNAL(job_finished(int,bool,QString)), this, SLOT(job_finished(int,bool,QString)));
 
 	vlayout->addWidget(file_label);
 	vlayout->addWidget(file);
+	vlayout->addWidget(size_label);
+	vlayout->addWidget(chip_size);
 
 	hlayout->addWidget(read_btn);
 	hlayout->addWidget(write_btn);
+	hlayout->addWidget(verify_btn);
 	hlayout->addWidget(chip_id_btn);
 	
 	vlayout->addLayout(hlayout);
+	vlayout->addWidget(rate);
 	vlayout->addSpacing(50);
 	vlayout->addWidget(log_label);
 	vlayout->addWidget(msglog);
+	vlayout->addWidget(hexview, 1);
 
 	setLayout(vlayout);
 }
 
-void SpiGui::read_spi(void)
+void SpiGui::start_job(int op)
 {
-	int ret = 0, i = 0;
-	unsigned long chipsize = 262144;
-	QString qmsg_start = QString("Reading SPI Chip...");
-	QString qmsg_fail = QString("Reading SPI Chip...Failed");
-	QString qmsg_success = QString("Reading SPI Chip...Success!");
-	QByteArray data_byte("\x03\x00\x00\x00");
-	QByteArray read_cmd, read_resp;
-
-	QCoreApplication::sendEvent(parent->parent, new BPStatusMsgEvent(qmsg_start));
-	postMsgEvent("JEDEC READ");
-
-	if (!parent->bp->serial->isOpen())
-		goto err;
-
-	ret = parent->bp->enter_mode_spi();
-	if (ret)
-	{
-		postMsgEvent("SPI OK.");
-	} else {
-		postMsgEvent("SPI Failed.");
-		goto err;
-	}
-
-	ret = parent->bp->bbio_peripherial_set(0x0B);
-	if (ret)
-	{
-		postMsgEvent("Peripherial Config Ok.");
-	} else {
-		postMsgEvent("Peripherial Config Failed.");
-		goto err;
-	}
-
-	ret = parent->bp->bbio_speed_set(0x06);
-	if (ret)
-	{
-		postMsgEvent("SPI Speed Config Ok.");
-	} else {
-		postMsgEvent("SPI Speed Config Failed.");
-		goto err;
-	}
+	QString text = chip_size->text().trimmed();
+	qint64 size = 0;
 
-	ret = parent->bp->spi_configure_set(0x08);
-	if (ret)
+	if (!parent->bp->is_open() || parent->bp->busy())
 	{
-		postMsgEvent("SPI Config Ok.");
-	} else {
-		postMsgEvent("SPI Config Failed.");
-		goto err;
+		postMsgEvent("Bus Pirate not open or busy.");
+		return;
 	}
-
-	ret = parent->bp->spi_cs_low();
-	if (ret)
+	if (op != SpiFlashJob::Identify && file->text().isEmpty())
 	{
-		postMsgEvent("CS Low: Ok.");
-	} else {
-		postMsgEvent("CS Low: Failed.");
+		postMsgEvent("No file.");
+		return;
 	}
 
-	//for (i = 0; i <chipsize; i+=16)
-	//{
-		read_cmd = parent->bp->bbio_bulk_trans(data_byte, 4);
-		if (read_cmd.contains("\x01"))
-		{
-			postMsgEvent("Reading...");
-		} else {
-			postMsgEvent("Reading...Failed!");
-		}
-
-	for (i=0; i<chipsize; i+=16)
+	if (!text.isEmpty())
 	{
-		QByteArray ba;
-		ba.resize(16);
-		read_resp = parent->bp->bbio_bulk_trans(ba, 16);
-		if (read_resp.contains("\x01"))
-		{
-			for (i=0; i<16; i++)  postMsgEvent(QString("0x%1 ").arg((QString)read_resp.mid(i,1).toHex()).toAscii());
-		} else {
-			postMsgEvent("Reading...Failed!");
-		}
+		size = text.left(text.length() - (text.at(text.length() - 1).isLetter() ? 1 : 0)).toLongLong();
+		if (text.endsWith('K', Qt::CaseInsensitive))
+			size *= 1024;
+		else if (text.endsWith('M', Qt::CaseInsensitive))
+			size *= 1024 * 1024;
 	}
 
-	ret = parent->bp->spi_cs_high();
-	if (ret)
-	{
-		postMsgEvent("CS High: Ok.");
-	} else {
-		postMsgEvent("CS High: Failed.");
-	}
+	rate->clear();
+	hexview->clear();
+	job_timer.start();
+	job_id = parent->bp->submit(new SpiFlashJob((SpiFlashJob::Op)op, file->text(), size));
+}
 
-	ret = parent->bp->reset_bbio();
-	if (ret)
-	{
-		postMsgEvent("Reset to BBIO mode: Ok.");
-	} else {
-		postMsgEvent("Reset to BBIO mode: Failed.");
-	}
-	QCoreApplication::sendEvent(parent->parent, new BPStatusMsgEvent(qmsg_success));
-	return;	
-err:
-	QCoreApplication::sendEvent(parent->parent, new BPStatusMsgEvent(qmsg_fail));
+void SpiGui::read_spi(void)
+{
+	start_job(SpiFlashJob::Read);
 }
 
 void SpiGui::write_spi(void)
-{}
+{
+	start_job(SpiFlashJob::Program);
+}
+
+void SpiGui::verify_spi(void)
+{
+	start_job(SpiFlashJob::Verify);
+}
 
 void SpiGui::spi_chip_id(void)
 {
-	QString qmsg_start = QString("Getting SPI Chip Id...");
-	QString qmsg_fail = QString("Getting SPI Chip Id...Failed");
-	QString qmsg_success = QString("Getting SPI Chip Id...Success!");
-	QByteArray data_byte("\x9F\x00\x00\x00");
-	QByteArray chip_id;
-	int ret = 0, i = 0;
+	start_job(SpiFlashJob::Identify);
+}
 
-	QCoreApplication::sendEvent(parent->parent, new BPStatusMsgEvent(qmsg_start));
-	postMsgEvent("JEDEC RDID");
-	
-	if (!parent->bp->serial->isOpen())
-		goto err;
+void SpiGui::job_progress(int id, qint64 done, qint64 total)
+{
+	qint64 ms = qMax(job_timer.elapsed(), (qint64)1);
 
-	ret = parent->bp->enter_mode_spi();
-	if (ret)
-	{
-		postMsgEvent("SPI OK.");
-	} else {
-		postMsgEvent("SPI Failed.");
-		goto err;
-	}
-	
-	ret = parent->bp->bbio_peripherial_set(0x0B);
-	if (ret)
-	{
-		postMsgEvent("Peripherial Config Ok.");
-	} else {
-		postMsgEvent("Peripherial Config Failed.");
-		goto err;
-	}
-	
-	ret = parent->bp->bbio_speed_set(0x06);
-	if (ret)
-	{
-		postMsgEvent("SPI Speed Config Ok.");
-	} else {
-		postMsgEvent("SPI Speed Config Failed.");
-		goto err;
-	}
-	
-	ret = parent->bp->spi_configure_set(0x08);
-	if (ret)
-	{
-		postMsgEvent("SPI Config Ok.");
-	} else {
-		postMsgEvent("SPI Config Failed.");
-		goto err;
-	}
-	
-	ret = parent->bp->spi_cs_low();
-	if (ret)
-	{
-		postMsgEvent("CS Low: Ok.");
-	} else {
-		postMsgEvent("CS Low: Failed.");
-	}
-	
-	chip_id = parent->bp->bbio_bulk_trans(data_byte, 4);
-	if (chip_id.contains("\x01"))
-	{
-		postMsgEvent("ChipID:");
-		for (i = 0; i < chip_id.size(); ++i)  postMsgEvent(QString("0x%1 ").arg((QString)chip_id.mid(i,1).toHex()).toAscii());
-	} else {
-		postMsgEvent("ChipID: Failed!");
-	}
-	
-	ret = parent->bp->spi_cs_high();
-	if (ret)
-	{
-		postMsgEvent("CS High: Ok.");
-	} else {
-		postMsgEvent("CS High: Failed.");
-	}
-	
-	ret = parent->bp->reset_bbio();
-	if (ret)
-	{
-		postMsgEvent("Reset to BBIO mode: Ok.");
-	} else {
-		postMsgEvent("Reset to BBIO mode: Failed.");
-	}
-	QCoreApplication::sendEvent(parent->parent, new BPStatusMsgEvent(qmsg_success));
-	return;	
-err:
-	QCoreApplication::sendEvent(parent->parent, new BPStatusMsgEvent(qmsg_fail));
+	if (id != job_id)
+		return;
+	rate->setText(QString("%1K of %2K, %3 KB/s").arg(done / 1024).arg(total / 1024)
+		.arg(done * 1000.0 / 1024.0 / ms, 0, 'f', 1));
 }
 
-void SpiGui::customEvent(QEvent *ev)
+void SpiGui::job_message(int id, const QString &msg)
 {
-	if (static_cast<BPEventType>(ev->type()) == SpiLogMsgEventType)
-	{
-		msglog->append(dynamic_cast<SpiLogMsgEvent* >(ev)->msg);
-	}
+	if (id == job_id)
+		msglog->append(msg);
 }
 
-void SpiGui::postMsgEvent(const char* msg)
+void SpiGui::job_data(int id, const QByteArray &data)
 {
-	QString qmsg = QString(msg);
-	QCoreApplication::sendEvent(this, new SpiLogMsgEvent(qmsg));
+	if (id == job_id)
+		hexview->append(data);
 }
 
+void SpiGui::job_finished(int id, bool ok, const QString &msg)
+{
+	if (id != job_id)
+		return;
+	msglog->append(QString("%1 (%2 ms)").arg(msg).arg(job_timer.elapsed()));
+	job_id = 0;
+}
+
+void SpiGui::postMsgEvent(const char* msg)
+{
+	msglog->append(QString(msg));
+}
@@ -0,0 +1,156 @@
+#include <QtWidgets>
+#include "LogView.h"
+
+LogView::LogView(QWidget *parent) : QPlainTextEdit(parent)
+{
+	setReadOnly(true);
+	setMaximumBlockCount(LOG_MAX_LINES);
+
+	timer = new QTimer(this);
+	timer->setSingleShot(true);
+	timer->setInterval(LOG_REFRESH_MS);
+	connect(timer, SIGNAL(timeout()), this, SLOT(refresh()));
+}
+
+void LogView::append(const QString &line)
+{
+	pending << line;
+	if (pending.size() > LOG_MAX_LINES)
+		pending.removeFirst();
+	if (!timer->isActive())
+		timer->start();
+}
+
+void LogView::refresh()
+{
+	if (pending.isEmpty())
+		return;
+	appendPlainText(pending.join("\n"));
+	pending.clear();
+}
+
+void LogView::clear()
+{
+	pending.clear();
+	QPlainTextEdit::clear();
+}
+
+HexView::HexView(QWidget *parent) : QAbstractScrollArea(parent)
+{
+	QFont font("Monospace");
+	font.setStyleHint(QFont::TypeWriter);
+	setFont(font);
+	setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+	head = 0;
+
+	timer = new QTimer(this);
+	timer->setSingleShot(true);
+	timer->setInterval(LOG_REFRESH_MS);
+	connect(timer, SIGNAL(timeout()), this, SLOT(refresh()));
+}
+
+void HexView::append(const QByteArray &data)
+{
+	const char *p = data.constData();
+	qint64 n = data.size();
+	int pos, len;
+
+	if (n > HEX_MAX_BYTES)
+	{
+		p += n - HEX_MAX_BYTES;
+		head += n - HEX_MAX_BYTES;
+		n = HEX_MAX_BYTES;
+	}
+
+	/* grows until it is full, then wraps: offset o is at o % HEX_MAX_BYTES */
+	if (ring.size() < HEX_MAX_BYTES)
+		ring.resize((int)qMin(head + n, (qint64)HEX_MAX_BYTES));
+
+	while (n > 0)
+	{
+		pos = (int)(head % HEX_MAX_BYTES);
+		len = (int)qMin(n, (qint64)(HEX_MAX_BYTES - pos));
+		memcpy(ring.data() + pos, p, len);
+		p += len;
+		n -= len;
+		head += len;
+	}
+
+	if (!timer->isActive())
+		timer->start();
+}
+
+qint64 HexView::total() const
+{
+	return head;
+}
+
+void HexView::clear()
+{
+	ring.clear();
+	head = 0;
+	refresh();
+}
+
+int HexView::visibleRows() const
+{
+	return qMax(1, viewport()->height() / fontMetrics().height());
+}
+
+void HexView::updateScrollBar()
+{
+	QScrollBar *bar = verticalScrollBar();
+	bool follow = bar->value() == bar->maximum();
+	qint64 first = qMax((qint64)0, head - HEX_MAX_BYTES);
+	int rows = (int)((head + HEX_ROW_BYTES - 1) / HEX_ROW_BYTES - first / HEX_ROW_BYTES);
+
+	bar->setRange(0, qMax(0, rows - visibleRows()));
+	bar->setPageStep(visibleRows());
+	if (follow)
+		bar->setValue(bar->maximum());
+}
+
+void HexView::refresh()
+{
+	updateScrollBar();
+	viewport()->update();
+}
+
+void HexView::resizeEvent(QResizeEvent *ev)
+{
+	QAbstractScrollArea::resizeEvent(ev);
+	updateScrollBar();
+}
+
+/* only the rows on screen */
+void HexView::paintEvent(QPaintEvent *ev)
+{
+	QPainter painter(viewport());
+	QFontMetrics fm = fontMetrics();
+	qint64 first = qMax((qint64)0, head - HEX_MAX_BYTES);
+	qint64 addr = (first / HEX_ROW_BYTES + verticalScrollBar()->value()) * HEX_ROW_BYTES;
+	QString hex, ascii;
+	qint64 offset;
+	uchar c;
+	int y, i;
+
+	for (y = fm.ascent(); y - fm.ascent() < viewport()->height() && addr < head; y += fm.height(), addr += HEX_ROW_BYTES)
+	{
+		hex.clear();
+		ascii.clear();
+		for (i = 0; i < HEX_ROW_BYTES; i++)
+		{
+			offset = addr + i;
+			if (offset < first || offset >= head)
+			{
+				hex += "   ";
+				ascii += ' ';
+				continue;
+			}
+			c = (uchar)ring.at((int)(offset % HEX_MAX_BYTES));
+			hex += QString("%1 ").arg(c, 2, 16, QChar('0'));
+			ascii += (c >= 0x20 && c < 0x7F) ? QLatin1Char((char)c) : QLatin1Char('.');
+		}
+		painter.drawText(4, y, QString("%1  %2 %3").arg(addr, 8, 16, QChar('0')).arg(hex).arg(ascii));
+	}
+}
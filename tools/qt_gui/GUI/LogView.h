@@ -0,0 +1,60 @@
+#ifndef __LOGVIEW_H
+#define __LOGVIEW_H
+
+#include <QtWidgets>
+
+/* the views catch up with what was appended at most this often */
+#define LOG_REFRESH_MS   40
+/* lines kept in a log, older ones scroll out */
+#define LOG_MAX_LINES    10000
+/* bytes kept in a hex view */
+#define HEX_MAX_BYTES    (16 * 1024 * 1024)
+#define HEX_ROW_BYTES    16
+
+/*
+ * Log of the interface tabs. append() only queues the line, the queued
+ * lines go into the document in one go when the refresh timer fires.
+ */
+class LogView : public QPlainTextEdit
+{
+Q_OBJECT
+public:
+	LogView(QWidget *parent = 0);
+	void append(const QString &line);
+public slots:
+	void clear();
+private slots:
+	void refresh();
+private:
+	QStringList pending;
+	QTimer *timer;
+};
+
+/*
+ * Hex dump of captured data. The bytes are kept in a ring buffer and
+ * only the rows on screen are ever formatted and painted, so it stays
+ * as quick with a whole flash chip in it as with a page.
+ */
+class HexView : public QAbstractScrollArea
+{
+Q_OBJECT
+public:
+	HexView(QWidget *parent = 0);
+	void append(const QByteArray &data);
+	qint64 total() const;
+public slots:
+	void clear();
+protected:
+	virtual void paintEvent(QPaintEvent *ev);
+	virtual void resizeEvent(QResizeEvent *ev);
+private slots:
+	void refresh();
+private:
+	void updateScrollBar();
+	int visibleRows() const;
+	QByteArray ring;
+	qint64 head;
+	QTimer *timer;
+};
+
+#endif
@@ -15,8 +15,22 @@ MainAppWindow::MainAppWindow()
 	statusBar()->showMessage("Ready");
 	bpstatus = new QLabel("Bus Pirate Closed");
 	statusBar()->addPermanentWidget(bpstatus);
+	jobprogress = new QProgressBar;
+	jobprogress->setRange(0, 100);
+	jobprogress->setMaximumWidth(150);
+	jobprogress->hide();
+	statusBar()->addPermanentWidget(jobprogress);
+	jobcancel = new QToolButton;
+	jobcancel->setText("Cancel");
+	jobcancel->hide();
+	statusBar()->addPermanentWidget(jobcancel);
 	frame = new MainWidgetFrame(this);
 	setCentralWidget(frame);
+
+	connect(jobcancel, SIGNAL(clicked()), frame->bp, SLOT(cancel()));
+	connect(frame->bp, SIGNAL(job_started(int,QString)), this, SLOT(jobStarted(int,QString)));
+	connect(frame->bp, SIGNAL(job_progress(int,qint64,qint64)), this, SLOT(jobProgress(int,qint64,qint64)));
+	connect(frame->bp, SIGNAL(job_finished(int,bool,QString)), this, SLOT(jobFinished(int,bool,QString)));
 }
 
 void MainAppWindow::customEvent(QEvent *ev)
@@ -31,6 +45,29 @@ void MainAppWindow::customEvent(QEvent *ev)
 	}
 }
 
+void MainAppWindow::jobStarted(int id, const QString &name)
+{
+	jobname = name;
+	jobprogress->setValue(0);
+	jobprogress->show();
+	jobcancel->show();
+	statusBar()->showMessage(QString("%1...").arg(name));
+}
+
+void MainAppWindow::jobProgress(int id, qint64 done, qint64 total)
+{
+	if (total > 0)
+		jobprogress->setValue((int)(done * 100 / total));
+	statusBar()->showMessage(QString("%1... %2 of %3 bytes").arg(jobname).arg(done).arg(total));
+}
+
+void MainAppWindow::jobFinished(int id, bool ok, const QString &msg)
+{
+	jobprogress->hide();
+	jobcancel->hide();
+	statusBar()->showMessage(msg);
+}
+
 void MainAppWindow::createActions(){}
 void MainAppWindow::createMenus(){}
 
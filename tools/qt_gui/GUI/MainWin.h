@@ -37,15 +37,23 @@ public:
 
 class MainAppWindow : public QMainWindow
 {
+Q_OBJECT
 protected:
 	virtual void customEvent(QEvent *ev);
 public:
 	MainAppWindow();
 	MainWidgetFrame *frame;
+private slots:
+	void jobStarted(int id, const QString &name);
+	void jobProgress(int id, qint64 done, qint64 total);
+	void jobFinished(int id, bool ok, const QString &msg);
 private:
 	void createActions();
 	void createMenus();
 	QLabel *bpstatus;
+	QProgressBar *jobprogress;
+	QToolButton *jobcancel;
+	QString jobname;
 };
 
 #endif
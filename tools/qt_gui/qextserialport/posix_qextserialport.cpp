@@ -2,7 +2,11 @@
 
 #include <fcntl.h>
 #include <stdio.h>
+#include <poll.h>
 #include "qextserialport.h"
+#ifdef Q_OS_LINUX
+#include <linux/serial.h>
+#endif
 #include <QMutexLocker>
 #include <QDebug>
 
@@ -21,6 +25,7 @@ QextSerialPort::QextSerialPort(const QextSerialPort& s)
     Settings.StopBits=s.Settings.StopBits;
     Settings.FlowControl=s.Settings.FlowControl;
     lastErr=s.lastErr;
+    _lowLatency = s._lowLatency;
 
     fd = s.fd;
     readNotifier = 0;
@@ -43,6 +48,7 @@ QextSerialPort& QextSerialPort::operator=(const QextSerialPort& s)
     Settings.StopBits=s.Settings.StopBits;
     Settings.FlowControl=s.Settings.FlowControl;
     lastErr=s.lastErr;
+    _lowLatency = s._lowLatency;
 
     fd = s.fd;
     readNotifier = 0;
@@ -705,14 +711,18 @@ void QextSerialPort::setTimeout(long millisec)
     Posix_Copy_Timeout.tv_sec = millisec / 1000;
     Posix_Copy_Timeout.tv_usec = millisec % 1000;
     if (isOpen()) {
-        if (millisec == -1)
+        //event driven reads never block, the timeout is used by waitForReadyRead() and writes
+        if (millisec == -1 || queryMode() == QextSerialPort::EventDriven)
             fcntl(fd, F_SETFL, O_NDELAY);
         else
             //O_SYNC should enable blocking ::write()
             //however this seems not working on Linux 2.6.21 (works on OpenBSD 4.2)
             fcntl(fd, F_SETFL, O_SYNC);
         tcgetattr(fd, & Posix_CommConfig);
-        Posix_CommConfig.c_cc[VTIME] = millisec/100;
+        if (queryMode() == QextSerialPort::EventDriven)
+            Posix_CommConfig.c_cc[VTIME] = 0;
+        else
+            Posix_CommConfig.c_cc[VTIME] = millisec/100;
         tcsetattr(fd, TCSAFLUSH, & Posix_CommConfig);
     }
 }
@@ -732,6 +742,7 @@ bool QextSerialPort::open(OpenMode mode)
         //note: linux 2.6.21 seems to ignore O_NDELAY flag
         if ((fd = ::open(port.toLatin1() ,O_RDWR | O_NOCTTY | O_NDELAY)) != -1) {
             qDebug("file opened succesfully");
+            lastErr = E_NO_ERROR;
 
             setOpenMode(mode);              // Flag the port as opened
             tcgetattr(fd, &old_termios);    // Save the old termios
@@ -761,10 +772,12 @@ bool QextSerialPort::open(OpenMode mode)
             setFlowControl(Settings.FlowControl);
             setTimeout(Settings.Timeout_Millisec);
             tcsetattr(fd, TCSAFLUSH, &Posix_CommConfig);
+            applyLowLatency();
 
+            readBuffer.clear();
             if (queryMode() == QextSerialPort::EventDriven) {
                 readNotifier = new QSocketNotifier(fd, QSocketNotifier::Read, this);
-                connect(readNotifier, SIGNAL(activated(int)), this, SIGNAL(readyRead()));
+                connect(readNotifier, SIGNAL(activated(int)), this, SLOT(readNotifierActivated()));
             }
         } else {
             qDebug() << "could not open file:" << strerror(errno);
@@ -789,12 +802,14 @@ void QextSerialPort::close()
         // Be a good QIODevice and call QIODevice::close() before POSIX close()
         //  so the aboutToClose() signal is emitted at the proper time
         QIODevice::close();	// Flag the device as closed
-        // QIODevice::close() doesn't actually close the port, so do that here
-        ::close(fd);
+        // The notifier must go before its descriptor does
         if(readNotifier) {
             delete readNotifier;
             readNotifier = 0;
         }
+        // QIODevice::close() doesn't actually close the port, so do that here
+        ::close(fd);
+        readBuffer.clear();
     }
 }
 
@@ -805,8 +820,10 @@ associated with the class is not currently open.
 void QextSerialPort::flush()
 {
     QMutexLocker lock(mutex);
-    if (isOpen())
+    if (isOpen()) {
         tcflush(fd, TCIOFLUSH);
+        readBuffer.clear();
+    }
 }
 
 /*!
@@ -836,7 +853,7 @@ qint64 QextSerialPort::bytesAvailable() const
         if (ioctl(fd, FIONREAD, &bytesQueued) == -1) {
             return (qint64)-1;
         }
-        return bytesQueued + QIODevice::bytesAvailable();
+        return bytesQueued + readBuffer.size() + QIODevice::bytesAvailable();
     }
     return 0;
 }
@@ -981,6 +998,16 @@ qint64 QextSerialPort::readData(char * data, qint64 maxSize)
 {
     QMutexLocker lock(mutex);
     int retVal = 0;
+    if (queryMode() == QextSerialPort::EventDriven) {
+        // take in whatever arrived since the notifier last ran, then serve from the buffer
+        fillReadBuffer();
+        retVal = (int)qMin(maxSize, (qint64)readBuffer.size());
+        memcpy(data, readBuffer.constData(), retVal);
+        readBuffer.remove(0, retVal);
+        if (retVal == 0 && lastErr == E_READ_FAILED)
+            return -1;
+        return retVal;
+    }
     retVal = ::read(fd, data, maxSize);
     if (retVal == -1)
         lastErr = E_READ_FAILED;
@@ -1000,9 +1027,160 @@ qint64 QextSerialPort::writeData(const char * data, qint64 maxSize)
 {
     QMutexLocker lock(mutex);
     int retVal = 0;
+    if (queryMode() == QextSerialPort::EventDriven) {
+        // the descriptor is non-blocking, wait for room in the tty instead of failing
+        struct pollfd pfd;
+        qint64 written = 0;
+        bool failed = false;
+        while (written < maxSize) {
+            retVal = ::write(fd, data + written, maxSize - written);
+            if (retVal > 0) {
+                written += retVal;
+                continue;
+            }
+            if (retVal == -1 && errno != EAGAIN && errno != EINTR) {
+                lastErr = E_WRITE_FAILED;
+                failed = true;
+                break;
+            }
+            if (Settings.Timeout_Millisec == -1)
+                break;
+            pfd.fd = fd;
+            pfd.events = POLLOUT;
+            pfd.revents = 0;
+            if (poll(&pfd, 1, Settings.Timeout_Millisec) == 0) {
+                lastErr = E_PORT_TIMEOUT;
+                break;
+            }
+        }
+        return (written == 0 && failed) ? -1 : written;
+    }
     retVal = ::write(fd, data, maxSize);
     if (retVal == -1)
        lastErr = E_WRITE_FAILED;
 
     return (qint64)retVal;
 }
+
+/*!
+Sets or clears ASYNC_LOW_LATENCY on the tty according to lowLatency().  Used internally,
+the caller holds the mutex and the port is open.
+*/
+void QextSerialPort::applyLowLatency()
+{
+#if defined(TIOCGSERIAL) && defined(ASYNC_LOW_LATENCY)
+    struct serial_struct serial;
+    if (ioctl(fd, TIOCGSERIAL, &serial) == -1) {
+        // not every tty driver has serial_struct (e.g. cdc_acm on older kernels)
+        if (_lowLatency)
+            qDebug() << "low latency not supported by" << port << ":" << strerror(errno);
+        return;
+    }
+    if (_lowLatency)
+        serial.flags |= ASYNC_LOW_LATENCY;
+    else
+        serial.flags &= ~ASYNC_LOW_LATENCY;
+    if (ioctl(fd, TIOCSSERIAL, &serial) == -1)
+        qDebug() << "could not set low latency on" << port << ":" << strerror(errno);
+#else
+    if (_lowLatency)
+        TTY_PORTABILITY_WARNING("QextSerialPort Portability Warning: low latency mode is not supported on this system.");
+#endif
+}
+
+/*!
+Moves everything the tty has buffered into readBuffer without blocking.  Returns true if
+anything was added.  On a hangup the read notifier is disabled, as it would fire forever, and
+lastErr is set to E_READ_FAILED.  Used internally in EventDriven mode, the caller holds the mutex.
+*/
+bool QextSerialPort::fillReadBuffer()
+{
+    char buf[1024];
+    struct pollfd pfd;
+    int n, before = readBuffer.size();
+    bool hungup = false;
+
+    for (;;) {
+        n = ::read(fd, buf, sizeof(buf));
+        if (n > 0) {
+            readBuffer.append(buf, n);
+            continue;
+        }
+        if (n == -1 && errno == EINTR)
+            continue;
+        if (n == -1 && errno != EAGAIN) {
+            hungup = true;
+        }
+        else if (n == 0) {
+            // with VMIN 0 an empty tty returns 0 as well, only poll() tells a hangup
+            pfd.fd = fd;
+            pfd.events = POLLIN;
+            pfd.revents = 0;
+            hungup = poll(&pfd, 1, 0) > 0 && (pfd.revents & (POLLHUP | POLLERR | POLLNVAL));
+        }
+        break;
+    }
+    if (hungup) {
+        lastErr = E_READ_FAILED;
+        if (readNotifier)
+            readNotifier->setEnabled(false);
+    }
+    return readBuffer.size() > before;
+}
+
+/*!
+Called by the read notifier in EventDriven mode: takes in the received bytes and emits
+readyRead() if there were any.
+*/
+void QextSerialPort::readNotifierActivated()
+{
+    bool ready;
+    {
+        QMutexLocker lock(mutex);
+        ready = isOpen() && fillReadBuffer();
+    }
+    if (ready)
+        emit readyRead();
+}
+
+/*!
+Blocks until there is data to read or msecs milliseconds have passed (-1 waits forever).
+Returns true if there is data to read.  In EventDriven mode this also works from a thread
+that is not running an event loop, readyRead() is emitted when new data came in.
+*/
+bool QextSerialPort::waitForReadyRead(int msecs)
+{
+    struct pollfd pfd;
+    bool ready = false;
+    int ret;
+
+    {
+        QMutexLocker lock(mutex);
+        if (!isOpen())
+            return false;
+        if (!readBuffer.isEmpty() || QIODevice::bytesAvailable() > 0)
+            return true;
+        pfd.fd = fd;
+    }
+
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    do {
+        ret = poll(&pfd, 1, msecs);
+    } while (ret == -1 && errno == EINTR);
+    if (ret <= 0)
+        return false;
+
+    {
+        QMutexLocker lock(mutex);
+        if (!isOpen())
+            return false;
+        if (queryMode() == QextSerialPort::EventDriven)
+            ready = fillReadBuffer();
+        else
+            ready = (pfd.revents & POLLIN) != 0;
+    }
+    if (ready && queryMode() == QextSerialPort::EventDriven)
+        emit readyRead();
+    return ready;
+}
@@ -144,6 +144,7 @@ void QextSerialPort::construct()
     Settings.StopBits=STOP_1;
     Settings.FlowControl=FLOW_HARDWARE;
     Settings.Timeout_Millisec=500;
+    _lowLatency = false;
     mutex = new QMutex( QMutex::Recursive );
     setOpenMode(QIODevice::NotOpen);
 }
@@ -153,6 +154,14 @@ void QextSerialPort::setQueryMode(QueryMode mechanism)
     _queryMode = mechanism;
 }
 
+void QextSerialPort::setLowLatency(bool set)
+{
+    QMutexLocker lock(mutex);
+    _lowLatency = set;
+    if (isOpen())
+        applyLowLatency();
+}
+
 /*!
 Sets the name of the device associated with the object, e.g. "COM1", or "/dev/ttyS0".
 */
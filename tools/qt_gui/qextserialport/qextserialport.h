@@ -245,6 +245,16 @@ class QextSerialPort: public QIODevice
 
         void setTimeout(long);
 
+        /*!
+         * Ask the driver to hand received bytes over as soon as they arrive
+         * instead of batching them (ASYNC_LOW_LATENCY on Linux, which also
+         * drops the latency timer of FTDI adapters to 1ms). Takes effect at
+         * once on an open port, otherwise on open(). Does nothing where the
+         * platform has no such setting.
+         */
+        void setLowLatency(bool set=true);
+        inline bool lowLatency() const { return _lowLatency; }
+
         bool open(OpenMode mode);
         bool isSequential() const;
         void close();
@@ -252,6 +262,7 @@ class QextSerialPort: public QIODevice
 
         qint64 size() const;
         qint64 bytesAvailable() const;
+        virtual bool waitForReadyRead(int msecs);
 
         void ungetChar(char c);
 
@@ -265,7 +276,6 @@ class QextSerialPort: public QIODevice
 
 #ifdef Q_OS_WIN
         virtual qint64 bytesToWrite() const;
-        virtual bool waitForReadyRead(int msecs);  ///< @todo implement.
         static QString fullPortNameWin(const QString & name);
 #endif
 
@@ -275,11 +285,13 @@ class QextSerialPort: public QIODevice
         PortSettings Settings;
         ulong lastErr;
         QueryMode _queryMode;
+        bool _lowLatency;
 
         // platform specific members
 #ifdef Q_OS_UNIX
         int fd;
         QSocketNotifier *readNotifier;
+        QByteArray readBuffer;      ///< bytes taken from the tty in EventDriven mode, not yet read()
         struct termios Posix_CommConfig;
         struct termios old_termios;
         struct timeval Posix_Timeout;
@@ -303,11 +315,18 @@ class QextSerialPort: public QIODevice
 #endif
 
         void construct(); // common construction
+        void applyLowLatency();
+#ifdef Q_OS_UNIX
+        bool fillReadBuffer();
+#endif
         void platformSpecificDestruct();
         void platformSpecificInit();
         qint64 readData(char * data, qint64 maxSize);
         qint64 writeData(const char * data, qint64 maxSize);
 
+    private slots:
+        void readNotifierActivated();
+
     signals:
 //        /**
 //         * This signal is emitted whenever port settings are updated.
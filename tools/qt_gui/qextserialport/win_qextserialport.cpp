@@ -18,6 +18,7 @@ QextSerialPort::QextSerialPort(const QextSerialPort& s):
     memcpy(& overlap, & s.overlap, sizeof(OVERLAPPED));
     setOpenMode(s.openMode());
     lastErr=s.lastErr;
+    _lowLatency = s._lowLatency;
     setPortName(s.port);
     Settings.FlowControl=s.Settings.FlowControl;
     Settings.Parity=s.Settings.Parity;
@@ -64,6 +65,7 @@ QextSerialPort& QextSerialPort::operator=(const QextSerialPort& s) {
     overlapThread = new Win_QextSerialThread(this);
     memcpy(& overlap, & s.overlap, sizeof(OVERLAPPED));
     lastErr=s.lastErr;
+    _lowLatency = s._lowLatency;
     port = s.port;
     Settings.FlowControl=s.Settings.FlowControl;
     Settings.Parity=s.Settings.Parity;
@@ -836,6 +838,21 @@ bool QextSerialPort::waitForReadyRead(int msecs)
     return false;
 }
 
+/*!
+Windows has no per-port equivalent; the FTDI latency timer is a driver setting there.
+*/
+void QextSerialPort::applyLowLatency()
+{
+    if (_lowLatency)
+        TTY_PORTABILITY_WARNING("QextSerialPort Portability Warning: low latency mode is not supported on Windows.");
+}
+
+/*!
+Reads are reported by the overlap thread on Windows, the read notifier is POSIX only.
+*/
+void QextSerialPort::readNotifierActivated()
+{}
+
 qint64 QextSerialPort::bytesToWrite() const
 {
     return _bytesToWrite;